@@ -38,6 +38,8 @@
 #include "kernel/concat.h"
 #include "kernel/exception.h"
 #include "kernel/operators.h"
+#include "kernel/file.h"
+#include "kernel/persistent.h"
 
 /**
  * Phalcon\Acl\Adapter\Memory
@@ -95,6 +97,20 @@
  *	}
  *
  *</code>
+ *
+ * Lists can be compiled into a decision table, every role, resource and access gets an
+ * integer id and the inherited access is resolved into a bitmap:
+ *
+ *<code>
+ *
+ *	//Compile the list and write it to a file
+ *	$acl->compile('app/cache/acl.ser');
+ *
+ *	//Load the compiled list in production
+ *	$acl = new Phalcon\Acl\Adapter\Memory();
+ *	$acl->setCompiled('app/cache/acl.ser');
+ *
+ *</code>
  */
 
 
@@ -112,6 +128,7 @@ PHALCON_INIT_CLASS(Phalcon_Acl_Adapter_Memory){
 	zend_declare_property_null(phalcon_acl_adapter_memory_ce, SL("_roleInherits"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_acl_adapter_memory_ce, SL("_resourcesNames"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_acl_adapter_memory_ce, SL("_accessList"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_acl_adapter_memory_ce, SL("_compiled"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_acl_adapter_memory_ce TSRMLS_CC, 1, phalcon_acl_adapterinterface_ce);
 
@@ -195,6 +212,11 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, addRole){
 		RETURN_MM_FALSE;
 	}
 	
+	/** 
+	 * The compiled decision table is not valid anymore
+	 */
+	phalcon_update_property_null(this_ptr, SL("_compiled") TSRMLS_CC);
+	
 	PHALCON_INIT_VAR(exists);
 	ZVAL_BOOL(exists, 1);
 	phalcon_update_property_array_append(this_ptr, SL("_roles"), object TSRMLS_CC);
@@ -794,6 +816,167 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, deny){
 	RETURN_CCTOR(status);
 }
 
+/**
+ * Finds an element in an array without copying the index, numeric strings are handled as PHP does
+ */
+static zval **phalcon_acl_adapter_memory_find(zval *arr, zval *index) {
+
+	zval **value;
+
+	if (Z_TYPE_P(arr) == IS_ARRAY) {
+		if (Z_TYPE_P(index) == IS_STRING) {
+			if (zend_symtable_find(Z_ARRVAL_P(arr), Z_STRVAL_P(index), Z_STRLEN_P(index) + 1, (void **) &value) == SUCCESS) {
+				return value;
+			}
+		} else {
+			if (Z_TYPE_P(index) == IS_LONG) {
+				if (zend_hash_index_find(Z_ARRVAL_P(arr), Z_LVAL_P(index), (void **) &value) == SUCCESS) {
+					return value;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Reads the key of the current element of a hash table, string keys are not copied
+ */
+static void phalcon_acl_adapter_memory_key(zval *key, HashTable *ht, HashPosition *pos) {
+
+	char *str_key;
+	uint str_key_length;
+	ulong num_key;
+
+	if (zend_hash_get_current_key_ex(ht, &str_key, &str_key_length, &num_key, 0, pos) == HASH_KEY_IS_STRING) {
+		ZVAL_STRINGL(key, str_key, str_key_length - 1, 0);
+	} else {
+		ZVAL_LONG(key, num_key);
+	}
+}
+
+/**
+ * Returns the id of a name in a compiled table, names not in the table get the next id
+ */
+static long phalcon_acl_adapter_memory_intern(zval *names, zval *name, long first) {
+
+	zval **id;
+	long next;
+
+	if ((id = phalcon_acl_adapter_memory_find(names, name)) != NULL) {
+		return Z_LVAL_PP(id);
+	}
+
+	next = zend_hash_num_elements(Z_ARRVAL_P(names)) + first;
+	if (Z_TYPE_P(name) == IS_STRING) {
+		add_assoc_long_ex(names, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, next);
+	} else {
+		add_index_long(names, Z_LVAL_P(name), next);
+	}
+
+	return next;
+}
+
+/**
+ * Resolves the access of a role as isAllowed does, the resource and the access are NULL
+ * for names that are not in the list
+ */
+static zval *phalcon_acl_adapter_memory_decide(zval *access_roles, zval *resource, zval *access) {
+
+	zval **resource_access, **have_access = NULL;
+	HashPosition pos;
+
+	if (Z_TYPE_P(access_roles) != IS_ARRAY) {
+		return NULL;
+	}
+
+	if (resource) {
+		resource_access = phalcon_acl_adapter_memory_find(access_roles, resource);
+		if (resource_access && Z_TYPE_PP(resource_access) == IS_ARRAY) {
+			if (access) {
+				have_access = phalcon_acl_adapter_memory_find(*resource_access, access);
+			}
+			if (!have_access) {
+				zend_hash_find(Z_ARRVAL_PP(resource_access), SS("*"), (void **) &have_access);
+			}
+		}
+	}
+
+	/**
+	 * Fall back to the first resource having a wildcard
+	 */
+	if (!have_access) {
+
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(access_roles), &pos);
+
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(access_roles), (void **) &resource_access, &pos) == SUCCESS) {
+
+			if (Z_TYPE_PP(resource_access) == IS_ARRAY && zend_hash_exists(Z_ARRVAL_PP(resource_access), SS("*"))) {
+				if (access) {
+					have_access = phalcon_acl_adapter_memory_find(*resource_access, access);
+				}
+				if (!have_access) {
+					zend_hash_find(Z_ARRVAL_PP(resource_access), SS("*"), (void **) &have_access);
+				}
+				break;
+			}
+
+			zend_hash_move_forward_ex(Z_ARRVAL_P(access_roles), &pos);
+		}
+	}
+
+	return have_access ? *have_access : NULL;
+}
+
+/**
+ * Checks an access in a compiled decision table without allocating memory, FAILURE is
+ * returned if the role is not in the table
+ */
+static int phalcon_acl_adapter_memory_check(zval *compiled, zval *role, zval *resource, zval *access, int *allowed) {
+
+	zval **roles, **resources, **accesses, **bitmap, **role_id, **resource_id, **access_id;
+	ulong bit;
+
+	if (zend_hash_find(Z_ARRVAL_P(compiled), SS("roles"), (void **) &roles) == FAILURE) {
+		return FAILURE;
+	}
+	if (zend_hash_find(Z_ARRVAL_P(compiled), SS("resources"), (void **) &resources) == FAILURE || Z_TYPE_PP(resources) != IS_ARRAY) {
+		return FAILURE;
+	}
+	if (zend_hash_find(Z_ARRVAL_P(compiled), SS("accesses"), (void **) &accesses) == FAILURE || Z_TYPE_PP(accesses) != IS_ARRAY) {
+		return FAILURE;
+	}
+	if (zend_hash_find(Z_ARRVAL_P(compiled), SS("bitmap"), (void **) &bitmap) == FAILURE || Z_TYPE_PP(bitmap) != IS_STRING) {
+		return FAILURE;
+	}
+
+	role_id = phalcon_acl_adapter_memory_find(*roles, role);
+	if (!role_id || Z_TYPE_PP(role_id) != IS_LONG) {
+		return FAILURE;
+	}
+
+	resource_id = phalcon_acl_adapter_memory_find(*resources, resource);
+	access_id = phalcon_acl_adapter_memory_find(*accesses, access);
+
+	bit = Z_LVAL_PP(role_id) * (zend_hash_num_elements(Z_ARRVAL_PP(resources)) + 1);
+	if (resource_id && Z_TYPE_PP(resource_id) == IS_LONG) {
+		bit += Z_LVAL_PP(resource_id);
+	}
+	bit *= zend_hash_num_elements(Z_ARRVAL_PP(accesses)) + 1;
+	if (access_id && Z_TYPE_PP(access_id) == IS_LONG) {
+		bit += Z_LVAL_PP(access_id);
+	}
+
+	if ((bit >> 3) >= (ulong) Z_STRLEN_PP(bitmap)) {
+		return FAILURE;
+	}
+
+	*allowed = (((unsigned char) Z_STRVAL_PP(bitmap)[bit >> 3]) >> (bit & 7)) & 1;
+
+	return SUCCESS;
+}
+
 /**
  * Check whether a role is allowed to access an action from a resource
  *
@@ -815,11 +998,12 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowed){
 	zval *role, *resource, *access, *events_manager;
 	zval *event_name = NULL, *status, *default_access, *roles_names;
 	zval *have_access = NULL, *access_roles, *resource_access = NULL;
-	zval *resource_name = NULL;
+	zval *resource_name = NULL, *compiled;
 	zval *t0 = NULL;
 	HashTable *ah0, *ah1;
 	HashPosition hp0, hp1;
 	zval **hd;
+	int allowed;
 
 	PHALCON_MM_GROW();
 
@@ -845,6 +1029,26 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowed){
 		}
 	}
 	
+	/** 
+	 * Use the compiled decision table if there is one
+	 */
+	PHALCON_OBS_VAR(compiled);
+	phalcon_read_property_this(&compiled, this_ptr, SL("_compiled"), PH_NOISY_CC);
+	if (Z_TYPE_P(compiled) == IS_ARRAY) {
+		if (phalcon_acl_adapter_memory_check(compiled, role, resource, access, &allowed) == SUCCESS) {
+	
+			phalcon_update_property_long(this_ptr, SL("_accessGranted"), allowed TSRMLS_CC);
+			if (Z_TYPE_P(events_manager) == IS_OBJECT) {
+				PHALCON_INIT_NVAR(event_name);
+				ZVAL_STRING(event_name, "acl:afterCheckAccess", 1);
+				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(events_manager, "fire", event_name, this_ptr);
+			}
+	
+			PHALCON_MM_RESTORE();
+			RETURN_LONG(allowed);
+		}
+	}
+	
 	PHALCON_OBS_VAR(default_access);
 	phalcon_read_property_this(&default_access, this_ptr, SL("_defaultAccess"), PH_NOISY_CC);
 	
@@ -978,6 +1182,11 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 
 	PHALCON_MM_GROW();
 
+	/** 
+	 * The compiled decision table is not valid anymore
+	 */
+	phalcon_update_property_null(this_ptr, SL("_compiled") TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(roles);
 	phalcon_read_property_this(&roles, this_ptr, SL("_roles"), PH_NOISY_CC);
 	
@@ -1116,3 +1325,429 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Stores a decision table in the process cache under the real path of its file, together with the
+ * stamp of the file so the table is dropped when the file is compiled again
+ */
+static void phalcon_acl_adapter_memory_cache_store(zval *path, zval *table TSRMLS_DC){
+
+	zval *entry, *stamp;
+
+	MAKE_STD_ZVAL(stamp);
+	phalcon_file_stamp(stamp, path TSRMLS_CC);
+	if (Z_TYPE_P(stamp) == IS_STRING) {
+		MAKE_STD_ZVAL(entry);
+		array_init_size(entry, 2);
+		add_assoc_zval_ex(entry, SS("stamp"), stamp);
+		Z_ADDREF_P(table);
+		add_assoc_zval_ex(entry, SS("table"), table);
+		phalcon_persistent_cache_store(phalcon_acl_compiled_cache, Z_STRVAL_P(path), Z_STRLEN_P(path), entry);
+		zval_ptr_dtor(&entry);
+	} else {
+		zval_ptr_dtor(&stamp);
+	}
+}
+
+/**
+ * Compiles the list into a decision table. Roles, resources and accesses get integer ids and
+ * the access of every role, including the inherited one, is stored in a bitmap so isAllowed
+ * does not traverse the list anymore. The table is written to a file if a path is passed
+ *
+ *<code>
+ *	$acl->compile('app/cache/acl.ser');
+ *</code>
+ *
+ * @param string $compiledPath
+ * @return array
+ */
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, compile){
+
+	zval *compiled_path = NULL, *roles_names, *resources_names;
+	zval *access_list, *internal_access, *roles, *resources;
+	zval *accesses, *compiled, *serialized, *status = NULL;
+	zval *exception_message, *have_access, *unique_id, *temporary_file, *path;
+	zval **access_roles, **resource_access, **hd;
+	zval role_key, resource_key, access_key;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
+	ulong number_resources, number_accesses, bit, bitmap_length;
+	long role_id, resource_id, access_id;
+	unsigned char *bitmap;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &compiled_path) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	PHALCON_OBS_VAR(roles_names);
+	phalcon_read_property_this(&roles_names, this_ptr, SL("_rolesNames"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(resources_names);
+	phalcon_read_property_this(&resources_names, this_ptr, SL("_resourcesNames"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(access_list);
+	phalcon_read_property_this(&access_list, this_ptr, SL("_accessList"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(internal_access);
+	phalcon_read_property_this(&internal_access, this_ptr, SL("_access"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(roles);
+	array_init(roles);
+	
+	PHALCON_INIT_VAR(resources);
+	array_init(resources);
+	
+	PHALCON_INIT_VAR(accesses);
+	array_init(accesses);
+	
+	/**
+	 * Roles get ids starting at zero
+	 */
+	if (Z_TYPE_P(roles_names) == IS_ARRAY) {
+		ah0 = Z_ARRVAL_P(roles_names);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+			phalcon_acl_adapter_memory_key(&role_key, ah0, &hp0);
+			phalcon_acl_adapter_memory_intern(roles, &role_key, 0);
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	/**
+	 * Resources and accesses get ids starting at one, zero is used for unknown names
+	 */
+	if (Z_TYPE_P(resources_names) == IS_ARRAY) {
+		ah0 = Z_ARRVAL_P(resources_names);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+			phalcon_acl_adapter_memory_key(&resource_key, ah0, &hp0);
+			phalcon_acl_adapter_memory_intern(resources, &resource_key, 1);
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	if (Z_TYPE_P(access_list) == IS_ARRAY) {
+		ah0 = Z_ARRVAL_P(access_list);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &resource_access, &hp0) == SUCCESS) {
+			if (Z_TYPE_PP(resource_access) == IS_ARRAY) {
+				ah1 = Z_ARRVAL_PP(resource_access);
+				zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+				while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+					phalcon_acl_adapter_memory_key(&access_key, ah1, &hp1);
+					if (!PHALCON_IS_STRING(&access_key, "*")) {
+						phalcon_acl_adapter_memory_intern(accesses, &access_key, 1);
+					}
+					zend_hash_move_forward_ex(ah1, &hp1);
+				}
+			}
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	/**
+	 * Names only used by allow() and deny() are interned too
+	 */
+	if (Z_TYPE_P(internal_access) == IS_ARRAY) {
+		ah0 = Z_ARRVAL_P(internal_access);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &access_roles, &hp0) == SUCCESS) {
+			if (Z_TYPE_PP(access_roles) == IS_ARRAY) {
+				ah1 = Z_ARRVAL_PP(access_roles);
+				zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+				while (zend_hash_get_current_data_ex(ah1, (void**) &resource_access, &hp1) == SUCCESS) {
+					phalcon_acl_adapter_memory_key(&resource_key, ah1, &hp1);
+					phalcon_acl_adapter_memory_intern(resources, &resource_key, 1);
+					if (Z_TYPE_PP(resource_access) == IS_ARRAY) {
+						ah2 = Z_ARRVAL_PP(resource_access);
+						zend_hash_internal_pointer_reset_ex(ah2, &hp2);
+						while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+							phalcon_acl_adapter_memory_key(&access_key, ah2, &hp2);
+							if (!PHALCON_IS_STRING(&access_key, "*")) {
+								phalcon_acl_adapter_memory_intern(accesses, &access_key, 1);
+							}
+							zend_hash_move_forward_ex(ah2, &hp2);
+						}
+					}
+					zend_hash_move_forward_ex(ah1, &hp1);
+				}
+			}
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	number_resources = zend_hash_num_elements(Z_ARRVAL_P(resources)) + 1;
+	number_accesses = zend_hash_num_elements(Z_ARRVAL_P(accesses)) + 1;
+	
+	bitmap_length = (zend_hash_num_elements(Z_ARRVAL_P(roles)) * number_resources * number_accesses + 7) >> 3;
+	bitmap = ecalloc(bitmap_length + 1, 1);
+	
+	/**
+	 * Resolve every role x resource x access, the tables are traversed in the order of their ids
+	 */
+	ah0 = Z_ARRVAL_P(roles);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		phalcon_acl_adapter_memory_key(&role_key, ah0, &hp0);
+		role_id = Z_LVAL_PP(hd);
+	
+		access_roles = phalcon_acl_adapter_memory_find(internal_access, &role_key);
+		if (access_roles) {
+	
+			ah1 = Z_ARRVAL_P(resources);
+			zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+	
+			for (resource_id = 0; resource_id < (long) number_resources; resource_id++) {
+	
+				if (resource_id > 0) {
+					phalcon_acl_adapter_memory_key(&resource_key, ah1, &hp1);
+					zend_hash_move_forward_ex(ah1, &hp1);
+				}
+	
+				ah2 = Z_ARRVAL_P(accesses);
+				zend_hash_internal_pointer_reset_ex(ah2, &hp2);
+	
+				for (access_id = 0; access_id < (long) number_accesses; access_id++) {
+	
+					if (access_id > 0) {
+						phalcon_acl_adapter_memory_key(&access_key, ah2, &hp2);
+						zend_hash_move_forward_ex(ah2, &hp2);
+					}
+	
+					have_access = phalcon_acl_adapter_memory_decide(*access_roles, resource_id ? &resource_key : NULL, access_id ? &access_key : NULL);
+					if (have_access && zend_is_true(have_access)) {
+						bit = (role_id * number_resources + resource_id) * number_accesses + access_id;
+						bitmap[bit >> 3] |= 1 << (bit & 7);
+					}
+				}
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(compiled);
+	array_init_size(compiled, 4);
+	phalcon_array_update_string(&compiled, SL("roles"), &roles, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&compiled, SL("resources"), &resources, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&compiled, SL("accesses"), &accesses, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	add_assoc_stringl_ex(compiled, SS("bitmap"), (char *) bitmap, bitmap_length, 0);
+	
+	if (compiled_path && Z_TYPE_P(compiled_path) == IS_STRING) {
+	
+		PHALCON_INIT_VAR(serialized);
+		PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", compiled);
+	
+		/**
+		 * Always use file_put_contents to write files instead of write the file directly,
+		 * this respect the open_basedir directive. The file is written aside and renamed, so
+		 * other processes never read a partial table and see a new inode
+		 */
+		PHALCON_INIT_VAR(unique_id);
+		PHALCON_CALL_FUNC(unique_id, "uniqid");
+	
+		PHALCON_INIT_VAR(temporary_file);
+		PHALCON_CONCAT_VSVS(temporary_file, compiled_path, ".", unique_id, ".tmp");
+	
+		PHALCON_INIT_VAR(status);
+		PHALCON_CALL_FUNC_PARAMS_2(status, "file_put_contents", temporary_file, serialized);
+		if (!PHALCON_IS_FALSE(status)) {
+			PHALCON_INIT_NVAR(status);
+			PHALCON_CALL_FUNC_PARAMS_2(status, "rename", temporary_file, compiled_path);
+			if (PHALCON_IS_FALSE(status)) {
+				VCWD_UNLINK(Z_STRVAL_P(temporary_file));
+			}
+		}
+	
+		if (PHALCON_IS_FALSE(status)) {
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SVS(exception_message, "Compiled ACL file '", compiled_path, "' cannot be written");
+			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_acl_exception_ce, exception_message);
+			return;
+		}
+	
+		PHALCON_INIT_VAR(path);
+		phalcon_realpath(path, compiled_path TSRMLS_CC);
+		if (Z_TYPE_P(path) == IS_STRING) {
+			phalcon_acl_adapter_memory_cache_store(path, compiled TSRMLS_CC);
+		}
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_compiled"), compiled TSRMLS_CC);
+	
+	RETURN_CTOR(compiled);
+}
+
+/**
+ * Sets a decision table produced by compile(). A path is read once per process and read again
+ * when the file changes, an array can be passed to keep the table in a shared memory cache
+ *
+ *<code>
+ *	$acl->setCompiled('app/cache/acl.ser');
+ *
+ *	$acl->setCompiled(apc_fetch('acl'));
+ *</code>
+ *
+ * @param string|array $compiled
+ */
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, setCompiled){
+
+	zval *compiled, *table = NULL, *contents, *exception_message;
+	zval *path, *stamp, *entry, *cached_stamp;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &compiled) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	if (Z_TYPE_P(compiled) == IS_STRING) {
+	
+		/**
+		 * Tables are cached under the real path of the file and only trusted while the
+		 * modification time, size and inode of the file are the same
+		 */
+		PHALCON_INIT_VAR(path);
+		phalcon_realpath(path, compiled TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(stamp);
+		phalcon_file_stamp(stamp, path TSRMLS_CC);
+		if (Z_TYPE_P(stamp) != IS_STRING) {
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SVS(exception_message, "Compiled ACL file '", compiled, "' does not exist");
+			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_acl_exception_ce, exception_message);
+			return;
+		}
+	
+		PHALCON_INIT_VAR(entry);
+		if (phalcon_persistent_cache_fetch(entry, phalcon_acl_compiled_cache, Z_STRVAL_P(path), Z_STRLEN_P(path)) == SUCCESS) {
+			if (phalcon_array_isset_string(entry, SS("stamp"))) {
+				PHALCON_OBS_VAR(cached_stamp);
+				phalcon_array_fetch_string(&cached_stamp, entry, SL("stamp"), PH_NOISY_CC);
+				if (PHALCON_IS_EQUAL(cached_stamp, stamp)) {
+					PHALCON_OBS_VAR(table);
+					phalcon_array_fetch_string(&table, entry, SL("table"), PH_NOISY_CC);
+				}
+			}
+		}
+	
+		if (!table) {
+			PHALCON_INIT_VAR(contents);
+			PHALCON_CALL_FUNC_PARAMS_1(contents, "file_get_contents", path);
+	
+			PHALCON_INIT_VAR(table);
+			if (Z_TYPE_P(contents) == IS_STRING) {
+				PHALCON_CALL_FUNC_PARAMS_1(table, "unserialize", contents);
+			}
+	
+			if (Z_TYPE_P(table) == IS_ARRAY) {
+				phalcon_acl_adapter_memory_cache_store(path, table TSRMLS_CC);
+			}
+		}
+	} else {
+		PHALCON_CPY_WRT(table, compiled);
+	}
+	
+	if (Z_TYPE_P(table) != IS_ARRAY || !phalcon_array_isset_string(table, SS("roles")) || !phalcon_array_isset_string(table, SS("bitmap"))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_acl_exception_ce, "The compiled ACL is not valid");
+		return;
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_compiled"), table TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the compiled decision table, null is returned if the list is not compiled
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, getCompiled){
+
+
+	RETURN_MEMBER(this_ptr, "_compiled");
+}
+
+/**
+ * Checks several accesses of a role at once, every check is a pair resource/access and the
+ * keys of the checks are kept in the result
+ *
+ *<code>
+ *	$menu = $acl->isAllowedMany('Guests', array(
+ *		'products' => array('products', 'index'),
+ *		'invoices' => array('invoices', 'index')
+ *	));
+ *</code>
+ *
+ * @param string $role
+ * @param array $checks
+ * @return array
+ */
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowedMany){
+
+	zval *role, *checks, *compiled, *events_manager, *key = NULL;
+	zval *check = NULL, *resource = NULL, *access = NULL, *have_access = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int allowed, use_compiled;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &role, &checks) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	if (Z_TYPE_P(checks) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_acl_exception_ce, "Checks must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(compiled);
+	phalcon_read_property_this(&compiled, this_ptr, SL("_compiled"), PH_NOISY_CC);
+	
+	/**
+	 * The decision table is read directly if there are no listeners for the checks
+	 */
+	PHALCON_OBS_VAR(events_manager);
+	phalcon_read_property_this(&events_manager, this_ptr, SL("_eventsManager"), PH_NOISY_CC);
+	use_compiled = Z_TYPE_P(compiled) == IS_ARRAY && Z_TYPE_P(events_manager) != IS_OBJECT;
+	
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(checks)));
+	
+	if (!phalcon_is_iterable(checks, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(check);
+	
+		if (Z_TYPE_P(check) != IS_ARRAY || !phalcon_array_isset_long(check, 0) || !phalcon_array_isset_long(check, 1)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_acl_exception_ce, "Every check must be an array with a resource and an access");
+			return;
+		}
+	
+		PHALCON_OBS_NVAR(resource);
+		phalcon_array_fetch_long(&resource, check, 0, PH_NOISY_CC);
+	
+		PHALCON_OBS_NVAR(access);
+		phalcon_array_fetch_long(&access, check, 1, PH_NOISY_CC);
+	
+		if (!use_compiled || phalcon_acl_adapter_memory_check(compiled, role, resource, access, &allowed) == FAILURE) {
+			PHALCON_INIT_NVAR(have_access);
+			PHALCON_CALL_METHOD_PARAMS_3(have_access, this_ptr, "isallowed", role, resource, access);
+			allowed = zend_is_true(have_access);
+		}
+	
+		phalcon_array_update_zval_bool(&return_value, key, allowed, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
@@ -36,6 +36,10 @@ PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowed);
 PHP_METHOD(Phalcon_Acl_Adapter_Memory, getRoles);
 PHP_METHOD(Phalcon_Acl_Adapter_Memory, getResources);
 PHP_METHOD(Phalcon_Acl_Adapter_Memory, _rebuildAccessList);
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, compile);
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, setCompiled);
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, getCompiled);
+PHP_METHOD(Phalcon_Acl_Adapter_Memory, isAllowedMany);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_acl_adapter_memory_addrole, 0, 0, 1)
 	ZEND_ARG_INFO(0, role)
@@ -88,6 +92,19 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_acl_adapter_memory_isallowed, 0, 0, 3)
 	ZEND_ARG_INFO(0, access)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_acl_adapter_memory_compile, 0, 0, 0)
+	ZEND_ARG_INFO(0, compiledPath)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_acl_adapter_memory_setcompiled, 0, 0, 1)
+	ZEND_ARG_INFO(0, compiled)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_acl_adapter_memory_isallowedmany, 0, 0, 2)
+	ZEND_ARG_INFO(0, role)
+	ZEND_ARG_INFO(0, checks)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_acl_adapter_memory_method_entry){
 	PHP_ME(Phalcon_Acl_Adapter_Memory, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Acl_Adapter_Memory, addRole, arginfo_phalcon_acl_adapter_memory_addrole, ZEND_ACC_PUBLIC) 
@@ -104,6 +121,10 @@ PHALCON_INIT_FUNCS(phalcon_acl_adapter_memory_method_entry){
 	PHP_ME(Phalcon_Acl_Adapter_Memory, getRoles, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Acl_Adapter_Memory, getResources, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Acl_Adapter_Memory, _rebuildAccessList, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Acl_Adapter_Memory, compile, arginfo_phalcon_acl_adapter_memory_compile, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Acl_Adapter_Memory, setCompiled, arginfo_phalcon_acl_adapter_memory_setcompiled, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Acl_Adapter_Memory, getCompiled, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Acl_Adapter_Memory, isAllowedMany, arginfo_phalcon_acl_adapter_memory_isallowedmany, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -0,0 +1,142 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/exception.h"
+#include "kernel/operators.h"
+
+/**
+ * Phalcon\Async
+ *
+ * Waits for several network operations at the same time, every operation uses its own
+ * non-blocking connection and the sockets are multiplexed with poll(), so the time spent
+ * waiting is the time of the slowest operation instead of the sum of all of them
+ *
+ *<code>
+ *	$app->get('/dashboard', function () use ($app) {
+ *
+ *		$cache = $app->modelsCache;
+ *
+ *		$news = $cache->getAsync('news');
+ *		$weather = $cache->getAsync('weather');
+ *		$job = $app->queue->putAsync(array('visit' => time()));
+ *
+ *		//Wait at most 200ms for the three operations
+ *		Phalcon\Async::wait(array($news, $weather, $job), 0.2);
+ *
+ *		echo $news->isReady() ? $news->getResult() : 'No news';
+ *	});
+ *</code>
+ */
+
+
+/**
+ * Phalcon\Async initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Async){
+
+	PHALCON_REGISTER_CLASS(Phalcon, Async, async, phalcon_async_method_entry, 0);
+
+	return SUCCESS;
+}
+
+/**
+ * Sends a request to a server returning a handle whose result is the first line of
+ * the response
+ *
+ *<code>
+ *	$handle = Phalcon\Async::send('tcp://127.0.0.1:11211', "version\r\n");
+ *	echo $handle->getResult(); // VERSION 1.4.15
+ *</code>
+ *
+ * @param string $address
+ * @param string $request
+ * @return Phalcon\Async\Handle
+ */
+PHP_METHOD(Phalcon_Async, send){
+
+	zval *address, *request;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &address, &request);
+	
+	if (Z_TYPE_P(address) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_async_exception_ce, "The address must be a string");
+		return;
+	}
+	if (Z_TYPE_P(request) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_async_exception_ce, "The request must be a string");
+		return;
+	}
+	
+	phalcon_async_handle_create(return_value, address, request, PHALCON_ASYNC_LINE, NULL, NULL TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Waits for several handles, the timeout is given in seconds and no timeout waits until
+ * all of them are completed. Returns the number of completed handles
+ *
+ * @param Phalcon\Async\Handle[] $handles
+ * @param double $timeout
+ * @return int
+ */
+PHP_METHOD(Phalcon_Async, wait){
+
+	zval *handles, *timeout = NULL;
+	long milliseconds = -1, completed;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &handles, &timeout);
+	
+	if (Z_TYPE_P(handles) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_async_exception_ce, "The handles must be an array");
+		return;
+	}
+	
+	if (timeout && Z_TYPE_P(timeout) != IS_NULL) {
+		if (Z_TYPE_P(timeout) == IS_DOUBLE) {
+			milliseconds = (long) (Z_DVAL_P(timeout) * 1000);
+		} else {
+			milliseconds = phalcon_get_intval(timeout) * 1000;
+		}
+	}
+	
+	completed = phalcon_async_wait(handles, milliseconds TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(completed);
+}
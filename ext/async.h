@@ -0,0 +1,42 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+extern zend_class_entry *phalcon_async_ce;
+
+PHALCON_INIT_CLASS(Phalcon_Async);
+
+PHP_METHOD(Phalcon_Async, send);
+PHP_METHOD(Phalcon_Async, wait);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_async_send, 0, 0, 2)
+	ZEND_ARG_INFO(0, address)
+	ZEND_ARG_INFO(0, request)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_async_wait, 0, 0, 1)
+	ZEND_ARG_INFO(0, handles)
+	ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
+PHALCON_INIT_FUNCS(phalcon_async_method_entry){
+	PHP_ME(Phalcon_Async, send, arginfo_phalcon_async_send, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Async, wait, arginfo_phalcon_async_wait, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_FE_END
+};
+
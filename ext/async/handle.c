@@ -0,0 +1,614 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "main/php_network.h"
+#include "ext/standard/php_var.h"
+
+#ifdef PHP_WIN32
+#include "win32/time.h"
+#else
+#include <sys/time.h>
+#endif
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/object.h"
+#include "kernel/array.h"
+#include "kernel/fcall.h"
+#include "kernel/exception.h"
+#include "kernel/operators.h"
+
+/**
+ * Phalcon\Async\Handle
+ *
+ * Operation started by Phalcon\Async or by the asynchronous methods of the cache backends
+ * and the queues. The request is written and the response is read while the handles are
+ * waited, so several operations run at the same time on their own connections
+ *
+ *<code>
+ *	$user = $cache->getAsync('user-' . $id);
+ *	$stats = $cache->getAsync('stats');
+ *	$job = $queue->putAsync(array('processVideo' => 4871));
+ *
+ *	Phalcon\Async::wait(array($user, $stats, $job), 0.5);
+ *
+ *	if ($user->isReady()) {
+ *		echo $user->getResult()->name;
+ *	}
+ *</code>
+ */
+
+/** Bytes read from a socket every time it is readable */
+#define PHALCON_ASYNC_CHUNK 65536
+
+/** Writing to a connection closed by the server must not raise SIGPIPE */
+#ifdef MSG_NOSIGNAL
+#define PHALCON_ASYNC_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define PHALCON_ASYNC_SEND_FLAGS 0
+#endif
+
+/**
+ * Phalcon\Async\Handle initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Async_Handle){
+
+	PHALCON_REGISTER_CLASS(Phalcon\\Async, Handle, async_handle, phalcon_async_handle_method_entry, 0);
+
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_stream"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_request"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_buffer"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_async_handle_ce, SL("_protocol"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_async_handle_ce, SL("_ready"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_result"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_error"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_callback"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_async_handle_ce, SL("_context"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_async_handle_ce, SL("_resolved"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	return SUCCESS;
+}
+
+/**
+ * Completes a handle keeping its result or its error, the connection is closed
+ */
+static void phalcon_async_handle_finish(zval *handle, zval *result, const char *error TSRMLS_DC){
+
+	zend_update_property_null(phalcon_async_handle_ce, handle, SL("_stream") TSRMLS_CC);
+	zend_update_property_null(phalcon_async_handle_ce, handle, SL("_request") TSRMLS_CC);
+	zend_update_property_null(phalcon_async_handle_ce, handle, SL("_buffer") TSRMLS_CC);
+
+	if (error) {
+		zend_update_property_string(phalcon_async_handle_ce, handle, SL("_error"), (char *) error TSRMLS_CC);
+	} else {
+		zend_update_property(phalcon_async_handle_ce, handle, SL("_result"), result TSRMLS_CC);
+	}
+
+	zend_update_property_bool(phalcon_async_handle_ce, handle, SL("_ready"), 1 TSRMLS_CC);
+}
+
+/**
+ * Parses the response received by a handle, 0 is returned while the response is incomplete
+ * and -1 if it is not the expected one
+ */
+static int phalcon_async_handle_parse(long protocol, char *buffer, size_t length, zval *result TSRMLS_DC){
+
+	char *eol, *next, *end;
+	unsigned long flags, bytes;
+	size_t header;
+	const unsigned char *cursor;
+	php_unserialize_data_t var_hash;
+	int status;
+
+	eol = php_memnstr(buffer, "\r\n", 2, buffer + length);
+	if (!eol) {
+		return 0;
+	}
+
+	switch (protocol) {
+
+		case PHALCON_ASYNC_MEMCACHE_GET:
+
+			/**
+			 * Misses are returned as false as the Memcache extension does
+			 */
+			if (eol - buffer == 3 && !memcmp(buffer, "END", 3)) {
+				ZVAL_FALSE(result);
+				return 1;
+			}
+
+			/**
+			 * VALUE <key> <flags> <bytes>
+			 */
+			if (eol - buffer < 6 || memcmp(buffer, "VALUE ", 6)) {
+				return -1;
+			}
+
+			next = memchr(buffer + 6, ' ', eol - buffer - 6);
+			if (!next) {
+				return -1;
+			}
+
+			flags = strtoul(next + 1, &end, 10);
+			bytes = strtoul(end, NULL, 10);
+
+			header = eol - buffer + 2;
+			if (length < header + bytes + sizeof("\r\nEND\r\n") - 1) {
+				return 0;
+			}
+
+			/**
+			 * Compressed values are not supported
+			 */
+			if (flags & 2) {
+				return -1;
+			}
+
+			if (flags & 1) {
+				cursor = (const unsigned char *) buffer + header;
+
+				PHP_VAR_UNSERIALIZE_INIT(var_hash);
+				status = php_var_unserialize(&result, &cursor, cursor + bytes, &var_hash TSRMLS_CC);
+				PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+
+				if (!status) {
+					zval_dtor(result);
+					ZVAL_NULL(result);
+					return -1;
+				}
+				return 1;
+			}
+
+			ZVAL_STRINGL(result, buffer + header, bytes, 1);
+
+			/**
+			 * Scalars stored by the Memcache extension 3.x keep their type in the flags
+			 */
+			switch (flags & 0x0f00) {
+				case 0x0100:
+					convert_to_boolean(result);
+					break;
+				case 0x0300:
+					convert_to_long(result);
+					break;
+				case 0x0700:
+					convert_to_double(result);
+					break;
+			}
+
+			return 1;
+
+		case PHALCON_ASYNC_BEANSTALK_PUT:
+
+			/**
+			 * The tube is selected first if the queue is using one
+			 */
+			if (eol - buffer > 6 && !memcmp(buffer, "USING ", 6)) {
+				next = php_memnstr(eol + 2, "\r\n", 2, buffer + length);
+				if (!next) {
+					return 0;
+				}
+				buffer = eol + 2;
+				eol = next;
+			}
+
+			if (eol - buffer > 9 && !memcmp(buffer, "INSERTED ", 9)) {
+				ZVAL_STRINGL(result, buffer + 9, eol - buffer - 9, 1);
+				return 1;
+			}
+
+			if (eol - buffer > 7 && !memcmp(buffer, "BURIED ", 7)) {
+				ZVAL_STRINGL(result, buffer + 7, eol - buffer - 7, 1);
+				return 1;
+			}
+
+			ZVAL_FALSE(result);
+			return 1;
+	}
+
+	ZVAL_STRINGL(result, buffer, eol - buffer, 1);
+	return 1;
+}
+
+/**
+ * Returns the socket of a pending handle and the events it is waiting for, handles whose
+ * connection is not available are completed with an error
+ */
+static php_socket_t phalcon_async_handle_socket(zval *handle, short *events TSRMLS_DC){
+
+	zval *connection, *request;
+	php_stream *stream = NULL;
+	php_socket_t fd;
+
+	connection = zend_read_property(phalcon_async_handle_ce, handle, SL("_stream"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(connection) == IS_RESOURCE) {
+		php_stream_from_zval_no_verify(stream, &connection);
+	}
+
+	if (!stream || php_stream_cast(stream, PHP_STREAM_AS_FD_FOR_SELECT | PHP_STREAM_CAST_INTERNAL, (void *) &fd, 0) != SUCCESS || fd == SOCK_ERR) {
+		phalcon_async_handle_finish(handle, NULL, "The connection is not available" TSRMLS_CC);
+		return SOCK_ERR;
+	}
+
+	request = zend_read_property(phalcon_async_handle_ce, handle, SL("_request"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(request) == IS_STRING && Z_STRLEN_P(request) > 0) {
+		*events = POLLOUT;
+	} else {
+		*events = POLLIN;
+	}
+
+	return fd;
+}
+
+/**
+ * Writes the pending request or reads the response of a handle as far as the socket allows
+ * it without blocking
+ */
+static void phalcon_async_handle_io(zval *handle, php_socket_t fd, short revents TSRMLS_DC){
+
+	zval *request, *buffer, *protocol, *result, *received;
+	char *data, *error, *eol;
+	size_t length = 0;
+	ssize_t n;
+	int status, code;
+
+	request = zend_read_property(phalcon_async_handle_ce, handle, SL("_request"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(request) == IS_STRING && Z_STRLEN_P(request) > 0) {
+
+		n = send(fd, Z_STRVAL_P(request), Z_STRLEN_P(request), PHALCON_ASYNC_SEND_FLAGS);
+		if (n < 0) {
+			code = php_socket_errno();
+			if (code != EWOULDBLOCK && code != EAGAIN && code != EINTR) {
+				data = php_socket_strerror(code, NULL, 0);
+				spprintf(&error, 0, "Cannot send the request: %s", data);
+				efree(data);
+				phalcon_async_handle_finish(handle, NULL, error TSRMLS_CC);
+				efree(error);
+			}
+			return;
+		}
+
+		zend_update_property_stringl(phalcon_async_handle_ce, handle, SL("_request"), Z_STRVAL_P(request) + n, Z_STRLEN_P(request) - n TSRMLS_CC);
+		return;
+	}
+
+	buffer = zend_read_property(phalcon_async_handle_ce, handle, SL("_buffer"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(buffer) == IS_STRING) {
+		length = Z_STRLEN_P(buffer);
+	}
+
+	data = emalloc(length + PHALCON_ASYNC_CHUNK + 1);
+	if (length) {
+		memcpy(data, Z_STRVAL_P(buffer), length);
+	}
+
+	n = recv(fd, data + length, PHALCON_ASYNC_CHUNK, 0);
+	if (n <= 0) {
+		efree(data);
+		if (n < 0) {
+			code = php_socket_errno();
+			if (code == EWOULDBLOCK || code == EAGAIN || code == EINTR) {
+				return;
+			}
+		}
+		phalcon_async_handle_finish(handle, NULL, "The connection was closed before receiving the response" TSRMLS_CC);
+		return;
+	}
+
+	length += n;
+	data[length] = '\0';
+
+	protocol = zend_read_property(phalcon_async_handle_ce, handle, SL("_protocol"), 1 TSRMLS_CC);
+
+	ALLOC_INIT_ZVAL(result);
+	status = phalcon_async_handle_parse(phalcon_get_intval(protocol), data, length, result TSRMLS_CC);
+
+	if (!status) {
+		MAKE_STD_ZVAL(received);
+		ZVAL_STRINGL(received, data, length, 0);
+		zend_update_property(phalcon_async_handle_ce, handle, SL("_buffer"), received TSRMLS_CC);
+		zval_ptr_dtor(&received);
+	} else {
+		if (status < 0) {
+			eol = php_memnstr(data, "\r\n", 2, data + length);
+			spprintf(&error, 0, "Unexpected response from the server: %.*s", (int) MIN(eol ? eol - data : length, 64), data);
+			phalcon_async_handle_finish(handle, NULL, error TSRMLS_CC);
+			efree(error);
+		} else {
+			phalcon_async_handle_finish(handle, result, NULL TSRMLS_CC);
+		}
+		efree(data);
+	}
+
+	zval_ptr_dtor(&result);
+}
+
+/**
+ * Starts an operation, the connection is established in background and the request is
+ * sent as soon as the socket is writable
+ */
+void phalcon_async_handle_create(zval *handle, zval *address, zval *request, int protocol, zval *callback, zval *context TSRMLS_DC){
+
+	zval *connection;
+	php_stream *stream;
+	char *error_message = NULL;
+	int error_code = 0;
+
+	object_init_ex(handle, phalcon_async_handle_ce);
+	zend_update_property_long(phalcon_async_handle_ce, handle, SL("_protocol"), protocol TSRMLS_CC);
+
+	if (callback) {
+		zend_update_property(phalcon_async_handle_ce, handle, SL("_callback"), callback TSRMLS_CC);
+	}
+	if (context) {
+		zend_update_property(phalcon_async_handle_ce, handle, SL("_context"), context TSRMLS_CC);
+	}
+
+	stream = php_stream_xport_create(Z_STRVAL_P(address), Z_STRLEN_P(address), 0, STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT | STREAM_XPORT_CONNECT_ASYNC, NULL, NULL, NULL, &error_message, &error_code);
+	if (!stream) {
+		phalcon_async_handle_finish(handle, NULL, error_message ? error_message : "Cannot connect to the server" TSRMLS_CC);
+		if (error_message) {
+			efree(error_message);
+		}
+		return;
+	}
+
+	if (error_message) {
+		efree(error_message);
+	}
+
+	php_stream_set_option(stream, PHP_STREAM_OPTION_BLOCKING, 0, NULL);
+
+	MAKE_STD_ZVAL(connection);
+	php_stream_to_zval(stream, connection);
+	zend_update_property(phalcon_async_handle_ce, handle, SL("_stream"), connection TSRMLS_CC);
+	zval_ptr_dtor(&connection);
+
+	zend_update_property(phalcon_async_handle_ce, handle, SL("_request"), request TSRMLS_CC);
+}
+
+/**
+ * Waits for several handles at the same time processing every socket as soon as it is ready,
+ * a negative timeout (in milliseconds) waits until all of them are completed. The number of
+ * completed handles is returned
+ */
+long phalcon_async_wait(zval *handles, long timeout TSRMLS_DC){
+
+	HashTable *ht = Z_ARRVAL_P(handles);
+	HashPosition pos;
+	zval **handle, **pending, *ready;
+	php_pollfd *fds;
+	struct timeval start, now;
+	long remaining = -1, completed = 0;
+	int count, status, i, n;
+
+	count = zend_hash_num_elements(ht);
+	if (!count) {
+		return 0;
+	}
+
+	fds = safe_emalloc(count, sizeof(php_pollfd), 0);
+	pending = safe_emalloc(count, sizeof(zval *), 0);
+
+	gettimeofday(&start, NULL);
+
+	while (1) {
+
+		n = 0;
+
+		zend_hash_internal_pointer_reset_ex(ht, &pos);
+		while (zend_hash_get_current_data_ex(ht, (void **) &handle, &pos) == SUCCESS) {
+
+			if (Z_TYPE_PP(handle) == IS_OBJECT && instanceof_function(Z_OBJCE_PP(handle), phalcon_async_handle_ce TSRMLS_CC)) {
+				ready = zend_read_property(phalcon_async_handle_ce, *handle, SL("_ready"), 1 TSRMLS_CC);
+				if (!zend_is_true(ready)) {
+					fds[n].fd = phalcon_async_handle_socket(*handle, &fds[n].events TSRMLS_CC);
+					if (fds[n].fd != SOCK_ERR) {
+						fds[n].revents = 0;
+						pending[n++] = *handle;
+					}
+				}
+			}
+
+			zend_hash_move_forward_ex(ht, &pos);
+		}
+
+		if (!n) {
+			break;
+		}
+
+		if (timeout >= 0) {
+			gettimeofday(&now, NULL);
+			remaining = timeout - ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_usec - start.tv_usec) / 1000);
+			if (remaining < 0) {
+				remaining = 0;
+			}
+		}
+
+		status = php_poll2(fds, n, remaining);
+		if (status < 0 && php_socket_errno() == EINTR) {
+			continue;
+		}
+
+		/**
+		 * Stop on timeout, the handles still pending can be waited again later
+		 */
+		if (status <= 0) {
+			break;
+		}
+
+		for (i = 0; i < n; i++) {
+			if (fds[i].revents) {
+				phalcon_async_handle_io(pending[i], fds[i].fd, fds[i].revents TSRMLS_CC);
+			}
+		}
+	}
+
+	efree(fds);
+	efree(pending);
+
+	zend_hash_internal_pointer_reset_ex(ht, &pos);
+	while (zend_hash_get_current_data_ex(ht, (void **) &handle, &pos) == SUCCESS) {
+		if (Z_TYPE_PP(handle) == IS_OBJECT && instanceof_function(Z_OBJCE_PP(handle), phalcon_async_handle_ce TSRMLS_CC)) {
+			ready = zend_read_property(phalcon_async_handle_ce, *handle, SL("_ready"), 1 TSRMLS_CC);
+			if (zend_is_true(ready)) {
+				completed++;
+			}
+		}
+		zend_hash_move_forward_ex(ht, &pos);
+	}
+
+	return completed;
+}
+
+/**
+ * Checks whether the operation is completed
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Async_Handle, isReady){
+
+
+	RETURN_MEMBER(this_ptr, "_ready");
+}
+
+/**
+ * Waits for the operation, a timeout in seconds can be passed. Returns whether the operation
+ * is completed
+ *
+ * @param double $timeout
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Async_Handle, wait){
+
+	zval *timeout = NULL, *handles, *completed, *ready;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 0, 1, &timeout);
+	
+	if (!timeout) {
+		PHALCON_INIT_VAR(timeout);
+	}
+	
+	PHALCON_INIT_VAR(handles);
+	array_init_size(handles, 1);
+	phalcon_array_append(&handles, this_ptr, PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(completed);
+	PHALCON_CALL_STATIC_PARAMS_2(completed, "phalcon\\async", "wait", handles, timeout);
+	
+	PHALCON_OBS_VAR(ready);
+	phalcon_read_property_this(&ready, this_ptr, SL("_ready"), PH_NOISY_CC);
+	
+	RETURN_CCTOR(ready);
+}
+
+/**
+ * Returns the result of the operation waiting for it if needed, a Phalcon\Async\Exception
+ * is thrown if the operation failed
+ *
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Async_Handle, getResult){
+
+	zval *ready = NULL, *handles, *error, *result = NULL, *callback;
+	zval *resolved, *context, *arguments;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(ready);
+	phalcon_read_property_this(&ready, this_ptr, SL("_ready"), PH_NOISY_CC);
+	if (!zend_is_true(ready)) {
+	
+		PHALCON_INIT_VAR(handles);
+		array_init_size(handles, 1);
+		phalcon_array_append(&handles, this_ptr, PH_SEPARATE TSRMLS_CC);
+		phalcon_async_wait(handles, -1 TSRMLS_CC);
+	
+		PHALCON_OBS_NVAR(ready);
+		phalcon_read_property_this(&ready, this_ptr, SL("_ready"), PH_NOISY_CC);
+		if (!zend_is_true(ready)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_async_exception_ce, "The operation could not be completed");
+			return;
+		}
+	}
+	
+	PHALCON_OBS_VAR(error);
+	phalcon_read_property_this(&error, this_ptr, SL("_error"), PH_NOISY_CC);
+	if (Z_TYPE_P(error) != IS_NULL) {
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_async_exception_ce, error);
+		return;
+	}
+	
+	PHALCON_OBS_VAR(result);
+	phalcon_read_property_this(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+	
+	/** 
+	 * The result is passed once to the callback of the component which started the operation
+	 */
+	PHALCON_OBS_VAR(callback);
+	phalcon_read_property_this(&callback, this_ptr, SL("_callback"), PH_NOISY_CC);
+	if (Z_TYPE_P(callback) != IS_NULL) {
+	
+		PHALCON_OBS_VAR(resolved);
+		phalcon_read_property_this(&resolved, this_ptr, SL("_resolved"), PH_NOISY_CC);
+		if (!zend_is_true(resolved)) {
+	
+			PHALCON_OBS_VAR(context);
+			phalcon_read_property_this(&context, this_ptr, SL("_context"), PH_NOISY_CC);
+	
+			PHALCON_INIT_VAR(arguments);
+			array_init_size(arguments, 2);
+			phalcon_array_append(&arguments, result, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&arguments, context, PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(result);
+			PHALCON_CALL_USER_FUNC_ARRAY(result, callback, arguments);
+			phalcon_update_property_this(this_ptr, SL("_result"), result TSRMLS_CC);
+			phalcon_update_property_bool(this_ptr, SL("_resolved"), 1 TSRMLS_CC);
+		}
+	}
+	
+	RETURN_CCTOR(result);
+}
+
+/**
+ * Returns the error message if the operation failed
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Async_Handle, getError){
+
+
+	RETURN_MEMBER(this_ptr, "_error");
+}
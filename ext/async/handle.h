@@ -0,0 +1,48 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+extern zend_class_entry *phalcon_async_handle_ce;
+
+PHALCON_INIT_CLASS(Phalcon_Async_Handle);
+
+/** Protocols understood by the handles */
+#define PHALCON_ASYNC_LINE 0
+#define PHALCON_ASYNC_MEMCACHE_GET 1
+#define PHALCON_ASYNC_BEANSTALK_PUT 2
+
+extern void phalcon_async_handle_create(zval *handle, zval *address, zval *request, int protocol, zval *callback, zval *context TSRMLS_DC);
+extern long phalcon_async_wait(zval *handles, long timeout TSRMLS_DC);
+
+PHP_METHOD(Phalcon_Async_Handle, isReady);
+PHP_METHOD(Phalcon_Async_Handle, wait);
+PHP_METHOD(Phalcon_Async_Handle, getResult);
+PHP_METHOD(Phalcon_Async_Handle, getError);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_async_handle_wait, 0, 0, 0)
+	ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
+PHALCON_INIT_FUNCS(phalcon_async_handle_method_entry){
+	PHP_ME(Phalcon_Async_Handle, isReady, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Async_Handle, wait, arginfo_phalcon_async_handle_wait, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Async_Handle, getResult, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Async_Handle, getError, NULL, ZEND_ACC_PUBLIC) 
+	PHP_FE_END
+};
+
@@ -25,6 +25,16 @@
 #include "php_phalcon.h"
 #include "phalcon.h"
 
+#include <math.h>
+
+#ifdef PHP_WIN32
+#include "win32/time.h"
+#elif defined(HAVE_SYS_TIME_H)
+#include <sys/time.h>
+#endif
+
+#include "ext/standard/php_lcg.h"
+
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
@@ -37,13 +47,67 @@
 #include "kernel/object.h"
 #include "kernel/fcall.h"
 #include "kernel/operators.h"
+#include "kernel/concat.h"
 
 /**
  * Phalcon\Cache\Backend
  *
  * This class implements common functionality for backend adapters. A backend cache adapter may extend this class
+ *
+ * Passing any of the options 'beta', 'grace' or 'lock' enables the stampede protection: entries
+ * are stored with their expiration time and the time spent regenerating them, so they can be
+ * recomputed a bit before they expire (XFetch) and, when a 'lock' lifetime is given, only one
+ * worker regenerates an entry while the others keep receiving the stale one for 'grace' seconds
+ *
+ *<code>
+ *	$cache = new Phalcon\Cache\Backend\Memcache($frontCache, array(
+ *		'host' => 'localhost',
+ *		'port' => 11211,
+ *		'beta' => 1.0,
+ *		'grace' => 60,
+ *		'lock' => 10
+ *	));
+ *</code>
+ */
+
+/**
+ * Returns the current time with microseconds
+ */
+static double phalcon_cache_backend_now(void){
+
+	struct timeval tp = {0};
+
+	gettimeofday(&tp, NULL);
+	return (double) tp.tv_sec + tp.tv_usec / 1000000.0;
+}
+
+/**
+ * Counts a miss and remembers when the regeneration of the entry started
+ */
+static void phalcon_cache_backend_miss(zval *this_ptr, zval *last_key TSRMLS_DC){
+
+	zval *started;
+
+	phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+
+	MAKE_STD_ZVAL(started);
+	ZVAL_DOUBLE(started, phalcon_cache_backend_now());
+	phalcon_update_property_array(this_ptr, SL("_computing"), last_key, started TSRMLS_CC);
+	zval_ptr_dtor(&started);
+}
+
+/**
+ * Remembers a key of getMany() whose regeneration was handed to the caller
  */
+static void phalcon_cache_backend_track_regenerating(zval *this_ptr, zval *key_name TSRMLS_DC){
 
+	zval *regenerating;
+
+	regenerating = zend_read_property(phalcon_cache_backend_ce, this_ptr, SL("_regenerating"), 1 TSRMLS_CC);
+	if (zend_is_true(regenerating)) {
+		phalcon_update_property_array_append(this_ptr, SL("_regeneratingKeys"), key_name TSRMLS_CC);
+	}
+}
 
 /**
  * Phalcon\Cache\Backend initializer
@@ -58,6 +122,17 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend){
 	zend_declare_property_string(phalcon_cache_backend_ce, SL("_lastKey"), "", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_fresh"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_started"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_stampede"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_double(phalcon_cache_backend_ce, SL("_beta"), 1.0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_backend_ce, SL("_grace"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_backend_ce, SL("_lockLifetime"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_cache_backend_ce, SL("_locks"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_cache_backend_ce, SL("_computing"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_regenerating"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_cache_backend_ce, SL("_regeneratingKeys"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_backend_ce, SL("_hits"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_backend_ce, SL("_misses"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_backend_ce, SL("_stale"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
@@ -70,7 +145,8 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend){
  */
 PHP_METHOD(Phalcon_Cache_Backend, __construct){
 
-	zval *frontend, *options = NULL, *prefix;
+	zval *frontend, *options = NULL, *prefix, *beta, *grace, *lock;
+	zval *value;
 
 	PHALCON_MM_GROW();
 
@@ -94,6 +170,33 @@ PHP_METHOD(Phalcon_Cache_Backend, __construct){
 		phalcon_update_property_this(this_ptr, SL("_prefix"), prefix TSRMLS_CC);
 	}
 	
+	/** 
+	 * Any of the stampede options enables the protection
+	 */
+	if (phalcon_array_isset_string(options, SS("beta"))) {
+		PHALCON_OBS_VAR(beta);
+		phalcon_array_fetch_string(&beta, options, SL("beta"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(value);
+		phalcon_cast(value, beta, IS_DOUBLE);
+		phalcon_update_property_this(this_ptr, SL("_beta"), value TSRMLS_CC);
+		phalcon_update_property_bool(this_ptr, SL("_stampede"), 1 TSRMLS_CC);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("grace"))) {
+		PHALCON_OBS_VAR(grace);
+		phalcon_array_fetch_string(&grace, options, SL("grace"), PH_NOISY_CC);
+		phalcon_update_property_long(this_ptr, SL("_grace"), phalcon_get_intval(grace) TSRMLS_CC);
+		phalcon_update_property_bool(this_ptr, SL("_stampede"), 1 TSRMLS_CC);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("lock"))) {
+		PHALCON_OBS_VAR(lock);
+		phalcon_array_fetch_string(&lock, options, SL("lock"), PH_NOISY_CC);
+		phalcon_update_property_long(this_ptr, SL("_lockLifetime"), phalcon_get_intval(lock) TSRMLS_CC);
+		phalcon_update_property_bool(this_ptr, SL("_stampede"), 1 TSRMLS_CC);
+	}
+	
 	phalcon_update_property_this(this_ptr, SL("_frontend"), frontend TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_options"), options TSRMLS_CC);
 	
@@ -241,3 +344,521 @@ PHP_METHOD(Phalcon_Cache_Backend, getLastKey){
 	RETURN_MEMBER(this_ptr, "_lastKey");
 }
 
+
+/**
+ * Checks whether the last get() handed the regeneration of an expired or about to expire
+ * entry to the caller
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, isRegenerating){
+
+
+	RETURN_MEMBER(this_ptr, "_regenerating");
+}
+
+/**
+ * Returns the keys whose regeneration was handed to the caller by the last getMany()
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, getRegeneratingKeys){
+
+	zval *keys;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(keys);
+	phalcon_read_property_this(&keys, this_ptr, SL("_regeneratingKeys"), PH_NOISY_CC);
+	if (Z_TYPE_P(keys) == IS_ARRAY) {
+		RETURN_CCTOR(keys);
+	}
+	
+	array_init(return_value);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the number of hits, misses and stale entries served by the backend
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, getStats){
+
+	zval *hits, *misses, *stale;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(hits);
+	phalcon_read_property_this(&hits, this_ptr, SL("_hits"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(misses);
+	phalcon_read_property_this(&misses, this_ptr, SL("_misses"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(stale);
+	phalcon_read_property_this(&stale, this_ptr, SL("_stale"), PH_NOISY_CC);
+	
+	array_init_size(return_value, 3);
+	add_assoc_long_ex(return_value, SS("hits"), phalcon_get_intval(hits));
+	add_assoc_long_ex(return_value, SS("misses"), phalcon_get_intval(misses));
+	add_assoc_long_ex(return_value, SS("stale"), phalcon_get_intval(stale));
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Decides what a get() returns when the stampede protection is enabled. Entries expired within
+ * the grace period and entries chosen for an early recomputation are handed to the worker
+ * acquiring the lock, the other workers keep receiving the stored content. A lifetime passed to
+ * get() is counted from the time the entry was stored
+ *
+ * @param string $lastKey
+ * @param array $cachedContent
+ * @param long $lifetime
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _stampede){
+
+	zval *last_key, *cached_content, *lifetime = NULL, *content, *expires, *delta;
+	zval *created, *grace, *beta, *lock_lifetime, *lock_key, *acquired;
+	double now, expiration, computed, random;
+	int recompute = 0, stale = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 1, &last_key, &cached_content, &lifetime);
+	
+	phalcon_update_property_bool(this_ptr, SL("_regenerating"), 0 TSRMLS_CC);
+	
+	if (Z_TYPE_P(cached_content) == IS_NULL) {
+		phalcon_cache_backend_miss(this_ptr, last_key TSRMLS_CC);
+		RETURN_MM_NULL();
+	}
+	
+	/** 
+	 * Entries stored before the protection was enabled are returned as they are
+	 */
+	if (Z_TYPE_P(cached_content) != IS_ARRAY || !phalcon_array_isset_string(cached_content, SS("expires")) || !phalcon_array_isset_string(cached_content, SS("content"))) {
+		phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		RETURN_CCTOR(cached_content);
+	}
+	
+	PHALCON_OBS_VAR(expires);
+	phalcon_array_fetch_string(&expires, cached_content, SL("expires"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(content);
+	phalcon_array_fetch_string(&content, cached_content, SL("content"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(grace);
+	phalcon_read_property_this(&grace, this_ptr, SL("_grace"), PH_NOISY_CC);
+	
+	now = phalcon_cache_backend_now();
+	expiration = (double) phalcon_get_intval(expires);
+	
+	if (lifetime && Z_TYPE_P(lifetime) != IS_NULL && phalcon_array_isset_string(cached_content, SS("created"))) {
+		PHALCON_OBS_VAR(created);
+		phalcon_array_fetch_string(&created, cached_content, SL("created"), PH_NOISY_CC);
+		expiration = (double) (phalcon_get_intval(created) + phalcon_get_intval(lifetime));
+	}
+	
+	if (now >= expiration + phalcon_get_intval(grace)) {
+		phalcon_cache_backend_miss(this_ptr, last_key TSRMLS_CC);
+		RETURN_MM_NULL();
+	}
+	
+	if (now >= expiration) {
+		stale = 1;
+		recompute = 1;
+	} else {
+		/** 
+		 * XFetch: the closer the expiration and the longer the regeneration, the more likely
+		 * an early recomputation is
+		 */
+		PHALCON_OBS_VAR(beta);
+		phalcon_read_property_this(&beta, this_ptr, SL("_beta"), PH_NOISY_CC);
+	
+		computed = 0;
+		if (phalcon_array_isset_string(cached_content, SS("delta"))) {
+			PHALCON_OBS_VAR(delta);
+			phalcon_array_fetch_string(&delta, cached_content, SL("delta"), PH_NOISY_CC);
+			if (Z_TYPE_P(delta) == IS_DOUBLE) {
+				computed = Z_DVAL_P(delta);
+			}
+		}
+	
+		if (Z_TYPE_P(beta) == IS_DOUBLE && Z_DVAL_P(beta) > 0 && computed > 0) {
+			random = php_combined_lcg(TSRMLS_C);
+			if (random > 0 && now - computed * Z_DVAL_P(beta) * log(random) >= expiration) {
+				recompute = 1;
+			}
+		}
+	}
+	
+	if (!recompute) {
+		phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		RETURN_CCTOR(content);
+	}
+	
+	/** 
+	 * Only the worker acquiring the lock regenerates the entry
+	 */
+	PHALCON_OBS_VAR(lock_lifetime);
+	phalcon_read_property_this(&lock_lifetime, this_ptr, SL("_lockLifetime"), PH_NOISY_CC);
+	if (phalcon_get_intval(lock_lifetime) > 0) {
+	
+		PHALCON_INIT_VAR(lock_key);
+		PHALCON_CONCAT_VS(lock_key, last_key, ".lock");
+	
+		PHALCON_INIT_VAR(acquired);
+		PHALCON_CALL_METHOD_PARAMS_2(acquired, this_ptr, "_acquirelock", lock_key, lock_lifetime);
+		if (!zend_is_true(acquired)) {
+			if (stale) {
+				phalcon_property_incr(this_ptr, SL("_stale") TSRMLS_CC);
+			} else {
+				phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+			}
+			RETURN_CCTOR(content);
+		}
+	
+		phalcon_update_property_array(this_ptr, SL("_locks"), lock_key, acquired TSRMLS_CC);
+	}
+	
+	phalcon_update_property_bool(this_ptr, SL("_regenerating"), 1 TSRMLS_CC);
+	phalcon_cache_backend_miss(this_ptr, last_key TSRMLS_CC);
+	
+	RETURN_MM_NULL();
+}
+
+/**
+ * Wraps a prepared content with its expiration time and the time spent regenerating it,
+ * releasing the lock taken to regenerate it
+ *
+ * @param string $lastKey
+ * @param mixed $preparedContent
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _envelope){
+
+	zval *last_key, *prepared_content, *lifetime, *computing;
+	zval *started, *locks, *lock_key;
+	double delta = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 3, 0, &last_key, &prepared_content, &lifetime);
+	
+	PHALCON_OBS_VAR(computing);
+	phalcon_read_property_this(&computing, this_ptr, SL("_computing"), PH_NOISY_CC);
+	if (phalcon_array_isset(computing, last_key)) {
+	
+		PHALCON_OBS_VAR(started);
+		phalcon_array_fetch(&started, computing, last_key, PH_NOISY_CC);
+		if (Z_TYPE_P(started) == IS_DOUBLE) {
+			delta = phalcon_cache_backend_now() - Z_DVAL_P(started);
+			if (delta < 0) {
+				delta = 0;
+			}
+		}
+		phalcon_unset_property_array(this_ptr, SL("_computing"), last_key TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(lock_key);
+	PHALCON_CONCAT_VS(lock_key, last_key, ".lock");
+	
+	PHALCON_OBS_VAR(locks);
+	phalcon_read_property_this(&locks, this_ptr, SL("_locks"), PH_NOISY_CC);
+	if (phalcon_array_isset(locks, lock_key)) {
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "_releaselock", lock_key);
+		phalcon_unset_property_array(this_ptr, SL("_locks"), lock_key TSRMLS_CC);
+	}
+	
+	array_init_size(return_value, 4);
+	add_assoc_long_ex(return_value, SS("created"), (long) time(NULL));
+	add_assoc_long_ex(return_value, SS("expires"), (long) time(NULL) + phalcon_get_intval(lifetime));
+	add_assoc_double_ex(return_value, SS("delta"), delta);
+	Z_ADDREF_P(prepared_content);
+	add_assoc_zval_ex(return_value, SS("content"), prepared_content);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Tries to acquire the lock to regenerate an entry. Backends shared between processes
+ * override it with an atomic operation of their storage, by default the lock is only
+ * shared by the current request
+ *
+ * @param string $lockKey
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _acquireLock){
+
+	zval *lock_key, *lifetime, *locks;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &lock_key, &lifetime);
+	
+	PHALCON_OBS_VAR(locks);
+	phalcon_read_property_this(&locks, this_ptr, SL("_locks"), PH_NOISY_CC);
+	if (phalcon_array_isset(locks, lock_key)) {
+		RETURN_MM_FALSE;
+	}
+	
+	RETURN_MM_TRUE;
+}
+
+/**
+ * Releases the lock taken to regenerate an entry
+ *
+ * @param string $lockKey
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _releaseLock){
+
+	zval *lock_key;
+
+	phalcon_fetch_params(0, 1, 0, &lock_key);
+	
+}
+
+/**
+ * Processes the contents read by getMany in a single operation as get() does with every one
+ * of them, the raw contents are indexed by the key with the prefix and the keys not found are
+ * not present in the result
+ *
+ * @param array $keys
+ * @param array $cachedContents
+ * @param string $keyPrefix
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _processMany){
+
+	zval *keys, *cached_contents, *key_prefix, *lifetime = NULL, *frontend, *stampede;
+	zval *contents, *key_name = NULL, *prefixed_key = NULL;
+	zval *cached_content = NULL, *content = NULL, *processed = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 3, 1, &keys, &cached_contents, &key_prefix, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(contents);
+	array_init(contents);
+	
+	phalcon_update_property_empty_array(phalcon_cache_backend_ce, this_ptr, SL("_regeneratingKeys") TSRMLS_CC);
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, key_prefix, key_name);
+	
+		if (phalcon_array_isset(cached_contents, prefixed_key)) {
+			PHALCON_OBS_NVAR(cached_content);
+			phalcon_array_fetch(&cached_content, cached_contents, prefixed_key, PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_NVAR(cached_content);
+		}
+	
+		if (zend_is_true(stampede)) {
+			PHALCON_INIT_NVAR(content);
+			PHALCON_CALL_METHOD_PARAMS_3(content, this_ptr, "_stampede", prefixed_key, cached_content, lifetime);
+			if (Z_TYPE_P(content) == IS_NULL) {
+				phalcon_cache_backend_track_regenerating(this_ptr, key_name TSRMLS_CC);
+			}
+		} else {
+			if (Z_TYPE_P(cached_content) == IS_NULL) {
+				phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+			} else {
+				phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+			}
+			PHALCON_CPY_WRT(content, cached_content);
+		}
+	
+		if (Z_TYPE_P(content) != IS_NULL) {
+			PHALCON_INIT_NVAR(processed);
+			PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
+			phalcon_array_update_zval(&contents, key_name, &processed, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(contents);
+}
+
+/**
+ * Returns several cached contents at once, keys not found are not present in the result.
+ * Backends able to fetch several keys in a single operation override it
+ *
+ *<code>
+ *	$widgets = $cache->getMany(array('menu', 'footer', 'latest-posts'));
+ *</code>
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, getMany){
+
+	zval *keys, *lifetime = NULL, *contents, *key_name = NULL;
+	zval *content = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(contents);
+	array_init(contents);
+	
+	phalcon_update_property_empty_array(phalcon_cache_backend_ce, this_ptr, SL("_regeneratingKeys") TSRMLS_CC);
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(content);
+		PHALCON_CALL_METHOD_PARAMS_2(content, this_ptr, "get", key_name, lifetime);
+		if (Z_TYPE_P(content) != IS_NULL) {
+			phalcon_array_update_zval(&contents, key_name, &content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		} else {
+			phalcon_cache_backend_track_regenerating(this_ptr, key_name TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(contents);
+}
+
+/**
+ * Stores several contents at once, the keys of the array are the keys of the cache
+ *
+ *<code>
+ *	$cache->saveMany(array('menu' => $menu, 'footer' => $footer), 3600);
+ *</code>
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, saveMany){
+
+	zval *items, *lifetime = NULL, *stop_buffer, *key_name = NULL;
+	zval *content = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &items, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(items) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Items must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(stop_buffer);
+	ZVAL_BOOL(stop_buffer, 0);
+	
+	phalcon_is_iterable(items, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key_name, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(content);
+	
+		/** 
+		 * save() takes a null content from the frontend buffer, a null content can't be told
+		 * apart from a miss so the key is deleted instead
+		 */
+		if (Z_TYPE_P(content) == IS_NULL) {
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "delete", key_name);
+		} else {
+			PHALCON_CALL_METHOD_PARAMS_4_NORETURN(this_ptr, "save", key_name, content, lifetime, stop_buffer);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_MM_TRUE;
+}
+
+/**
+ * Deletes several values from the cache at once, returning the number of deleted keys
+ *
+ * @param array $keys
+ * @return int
+ */
+PHP_METHOD(Phalcon_Cache_Backend, deleteMany){
+
+	zval *keys, *key_name = NULL, *success = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	long deleted = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &keys);
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(success);
+		PHALCON_CALL_METHOD_PARAMS_1(success, this_ptr, "delete", key_name);
+		if (zend_is_true(success)) {
+			deleted++;
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(deleted);
+}
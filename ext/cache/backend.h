@@ -30,6 +30,17 @@ PHP_METHOD(Phalcon_Cache_Backend, isFresh);
 PHP_METHOD(Phalcon_Cache_Backend, isStarted);
 PHP_METHOD(Phalcon_Cache_Backend, setLastKey);
 PHP_METHOD(Phalcon_Cache_Backend, getLastKey);
+PHP_METHOD(Phalcon_Cache_Backend, isRegenerating);
+PHP_METHOD(Phalcon_Cache_Backend, getRegeneratingKeys);
+PHP_METHOD(Phalcon_Cache_Backend, getStats);
+PHP_METHOD(Phalcon_Cache_Backend, _stampede);
+PHP_METHOD(Phalcon_Cache_Backend, _envelope);
+PHP_METHOD(Phalcon_Cache_Backend, _acquireLock);
+PHP_METHOD(Phalcon_Cache_Backend, _releaseLock);
+PHP_METHOD(Phalcon_Cache_Backend, _processMany);
+PHP_METHOD(Phalcon_Cache_Backend, getMany);
+PHP_METHOD(Phalcon_Cache_Backend, saveMany);
+PHP_METHOD(Phalcon_Cache_Backend, deleteMany);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, frontend)
@@ -49,6 +60,20 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend_setlastkey, 0, 0, 1)
 	ZEND_ARG_INFO(0, lastKey)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend_getmany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend_savemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, items)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend_deletemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_cache_backend_method_entry){
 	PHP_ME(Phalcon_Cache_Backend, __construct, arginfo_phalcon_cache_backend___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Cache_Backend, start, arginfo_phalcon_cache_backend_start, ZEND_ACC_PUBLIC) 
@@ -59,6 +84,17 @@ PHALCON_INIT_FUNCS(phalcon_cache_backend_method_entry){
 	PHP_ME(Phalcon_Cache_Backend, isStarted, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Cache_Backend, setLastKey, arginfo_phalcon_cache_backend_setlastkey, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Cache_Backend, getLastKey, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, isRegenerating, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, getRegeneratingKeys, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, getStats, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, _stampede, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Cache_Backend, _envelope, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Cache_Backend, _acquireLock, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Cache_Backend, _releaseLock, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Cache_Backend, _processMany, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Cache_Backend, getMany, arginfo_phalcon_cache_backend_getmany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, saveMany, arginfo_phalcon_cache_backend_savemany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Backend, deleteMany, arginfo_phalcon_cache_backend_deletemany, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
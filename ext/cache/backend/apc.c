@@ -72,7 +72,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Apc){
 
 	PHALCON_REGISTER_CLASS_EX(Phalcon\\Cache\\Backend, Apc, cache_backend_apc, "phalcon\\cache\\backend", phalcon_cache_backend_apc_method_entry, 0);
 
-	zend_class_implements(phalcon_cache_backend_apc_ce TSRMLS_CC, 1, phalcon_cache_backendinterface_ce);
+	zend_class_implements(phalcon_cache_backend_apc_ce TSRMLS_CC, 2, phalcon_cache_backendinterface_ce, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -87,7 +87,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Apc){
 PHP_METHOD(Phalcon_Cache_Backend_Apc, get){
 
 	zval *key_name, *lifetime = NULL, *frontend, *prefix, *prefixed_key;
-	zval *cached_content, *processed;
+	zval *cached_content, *stampede, *content = NULL, *processed;
 
 	PHALCON_MM_GROW();
 
@@ -111,12 +111,30 @@ PHP_METHOD(Phalcon_Cache_Backend_Apc, get){
 	
 	PHALCON_INIT_VAR(cached_content);
 	PHALCON_CALL_FUNC_PARAMS_1(cached_content, "apc_fetch", prefixed_key);
-	if (PHALCON_IS_FALSE(cached_content)) {
-		RETURN_MM_NULL();
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			PHALCON_INIT_NVAR(cached_content);
+		}
+	
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_2(content, this_ptr, "_stampede", prefixed_key, cached_content);
+		if (Z_TYPE_P(content) == IS_NULL) {
+			RETURN_MM_NULL();
+		}
+	} else {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+			RETURN_MM_NULL();
+		}
+		phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		PHALCON_CPY_WRT(content, cached_content);
 	}
 	
 	PHALCON_INIT_VAR(processed);
-	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", cached_content);
+	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
 	
 	RETURN_CCTOR(processed);
 }
@@ -133,7 +151,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Apc, save){
 
 	zval *key_name = NULL, *content = NULL, *lifetime = NULL, *stop_buffer = NULL;
 	zval *last_key = NULL, *prefix, *frontend, *cached_content = NULL;
-	zval *prepared_content, *ttl = NULL, *is_buffering;
+	zval *prepared_content, *ttl = NULL, *stampede, *envelope = NULL;
+	zval *grace, *storage_ttl = NULL, *is_buffering;
 
 	PHALCON_MM_GROW();
 
@@ -191,7 +210,26 @@ PHP_METHOD(Phalcon_Cache_Backend_Apc, save){
 		PHALCON_CPY_WRT(ttl, lifetime);
 	}
 	
-	PHALCON_CALL_FUNC_PARAMS_3_NORETURN("apc_store", last_key, prepared_content, ttl);
+	/** 
+	 * Protected entries are kept for the grace period after they expire
+	 */
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_INIT_VAR(envelope);
+		PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+	
+		PHALCON_OBS_VAR(grace);
+		phalcon_read_property_this(&grace, this_ptr, SL("_grace"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(storage_ttl);
+		phalcon_add_function(storage_ttl, ttl, grace TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(envelope, prepared_content);
+		PHALCON_CPY_WRT(storage_ttl, ttl);
+	}
+	
+	PHALCON_CALL_FUNC_PARAMS_3_NORETURN("apc_store", last_key, envelope, storage_ttl);
 	
 	PHALCON_INIT_VAR(is_buffering);
 	PHALCON_CALL_METHOD(is_buffering, frontend, "isbuffering");
@@ -347,3 +385,210 @@ PHP_METHOD(Phalcon_Cache_Backend_Apc, exists){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Acquires the lock to regenerate an entry, apc_add() only succeeds for one process
+ *
+ * @param string $lockKey
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Apc, _acquireLock){
+
+	zval *lock_key, *lifetime, *value, *success;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &lock_key, &lifetime);
+	
+	PHALCON_INIT_VAR(value);
+	ZVAL_LONG(value, (long) time(NULL));
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_FUNC_PARAMS_3(success, "apc_add", lock_key, value, lifetime);
+	
+	RETURN_NCTOR(success);
+}
+
+/**
+ * Releases the lock taken to regenerate an entry
+ *
+ * @param string $lockKey
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Apc, _releaseLock){
+
+	zval *lock_key;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &lock_key);
+	
+	PHALCON_CALL_FUNC_PARAMS_1_NORETURN("apc_delete", lock_key);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns several cached contents fetching all the keys with a single apc_fetch()
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Apc, getMany){
+
+	zval *keys, *lifetime = NULL, *prefix, *prefixed_keys;
+	zval *key_name = NULL, *prefixed_key = NULL, *cached_contents = NULL;
+	zval *key_prefix, *contents;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(prefixed_keys);
+	array_init_size(prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_SVV(prefixed_key, "_PHCA", prefix, key_name);
+		phalcon_array_append(&prefixed_keys, prefixed_key, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(cached_contents);
+	PHALCON_CALL_FUNC_PARAMS_1(cached_contents, "apc_fetch", prefixed_keys);
+	if (Z_TYPE_P(cached_contents) != IS_ARRAY) { 
+		PHALCON_INIT_NVAR(cached_contents);
+		array_init(cached_contents);
+	}
+	
+	PHALCON_INIT_VAR(key_prefix);
+	PHALCON_CONCAT_SV(key_prefix, "_PHCA", prefix);
+	
+	PHALCON_INIT_VAR(contents);
+	PHALCON_CALL_METHOD_PARAMS_3(contents, this_ptr, "_processmany", keys, cached_contents, key_prefix);
+	
+	RETURN_CCTOR(contents);
+}
+
+/**
+ * Stores several contents at once with a single apc_store()
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Apc, saveMany){
+
+	zval *items, *lifetime = NULL, *frontend, *prefix, *ttl = NULL;
+	zval *stampede, *grace, *storage_ttl = NULL, *prepared_items;
+	zval *key_name = NULL, *content = NULL, *last_key = NULL;
+	zval *prepared_content = NULL, *envelope = NULL, *null_value;
+	zval *failed;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &items, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(items) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Items must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(lifetime) == IS_NULL) {
+		PHALCON_INIT_VAR(ttl);
+		PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+	} else {
+		PHALCON_CPY_WRT(ttl, lifetime);
+	}
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_OBS_VAR(grace);
+		phalcon_read_property_this(&grace, this_ptr, SL("_grace"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(storage_ttl);
+		phalcon_add_function(storage_ttl, ttl, grace TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(storage_ttl, ttl);
+	}
+	
+	PHALCON_INIT_VAR(prepared_items);
+	array_init_size(prepared_items, zend_hash_num_elements(Z_ARRVAL_P(items)));
+	
+	phalcon_is_iterable(items, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key_name, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(content);
+	
+		PHALCON_INIT_NVAR(last_key);
+		PHALCON_CONCAT_SVV(last_key, "_PHCA", prefix, key_name);
+	
+		PHALCON_INIT_NVAR(prepared_content);
+		PHALCON_CALL_METHOD_PARAMS_1(prepared_content, frontend, "beforestore", content);
+		if (zend_is_true(stampede)) {
+			PHALCON_INIT_NVAR(envelope);
+			PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+		} else {
+			PHALCON_CPY_WRT(envelope, prepared_content);
+		}
+	
+		phalcon_array_update_zval(&prepared_items, last_key, &envelope, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(null_value);
+	
+	/** 
+	 * apc_store() returns the keys that could not be stored
+	 */
+	PHALCON_INIT_VAR(failed);
+	PHALCON_CALL_FUNC_PARAMS_3(failed, "apc_store", prepared_items, null_value, storage_ttl);
+	if (Z_TYPE_P(failed) == IS_ARRAY) { 
+		if (zend_hash_num_elements(Z_ARRVAL_P(failed))) {
+			RETURN_MM_FALSE;
+		}
+	} else if (PHALCON_IS_FALSE(failed)) {
+		RETURN_MM_FALSE;
+	}
+	
+	RETURN_MM_TRUE;
+}
@@ -25,6 +25,9 @@
 #include "php_phalcon.h"
 #include "phalcon.h"
 
+#include "ext/standard/php_var.h"
+#include "ext/standard/php_lcg.h"
+
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
@@ -73,6 +76,22 @@
  *</code>
  */
 
+/**
+ * Unserializes the envelope of a protected entry, files that cannot be unserialized are
+ * treated as missing without emitting notices
+ */
+static void phalcon_cache_backend_file_unserialize(zval *return_value, zval *serialized TSRMLS_DC){
+
+	const unsigned char *p = (const unsigned char *) Z_STRVAL_P(serialized);
+	php_unserialize_data_t var_hash;
+
+	PHP_VAR_UNSERIALIZE_INIT(var_hash);
+	if (!php_var_unserialize(&return_value, &p, p + Z_STRLEN_P(serialized), &var_hash TSRMLS_CC)) {
+		zval_dtor(return_value);
+		ZVAL_NULL(return_value);
+	}
+	PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+}
 
 /**
  * Phalcon\Cache\Backend\File initializer
@@ -81,7 +100,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_File){
 
 	PHALCON_REGISTER_CLASS_EX(Phalcon\\Cache\\Backend, File, cache_backend_file, "phalcon\\cache\\backend", phalcon_cache_backend_file_method_entry, 0);
 
-	zend_class_implements(phalcon_cache_backend_file_ce TSRMLS_CC, 1, phalcon_cache_backendinterface_ce);
+	zend_class_implements(phalcon_cache_backend_file_ce TSRMLS_CC, 2, phalcon_cache_backendinterface_ce, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -131,7 +150,7 @@ PHP_METHOD(Phalcon_Cache_Backend_File, get){
 	zval *cache_dir, *cache_file, *frontend, *timestamp;
 	zval *ttl = NULL, *modified_time, *difference, *not_expired;
 	zval *cached_content, *exception_message;
-	zval *processed;
+	zval *processed, *stampede, *envelope = NULL, *content;
 
 	PHALCON_MM_GROW();
 
@@ -158,6 +177,39 @@ PHP_METHOD(Phalcon_Cache_Backend_File, get){
 	
 	PHALCON_INIT_VAR(cache_file);
 	PHALCON_CONCAT_VV(cache_file, cache_dir, prefixed_key);
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+	
+		/** 
+		 * Protected entries carry their own expiration time
+		 */
+		PHALCON_INIT_VAR(envelope);
+		if (phalcon_file_exists(cache_file TSRMLS_CC) == SUCCESS) {
+	
+			PHALCON_INIT_VAR(cached_content);
+			PHALCON_CALL_FUNC_PARAMS_1(cached_content, "file_get_contents", cache_file);
+			if (Z_TYPE_P(cached_content) == IS_STRING) {
+				phalcon_cache_backend_file_unserialize(envelope, cached_content TSRMLS_CC);
+			}
+		}
+	
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_3(content, this_ptr, "_stampede", prefixed_key, envelope, lifetime);
+		if (Z_TYPE_P(content) == IS_NULL) {
+			RETURN_MM_NULL();
+		}
+	
+		PHALCON_OBS_VAR(frontend);
+		phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(processed);
+		PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
+	
+		RETURN_CCTOR(processed);
+	}
+	
 	if (phalcon_file_exists(cache_file TSRMLS_CC) == SUCCESS) {
 	
 		PHALCON_OBS_VAR(frontend);
@@ -198,6 +250,8 @@ PHP_METHOD(Phalcon_Cache_Backend_File, get){
 				return;
 			}
 	
+			phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+	
 			PHALCON_INIT_VAR(processed);
 			PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", cached_content);
 	
@@ -205,6 +259,8 @@ PHP_METHOD(Phalcon_Cache_Backend_File, get){
 		}
 	}
 	
+	phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+	
 	RETURN_MM_NULL();
 }
 
@@ -221,7 +277,7 @@ PHP_METHOD(Phalcon_Cache_Backend_File, save){
 	zval *key_name = NULL, *content = NULL, *lifetime = NULL, *stop_buffer = NULL;
 	zval *last_key = NULL, *prefix, *frontend, *options, *cache_dir;
 	zval *cache_file, *cached_content = NULL, *prepared_content;
-	zval *status, *is_buffering;
+	zval *stampede, *ttl = NULL, *envelope, *status, *is_buffering;
 
 	PHALCON_MM_GROW();
 
@@ -272,7 +328,7 @@ PHP_METHOD(Phalcon_Cache_Backend_File, save){
 	
 	PHALCON_INIT_VAR(cache_file);
 	PHALCON_CONCAT_VV(cache_file, cache_dir, last_key);
-	if (!zend_is_true(content)) {
+	if (Z_TYPE_P(content) == IS_NULL) {
 		PHALCON_INIT_VAR(cached_content);
 		PHALCON_CALL_METHOD(cached_content, frontend, "getcontent");
 	} else {
@@ -282,6 +338,26 @@ PHP_METHOD(Phalcon_Cache_Backend_File, save){
 	PHALCON_INIT_VAR(prepared_content);
 	PHALCON_CALL_METHOD_PARAMS_1(prepared_content, frontend, "beforestore", cached_content);
 	
+	/** 
+	 * Protected entries are serialized with their expiration time
+	 */
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (Z_TYPE_P(lifetime) == IS_NULL) {
+			PHALCON_INIT_VAR(ttl);
+			PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+		} else {
+			PHALCON_CPY_WRT(ttl, lifetime);
+		}
+	
+		PHALCON_INIT_VAR(envelope);
+		PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+	
+		PHALCON_INIT_NVAR(prepared_content);
+		PHALCON_CALL_FUNC_PARAMS_1(prepared_content, "serialize", envelope);
+	}
+	
 	/** 
 	 * We use file_put_contents to respect open-base-dir directive
 	 */
@@ -409,8 +485,18 @@ PHP_METHOD(Phalcon_Cache_Backend_File, queryKeys){
 	
 			PHALCON_INIT_NVAR(key);
 			PHALCON_CALL_METHOD(key, item, "getfilename");
+	
+			/** 
+			 * Lock files taken to regenerate entries are not keys
+			 */
+			if (Z_TYPE_P(key) == IS_STRING && Z_STRLEN_P(key) > 5 && !memcmp(Z_STRVAL_P(key) + Z_STRLEN_P(key) - 5, ".lock", 5)) {
+				PHALCON_CALL_METHOD_NORETURN(iterator, "next");
+				continue;
+			}
+	
 			if (zend_is_true(prefix)) {
 				if (!phalcon_start_with(key, prefix, NULL)) {
+					PHALCON_CALL_METHOD_NORETURN(iterator, "next");
 					continue;
 				}
 			}
@@ -508,3 +594,223 @@ PHP_METHOD(Phalcon_Cache_Backend_File, exists){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Acquires the lock to regenerate an entry by creating a lock file, only one process can create
+ * it. Lock files older than their lifetime were left by workers that died, they are renamed
+ * before being removed so a single process replaces them
+ *
+ * @param string $lockKey
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_File, _acquireLock){
+
+	zval *lock_key, *lifetime, *options, *cache_dir, *lock_file;
+	php_stream *stream;
+	struct stat info, moved;
+	char *stale_file;
+	int attempts;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &lock_key, &lifetime);
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(cache_dir);
+	phalcon_array_fetch_string(&cache_dir, options, SL("cacheDir"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(lock_file);
+	PHALCON_CONCAT_VV(lock_file, cache_dir, lock_key);
+	
+	for (attempts = 0; attempts < 2; attempts++) {
+	
+		stream = php_stream_open_wrapper(Z_STRVAL_P(lock_file), "xb", 0, NULL);
+		if (stream) {
+			php_stream_close(stream);
+			RETURN_MM_TRUE;
+		}
+	
+		/** 
+		 * The lock was released meanwhile
+		 */
+		if (VCWD_STAT(Z_STRVAL_P(lock_file), &info) != 0) {
+			continue;
+		}
+	
+		if ((long) info.st_mtime + phalcon_get_intval(lifetime) > (long) time(NULL)) {
+			break;
+		}
+	
+		/** 
+		 * Only one process can move the stale lock away. A lock created by another process
+		 * after the check is not the one that was checked, so it is put back
+		 */
+		spprintf(&stale_file, 0, "%s.%.0f.lock", Z_STRVAL_P(lock_file), php_combined_lcg(TSRMLS_C) * 1000000000);
+		if (VCWD_RENAME(Z_STRVAL_P(lock_file), stale_file) != 0) {
+			efree(stale_file);
+			break;
+		}
+	
+		if (VCWD_STAT(stale_file, &moved) == 0 && (moved.st_ino != info.st_ino || moved.st_mtime != info.st_mtime)) {
+			VCWD_RENAME(stale_file, Z_STRVAL_P(lock_file));
+			efree(stale_file);
+			break;
+		}
+	
+		VCWD_UNLINK(stale_file);
+		efree(stale_file);
+	}
+	
+	RETURN_MM_FALSE;
+}
+
+/**
+ * Releases the lock taken to regenerate an entry
+ *
+ * @param string $lockKey
+ */
+PHP_METHOD(Phalcon_Cache_Backend_File, _releaseLock){
+
+	zval *lock_key, *options, *cache_dir, *lock_file;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &lock_key);
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(cache_dir);
+	phalcon_array_fetch_string(&cache_dir, options, SL("cacheDir"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(lock_file);
+	PHALCON_CONCAT_VV(lock_file, cache_dir, lock_key);
+	
+	if (phalcon_file_exists(lock_file TSRMLS_CC) == SUCCESS) {
+		VCWD_UNLINK(Z_STRVAL_P(lock_file));
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns several cached contents. Every file is opened once, its modification time is taken
+ * from the opened stream instead of checking the existence and the time of the file separately
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_File, getMany){
+
+	zval *keys, *lifetime = NULL, *options, *prefix, *cache_dir;
+	zval *frontend, *stampede, *ttl = NULL, *cached_contents, *key_name = NULL;
+	zval *prefixed_key = NULL, *cache_file = NULL, *cached_content = NULL;
+	zval *content = NULL, *contents;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	php_stream *stream;
+	php_stream_statbuf info;
+	char *buffer;
+	size_t length;
+	long limit;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(cache_dir);
+	phalcon_array_fetch_string(&cache_dir, options, SL("cacheDir"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(lifetime) == IS_NULL) {
+		PHALCON_INIT_VAR(ttl);
+		PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+	} else {
+		PHALCON_CPY_WRT(ttl, lifetime);
+	}
+	
+	limit = (long) time(NULL) - phalcon_get_intval(ttl);
+	
+	PHALCON_INIT_VAR(cached_contents);
+	array_init(cached_contents);
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+	
+		PHALCON_INIT_NVAR(cache_file);
+		PHALCON_CONCAT_VV(cache_file, cache_dir, prefixed_key);
+	
+		PHALCON_INIT_NVAR(cached_content);
+	
+		stream = php_stream_open_wrapper(Z_STRVAL_P(cache_file), "rb", 0, NULL);
+		if (stream) {
+	
+			/** 
+			 * Protected entries carry their own expiration time
+			 */
+			if (zend_is_true(stampede) || (php_stream_stat(stream, &info) == 0 && limit < (long) info.sb.st_mtime)) {
+	
+				buffer = NULL;
+				length = php_stream_copy_to_mem(stream, &buffer, PHP_STREAM_COPY_ALL, 0);
+	
+				if (zend_is_true(stampede)) {
+					if (buffer) {
+						PHALCON_INIT_NVAR(content);
+						ZVAL_STRINGL(content, buffer, length, 0);
+						phalcon_cache_backend_file_unserialize(cached_content, content TSRMLS_CC);
+					}
+				} else {
+					if (buffer) {
+						ZVAL_STRINGL(cached_content, buffer, length, 0);
+					} else {
+						ZVAL_EMPTY_STRING(cached_content);
+					}
+				}
+			}
+	
+			php_stream_close(stream);
+		}
+	
+		if (Z_TYPE_P(cached_content) != IS_NULL) {
+			phalcon_array_update_zval(&cached_contents, prefixed_key, &cached_content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(contents);
+	PHALCON_CALL_METHOD_PARAMS_4(contents, this_ptr, "_processmany", keys, cached_contents, prefix, lifetime);
+	
+	RETURN_CCTOR(contents);
+}
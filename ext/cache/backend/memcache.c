@@ -80,7 +80,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Memcache){
 
 	zend_declare_property_null(phalcon_cache_backend_memcache_ce, SL("_memcache"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
-	zend_class_implements(phalcon_cache_backend_memcache_ce TSRMLS_CC, 1, phalcon_cache_backendinterface_ce);
+	zend_class_implements(phalcon_cache_backend_memcache_ce TSRMLS_CC, 2, phalcon_cache_backendinterface_ce, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -189,8 +189,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcache, _connect){
 PHP_METHOD(Phalcon_Cache_Backend_Memcache, get){
 
 	zval *key_name, *lifetime = NULL, *memcache = NULL, *frontend;
-	zval *prefix, *prefixed_key, *cached_content;
-	zval *content;
+	zval *prefix, *prefixed_key, *cached_content, *stampede;
+	zval *content = NULL, *processed;
 
 	PHALCON_MM_GROW();
 
@@ -223,14 +223,32 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcache, get){
 	
 	PHALCON_INIT_VAR(cached_content);
 	PHALCON_CALL_METHOD_PARAMS_1(cached_content, memcache, "get", prefixed_key);
-	if (PHALCON_IS_FALSE(cached_content)) {
-		RETURN_MM_NULL();
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			PHALCON_INIT_NVAR(cached_content);
+		}
+	
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_2(content, this_ptr, "_stampede", prefixed_key, cached_content);
+		if (Z_TYPE_P(content) == IS_NULL) {
+			RETURN_MM_NULL();
+		}
+	} else {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+			RETURN_MM_NULL();
+		}
+		phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		PHALCON_CPY_WRT(content, cached_content);
 	}
 	
-	PHALCON_INIT_VAR(content);
-	PHALCON_CALL_METHOD_PARAMS_1(content, frontend, "afterretrieve", cached_content);
+	PHALCON_INIT_VAR(processed);
+	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
 	
-	RETURN_CCTOR(content);
+	RETURN_CCTOR(processed);
 }
 
 /**
@@ -246,6 +264,7 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcache, save){
 	zval *key_name = NULL, *content = NULL, *lifetime = NULL, *stop_buffer = NULL;
 	zval *last_key = NULL, *prefix, *frontend, *memcache = NULL, *cached_content = NULL;
 	zval *prepared_content, *ttl = NULL, *flags, *success;
+	zval *stampede, *envelope = NULL, *grace, *storage_ttl = NULL;
 	zval *options, *special_key, *keys = NULL, *is_buffering;
 
 	PHALCON_MM_GROW();
@@ -323,11 +342,30 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcache, save){
 	PHALCON_INIT_VAR(flags);
 	ZVAL_LONG(flags, 0);
 	
+	/** 
+	 * Protected entries are kept for the grace period after they expire
+	 */
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_INIT_VAR(envelope);
+		PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+	
+		PHALCON_OBS_VAR(grace);
+		phalcon_read_property_this(&grace, this_ptr, SL("_grace"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(storage_ttl);
+		phalcon_add_function(storage_ttl, ttl, grace TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(envelope, prepared_content);
+		PHALCON_CPY_WRT(storage_ttl, ttl);
+	}
+	
 	/** 
 	 * We store without flags
 	 */
 	PHALCON_INIT_VAR(success);
-	PHALCON_CALL_METHOD_PARAMS_4(success, memcache, "set", last_key, prepared_content, flags, ttl);
+	PHALCON_CALL_METHOD_PARAMS_4(success, memcache, "set", last_key, envelope, flags, storage_ttl);
 	if (!zend_is_true(success)) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Failed storing data in memcached");
 		return;
@@ -559,3 +597,463 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcache, exists){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Acquires the lock to regenerate an entry, Memcache::add() only succeeds for one process
+ *
+ * @param string $lockKey
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, _acquireLock){
+
+	zval *lock_key, *lifetime, *memcache = NULL, *value, *flags, *success;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &lock_key, &lifetime);
+	
+	PHALCON_OBS_VAR(memcache);
+	phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	if (Z_TYPE_P(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_connect");
+	
+		PHALCON_OBS_NVAR(memcache);
+		phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	}
+	
+	PHALCON_INIT_VAR(value);
+	ZVAL_LONG(value, (long) time(NULL));
+	
+	PHALCON_INIT_VAR(flags);
+	ZVAL_LONG(flags, 0);
+	
+	PHALCON_INIT_VAR(success);
+	PHALCON_CALL_METHOD_PARAMS_4(success, memcache, "add", lock_key, value, flags, lifetime);
+	
+	RETURN_NCTOR(success);
+}
+
+/**
+ * Releases the lock taken to regenerate an entry
+ *
+ * @param string $lockKey
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, _releaseLock){
+
+	zval *lock_key, *memcache;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &lock_key);
+	
+	PHALCON_OBS_VAR(memcache);
+	phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	if (Z_TYPE_P(memcache) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(memcache, "delete", lock_key);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns several cached contents fetching all the keys in a single round trip
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, getMany){
+
+	zval *keys, *lifetime = NULL, *memcache = NULL, *prefix;
+	zval *prefixed_keys, *key_name = NULL, *prefixed_key = NULL;
+	zval *cached_contents = NULL, *contents;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(memcache);
+	phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	if (Z_TYPE_P(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_connect");
+	
+		PHALCON_OBS_NVAR(memcache);
+		phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	}
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(prefixed_keys);
+	array_init_size(prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+		phalcon_array_append(&prefixed_keys, prefixed_key, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	/** 
+	 * Memcache::get() accepts an array of keys returning the ones found
+	 */
+	PHALCON_INIT_VAR(cached_contents);
+	PHALCON_CALL_METHOD_PARAMS_1(cached_contents, memcache, "get", prefixed_keys);
+	if (Z_TYPE_P(cached_contents) != IS_ARRAY) { 
+		PHALCON_INIT_NVAR(cached_contents);
+		array_init(cached_contents);
+	}
+	
+	PHALCON_INIT_VAR(contents);
+	PHALCON_CALL_METHOD_PARAMS_3(contents, this_ptr, "_processmany", keys, cached_contents, prefix);
+	
+	RETURN_CCTOR(contents);
+}
+
+/**
+ * Stores several contents at once, the stats key is only updated once
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, saveMany){
+
+	zval *items, *lifetime = NULL, *memcache = NULL, *frontend, *prefix;
+	zval *ttl = NULL, *stampede, *grace, *storage_ttl = NULL, *flags;
+	zval *options, *special_key, *stored_keys = NULL, *key_name = NULL;
+	zval *content = NULL, *last_key = NULL, *prepared_content = NULL;
+	zval *envelope = NULL, *success = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int changed = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &items, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(items) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Items must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(memcache);
+	phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	if (Z_TYPE_P(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_connect");
+	
+		PHALCON_OBS_NVAR(memcache);
+		phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	}
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(lifetime) == IS_NULL) {
+		PHALCON_INIT_VAR(ttl);
+		PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+	} else {
+		PHALCON_CPY_WRT(ttl, lifetime);
+	}
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_OBS_VAR(grace);
+		phalcon_read_property_this(&grace, this_ptr, SL("_grace"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(storage_ttl);
+		phalcon_add_function(storage_ttl, ttl, grace TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(storage_ttl, ttl);
+	}
+	
+	PHALCON_INIT_VAR(flags);
+	ZVAL_LONG(flags, 0);
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(special_key);
+	phalcon_array_fetch_string(&special_key, options, SL("statsKey"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(stored_keys);
+	PHALCON_CALL_METHOD_PARAMS_1(stored_keys, memcache, "get", special_key);
+	if (Z_TYPE_P(stored_keys) != IS_ARRAY) { 
+		PHALCON_INIT_NVAR(stored_keys);
+		array_init(stored_keys);
+	}
+	
+	phalcon_is_iterable(items, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key_name, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(content);
+	
+		PHALCON_INIT_NVAR(last_key);
+		PHALCON_CONCAT_VV(last_key, prefix, key_name);
+	
+		PHALCON_INIT_NVAR(prepared_content);
+		PHALCON_CALL_METHOD_PARAMS_1(prepared_content, frontend, "beforestore", content);
+		if (zend_is_true(stampede)) {
+			PHALCON_INIT_NVAR(envelope);
+			PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+		} else {
+			PHALCON_CPY_WRT(envelope, prepared_content);
+		}
+	
+		PHALCON_INIT_NVAR(success);
+		PHALCON_CALL_METHOD_PARAMS_4(success, memcache, "set", last_key, envelope, flags, storage_ttl);
+		if (!zend_is_true(success)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Failed storing data in memcached");
+			return;
+		}
+	
+		if (!phalcon_array_isset(stored_keys, last_key)) {
+			phalcon_array_update_zval(&stored_keys, last_key, &ttl, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			changed = 1;
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	if (changed) {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(memcache, "set", special_key, stored_keys);
+	}
+	
+	RETURN_MM_TRUE;
+}
+
+/**
+ * Deletes several values from the cache at once, the stats key is only updated once
+ *
+ * @param array $keys
+ * @return int
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, deleteMany){
+
+	zval *keys, *memcache = NULL, *prefix, *options, *special_key;
+	zval *stored_keys, *key_name = NULL, *prefixed_key = NULL;
+	zval *success = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	long deleted = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &keys);
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(memcache);
+	phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	if (Z_TYPE_P(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_connect");
+	
+		PHALCON_OBS_NVAR(memcache);
+		phalcon_read_property_this(&memcache, this_ptr, SL("_memcache"), PH_NOISY_CC);
+	}
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(special_key);
+	phalcon_array_fetch_string(&special_key, options, SL("statsKey"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(stored_keys);
+	PHALCON_CALL_METHOD_PARAMS_1(stored_keys, memcache, "get", special_key);
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+	
+		if (Z_TYPE_P(stored_keys) == IS_ARRAY) { 
+			phalcon_array_unset(&stored_keys, prefixed_key, PH_SEPARATE);
+		}
+	
+		PHALCON_INIT_NVAR(success);
+		PHALCON_CALL_METHOD_PARAMS_1(success, memcache, "delete", prefixed_key);
+		if (zend_is_true(success)) {
+			deleted++;
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	if (Z_TYPE_P(stored_keys) == IS_ARRAY) { 
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(memcache, "set", special_key, stored_keys);
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(deleted);
+}
+
+/**
+ * Starts reading a cached content without waiting for the server, the returned handle can
+ * be waited together with other operations using Phalcon\Async::wait
+ *
+ *<code>
+ *	$posts = $cache->getAsync('posts');
+ *	$tags = $cache->getAsync('tags');
+ *
+ *	Phalcon\Async::wait(array($posts, $tags));
+ *
+ *	foreach ($posts->getResult() as $post) {
+ *		echo $post->title;
+ *	}
+ *</code>
+ *
+ * @param int|string $keyName
+ * @return Phalcon\Async\Handle
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, getAsync){
+
+	zval *key_name, *options, *host, *port, *address, *prefix;
+	zval *prefixed_key, *sanitized_key, *request, *callback;
+	int i;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &key_name) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(host);
+	phalcon_array_fetch_string(&host, options, SL("host"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(port);
+	phalcon_array_fetch_string(&port, options, SL("port"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(address);
+	PHALCON_CONCAT_SVSV(address, "tcp://", host, ":", port);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(prefixed_key);
+	PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+	
+	/** 
+	 * Keys are sent as the Memcache extension does, control characters and spaces are
+	 * replaced by underscores so they cannot inject other commands
+	 */
+	PHALCON_INIT_VAR(sanitized_key);
+	ZVAL_ZVAL(sanitized_key, prefixed_key, 1, 0);
+	convert_to_string(sanitized_key);
+	if (!Z_STRLEN_P(sanitized_key) || Z_STRLEN_P(sanitized_key) > 250) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "The key must contain between 1 and 250 characters");
+		return;
+	}
+	
+	for (i = 0; i < Z_STRLEN_P(sanitized_key); i++) {
+		if ((unsigned char) Z_STRVAL_P(sanitized_key)[i] <= ' ') {
+			Z_STRVAL_P(sanitized_key)[i] = '_';
+		}
+	}
+	
+	PHALCON_INIT_VAR(request);
+	PHALCON_CONCAT_SVS(request, "get ", sanitized_key, "\r\n");
+	
+	PHALCON_INIT_VAR(callback);
+	array_init_size(callback, 2);
+	phalcon_array_append(&callback, this_ptr, PH_SEPARATE TSRMLS_CC);
+	add_next_index_stringl(callback, SL("resolveAsync"), 1);
+	
+	phalcon_async_handle_create(return_value, address, request, PHALCON_ASYNC_MEMCACHE_GET, callback, prefixed_key TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Processes the content read by a handle returned by getAsync as get does, this method is
+ * called by the handle when its result is requested
+ *
+ * @param mixed $cachedContent
+ * @param string $prefixedKey
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcache, resolveAsync){
+
+	zval *cached_content, *prefixed_key, *frontend, *stampede;
+	zval *content = NULL, *processed;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &cached_content, &prefixed_key) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	phalcon_update_property_this(this_ptr, SL("_lastKey"), prefixed_key TSRMLS_CC);
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			PHALCON_INIT_NVAR(cached_content);
+		}
+	
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_2(content, this_ptr, "_stampede", prefixed_key, cached_content);
+		if (Z_TYPE_P(content) == IS_NULL) {
+			RETURN_MM_NULL();
+		}
+	} else {
+		if (PHALCON_IS_FALSE(cached_content)) {
+			phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+			RETURN_MM_NULL();
+		}
+		phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		PHALCON_CPY_WRT(content, cached_content);
+	}
+	
+	PHALCON_INIT_VAR(processed);
+	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
+	
+	RETURN_CCTOR(processed);
+}
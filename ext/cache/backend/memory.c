@@ -69,7 +69,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Memory){
 
 	zend_declare_property_null(phalcon_cache_backend_memory_ce, SL("_data"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
-	zend_class_implements(phalcon_cache_backend_memory_ce TSRMLS_CC, 1, phalcon_cache_backendinterface_ce);
+	zend_class_implements(phalcon_cache_backend_memory_ce TSRMLS_CC, 2, phalcon_cache_backendinterface_ce, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -84,7 +84,8 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Memory){
 PHP_METHOD(Phalcon_Cache_Backend_Memory, get){
 
 	zval *key_name, *lifetime = NULL, *last_key = NULL, *prefix, *data;
-	zval *cached_content, *frontend, *processed;
+	zval *cached_content = NULL, *stampede, *content = NULL, *frontend;
+	zval *processed;
 
 	PHALCON_MM_GROW();
 
@@ -109,13 +110,28 @@ PHP_METHOD(Phalcon_Cache_Backend_Memory, get){
 	
 	PHALCON_OBS_VAR(data);
 	phalcon_read_property_this(&data, this_ptr, SL("_data"), PH_NOISY_CC);
-	if (!phalcon_array_isset(data, last_key)) {
-		RETURN_MM_NULL();
+	if (phalcon_array_isset(data, last_key)) {
+		PHALCON_OBS_VAR(cached_content);
+		phalcon_array_fetch(&cached_content, data, last_key, PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_VAR(cached_content);
+	}
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_2(content, this_ptr, "_stampede", last_key, cached_content);
+	} else {
+		if (Z_TYPE_P(cached_content) == IS_NULL) {
+			phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+		} else {
+			phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+		}
+		PHALCON_CPY_WRT(content, cached_content);
 	}
 	
-	PHALCON_OBS_VAR(cached_content);
-	phalcon_array_fetch(&cached_content, data, last_key, PH_NOISY_CC);
-	if (Z_TYPE_P(cached_content) == IS_NULL) {
+	if (Z_TYPE_P(content) == IS_NULL) {
 		RETURN_MM_NULL();
 	}
 	
@@ -123,7 +139,7 @@ PHP_METHOD(Phalcon_Cache_Backend_Memory, get){
 	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
 	
 	PHALCON_INIT_VAR(processed);
-	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", cached_content);
+	PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
 	
 	RETURN_CCTOR(processed);
 }
@@ -140,7 +156,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Memory, save){
 
 	zval *key_name = NULL, *content = NULL, *lifetime = NULL, *stop_buffer = NULL;
 	zval *last_key = NULL, *prefix, *frontend, *cached_content = NULL;
-	zval *prepared_content, *is_buffering;
+	zval *prepared_content, *stampede, *ttl = NULL, *envelope = NULL;
+	zval *is_buffering;
 
 	PHALCON_MM_GROW();
 
@@ -191,7 +208,24 @@ PHP_METHOD(Phalcon_Cache_Backend_Memory, save){
 	
 	PHALCON_INIT_VAR(prepared_content);
 	PHALCON_CALL_METHOD_PARAMS_1(prepared_content, frontend, "beforestore", cached_content);
-	phalcon_update_property_array(this_ptr, SL("_data"), last_key, prepared_content TSRMLS_CC);
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (Z_TYPE_P(lifetime) == IS_NULL) {
+			PHALCON_INIT_VAR(ttl);
+			PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+		} else {
+			PHALCON_CPY_WRT(ttl, lifetime);
+		}
+	
+		PHALCON_INIT_VAR(envelope);
+		PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+	} else {
+		PHALCON_CPY_WRT(envelope, prepared_content);
+	}
+	
+	phalcon_update_property_array(this_ptr, SL("_data"), last_key, envelope TSRMLS_CC);
 	
 	PHALCON_INIT_VAR(is_buffering);
 	PHALCON_CALL_METHOD(is_buffering, frontend, "isbuffering");
@@ -77,7 +77,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend_Mongo){
 
 	zend_declare_property_null(phalcon_cache_backend_mongo_ce, SL("_collection"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
-	zend_class_implements(phalcon_cache_backend_mongo_ce TSRMLS_CC, 1, phalcon_cache_backendinterface_ce);
+	zend_class_implements(phalcon_cache_backend_mongo_ce TSRMLS_CC, 2, phalcon_cache_backendinterface_ce, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -220,7 +220,7 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, get){
 	zval *key_name, *lifetime = NULL, *frontend, *prefix, *prefixed_key;
 	zval *collection, *conditions, *document, *timestamp;
 	zval *ttl = NULL, *modified_time, *difference, *not_expired;
-	zval *cached_content, *content;
+	zval *cached_content = NULL, *content, *stampede, *processed;
 
 	PHALCON_MM_GROW();
 
@@ -251,6 +251,32 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, get){
 	
 	PHALCON_INIT_VAR(document);
 	PHALCON_CALL_METHOD_PARAMS_1(document, collection, "findone", conditions);
+	
+	/** 
+	 * Protected entries carry their own expiration time
+	 */
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		if (phalcon_array_isset_string(document, SS("data"))) {
+			PHALCON_OBS_VAR(cached_content);
+			phalcon_array_fetch_string(&cached_content, document, SL("data"), PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_VAR(cached_content);
+		}
+	
+		PHALCON_INIT_VAR(content);
+		PHALCON_CALL_METHOD_PARAMS_3(content, this_ptr, "_stampede", prefixed_key, cached_content, lifetime);
+		if (Z_TYPE_P(content) == IS_NULL) {
+			RETURN_MM_NULL();
+		}
+	
+		PHALCON_INIT_VAR(processed);
+		PHALCON_CALL_METHOD_PARAMS_1(processed, frontend, "afterretrieve", content);
+	
+		RETURN_CCTOR(processed);
+	}
+	
 	if (Z_TYPE_P(document) == IS_ARRAY) { 
 	
 		PHALCON_INIT_VAR(timestamp);
@@ -288,6 +314,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, get){
 			PHALCON_OBS_VAR(cached_content);
 			phalcon_array_fetch_string(&cached_content, document, SL("data"), PH_NOISY_CC);
 	
+			phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+	
 			PHALCON_INIT_VAR(content);
 			PHALCON_CALL_METHOD_PARAMS_1(content, frontend, "afterretrieve", cached_content);
 	
@@ -295,6 +323,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, get){
 		}
 	}
 	
+	phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+	
 	RETURN_MM_NULL();
 }
 
@@ -311,7 +341,8 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, save){
 	zval *key_name = NULL, *content = NULL, *lifetime = NULL, *stop_buffer = NULL;
 	zval *last_key = NULL, *prefix, *frontend, *cached_content = NULL;
 	zval *prepared_content, *ttl = NULL, *collection, *timestamp;
-	zval *conditions, *document, *data, *is_buffering;
+	zval *conditions, *document, *data, *stampede, *envelope;
+	zval *is_buffering;
 
 	PHALCON_MM_GROW();
 
@@ -369,6 +400,18 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, save){
 		PHALCON_CPY_WRT(ttl, lifetime);
 	}
 	
+	/** 
+	 * Protected entries are stored with their expiration time
+	 */
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	if (zend_is_true(stampede)) {
+		PHALCON_INIT_VAR(envelope);
+		PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+	
+		PHALCON_CPY_WRT(prepared_content, envelope);
+	}
+	
 	PHALCON_INIT_VAR(collection);
 	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
 	
@@ -588,3 +631,448 @@ PHP_METHOD(Phalcon_Cache_Backend_Mongo, exists){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Acquires the lock to regenerate an entry. The lock document is upserted and incremented
+ * atomically, only the process creating it or taking over an expired one gets the lock
+ *
+ * @param string $lockKey
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Mongo, _acquireLock){
+
+	zval *lock_key, *lifetime, *collection, *timestamp, *expires;
+	zval *conditions, *increment, *counter, *insert, *update;
+	zval *fields, *options, *document = NULL, *count, *expired;
+	zval *reset;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &lock_key, &lifetime);
+	
+	PHALCON_INIT_VAR(collection);
+	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
+	
+	PHALCON_INIT_VAR(timestamp);
+	ZVAL_LONG(timestamp, (long) time(NULL));
+	
+	PHALCON_INIT_VAR(expires);
+	ZVAL_LONG(expires, (long) time(NULL) + phalcon_get_intval(lifetime));
+	
+	PHALCON_INIT_VAR(conditions);
+	array_init_size(conditions, 1);
+	phalcon_array_update_string(&conditions, SL("key"), &lock_key, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(counter);
+	array_init_size(counter, 1);
+	add_assoc_long_ex(counter, SS("count"), 1);
+	
+	PHALCON_INIT_VAR(insert);
+	array_init_size(insert, 1);
+	phalcon_array_update_string(&insert, SL("time"), &expires, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(increment);
+	array_init_size(increment, 2);
+	phalcon_array_update_string(&increment, SL("$inc"), &counter, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&increment, SL("$setOnInsert"), &insert, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(fields);
+	array_init(fields);
+	
+	PHALCON_INIT_VAR(options);
+	array_init_size(options, 2);
+	add_assoc_bool_ex(options, SS("upsert"), 1);
+	add_assoc_bool_ex(options, SS("new"), 1);
+	
+	PHALCON_INIT_VAR(document);
+	PHALCON_CALL_METHOD_PARAMS_4(document, collection, "findandmodify", conditions, increment, fields, options);
+	if (Z_TYPE_P(document) != IS_ARRAY) {
+		RETURN_MM_FALSE;
+	}
+	
+	PHALCON_OBS_VAR(count);
+	phalcon_array_fetch_string(&count, document, SL("count"), PH_NOISY_CC);
+	if (phalcon_get_intval(count) == 1) {
+		RETURN_MM_TRUE;
+	}
+	
+	/** 
+	 * Take over a lock whose holder did not release it in time
+	 */
+	PHALCON_INIT_VAR(expired);
+	array_init_size(expired, 1);
+	phalcon_array_update_string(&expired, SL("$lt"), &timestamp, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&conditions, SL("time"), &expired, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(reset);
+	array_init_size(reset, 1);
+	phalcon_array_update_string(&reset, SL("time"), &expires, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(update);
+	array_init_size(update, 1);
+	phalcon_array_update_string(&update, SL("$set"), &reset, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	phalcon_array_update_string_bool(&options, SL("upsert"), 0, PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_NVAR(document);
+	PHALCON_CALL_METHOD_PARAMS_4(document, collection, "findandmodify", conditions, update, fields, options);
+	if (Z_TYPE_P(document) == IS_ARRAY) {
+		RETURN_MM_TRUE;
+	}
+	
+	RETURN_MM_FALSE;
+}
+
+/**
+ * Releases the lock taken to regenerate an entry
+ *
+ * @param string $lockKey
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Mongo, _releaseLock){
+
+	zval *lock_key, *collection, *conditions;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &lock_key);
+	
+	PHALCON_INIT_VAR(collection);
+	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
+	
+	PHALCON_INIT_VAR(conditions);
+	array_init_size(conditions, 1);
+	phalcon_array_update_string(&conditions, SL("key"), &lock_key, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(collection, "remove", conditions);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns several cached contents fetching all the documents with a single $in query
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Mongo, getMany){
+
+	zval *keys, *lifetime = NULL, *frontend, *prefix, *prefixed_keys;
+	zval *key_name = NULL, *prefixed_key = NULL, *collection, *in_keys;
+	zval *conditions, *cursor, *use_keys, *documents, *document = NULL;
+	zval *document_key = NULL, *cached_documents, *stampede, *ttl = NULL;
+	zval *limit, *cached_contents, *cached_content = NULL, *contents;
+	zval *modified_time = NULL;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(prefixed_keys);
+	array_init_size(prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+		phalcon_array_append(&prefixed_keys, prefixed_key, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(collection);
+	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
+	
+	PHALCON_INIT_VAR(in_keys);
+	array_init_size(in_keys, 1);
+	phalcon_array_update_string(&in_keys, SL("$in"), &prefixed_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(conditions);
+	array_init_size(conditions, 1);
+	phalcon_array_update_string(&conditions, SL("key"), &in_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(cursor);
+	PHALCON_CALL_METHOD_PARAMS_1(cursor, collection, "find", conditions);
+	
+	PHALCON_INIT_VAR(use_keys);
+	ZVAL_BOOL(use_keys, 0);
+	
+	PHALCON_INIT_VAR(documents);
+	PHALCON_CALL_FUNC_PARAMS_2(documents, "iterator_to_array", cursor, use_keys);
+	
+	/** 
+	 * Index the documents by their key
+	 */
+	PHALCON_INIT_VAR(cached_documents);
+	array_init(cached_documents);
+	
+	if (phalcon_is_iterable(documents, &ah1, &hp1, 0, 0 TSRMLS_CC)) {
+	
+		while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(document);
+	
+			if (phalcon_array_isset_string(document, SS("key"))) {
+				PHALCON_OBS_NVAR(document_key);
+				phalcon_array_fetch_string(&document_key, document, SL("key"), PH_NOISY_CC);
+				phalcon_array_update_zval(&cached_documents, document_key, &document, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			}
+	
+			zend_hash_move_forward_ex(ah1, &hp1);
+		}
+	}
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(lifetime) == IS_NULL) {
+		PHALCON_INIT_VAR(ttl);
+		PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+	} else {
+		PHALCON_CPY_WRT(ttl, lifetime);
+	}
+	
+	PHALCON_INIT_VAR(limit);
+	ZVAL_LONG(limit, (long) time(NULL) - phalcon_get_intval(ttl));
+	
+	PHALCON_INIT_VAR(cached_contents);
+	array_init(cached_contents);
+	
+	phalcon_is_iterable(keys, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+	
+		PHALCON_INIT_NVAR(cached_content);
+		if (phalcon_array_isset(cached_documents, prefixed_key)) {
+	
+			PHALCON_OBS_NVAR(document);
+			phalcon_array_fetch(&document, cached_documents, prefixed_key, PH_NOISY_CC);
+			if (phalcon_array_isset_string(document, SS("data"))) {
+	
+				/** 
+				 * Unprotected entries expire based on the column 'time'
+				 */
+				if (zend_is_true(stampede)) {
+					PHALCON_OBS_NVAR(cached_content);
+					phalcon_array_fetch_string(&cached_content, document, SL("data"), PH_NOISY_CC);
+				} else if (phalcon_array_isset_string(document, SS("time"))) {
+					PHALCON_OBS_NVAR(modified_time);
+					phalcon_array_fetch_string(&modified_time, document, SL("time"), PH_NOISY_CC);
+					if (phalcon_get_intval(limit) < phalcon_get_intval(modified_time)) {
+						PHALCON_OBS_NVAR(cached_content);
+						phalcon_array_fetch_string(&cached_content, document, SL("data"), PH_NOISY_CC);
+					}
+				}
+			}
+		}
+	
+		if (Z_TYPE_P(cached_content) != IS_NULL) {
+			phalcon_array_update_zval(&cached_contents, prefixed_key, &cached_content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah2, &hp2);
+	}
+	
+	PHALCON_INIT_VAR(contents);
+	PHALCON_CALL_METHOD_PARAMS_4(contents, this_ptr, "_processmany", keys, cached_contents, prefix, lifetime);
+	
+	RETURN_CCTOR(contents);
+}
+
+/**
+ * Stores several contents at once, every document is upserted without reading it first
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Mongo, saveMany){
+
+	zval *items, *lifetime = NULL, *frontend, *prefix, *ttl = NULL;
+	zval *stampede, *collection, *timestamp, *time_column;
+	zval *options, *key_name = NULL, *content = NULL, *last_key = NULL;
+	zval *prepared_content = NULL, *envelope = NULL, *conditions = NULL;
+	zval *data = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &items, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(items) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Items must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(frontend);
+	phalcon_read_property_this(&frontend, this_ptr, SL("_frontend"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(lifetime) == IS_NULL) {
+		PHALCON_INIT_VAR(ttl);
+		PHALCON_CALL_METHOD(ttl, frontend, "getlifetime");
+	} else {
+		PHALCON_CPY_WRT(ttl, lifetime);
+	}
+	
+	PHALCON_OBS_VAR(stampede);
+	phalcon_read_property_this(&stampede, this_ptr, SL("_stampede"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(collection);
+	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
+	
+	/** 
+	 * The column 'time' is computed as in save()
+	 */
+	PHALCON_INIT_VAR(timestamp);
+	ZVAL_LONG(timestamp, (long) time(NULL));
+	
+	PHALCON_INIT_VAR(time_column);
+	phalcon_add_function(time_column, lifetime, timestamp TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(options);
+	array_init_size(options, 1);
+	add_assoc_bool_ex(options, SS("upsert"), 1);
+	
+	phalcon_is_iterable(items, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key_name, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(content);
+	
+		PHALCON_INIT_NVAR(last_key);
+		PHALCON_CONCAT_VV(last_key, prefix, key_name);
+	
+		PHALCON_INIT_NVAR(prepared_content);
+		PHALCON_CALL_METHOD_PARAMS_1(prepared_content, frontend, "beforestore", content);
+		if (zend_is_true(stampede)) {
+			PHALCON_INIT_NVAR(envelope);
+			PHALCON_CALL_METHOD_PARAMS_3(envelope, this_ptr, "_envelope", last_key, prepared_content, ttl);
+		} else {
+			PHALCON_CPY_WRT(envelope, prepared_content);
+		}
+	
+		PHALCON_INIT_NVAR(conditions);
+		array_init_size(conditions, 1);
+		phalcon_array_update_string(&conditions, SL("key"), &last_key, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_INIT_NVAR(data);
+		array_init_size(data, 3);
+		phalcon_array_update_string(&data, SL("key"), &last_key, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		phalcon_array_update_string(&data, SL("time"), &time_column, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		phalcon_array_update_string(&data, SL("data"), &envelope, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(collection, "update", conditions, data, options);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_MM_TRUE;
+}
+
+/**
+ * Deletes several values from the cache with a single $in query
+ *
+ * @param array $keys
+ * @return int
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Mongo, deleteMany){
+
+	zval *keys, *prefix, *prefixed_keys, *key_name = NULL;
+	zval *prefixed_key = NULL, *collection, *in_keys, *conditions;
+	zval *status, *removed;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &keys);
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(prefixed_keys);
+	array_init_size(prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	
+	phalcon_is_iterable(keys, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		PHALCON_INIT_NVAR(prefixed_key);
+		PHALCON_CONCAT_VV(prefixed_key, prefix, key_name);
+		phalcon_array_append(&prefixed_keys, prefixed_key, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(collection);
+	PHALCON_CALL_METHOD(collection, this_ptr, "_getcollection");
+	
+	PHALCON_INIT_VAR(in_keys);
+	array_init_size(in_keys, 1);
+	phalcon_array_update_string(&in_keys, SL("$in"), &prefixed_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(conditions);
+	array_init_size(conditions, 1);
+	phalcon_array_update_string(&conditions, SL("key"), &in_keys, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(status);
+	PHALCON_CALL_METHOD_PARAMS_1(status, collection, "remove", conditions);
+	
+	/** 
+	 * Acknowledged removals report the number of documents removed
+	 */
+	if (phalcon_array_isset_string(status, SS("n"))) {
+		PHALCON_OBS_VAR(removed);
+		phalcon_array_fetch_string(&removed, status, SL("n"), PH_NOISY_CC);
+		RETURN_CCTOR(removed);
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(zend_is_true(status) ? zend_hash_num_elements(Z_ARRVAL_P(keys)) : 0);
+}
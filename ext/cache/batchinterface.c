@@ -0,0 +1,65 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "kernel/main.h"
+
+/**
+ * Phalcon\Cache\BatchInterface initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Cache_BatchInterface){
+
+	PHALCON_REGISTER_INTERFACE(Phalcon\\Cache, BatchInterface, cache_batchinterface, phalcon_cache_batchinterface_method_entry);
+
+	return SUCCESS;
+}
+
+/**
+ * Returns several cached contents at once, keys not found are not present in the result
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BatchInterface, getMany);
+
+/**
+ * Stores several contents at once
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BatchInterface, saveMany);
+
+/**
+ * Deletes several values from the cache at once
+ *
+ * @param array $keys
+ * @return int
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BatchInterface, deleteMany);
+
@@ -0,0 +1,43 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+extern zend_class_entry *phalcon_cache_batchinterface_ce;
+
+PHALCON_INIT_CLASS(Phalcon_Cache_BatchInterface);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_batchinterface_getmany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_batchinterface_savemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, items)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_batchinterface_deletemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+ZEND_END_ARG_INFO()
+
+PHALCON_INIT_FUNCS(phalcon_cache_batchinterface_method_entry){
+	PHP_ABSTRACT_ME(Phalcon_Cache_BatchInterface, getMany, arginfo_phalcon_cache_batchinterface_getmany)
+	PHP_ABSTRACT_ME(Phalcon_Cache_BatchInterface, saveMany, arginfo_phalcon_cache_batchinterface_savemany)
+	PHP_ABSTRACT_ME(Phalcon_Cache_BatchInterface, deleteMany, arginfo_phalcon_cache_batchinterface_deletemany)
+	PHP_FE_END
+};
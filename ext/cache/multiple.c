@@ -35,11 +35,19 @@
 #include "kernel/exception.h"
 #include "kernel/object.h"
 #include "kernel/fcall.h"
+#include "kernel/array.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Cache\Multiple
  *
  * Allows to read to chained backends writing to multiple backends
+ *
+ * When a backend with stampede protection hands the regeneration of an entry to the caller
+ * the chain stops there, so the entry is regenerated once and saved again in every backend
+ *
+ * getMany() asks every backend only for the keys still missing, the contents found in a
+ * backend are stored in the backends queried before it
  */
 
 
@@ -51,6 +59,10 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Multiple){
 	PHALCON_REGISTER_CLASS(Phalcon\\Cache, Multiple, cache_multiple, phalcon_cache_multiple_method_entry, 0);
 
 	zend_declare_property_null(phalcon_cache_multiple_ce, SL("_backends"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_multiple_ce, SL("_hits"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_cache_multiple_ce, SL("_misses"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	zend_class_implements(phalcon_cache_multiple_ce TSRMLS_CC, 1, phalcon_cache_batchinterface_ce);
 
 	return SUCCESS;
 }
@@ -120,7 +132,7 @@ PHP_METHOD(Phalcon_Cache_Multiple, push){
 PHP_METHOD(Phalcon_Cache_Multiple, get){
 
 	zval *key_name, *lifetime = NULL, *backends, *backend = NULL;
-	zval *content = NULL;
+	zval *content = NULL, *regenerating = NULL;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -149,12 +161,26 @@ PHP_METHOD(Phalcon_Cache_Multiple, get){
 		PHALCON_INIT_NVAR(content);
 		PHALCON_CALL_METHOD_PARAMS_2(content, backend, "get", key_name, lifetime);
 		if (Z_TYPE_P(content) != IS_NULL) {
+			phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
 			RETURN_CCTOR(content);
 		}
 	
+		/** 
+		 * The caller was chosen to regenerate the entry
+		 */
+		if (Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_backend_ce TSRMLS_CC)) {
+			PHALCON_INIT_NVAR(regenerating);
+			PHALCON_CALL_METHOD(regenerating, backend, "isregenerating");
+			if (zend_is_true(regenerating)) {
+				break;
+			}
+		}
+	
 		zend_hash_move_forward_ex(ah0, &hp0);
 	}
 	
+	phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+	
 	RETURN_MM_NULL();
 }
 
@@ -352,3 +378,393 @@ PHP_METHOD(Phalcon_Cache_Multiple, exists){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Returns the hits and misses of the chain, the stale entries served by its backends
+ * and the statistics of every backend
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, getStats){
+
+	zval *hits, *misses, *backends, *backend = NULL, *stats = NULL;
+	zval *all_stats, *stale = NULL;
+	long total_stale = 0;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(all_stats);
+	array_init(all_stats);
+	
+	PHALCON_OBS_VAR(backends);
+	phalcon_read_property_this(&backends, this_ptr, SL("_backends"), PH_NOISY_CC);
+	
+	if (phalcon_is_iterable(backends, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(backend);
+	
+			if (Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_backend_ce TSRMLS_CC)) {
+				PHALCON_INIT_NVAR(stats);
+				PHALCON_CALL_METHOD(stats, backend, "getstats");
+				if (phalcon_array_isset_string(stats, SS("stale"))) {
+					PHALCON_OBS_NVAR(stale);
+					phalcon_array_fetch_string(&stale, stats, SL("stale"), PH_NOISY_CC);
+					total_stale += phalcon_get_intval(stale);
+				}
+			} else {
+				PHALCON_INIT_NVAR(stats);
+			}
+	
+			phalcon_array_append(&all_stats, stats, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	PHALCON_OBS_VAR(hits);
+	phalcon_read_property_this(&hits, this_ptr, SL("_hits"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(misses);
+	phalcon_read_property_this(&misses, this_ptr, SL("_misses"), PH_NOISY_CC);
+	
+	array_init_size(return_value, 4);
+	add_assoc_long_ex(return_value, SS("hits"), phalcon_get_intval(hits));
+	add_assoc_long_ex(return_value, SS("misses"), phalcon_get_intval(misses));
+	add_assoc_long_ex(return_value, SS("stale"), total_stale);
+	Z_ADDREF_P(all_stats);
+	add_assoc_zval_ex(return_value, SS("backends"), all_stats);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns several cached contents at once. Every backend is only asked for the keys not found
+ * in the previous ones, and the contents found are stored in the backends that missed them.
+ * Backends not implementing Phalcon\Cache\BatchInterface are asked key by key, and keys whose
+ * regeneration is handed to the caller are not looked up in the next backends, as get() does
+ *
+ *<code>
+ *	$widgets = $cache->getMany(array('menu', 'footer', 'latest-posts'));
+ *</code>
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, getMany){
+
+	zval *keys, *lifetime = NULL, *backends, *found, *missing = NULL;
+	zval *queried, *backend = NULL, *contents = NULL, *previous = NULL;
+	zval *key_name = NULL, *remaining = NULL, *content = NULL, *ordered;
+	zval *hits, *regenerating = NULL, *regenerating_keys = NULL, *stop_buffer;
+	zval *stored_key = NULL;
+	HashTable *ah0, *ah1, *ah2, *ah3, *ah4, *ah5;
+	HashPosition hp0, hp1, hp2, hp3, hp4, hp5;
+	zval **hd;
+	long number_found = 0;
+	int is_backend;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &keys, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(found);
+	array_init(found);
+	
+	PHALCON_INIT_VAR(queried);
+	array_init(queried);
+	
+	PHALCON_INIT_VAR(stop_buffer);
+	ZVAL_BOOL(stop_buffer, 0);
+	
+	PHALCON_CPY_WRT(missing, keys);
+	
+	PHALCON_OBS_VAR(backends);
+	phalcon_read_property_this(&backends, this_ptr, SL("_backends"), PH_NOISY_CC);
+	
+	if (phalcon_is_iterable(backends, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			if (!zend_hash_num_elements(Z_ARRVAL_P(missing))) {
+				break;
+			}
+	
+			PHALCON_GET_FOREACH_VALUE(backend);
+	
+			is_backend = Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_backend_ce TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(regenerating_keys);
+			array_init(regenerating_keys);
+	
+			if (Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_batchinterface_ce TSRMLS_CC)) {
+				PHALCON_INIT_NVAR(contents);
+				PHALCON_CALL_METHOD_PARAMS_2(contents, backend, "getmany", missing, lifetime);
+	
+				if (is_backend) {
+					PHALCON_INIT_NVAR(regenerating_keys);
+					PHALCON_CALL_METHOD(regenerating_keys, backend, "getregeneratingkeys");
+				}
+			} else {
+				PHALCON_INIT_NVAR(contents);
+				array_init(contents);
+	
+				phalcon_is_iterable(missing, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+				while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+					PHALCON_GET_FOREACH_VALUE(key_name);
+	
+					PHALCON_INIT_NVAR(content);
+					PHALCON_CALL_METHOD_PARAMS_2(content, backend, "get", key_name, lifetime);
+					if (Z_TYPE_P(content) != IS_NULL) {
+						phalcon_array_update_zval(&contents, key_name, &content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+					} else {
+						if (is_backend) {
+							PHALCON_INIT_NVAR(regenerating);
+							PHALCON_CALL_METHOD(regenerating, backend, "isregenerating");
+							if (zend_is_true(regenerating)) {
+								phalcon_array_append(&regenerating_keys, key_name, PH_SEPARATE TSRMLS_CC);
+							}
+						}
+					}
+	
+					zend_hash_move_forward_ex(ah1, &hp1);
+				}
+			}
+	
+			if (Z_TYPE_P(contents) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(contents))) {
+	
+				/** 
+				 * Fill the backends that missed these keys
+				 */
+				phalcon_is_iterable(queried, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+				while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+					PHALCON_GET_FOREACH_VALUE(previous);
+	
+					if (instanceof_function(Z_OBJCE_P(previous), phalcon_cache_batchinterface_ce TSRMLS_CC)) {
+						PHALCON_CALL_METHOD_PARAMS_2_NORETURN(previous, "savemany", contents, lifetime);
+					} else {
+						phalcon_is_iterable(contents, &ah3, &hp3, 0, 0 TSRMLS_CC);
+	
+						while (zend_hash_get_current_data_ex(ah3, (void**) &hd, &hp3) == SUCCESS) {
+	
+							PHALCON_GET_FOREACH_KEY(stored_key, ah3, hp3);
+							PHALCON_GET_FOREACH_VALUE(content);
+	
+							PHALCON_CALL_METHOD_PARAMS_4_NORETURN(previous, "save", stored_key, content, lifetime, stop_buffer);
+	
+							zend_hash_move_forward_ex(ah3, &hp3);
+						}
+					}
+	
+					zend_hash_move_forward_ex(ah2, &hp2);
+				}
+			}
+	
+			if (Z_TYPE_P(contents) != IS_ARRAY) {
+				PHALCON_INIT_NVAR(contents);
+				array_init(contents);
+			}
+	
+			/** 
+			 * Keys handed for regeneration are left to the caller
+			 */
+			PHALCON_INIT_NVAR(remaining);
+			array_init(remaining);
+	
+			phalcon_is_iterable(missing, &ah4, &hp4, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah4, (void**) &hd, &hp4) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(key_name);
+	
+				if (phalcon_array_isset(contents, key_name)) {
+					PHALCON_OBS_NVAR(content);
+					phalcon_array_fetch(&content, contents, key_name, PH_NOISY_CC);
+					phalcon_array_update_zval(&found, key_name, &content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				} else {
+					if (Z_TYPE_P(regenerating_keys) != IS_ARRAY || !phalcon_fast_in_array(key_name, regenerating_keys TSRMLS_CC)) {
+						phalcon_array_append(&remaining, key_name, PH_SEPARATE TSRMLS_CC);
+					}
+				}
+	
+				zend_hash_move_forward_ex(ah4, &hp4);
+			}
+	
+			PHALCON_CPY_WRT(missing, remaining);
+	
+			phalcon_array_append(&queried, backend, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	/** 
+	 * The contents are returned in the order of the keys
+	 */
+	PHALCON_INIT_VAR(ordered);
+	array_init(ordered);
+	
+	phalcon_is_iterable(keys, &ah5, &hp5, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah5, (void**) &hd, &hp5) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(key_name);
+	
+		if (phalcon_array_isset(found, key_name)) {
+			PHALCON_OBS_NVAR(content);
+			phalcon_array_fetch(&content, found, key_name, PH_NOISY_CC);
+			phalcon_array_update_zval(&ordered, key_name, &content, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			number_found++;
+		} else {
+			phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah5, &hp5);
+	}
+	
+	if (number_found) {
+		PHALCON_OBS_VAR(hits);
+		phalcon_read_property_this(&hits, this_ptr, SL("_hits"), PH_NOISY_CC);
+		phalcon_update_property_long(this_ptr, SL("_hits"), phalcon_get_intval(hits) + number_found TSRMLS_CC);
+	}
+	
+	RETURN_CTOR(ordered);
+}
+
+/**
+ * Stores several contents at once in every backend, backends not implementing
+ * Phalcon\Cache\BatchInterface store them one by one
+ *
+ * @param array $items
+ * @param long $lifetime
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, saveMany){
+
+	zval *items, *lifetime = NULL, *backends, *backend = NULL;
+	zval *key_name = NULL, *content = NULL, *stop_buffer;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &items, &lifetime);
+	
+	if (!lifetime) {
+		PHALCON_INIT_VAR(lifetime);
+	}
+	
+	if (Z_TYPE_P(items) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Items must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(stop_buffer);
+	ZVAL_BOOL(stop_buffer, 0);
+	
+	PHALCON_OBS_VAR(backends);
+	phalcon_read_property_this(&backends, this_ptr, SL("_backends"), PH_NOISY_CC);
+	
+	if (!phalcon_is_iterable(backends, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(backend);
+	
+		if (Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_batchinterface_ce TSRMLS_CC)) {
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(backend, "savemany", items, lifetime);
+		} else {
+			phalcon_is_iterable(items, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_KEY(key_name, ah1, hp1);
+				PHALCON_GET_FOREACH_VALUE(content);
+	
+				PHALCON_CALL_METHOD_PARAMS_4_NORETURN(backend, "save", key_name, content, lifetime, stop_buffer);
+	
+				zend_hash_move_forward_ex(ah1, &hp1);
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Deletes several values from every backend at once, backends not implementing
+ * Phalcon\Cache\BatchInterface delete them one by one
+ *
+ * @param array $keys
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, deleteMany){
+
+	zval *keys, *backends, *backend = NULL, *key_name = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &keys);
+	
+	if (Z_TYPE_P(keys) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "Keys must be an array");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(backends);
+	phalcon_read_property_this(&backends, this_ptr, SL("_backends"), PH_NOISY_CC);
+	
+	if (!phalcon_is_iterable(backends, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(backend);
+	
+		if (Z_TYPE_P(backend) == IS_OBJECT && instanceof_function(Z_OBJCE_P(backend), phalcon_cache_batchinterface_ce TSRMLS_CC)) {
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(backend, "deletemany", keys);
+		} else {
+			phalcon_is_iterable(keys, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(key_name);
+	
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(backend, "delete", key_name);
+	
+				zend_hash_move_forward_ex(ah1, &hp1);
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	
+	PHALCON_MM_RESTORE();
+}
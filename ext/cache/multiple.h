@@ -28,6 +28,10 @@ PHP_METHOD(Phalcon_Cache_Multiple, start);
 PHP_METHOD(Phalcon_Cache_Multiple, save);
 PHP_METHOD(Phalcon_Cache_Multiple, delete);
 PHP_METHOD(Phalcon_Cache_Multiple, exists);
+PHP_METHOD(Phalcon_Cache_Multiple, getStats);
+PHP_METHOD(Phalcon_Cache_Multiple, getMany);
+PHP_METHOD(Phalcon_Cache_Multiple, saveMany);
+PHP_METHOD(Phalcon_Cache_Multiple, deleteMany);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, backends)
@@ -63,6 +67,20 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple_exists, 0, 0, 0)
 	ZEND_ARG_INFO(0, lifetime)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple_getmany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple_savemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, items)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple_deletemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, keys)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_cache_multiple_method_entry){
 	PHP_ME(Phalcon_Cache_Multiple, __construct, arginfo_phalcon_cache_multiple___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Cache_Multiple, push, arginfo_phalcon_cache_multiple_push, ZEND_ACC_PUBLIC) 
@@ -71,6 +89,10 @@ PHALCON_INIT_FUNCS(phalcon_cache_multiple_method_entry){
 	PHP_ME(Phalcon_Cache_Multiple, save, arginfo_phalcon_cache_multiple_save, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Cache_Multiple, delete, arginfo_phalcon_cache_multiple_delete, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Cache_Multiple, exists, arginfo_phalcon_cache_multiple_exists, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Multiple, getStats, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Multiple, getMany, arginfo_phalcon_cache_multiple_getmany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Multiple, saveMany, arginfo_phalcon_cache_multiple_savemany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Cache_Multiple, deleteMany, arginfo_phalcon_cache_multiple_deletemany, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
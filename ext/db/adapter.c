@@ -460,6 +460,326 @@ PHP_METHOD(Phalcon_Db_Adapter, insert){
 	RETURN_CCTOR(success);
 }
 
+/**
+ * Inserts many rows into a table using multi-row INSERT statements. Rows are grouped in as
+ * few statements as possible, a new statement is started when the current one would exceed
+ * the 'maxPacketSize' (bytes) or 'maxParameters' (bound values) options. The 'onDuplicate'
+ * option is a list of fields to update when a row violates a unique key, PostgreSQL requires
+ * the columns of that unique key in the 'conflict' option
+ *
+ * <code>
+ * //Inserting two robots
+ * $success = $connection->insertMany(
+ *     "robots",
+ *     array(
+ *         array("Astro Boy", 1952),
+ *         array("Terminator", 1984)
+ *     ),
+ *     array("name", "year")
+ * );
+ *
+ * //Next SQL sentence is sent to the database system
+ * INSERT INTO `robots` (`name`, `year`) VALUES ("Astro boy", 1952), ("Terminator", 1984);
+ *
+ * //Updating the year of the robots that already exist
+ * $success = $connection->insertMany("robots", $rows, array("name", "year"), null, array(
+ *     "onDuplicate" => array("year"),
+ *     "conflict" => array("name")
+ * ));
+ * </code>
+ *
+ * @param 	string $table
+ * @param 	array $rows
+ * @param 	array $fields
+ * @param 	array $dataTypes
+ * @param 	array $options
+ * @return 	boolean
+ */
+PHP_METHOD(Phalcon_Db_Adapter, insertMany){
+
+	zval *table, *rows, *fields, *data_types = NULL, *options = NULL;
+	zval *exception_message, *max_packet_size = NULL, *max_parameters = NULL;
+	zval *on_duplicate = NULL, *conflict = NULL, *type, *dialect = NULL;
+	zval *escaped_table = NULL, *escaped_fields = NULL, *field = NULL, *escaped_field = NULL;
+	zval *joined_fields, *insert_prefix, *number_fields;
+	zval *groups, *insert_values, *bind_data_types = NULL;
+	zval *row = NULL, *placeholders = NULL, *row_values = NULL, *row_types = NULL;
+	zval *value = NULL, *position = NULL, *str_value = NULL, *bind_type = NULL;
+	zval *joined_values = NULL, *group = NULL, *joined_groups = NULL;
+	zval *insert_sql = NULL, *upsert_sql = NULL, *success = NULL;
+	long packet_size, maximum_size, number_parameters, maximum_parameters;
+	long group_size, group_parameters;
+	int has_row;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 3, 2, &table, &rows, &fields, &data_types, &options);
+	
+	if (!data_types) {
+		PHALCON_INIT_VAR(data_types);
+	}
+	
+	if (!options) {
+		PHALCON_INIT_VAR(options);
+	}
+	
+	if (Z_TYPE_P(rows) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The second parameter for insertMany isn't an Array");
+		return;
+	}
+	
+	if (Z_TYPE_P(fields) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The third parameter for insertMany isn't an Array");
+		return;
+	}
+	
+	if (!phalcon_fast_count_ev(rows TSRMLS_CC)) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Unable to insert into ", table, " without data");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_db_exception_ce, exception_message);
+		return;
+	}
+	
+	/** 
+	 * Statements are limited by the packet size of the server and the number of bound
+	 * parameters allowed by the driver, SQLite only allows 999 by default
+	 */
+	maximum_size = 1048576;
+	maximum_parameters = 65535;
+	
+	PHALCON_OBS_VAR(type);
+	phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+	if (PHALCON_IS_STRING(type, "sqlite")) {
+		maximum_parameters = 999;
+	}
+	
+	if (Z_TYPE_P(options) == IS_ARRAY) { 
+		if (phalcon_array_isset_string(options, SS("maxPacketSize"))) {
+			PHALCON_OBS_VAR(max_packet_size);
+			phalcon_array_fetch_string(&max_packet_size, options, SL("maxPacketSize"), PH_NOISY_CC);
+			maximum_size = phalcon_get_intval(max_packet_size);
+		}
+		if (phalcon_array_isset_string(options, SS("maxParameters"))) {
+			PHALCON_OBS_VAR(max_parameters);
+			phalcon_array_fetch_string(&max_parameters, options, SL("maxParameters"), PH_NOISY_CC);
+			maximum_parameters = phalcon_get_intval(max_parameters);
+		}
+		if (phalcon_array_isset_string(options, SS("onDuplicate"))) {
+			PHALCON_OBS_VAR(on_duplicate);
+			phalcon_array_fetch_string(&on_duplicate, options, SL("onDuplicate"), PH_NOISY_CC);
+			if (phalcon_array_isset_string(options, SS("conflict"))) {
+				PHALCON_OBS_VAR(conflict);
+				phalcon_array_fetch_string(&conflict, options, SL("conflict"), PH_NOISY_CC);
+			} else {
+				PHALCON_INIT_VAR(conflict);
+			}
+	
+			PHALCON_OBS_VAR(dialect);
+			phalcon_read_property_this(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
+		}
+	}
+	
+	if (PHALCON_GLOBAL(db).escape_identifiers) {
+		PHALCON_INIT_VAR(escaped_table);
+		PHALCON_CALL_METHOD_PARAMS_1(escaped_table, this_ptr, "escapeidentifier", table);
+	
+		PHALCON_INIT_VAR(escaped_fields);
+		array_init(escaped_fields);
+	
+		if (!phalcon_is_iterable(fields, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+			return;
+		}
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(field);
+	
+			PHALCON_INIT_NVAR(escaped_field);
+			PHALCON_CALL_METHOD_PARAMS_1(escaped_field, this_ptr, "escapeidentifier", field);
+			phalcon_array_append(&escaped_fields, escaped_field, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	} else {
+		PHALCON_CPY_WRT(escaped_table, table);
+		PHALCON_CPY_WRT(escaped_fields, fields);
+	}
+	
+	PHALCON_INIT_VAR(joined_fields);
+	phalcon_fast_join_str(joined_fields, SL(", "), escaped_fields TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(insert_prefix);
+	PHALCON_CONCAT_SVSVS(insert_prefix, "INSERT INTO ", escaped_table, " (", joined_fields, ") VALUES ");
+	
+	PHALCON_INIT_VAR(number_fields);
+	phalcon_fast_count(number_fields, fields TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(groups);
+	array_init(groups);
+	
+	PHALCON_INIT_VAR(insert_values);
+	array_init(insert_values);
+	
+	if (Z_TYPE_P(data_types) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(bind_data_types);
+		array_init(bind_data_types);
+	} else {
+		PHALCON_CPY_WRT(bind_data_types, data_types);
+	}
+	
+	packet_size = Z_STRLEN_P(insert_prefix);
+	number_parameters = 0;
+	
+	if (!phalcon_is_iterable(rows, &ah1, &hp1, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	/** 
+	 * Every row is converted to a group of placeholders using the same rules as insert(),
+	 * the pending groups are sent when there are no more rows or the next one doesn't fit
+	 */
+	while (1) {
+	
+		has_row = zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS;
+		group_size = 0;
+		group_parameters = 0;
+	
+		if (has_row) {
+	
+			PHALCON_GET_FOREACH_VALUE(row);
+	
+			if (Z_TYPE_P(row) != IS_ARRAY) { 
+				PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Every row to insert must be an Array");
+				return;
+			}
+	
+			if (zend_hash_num_elements(Z_ARRVAL_P(row)) != Z_LVAL_P(number_fields)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The number of values in a row doesn't match the number of fields");
+				return;
+			}
+	
+			PHALCON_INIT_NVAR(placeholders);
+			array_init(placeholders);
+	
+			PHALCON_INIT_NVAR(row_values);
+			array_init(row_values);
+	
+			PHALCON_INIT_NVAR(row_types);
+			array_init(row_types);
+	
+			phalcon_is_iterable(row, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_KEY(position, ah2, hp2);
+				PHALCON_GET_FOREACH_VALUE(value);
+	
+				if (Z_TYPE_P(value) == IS_OBJECT) {
+					PHALCON_INIT_NVAR(str_value);
+					PHALCON_CALL_FUNC_PARAMS_1(str_value, "strval", value);
+					phalcon_array_append(&placeholders, str_value, PH_SEPARATE TSRMLS_CC);
+				} else {
+					if (Z_TYPE_P(value) == IS_NULL) {
+						phalcon_array_append_string(&placeholders, SL("null"), PH_SEPARATE TSRMLS_CC);
+					} else {
+						phalcon_array_append_string(&placeholders, SL("?"), PH_SEPARATE TSRMLS_CC);
+						phalcon_array_append(&row_values, value, PH_SEPARATE TSRMLS_CC);
+						if (Z_TYPE_P(data_types) == IS_ARRAY) { 
+							if (!phalcon_array_isset(data_types, position)) {
+								PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Incomplete number of bind types");
+								return;
+							}
+	
+							PHALCON_OBS_NVAR(bind_type);
+							phalcon_array_fetch(&bind_type, data_types, position, PH_NOISY_CC);
+							phalcon_array_append(&row_types, bind_type, PH_SEPARATE TSRMLS_CC);
+						}
+	
+						/** 
+						 * Bound values travel in the packet too, strings are counted by its length
+						 */
+						if (Z_TYPE_P(value) == IS_STRING) {
+							group_size += Z_STRLEN_P(value);
+						} else {
+							group_size += 24;
+						}
+						group_parameters++;
+					}
+				}
+	
+				zend_hash_move_forward_ex(ah2, &hp2);
+			}
+	
+			PHALCON_INIT_NVAR(joined_values);
+			phalcon_fast_join_str(joined_values, SL(", "), placeholders TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(group);
+			PHALCON_CONCAT_SVS(group, "(", joined_values, ")");
+			group_size += Z_STRLEN_P(group) + 2;
+		}
+	
+		/** 
+		 * Send the pending groups in a single statement
+		 */
+		if (zend_hash_num_elements(Z_ARRVAL_P(groups))) {
+			if (!has_row || (packet_size + group_size) > maximum_size || (number_parameters + group_parameters) > maximum_parameters) {
+	
+				PHALCON_INIT_NVAR(joined_groups);
+				phalcon_fast_join_str(joined_groups, SL(", "), groups TSRMLS_CC);
+	
+				PHALCON_INIT_NVAR(insert_sql);
+				PHALCON_CONCAT_VV(insert_sql, insert_prefix, joined_groups);
+	
+				if (dialect) {
+					PHALCON_INIT_NVAR(upsert_sql);
+					PHALCON_CALL_METHOD_PARAMS_3(upsert_sql, dialect, "upsert", insert_sql, on_duplicate, conflict);
+					PHALCON_CPY_WRT(insert_sql, upsert_sql);
+				}
+	
+				PHALCON_INIT_NVAR(success);
+				PHALCON_CALL_METHOD_PARAMS_3(success, this_ptr, "execute", insert_sql, insert_values, bind_data_types);
+				if (PHALCON_IS_FALSE(success)) {
+					RETURN_CTOR(success);
+				}
+	
+				PHALCON_INIT_NVAR(groups);
+				array_init(groups);
+	
+				PHALCON_INIT_NVAR(insert_values);
+				array_init(insert_values);
+	
+				if (Z_TYPE_P(data_types) == IS_ARRAY) { 
+					PHALCON_INIT_NVAR(bind_data_types);
+					array_init(bind_data_types);
+				}
+	
+				packet_size = Z_STRLEN_P(insert_prefix);
+				number_parameters = 0;
+			}
+		}
+	
+		if (!has_row) {
+			break;
+		}
+	
+		phalcon_array_append(&groups, group, PH_SEPARATE TSRMLS_CC);
+		phalcon_merge_append(insert_values, row_values TSRMLS_CC);
+		if (Z_TYPE_P(data_types) == IS_ARRAY) { 
+			phalcon_merge_append(bind_data_types, row_types TSRMLS_CC);
+		}
+	
+		packet_size += group_size;
+		number_parameters += group_parameters;
+	
+		zend_hash_move_forward_ex(ah1, &hp1);
+	}
+	
+	RETURN_MM_TRUE;
+}
+
 /**
  * Updates data on a table using custom RBDM SQL syntax
  *
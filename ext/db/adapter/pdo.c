@@ -55,8 +55,14 @@
  *		'port' => '3306'
  *	));
  *</code>
+ *
+ * Prepared statements can be kept in a per-connection LRU cache keyed by their SQL, the option
+ * 'statementsCache' sets the number of statements cached (0 by default, the cache is disabled)
  */
 
+/** Number of prepared statements cached per connection by default, zero disables the cache */
+#define PHALCON_DB_ADAPTER_PDO_STATEMENTS 0
+
 
 /**
  * Phalcon\Db\Adapter\Pdo initializer
@@ -68,10 +74,125 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo){
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_pdo"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_affectedRows"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_transactionLevel"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_statements"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_statementsOpen"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_statementsSize"), PHALCON_DB_ADAPTER_PDO_STATEMENTS, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_statementsHits"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_statementsMisses"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_statementsEvictions"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
 
+/**
+ * Returns the cache of prepared statements of a connection ready to be modified
+ */
+static zval *phalcon_db_adapter_pdo_statements(zval *this_ptr TSRMLS_DC){
+
+	zval *statements, *copy;
+
+	statements = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statements) == IS_ARRAY && Z_REFCOUNT_P(statements) == 1) {
+		return statements;
+	}
+
+	MAKE_STD_ZVAL(copy);
+	if (Z_TYPE_P(statements) == IS_ARRAY) {
+		ZVAL_ZVAL(copy, statements, 1, 0);
+	} else {
+		array_init(copy);
+	}
+
+	zend_update_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), copy TSRMLS_CC);
+	zval_ptr_dtor(&copy);
+
+	return zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), 1 TSRMLS_CC);
+}
+
+/**
+ * Closes the cursors of the cached statements no resultset holds anymore, a statement whose
+ * rows were only partially fetched would otherwise keep tables locked or block the connection
+ */
+static void phalcon_db_adapter_pdo_close_idle(zval *this_ptr TSRMLS_DC){
+
+	zval *open, *statements, *still_open, **cached, **value;
+	HashTable *ht;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	open = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statementsOpen"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(open) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(open))) {
+		return;
+	}
+
+	statements = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statements"), 1 TSRMLS_CC);
+
+	MAKE_STD_ZVAL(still_open);
+	array_init(still_open);
+
+	ht = Z_ARRVAL_P(open);
+	zend_hash_internal_pointer_reset_ex(ht, &pos);
+	while (zend_hash_get_current_data_ex(ht, (void **) &value, &pos) == SUCCESS) {
+		if (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+			if (Z_TYPE_P(statements) == IS_ARRAY && zend_hash_find(Z_ARRVAL_P(statements), key, key_length, (void **) &cached) == SUCCESS && Z_TYPE_PP(cached) == IS_OBJECT) {
+				if (Z_REFCOUNT_PP(cached) == 1 && zend_objects_store_get_refcount(*cached TSRMLS_CC) == 1) {
+					zend_call_method_with_0_params(cached, Z_OBJCE_PP(cached), NULL, "closecursor", NULL);
+					if (EG(exception)) {
+						break;
+					}
+				} else {
+					add_assoc_bool_ex(still_open, key, key_length, 1);
+				}
+			}
+		}
+		zend_hash_move_forward_ex(ht, &pos);
+	}
+
+	zend_update_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_statementsOpen"), still_open TSRMLS_CC);
+	zval_ptr_dtor(&still_open);
+}
+
+/**
+ * Checks whether a SQL statement changes the schema, statements prepared before it could
+ * refer to objects that no longer exist
+ */
+static int phalcon_db_adapter_pdo_is_ddl(zval *sql_statement){
+
+	const char *sql;
+	int length;
+
+	if (Z_TYPE_P(sql_statement) != IS_STRING) {
+		return 0;
+	}
+
+	sql = Z_STRVAL_P(sql_statement);
+	length = Z_STRLEN_P(sql_statement);
+	while (length > 0 && isspace((unsigned char) *sql)) {
+		sql++;
+		length--;
+	}
+
+	if (length >= 6 && !strncasecmp(sql, "CREATE", 6)) {
+		return 1;
+	}
+	if (length >= 5 && !strncasecmp(sql, "ALTER", 5)) {
+		return 1;
+	}
+	if (length >= 4 && !strncasecmp(sql, "DROP", 4)) {
+		return 1;
+	}
+	if (length >= 8 && !strncasecmp(sql, "TRUNCATE", 8)) {
+		return 1;
+	}
+	if (length >= 6 && !strncasecmp(sql, "RENAME", 6)) {
+		return 1;
+	}
+
+	return 0;
+}
+
 /**
  * Constructor for Phalcon\Db\Adapter\Pdo
  *
@@ -120,6 +241,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 	zval *descriptor = NULL, *username = NULL, *password = NULL, *dsn_parts;
 	zval *value = NULL, *key = NULL, *dsn_attribute = NULL, *dsn_attributes = NULL;
 	zval *pdo_type, *dsn, *options = NULL, *persistent, *pdo;
+	zval *statements_cache;
 	zend_class_entry *ce;
 	HashTable *ah0;
 	HashPosition hp0;
@@ -176,6 +298,22 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 		array_init(options);
 	}
 
+	/**
+	 * Check the size of the prepared statements cache
+	 */
+	if (phalcon_array_isset_string(descriptor, SS("statementsCache"))) {
+		PHALCON_OBS_VAR(statements_cache);
+		phalcon_array_fetch_string(&statements_cache, descriptor, SL("statementsCache"), PH_NOISY_CC);
+		phalcon_update_property_long(this_ptr, SL("_statementsSize"), phalcon_get_intval(statements_cache) TSRMLS_CC);
+		phalcon_array_unset_string(&descriptor, SS("statementsCache"), PH_SEPARATE);
+	}
+
+	/**
+	 * Statements prepared by a previous connection cannot be reused
+	 */
+	phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
+
 	/**
 	 * Check if the user has defined a custom dsn
 	 */
@@ -247,7 +385,8 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 }
 
 /**
- * Returns a PDO prepared statement to be executed with 'executePrepared'
+ * Returns a PDO prepared statement to be executed with 'executePrepared', statements are
+ * taken from the statements cache when they are not being used by another resultset
  *
  *<code>
  * $statement = $db->prepare('SELECT * FROM robots WHERE name = :name');
@@ -259,17 +398,106 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
  */
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, prepare){
 
-	zval *sql_statement, *pdo, *statement;
+	zval *sql_statement, *size, *statements, *statement = NULL, *pdo;
+	zval *fetch_mode, *is_open = NULL;
+	zval **cached;
+	HashTable *ht;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+	long cache_size;
 
 	PHALCON_MM_GROW();
 
 	phalcon_fetch_params(1, 1, 0, &sql_statement);
 	
+	PHALCON_OBS_VAR(size);
+	phalcon_read_property_this(&size, this_ptr, SL("_statementsSize"), PH_NOISY_CC);
+	
+	cache_size = Z_TYPE_P(sql_statement) == IS_STRING ? phalcon_get_intval(size) : 0;
+	if (cache_size > 0) {
+	
+		phalcon_db_adapter_pdo_close_idle(this_ptr TSRMLS_CC);
+		if (EG(exception)) {
+			RETURN_MM_NULL();
+		}
+	
+		statements = phalcon_db_adapter_pdo_statements(this_ptr TSRMLS_CC);
+		ht = Z_ARRVAL_P(statements);
+	
+		/** 
+		 * A statement is reused only if nothing else holds it, so the rows of a resultset
+		 * still being fetched are never discarded
+		 */
+		if (zend_hash_find(ht, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, (void **) &cached) == SUCCESS) {
+			if (Z_TYPE_PP(cached) == IS_OBJECT && Z_REFCOUNT_PP(cached) == 1 && zend_objects_store_get_refcount(*cached TSRMLS_CC) == 1) {
+	
+				PHALCON_INIT_VAR(statement);
+				ZVAL_ZVAL(statement, *cached, 1, 0);
+	
+				/** 
+				 * Move the statement to the end of the list, the most recently used
+				 */
+				zend_hash_del(ht, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1);
+				Z_ADDREF_P(statement);
+				zend_hash_update(ht, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, &statement, sizeof(zval *), NULL);
+	
+				phalcon_property_incr(this_ptr, SL("_statementsHits") TSRMLS_CC);
+	
+				PHALCON_INIT_VAR(fetch_mode);
+				ZVAL_LONG(fetch_mode, PDO_FETCH_BOTH);
+				PHALCON_CALL_METHOD_NORETURN(statement, "closecursor");
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(statement, "setfetchmode", fetch_mode);
+	
+				PHALCON_INIT_VAR(is_open);
+				ZVAL_BOOL(is_open, 1);
+				phalcon_update_property_array_string(this_ptr, SL("_statementsOpen"), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, is_open TSRMLS_CC);
+	
+				RETURN_CCTOR(statement);
+			}
+		}
+	
+		phalcon_property_incr(this_ptr, SL("_statementsMisses") TSRMLS_CC);
+	}
+	
 	PHALCON_OBS_VAR(pdo);
 	phalcon_read_property_this(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
 	
-	PHALCON_INIT_VAR(statement);
+	PHALCON_INIT_NVAR(statement);
 	PHALCON_CALL_METHOD_PARAMS_1(statement, pdo, "prepare", sql_statement);
+	
+	if (cache_size > 0 && Z_TYPE_P(statement) == IS_OBJECT) {
+	
+		statements = phalcon_db_adapter_pdo_statements(this_ptr TSRMLS_CC);
+		ht = Z_ARRVAL_P(statements);
+	
+		/** 
+		 * A statement with the same SQL still in use is replaced without counting it as an eviction
+		 */
+		zend_hash_del(ht, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1);
+	
+		while (zend_hash_num_elements(ht) >= (ulong) cache_size) {
+			zend_hash_internal_pointer_reset_ex(ht, &pos);
+			if (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				zend_hash_del(ht, key, key_length);
+			} else {
+				zend_hash_index_del(ht, index);
+			}
+			phalcon_property_incr(this_ptr, SL("_statementsEvictions") TSRMLS_CC);
+		}
+	
+		Z_ADDREF_P(statement);
+		zend_hash_update(ht, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, &statement, sizeof(zval *), NULL);
+	
+		/** 
+		 * The cursor is closed by the next statement once no resultset holds it
+		 */
+		PHALCON_INIT_NVAR(is_open);
+		ZVAL_BOOL(is_open, 1);
+		phalcon_update_property_array_string(this_ptr, SL("_statementsOpen"), Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement) + 1, is_open TSRMLS_CC);
+	}
+	
 	RETURN_CCTOR(statement);
 }
 
@@ -433,13 +661,18 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 	if (Z_TYPE_P(bind_params) == IS_ARRAY) { 
 	
 		PHALCON_INIT_VAR(statement);
-		PHALCON_CALL_METHOD_PARAMS_1(statement, pdo, "prepare", sql_statement);
+		PHALCON_CALL_METHOD_PARAMS_1(statement, this_ptr, "prepare", sql_statement);
 		if (Z_TYPE_P(statement) == IS_OBJECT) {
 			PHALCON_INIT_VAR(r0);
 			PHALCON_CALL_METHOD_PARAMS_3(r0, this_ptr, "executeprepared", statement, bind_params, bind_types);
 			PHALCON_CPY_WRT(statement, r0);
 		}
 	} else {
+		phalcon_db_adapter_pdo_close_idle(this_ptr TSRMLS_CC);
+		if (EG(exception)) {
+			RETURN_MM_NULL();
+		}
+	
 		PHALCON_INIT_NVAR(statement);
 		PHALCON_CALL_METHOD_PARAMS_1(statement, pdo, "query", sql_statement);
 	}
@@ -448,6 +681,15 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 	 * Execute the afterQuery event if a EventsManager is available
 	 */
 	if (Z_TYPE_P(statement) == IS_OBJECT) {
+	
+		/** 
+		 * Statements prepared before a schema change are discarded
+		 */
+		if (phalcon_db_adapter_pdo_is_ddl(sql_statement)) {
+			phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+			phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
+		}
+	
 		if (Z_TYPE_P(events_manager) == IS_OBJECT) {
 			PHALCON_INIT_NVAR(event_name);
 			ZVAL_STRING(event_name, "db:afterQuery", 1);
@@ -525,7 +767,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 	if (Z_TYPE_P(bind_params) == IS_ARRAY) { 
 	
 		PHALCON_INIT_VAR(statement);
-		PHALCON_CALL_METHOD_PARAMS_1(statement, pdo, "prepare", sql_statement);
+		PHALCON_CALL_METHOD_PARAMS_1(statement, this_ptr, "prepare", sql_statement);
 		if (Z_TYPE_P(statement) == IS_OBJECT) {
 			PHALCON_INIT_VAR(r0);
 			PHALCON_CALL_METHOD_PARAMS_3(r0, this_ptr, "executeprepared", statement, bind_params, bind_types);
@@ -535,6 +777,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 			PHALCON_CALL_METHOD(affected_rows, statement, "rowcount");
 		}
 	} else {
+		phalcon_db_adapter_pdo_close_idle(this_ptr TSRMLS_CC);
+		if (EG(exception)) {
+			RETURN_MM_NULL();
+		}
+	
 		PHALCON_INIT_NVAR(affected_rows);
 		PHALCON_CALL_METHOD_PARAMS_1(affected_rows, pdo, "exec", sql_statement);
 	}
@@ -544,6 +791,15 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 	 */
 	if (Z_TYPE_P(affected_rows) == IS_LONG) {
 		phalcon_update_property_this(this_ptr, SL("_affectedRows"), affected_rows TSRMLS_CC);
+	
+		/** 
+		 * Statements prepared before a schema change are discarded
+		 */
+		if (phalcon_db_adapter_pdo_is_ddl(sql_statement)) {
+			phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+			phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
+		}
+
 		if (Z_TYPE_P(events_manager) == IS_OBJECT) {
 			PHALCON_INIT_NVAR(event_name);
 			ZVAL_STRING(event_name, "db:afterQuery", 1);
@@ -585,6 +841,8 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, close){
 	PHALCON_OBS_VAR(pdo);
 	phalcon_read_property_this(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
 	if (Z_TYPE_P(pdo) == IS_OBJECT) {
+		phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+		phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
 		phalcon_update_property_null(this_ptr, SL("_pdo") TSRMLS_CC);
 		RETURN_MM_TRUE;
 	}
@@ -898,6 +1156,12 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, rollback){
 	PHALCON_INIT_VAR(status);
 	PHALCON_CALL_METHOD(status, pdo, "rollback");
 	
+	/** 
+	 * Statements prepared in the transaction could refer to objects created by it
+	 */
+	phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
+	
 	RETURN_CCTOR(status);
 }
 
@@ -1005,3 +1269,53 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, getInternalHandler){
 	RETURN_CCTOR(pdo);
 }
 
+/**
+ * Returns the size of the prepared statements cache, the number of statements cached and the
+ * hits, misses and evictions of the cache
+ *
+ *<code>
+ *	print_r($connection->getStatementsCacheStats());
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, getStatementsCacheStats){
+
+	zval *size, *statements, *hits, *misses, *evictions;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(size);
+	phalcon_read_property_this(&size, this_ptr, SL("_statementsSize"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(statements);
+	phalcon_read_property_this(&statements, this_ptr, SL("_statements"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(hits);
+	phalcon_read_property_this(&hits, this_ptr, SL("_statementsHits"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(misses);
+	phalcon_read_property_this(&misses, this_ptr, SL("_statementsMisses"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(evictions);
+	phalcon_read_property_this(&evictions, this_ptr, SL("_statementsEvictions"), PH_NOISY_CC);
+	
+	array_init_size(return_value, 5);
+	phalcon_array_update_string(&return_value, SL("size"), &size, PH_COPY TSRMLS_CC);
+	add_assoc_long_ex(return_value, SS("count"), Z_TYPE_P(statements) == IS_ARRAY ? zend_hash_num_elements(Z_ARRVAL_P(statements)) : 0);
+	phalcon_array_update_string(&return_value, SL("hits"), &hits, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("misses"), &misses, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("evictions"), &evictions, PH_COPY TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Removes the statements kept in the prepared statements cache
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, clearStatementsCache){
+
+
+	phalcon_update_property_null(this_ptr, SL("_statements") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_statementsOpen") TSRMLS_CC);
+}
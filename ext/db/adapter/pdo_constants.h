@@ -27,4 +27,6 @@
 #define PDO_CURSOR_SCROLL 1
 #define PDO_ERRMODE_SILENT 0
 #define PDO_ERRMODE_WARNING 1
-#define PDO_ERRMODE_EXCEPTION 2
\ No newline at end of file
+#define PDO_ERRMODE_EXCEPTION 2
+
+#define PDO_FETCH_BOTH 4
\ No newline at end of file
@@ -141,6 +141,69 @@ PHP_METHOD(Phalcon_Db_Dialect, sharedLock){
 	RETURN_CTOR(sql);
 }
 
+/**
+ * Returns a multi-row INSERT modified to update the rows that violate a unique key,
+ * dialects supporting it must override this method
+ *
+ * @param string $sqlInsert
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect, upsert){
+
+	zval *sql_insert, *update_fields, *conflict_fields = NULL;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 1, &sql_insert, &update_fields, &conflict_fields);
+	
+	PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Updating duplicated rows is not supported by this database system");
+	return;
+}
+
+/**
+ * Escapes a column/table name with the escape char of the database system, the escape char
+ * is doubled inside the name. Names are returned as they are when identifiers are not escaped
+ * (phalcon.db.escape_identifiers)
+ *
+ *<code>
+ * echo $dialect->escapeIdentifier('robots'); // `robots` in MySQL
+ *</code>
+ *
+ * @param string $identifier
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect, escapeIdentifier){
+
+	zval *identifier, *escape_char, *double_escape_char, *name, *escaped;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &identifier);
+	
+	if (!PHALCON_GLOBAL(db).escape_identifiers) {
+		RETURN_CCTOR(identifier);
+	}
+	
+	PHALCON_OBS_VAR(escape_char);
+	phalcon_read_property_this(&escape_char, this_ptr, SL("_escapeChar"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(name);
+	if (Z_TYPE_P(identifier) == IS_STRING && PHALCON_IS_NOT_EMPTY(escape_char)) {
+		PHALCON_INIT_VAR(double_escape_char);
+		PHALCON_CONCAT_VV(double_escape_char, escape_char, escape_char);
+		phalcon_fast_str_replace(name, escape_char, double_escape_char, identifier TSRMLS_CC);
+	} else {
+		ZVAL_ZVAL(name, identifier, 1, 0);
+	}
+	
+	PHALCON_INIT_VAR(escaped);
+	PHALCON_CONCAT_VVV(escaped, escape_char, name, escape_char);
+	
+	RETURN_CTOR(escaped);
+}
+
 /**
  * Gets a list of columns with escaped identifiers
  *
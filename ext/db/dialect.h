@@ -24,6 +24,8 @@ PHALCON_INIT_CLASS(Phalcon_Db_Dialect);
 PHP_METHOD(Phalcon_Db_Dialect, limit);
 PHP_METHOD(Phalcon_Db_Dialect, forUpdate);
 PHP_METHOD(Phalcon_Db_Dialect, sharedLock);
+PHP_METHOD(Phalcon_Db_Dialect, upsert);
+PHP_METHOD(Phalcon_Db_Dialect, escapeIdentifier);
 PHP_METHOD(Phalcon_Db_Dialect, getColumnList);
 PHP_METHOD(Phalcon_Db_Dialect, getSqlExpression);
 PHP_METHOD(Phalcon_Db_Dialect, getSqlTable);
@@ -42,6 +44,16 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_sharedlock, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlQuery)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_upsert, 0, 0, 2)
+	ZEND_ARG_INFO(0, sqlInsert)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, conflictFields)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_escapeidentifier, 0, 0, 1)
+	ZEND_ARG_INFO(0, identifier)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_getcolumnlist, 0, 0, 1)
 	ZEND_ARG_INFO(0, columnList)
 ZEND_END_ARG_INFO()
@@ -64,6 +76,8 @@ PHALCON_INIT_FUNCS(phalcon_db_dialect_method_entry){
 	PHP_ME(Phalcon_Db_Dialect, limit, arginfo_phalcon_db_dialect_limit, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, forUpdate, arginfo_phalcon_db_dialect_forupdate, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, sharedLock, arginfo_phalcon_db_dialect_sharedlock, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect, upsert, arginfo_phalcon_db_dialect_upsert, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Dialect, escapeIdentifier, arginfo_phalcon_db_dialect_escapeidentifier, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, getColumnList, arginfo_phalcon_db_dialect_getcolumnlist, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, getSqlExpression, arginfo_phalcon_db_dialect_getsqlexpression, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Dialect, getSqlTable, arginfo_phalcon_db_dialect_getsqltable, ZEND_ACC_PUBLIC) 
@@ -1077,3 +1077,62 @@ PHP_METHOD(Phalcon_Db_Dialect_Mysql, tableOptions){
 	RETURN_CTOR(sql);
 }
 
+
+/**
+ * Returns a multi-row INSERT modified with an ON DUPLICATE KEY UPDATE clause
+ *
+ *<code>
+ * $sql = $dialect->upsert('INSERT INTO `robots` (`name`, `year`) VALUES (?, ?)', array('year'));
+ * echo $sql; // INSERT INTO `robots` (`name`, `year`) VALUES (?, ?) ON DUPLICATE KEY UPDATE `year` = VALUES(`year`)
+ *</code>
+ *
+ * @param string $sqlInsert
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, upsert){
+
+	zval *sql_insert, *update_fields, *conflict_fields = NULL;
+	zval *assignments, *field = NULL, *escaped_field = NULL, *assignment = NULL;
+	zval *joined_assignments, *sql;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 1, &sql_insert, &update_fields, &conflict_fields);
+	
+	if (Z_TYPE_P(update_fields) != IS_ARRAY || !phalcon_fast_count_ev(update_fields TSRMLS_CC)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "At least one field to update is required");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(assignments);
+	array_init(assignments);
+	
+	phalcon_is_iterable(update_fields, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(field);
+	
+		PHALCON_INIT_NVAR(escaped_field);
+		PHALCON_CALL_METHOD_PARAMS_1(escaped_field, this_ptr, "escapeidentifier", field);
+	
+		PHALCON_INIT_NVAR(assignment);
+		PHALCON_CONCAT_VSVS(assignment, escaped_field, " = VALUES(", escaped_field, ")");
+		phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(joined_assignments);
+	phalcon_fast_join_str(joined_assignments, SL(", "), assignments TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CONCAT_VSV(sql, sql_insert, " ON DUPLICATE KEY UPDATE ", joined_assignments);
+	
+	RETURN_CTOR(sql);
+}
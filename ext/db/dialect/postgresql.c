@@ -37,6 +37,8 @@
 #include "kernel/fcall.h"
 #include "kernel/operators.h"
 #include "kernel/concat.h"
+#include "kernel/array.h"
+#include "kernel/string.h"
 
 /**
  * Phalcon\Db\Dialect\Postgresql
@@ -609,3 +611,100 @@ PHP_METHOD(Phalcon_Db_Dialect_Postgresql, tableOptions){
 	RETURN_EMPTY_STRING();
 }
 
+
+/**
+ * Returns a multi-row INSERT modified with an ON CONFLICT clause, duplicated rows are
+ * ignored when there are no fields to update
+ *
+ *<code>
+ * $sql = $dialect->upsert('INSERT INTO "robots" ("name", "year") VALUES (?, ?)', array('year'), array('name'));
+ * echo $sql; // INSERT INTO "robots" ("name", "year") VALUES (?, ?) ON CONFLICT ("name") DO UPDATE SET "year" = EXCLUDED."year"
+ *</code>
+ *
+ * @param string $sqlInsert
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, upsert){
+
+	zval *sql_insert, *update_fields, *conflict_fields = NULL;
+	zval *columns, *field = NULL, *column = NULL, *joined_columns;
+	zval *assignments, *assignment = NULL, *joined_assignments;
+	zval *sql = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 1, &sql_insert, &update_fields, &conflict_fields);
+	
+	if (!conflict_fields) {
+		PHALCON_INIT_VAR(conflict_fields);
+	}
+	
+	PHALCON_INIT_VAR(columns);
+	array_init(columns);
+	
+	if (Z_TYPE_P(conflict_fields) == IS_ARRAY) { 
+	
+		phalcon_is_iterable(conflict_fields, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(field);
+	
+			PHALCON_INIT_NVAR(column);
+			PHALCON_CALL_METHOD_PARAMS_1(column, this_ptr, "escapeidentifier", field);
+			phalcon_array_append(&columns, column, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	}
+	
+	PHALCON_INIT_VAR(joined_columns);
+	phalcon_fast_join_str(joined_columns, SL(", "), columns TSRMLS_CC);
+	
+	if (Z_TYPE_P(update_fields) != IS_ARRAY || !phalcon_fast_count_ev(update_fields TSRMLS_CC)) {
+		PHALCON_INIT_VAR(sql);
+		if (phalcon_fast_count_ev(columns TSRMLS_CC)) {
+			PHALCON_CONCAT_VSVS(sql, sql_insert, " ON CONFLICT (", joined_columns, ") DO NOTHING");
+		} else {
+			PHALCON_CONCAT_VS(sql, sql_insert, " ON CONFLICT DO NOTHING");
+		}
+		RETURN_CTOR(sql);
+	}
+	
+	if (!phalcon_fast_count_ev(columns TSRMLS_CC)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The columns of the unique key in conflict are required to update duplicated rows");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(assignments);
+	array_init(assignments);
+	
+	phalcon_is_iterable(update_fields, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(field);
+	
+		PHALCON_INIT_NVAR(column);
+		PHALCON_CALL_METHOD_PARAMS_1(column, this_ptr, "escapeidentifier", field);
+	
+		PHALCON_INIT_NVAR(assignment);
+		PHALCON_CONCAT_VSV(assignment, column, " = EXCLUDED.", column);
+		phalcon_array_append(&assignments, assignment, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah1, &hp1);
+	}
+	
+	PHALCON_INIT_VAR(joined_assignments);
+	phalcon_fast_join_str(joined_assignments, SL(", "), assignments TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CONCAT_VSVSV(sql, sql_insert, " ON CONFLICT (", joined_columns, ") DO UPDATE SET ", joined_assignments);
+	
+	RETURN_CTOR(sql);
+}
@@ -62,6 +62,24 @@ PHALCON_DOC_METHOD(Phalcon_Db_DialectInterface, forUpdate);
  */
 PHALCON_DOC_METHOD(Phalcon_Db_DialectInterface, sharedLock);
 
+/**
+ * Returns a multi-row INSERT modified to update the rows that violate a unique key
+ *
+ * @param string $sqlInsert
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHALCON_DOC_METHOD(Phalcon_Db_DialectInterface, upsert);
+
+/**
+ * Escapes a column/table name with the escape char of the database system
+ *
+ * @param string $identifier
+ * @return string
+ */
+PHALCON_DOC_METHOD(Phalcon_Db_DialectInterface, escapeIdentifier);
+
 /**
  * Builds a SELECT statement
  *
@@ -29,12 +29,18 @@
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
 
+#include "ext/standard/php_smart_str.h"
+
+#include <time.h>
+
 #include "kernel/main.h"
 #include "kernel/memory.h"
 
 #include "kernel/fcall.h"
 #include "kernel/object.h"
 #include "kernel/operators.h"
+#include "kernel/array.h"
+#include "kernel/exception.h"
 
 /**
  * Phalcon\Db\Profiler
@@ -68,8 +74,26 @@
  *
  *</code>
  *
+ * In native mode no profile objects are created, statements are aggregated by their
+ * fingerprint, the SQL with its literals replaced by placeholders, keeping the number of
+ * executions, the time spent with its percentiles and the rows reported to stopProfile().
+ * Only the slowest statements are kept entirely
+ *
+ *<code>
+ *
+ *	$profiler = new Phalcon\Db\Profiler(array(
+ *		'native' => true,
+ *		'slowest' => 10
+ *	));
+ *
+ *	//At the end of the request
+ *	file_put_contents('/var/log/app/sql.json', $profiler->toJson() . PHP_EOL, FILE_APPEND);
+ *
+ *</code>
  */
 
+/** Number of sub-buckets per power of two in the histograms, the error is under 1/16 */
+#define PHALCON_DB_PROFILER_SUB_BUCKETS 16
 
 /**
  * Phalcon\Db\Profiler initializer
@@ -81,10 +105,496 @@ PHALCON_INIT_CLASS(Phalcon_Db_Profiler){
 	zend_declare_property_null(phalcon_db_profiler_ce, SL("_allProfiles"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_db_profiler_ce, SL("_activeProfile"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_long(phalcon_db_profiler_ce, SL("_totalSeconds"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_db_profiler_ce, SL("_native"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_profiler_ce, SL("_slowestSize"), 10, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_profiler_ce, SL("_activeStatement"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_profiler_ce, SL("_activeStart"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_db_profiler_ce, SL("_numberStatements"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_profiler_ce, SL("_statistics"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_profiler_ce, SL("_slowest"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
 
+/**
+ * Returns a monotonic time in microseconds, the wall clock is used where there is none
+ */
+static double phalcon_db_profiler_now(void){
+
+	struct timeval tp = {0};
+
+#if defined(CLOCK_MONOTONIC) && !defined(PHP_WIN32)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+	}
+#endif
+
+	gettimeofday(&tp, NULL);
+	return (double) tp.tv_sec * 1000000.0 + tp.tv_usec;
+}
+
+/**
+ * Returns an array property of the profiler ready to be modified
+ */
+static zval *phalcon_db_profiler_array(zval *this_ptr, char *name, int name_length TSRMLS_DC){
+
+	zval *value, *copy;
+
+	value = zend_read_property(phalcon_db_profiler_ce, this_ptr, name, name_length, 1 TSRMLS_CC);
+	if (Z_TYPE_P(value) == IS_ARRAY && Z_REFCOUNT_P(value) == 1) {
+		return value;
+	}
+
+	MAKE_STD_ZVAL(copy);
+	if (Z_TYPE_P(value) == IS_ARRAY) {
+		ZVAL_ZVAL(copy, value, 1, 0);
+	} else {
+		array_init(copy);
+	}
+
+	zend_update_property(phalcon_db_profiler_ce, this_ptr, name, name_length, copy TSRMLS_CC);
+	zval_ptr_dtor(&copy);
+
+	return zend_read_property(phalcon_db_profiler_ce, this_ptr, name, name_length, 1 TSRMLS_CC);
+}
+
+/**
+ * Returns an element of an array ready to be modified, NULL is returned if it does not exist
+ */
+static zval *phalcon_db_profiler_counter(zval *entry, char *name, uint name_length){
+
+	zval **value;
+
+	if (zend_hash_find(Z_ARRVAL_P(entry), name, name_length, (void **) &value) == FAILURE) {
+		return NULL;
+	}
+
+	SEPARATE_ZVAL(value);
+	return *value;
+}
+
+/**
+ * Appends a placeholder to a fingerprint, lists of placeholders are collapsed into one
+ */
+static void phalcon_db_profiler_placeholder(smart_str *fingerprint){
+
+	size_t length = fingerprint->len;
+
+	while (length && fingerprint->c[length - 1] == ' ') {
+		length--;
+	}
+
+	if (length && fingerprint->c[length - 1] == ',') {
+		length--;
+		while (length && fingerprint->c[length - 1] == ' ') {
+			length--;
+		}
+		if (length && fingerprint->c[length - 1] == '?') {
+			fingerprint->len = length;
+			return;
+		}
+	}
+
+	smart_str_appendc(fingerprint, '?');
+}
+
+/**
+ * Normalizes a SQL statement so the executions of the same statement with different values
+ * share a fingerprint: literals are replaced by placeholders, comments are removed and the
+ * whitespace is collapsed
+ */
+static void phalcon_db_profiler_fingerprint(smart_str *fingerprint, const char *sql, int length){
+
+	int i = 0, space = 0;
+	char ch, previous;
+
+	while (i < length) {
+
+		ch = sql[i];
+
+		if (ch == '/' && i + 1 < length && sql[i + 1] == '*') {
+			i += 2;
+			while (i + 1 < length && !(sql[i] == '*' && sql[i + 1] == '/')) {
+				i++;
+			}
+			i += 2;
+			space = 1;
+			continue;
+		}
+
+		if (ch == '-' && i + 1 < length && sql[i + 1] == '-') {
+			while (i < length && sql[i] != '\n') {
+				i++;
+			}
+			space = 1;
+			continue;
+		}
+
+		if (isspace((unsigned char) ch)) {
+			space = 1;
+			i++;
+			continue;
+		}
+
+		if (space) {
+			if (fingerprint->len) {
+				smart_str_appendc(fingerprint, ' ');
+			}
+			space = 0;
+		}
+
+		/**
+		 * String literals, quotes are escaped doubling them or with a backslash
+		 */
+		if (ch == '\'') {
+			i++;
+			while (i < length) {
+				if (sql[i] == '\\' && i + 1 < length) {
+					i += 2;
+					continue;
+				}
+				if (sql[i] == '\'') {
+					if (i + 1 < length && sql[i + 1] == '\'') {
+						i += 2;
+						continue;
+					}
+					break;
+				}
+				i++;
+			}
+			i++;
+			phalcon_db_profiler_placeholder(fingerprint);
+			continue;
+		}
+
+		/**
+		 * Numeric literals, digits that are part of an identifier are kept
+		 */
+		if (isdigit((unsigned char) ch)) {
+			previous = fingerprint->len ? fingerprint->c[fingerprint->len - 1] : ' ';
+			if (!isalnum((unsigned char) previous) && previous != '_' && previous != '$' && previous != ':') {
+				while (i < length && (isalnum((unsigned char) sql[i]) || sql[i] == '.')) {
+					i++;
+				}
+				phalcon_db_profiler_placeholder(fingerprint);
+				continue;
+			}
+		}
+
+		if (ch == '?') {
+			i++;
+			phalcon_db_profiler_placeholder(fingerprint);
+			continue;
+		}
+
+		smart_str_appendc(fingerprint, ch);
+		i++;
+	}
+
+	smart_str_0(fingerprint);
+}
+
+/**
+ * Returns the histogram bucket of a time in microseconds, times under 16 microseconds have
+ * their own bucket and every power of two above is split in 16 buckets
+ */
+static long phalcon_db_profiler_bucket(long value){
+
+	long exponent = 4;
+
+	if (value < PHALCON_DB_PROFILER_SUB_BUCKETS) {
+		return value < 0 ? 0 : value;
+	}
+
+	while (value >> (exponent + 1)) {
+		exponent++;
+	}
+
+	return (exponent - 3) * PHALCON_DB_PROFILER_SUB_BUCKETS + ((value >> (exponent - 4)) & (PHALCON_DB_PROFILER_SUB_BUCKETS - 1));
+}
+
+/**
+ * Returns the highest time in microseconds counted in a histogram bucket
+ */
+static long phalcon_db_profiler_highest(long bucket){
+
+	long exponent, sub_bucket;
+
+	if (bucket < PHALCON_DB_PROFILER_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	exponent = bucket / PHALCON_DB_PROFILER_SUB_BUCKETS + 3;
+	sub_bucket = bucket % PHALCON_DB_PROFILER_SUB_BUCKETS;
+
+	return ((PHALCON_DB_PROFILER_SUB_BUCKETS + sub_bucket + 1) << (exponent - 4)) - 1;
+}
+
+static int phalcon_db_profiler_compare_buckets(const void *a, const void *b){
+
+	long first = ((const long *) a)[0], second = ((const long *) b)[0];
+
+	return first < second ? -1 : (first > second ? 1 : 0);
+}
+
+/**
+ * Adds the percentiles of a histogram to an array, in seconds
+ */
+static void phalcon_db_profiler_percentiles(zval *return_value, HashTable *histogram, long count, long maximum){
+
+	static const double percentiles[] = { 50.0, 95.0, 99.0 };
+	static const char *names[] = { "p50", "p95", "p99" };
+
+	zval **value;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+	long *buckets, accumulated = 0, rank, highest;
+	int i = 0, j = 0, size;
+
+	size = zend_hash_num_elements(histogram);
+	buckets = safe_emalloc(size ? size : 1, 2 * sizeof(long), 0);
+
+	zend_hash_internal_pointer_reset_ex(histogram, &pos);
+	while (zend_hash_get_current_data_ex(histogram, (void **) &value, &pos) == SUCCESS) {
+		if (zend_hash_get_current_key_ex(histogram, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_LONG) {
+			buckets[i * 2] = index;
+			buckets[i * 2 + 1] = Z_LVAL_PP(value);
+			i++;
+		}
+		zend_hash_move_forward_ex(histogram, &pos);
+	}
+	size = i;
+
+	qsort(buckets, size, 2 * sizeof(long), phalcon_db_profiler_compare_buckets);
+
+	for (i = 0; i < 3; i++) {
+
+		rank = (long) (percentiles[i] / 100.0 * count + 0.999999);
+		if (rank < 1) {
+			rank = 1;
+		}
+
+		highest = 0;
+		while (j < size) {
+			if (accumulated + buckets[j * 2 + 1] >= rank) {
+				highest = phalcon_db_profiler_highest(buckets[j * 2]);
+				break;
+			}
+			accumulated += buckets[j * 2 + 1];
+			j++;
+		}
+
+		if (j >= size || highest > maximum) {
+			highest = maximum;
+		}
+
+		add_assoc_double(return_value, (char *) names[i], highest / 1000000.0);
+	}
+
+	efree(buckets);
+}
+
+/**
+ * Aggregates the active statement of a native profiler
+ */
+static void phalcon_db_profiler_aggregate(zval *this_ptr, zval *rows TSRMLS_DC){
+
+	zval *sql_statement, *start, *total_seconds, *slowest_size, *statistics, **entry_pp;
+	zval *entry, *histogram, *counter, *slowest, **item, **elapsed_pp, *slow_item;
+	smart_str fingerprint = {0};
+	HashPosition pos;
+	double elapsed, minimum = -1;
+	long micro, bucket, size;
+	ulong index, minimum_index = 0;
+	char *key, *slow_key;
+	uint key_length, slow_key_length;
+
+	sql_statement = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_activeStatement"), 1 TSRMLS_CC);
+	start = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_activeStart"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(sql_statement) != IS_STRING || Z_TYPE_P(start) != IS_DOUBLE) {
+		return;
+	}
+
+	elapsed = phalcon_db_profiler_now() - Z_DVAL_P(start);
+	if (elapsed < 0) {
+		elapsed = 0;
+	}
+	micro = (long) elapsed;
+
+	phalcon_db_profiler_fingerprint(&fingerprint, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement));
+	if (fingerprint.c) {
+		key = fingerprint.c;
+		key_length = fingerprint.len + 1;
+	} else {
+		key = "";
+		key_length = 1;
+	}
+
+	statistics = phalcon_db_profiler_array(this_ptr, SL("_statistics") TSRMLS_CC);
+	if (zend_symtable_find(Z_ARRVAL_P(statistics), key, key_length, (void **) &entry_pp) == SUCCESS && Z_TYPE_PP(entry_pp) == IS_ARRAY) {
+		SEPARATE_ZVAL(entry_pp);
+		entry = *entry_pp;
+	} else {
+		MAKE_STD_ZVAL(entry);
+		array_init_size(entry, 8);
+		add_assoc_long(entry, "count", 0);
+		add_assoc_double(entry, "total", 0);
+		add_assoc_long(entry, "min", micro);
+		add_assoc_long(entry, "max", 0);
+		add_assoc_long(entry, "rows", 0);
+
+		MAKE_STD_ZVAL(histogram);
+		array_init(histogram);
+		add_assoc_zval(entry, "histogram", histogram);
+
+		zend_symtable_update(Z_ARRVAL_P(statistics), key, key_length, &entry, sizeof(zval *), NULL);
+	}
+
+	if ((counter = phalcon_db_profiler_counter(entry, SS("count"))) != NULL) {
+		Z_LVAL_P(counter)++;
+	}
+	if ((counter = phalcon_db_profiler_counter(entry, SS("total"))) != NULL) {
+		Z_DVAL_P(counter) += elapsed;
+	}
+	if ((counter = phalcon_db_profiler_counter(entry, SS("min"))) != NULL && micro < Z_LVAL_P(counter)) {
+		Z_LVAL_P(counter) = micro;
+	}
+	if ((counter = phalcon_db_profiler_counter(entry, SS("max"))) != NULL && micro > Z_LVAL_P(counter)) {
+		Z_LVAL_P(counter) = micro;
+	}
+	if (rows && Z_TYPE_P(rows) != IS_NULL) {
+		if ((counter = phalcon_db_profiler_counter(entry, SS("rows"))) != NULL) {
+			Z_LVAL_P(counter) += phalcon_get_intval(rows);
+		}
+	}
+
+	if ((histogram = phalcon_db_profiler_counter(entry, SS("histogram"))) != NULL) {
+		bucket = phalcon_db_profiler_bucket(micro);
+		if (zend_hash_index_find(Z_ARRVAL_P(histogram), bucket, (void **) &item) == SUCCESS) {
+			SEPARATE_ZVAL(item);
+			Z_LVAL_PP(item)++;
+		} else {
+			add_index_long(histogram, bucket, 1);
+		}
+	}
+
+	/**
+	 * Only the slowest statements are kept, the fastest of them is replaced when it is full
+	 */
+	slowest_size = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_slowestSize"), 1 TSRMLS_CC);
+	size = phalcon_get_intval(slowest_size);
+	if (size > 0) {
+
+		slowest = phalcon_db_profiler_array(this_ptr, SL("_slowest") TSRMLS_CC);
+
+		if ((long) zend_hash_num_elements(Z_ARRVAL_P(slowest)) >= size) {
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(slowest), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(slowest), (void **) &item, &pos) == SUCCESS) {
+				if (zend_hash_find(Z_ARRVAL_PP(item), SS("elapsed"), (void **) &elapsed_pp) == SUCCESS) {
+					if (minimum < 0 || Z_DVAL_PP(elapsed_pp) < minimum) {
+						minimum = Z_DVAL_PP(elapsed_pp);
+						zend_hash_get_current_key_ex(Z_ARRVAL_P(slowest), &slow_key, &slow_key_length, &index, 0, &pos);
+						minimum_index = index;
+					}
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_P(slowest), &pos);
+			}
+		}
+
+		if (minimum < 0 || elapsed / 1000000.0 > minimum) {
+
+			MAKE_STD_ZVAL(slow_item);
+			array_init_size(slow_item, 3);
+			Z_ADDREF_P(sql_statement);
+			add_assoc_zval(slow_item, "sqlStatement", sql_statement);
+			add_assoc_stringl(slow_item, "fingerprint", key, key_length - 1, 1);
+			add_assoc_double(slow_item, "elapsed", elapsed / 1000000.0);
+
+			if (minimum < 0) {
+				add_next_index_zval(slowest, slow_item);
+			} else {
+				add_index_zval(slowest, minimum_index, slow_item);
+			}
+		}
+	}
+
+	smart_str_free(&fingerprint);
+
+	total_seconds = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_totalSeconds"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(total_seconds) == IS_DOUBLE) {
+		elapsed = Z_DVAL_P(total_seconds) + elapsed / 1000000.0;
+	} else {
+		elapsed = phalcon_get_intval(total_seconds) + elapsed / 1000000.0;
+	}
+	zend_update_property_double(phalcon_db_profiler_ce, this_ptr, SL("_totalSeconds"), elapsed TSRMLS_CC);
+
+	phalcon_property_incr(this_ptr, SL("_numberStatements") TSRMLS_CC);
+	zend_update_property_null(phalcon_db_profiler_ce, this_ptr, SL("_activeStart") TSRMLS_CC);
+}
+
+/**
+ * Sorts the slowest statements from the slowest one
+ */
+static int phalcon_db_profiler_compare_slowest(const void *a, const void *b TSRMLS_DC){
+
+	Bucket *first = *((Bucket **) a), *second = *((Bucket **) b);
+	zval **first_item = (zval **) first->pData, **second_item = (zval **) second->pData;
+	zval **first_elapsed, **second_elapsed;
+
+	if (Z_TYPE_PP(first_item) != IS_ARRAY || zend_hash_find(Z_ARRVAL_PP(first_item), SS("elapsed"), (void **) &first_elapsed) == FAILURE) {
+		return 1;
+	}
+	if (Z_TYPE_PP(second_item) != IS_ARRAY || zend_hash_find(Z_ARRVAL_PP(second_item), SS("elapsed"), (void **) &second_elapsed) == FAILURE) {
+		return -1;
+	}
+
+	if (Z_DVAL_PP(first_elapsed) > Z_DVAL_PP(second_elapsed)) {
+		return -1;
+	}
+
+	return Z_DVAL_PP(first_elapsed) < Z_DVAL_PP(second_elapsed) ? 1 : 0;
+}
+
+/**
+ * Phalcon\Db\Profiler constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Db_Profiler, __construct){
+
+	zval *options = NULL, *native, *slowest;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 0, 1, &options);
+	
+	if (options && Z_TYPE_P(options) != IS_NULL) {
+	
+		if (Z_TYPE_P(options) != IS_ARRAY) { 
+			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Options must be an array");
+			return;
+		}
+	
+		if (phalcon_array_isset_string(options, SS("native"))) {
+			PHALCON_OBS_VAR(native);
+			phalcon_array_fetch_string(&native, options, SL("native"), PH_NOISY_CC);
+			phalcon_update_property_bool(this_ptr, SL("_native"), zend_is_true(native) TSRMLS_CC);
+		}
+	
+		if (phalcon_array_isset_string(options, SS("slowest"))) {
+			PHALCON_OBS_VAR(slowest);
+			phalcon_array_fetch_string(&slowest, options, SL("slowest"), PH_NOISY_CC);
+			phalcon_update_property_long(this_ptr, SL("_slowestSize"), phalcon_get_intval(slowest) TSRMLS_CC);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Starts the profile of a SQL sentence
  *
@@ -93,13 +603,24 @@ PHALCON_INIT_CLASS(Phalcon_Db_Profiler){
  */
 PHP_METHOD(Phalcon_Db_Profiler, startProfile){
 
-	zval *sql_statement, *active_profile, *micro;
+	zval *sql_statement, *native, *active_profile, *micro;
 	zval *time;
 
 	PHALCON_MM_GROW();
 
 	phalcon_fetch_params(1, 1, 0, &sql_statement);
 	
+	/** 
+	 * Native profiles only keep the statement and the time it started
+	 */
+	PHALCON_OBS_VAR(native);
+	phalcon_read_property_this(&native, this_ptr, SL("_native"), PH_NOISY_CC);
+	if (zend_is_true(native)) {
+		phalcon_update_property_this(this_ptr, SL("_activeStatement"), sql_statement TSRMLS_CC);
+		zend_update_property_double(phalcon_db_profiler_ce, this_ptr, SL("_activeStart"), phalcon_db_profiler_now() TSRMLS_CC);
+		RETURN_THIS();
+	}
+	
 	PHALCON_INIT_VAR(active_profile);
 	object_init_ex(active_profile, phalcon_db_profiler_item_ce);
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(active_profile, "setsqlstatement", sql_statement);
@@ -120,17 +641,28 @@ PHP_METHOD(Phalcon_Db_Profiler, startProfile){
 }
 
 /**
- * Stops the active profile
+ * Stops the active profile, native profilers add the number of rows passed to the statistics
+ * of the statement
  *
+ * @param int $rows
  * @return Phalcon\Db\Profiler
  */
 PHP_METHOD(Phalcon_Db_Profiler, stopProfile){
 
-	zval *micro, *final_time, *active_profile, *initial_time;
+	zval *rows = NULL, *native, *micro, *final_time, *active_profile, *initial_time;
 	zval *diference, *total_seconds, *new_total_seconds;
 
 	PHALCON_MM_GROW();
 
+	phalcon_fetch_params(1, 0, 1, &rows);
+	
+	PHALCON_OBS_VAR(native);
+	phalcon_read_property_this(&native, this_ptr, SL("_native"), PH_NOISY_CC);
+	if (zend_is_true(native)) {
+		phalcon_db_profiler_aggregate(this_ptr, rows TSRMLS_CC);
+		RETURN_THIS();
+	}
+	
 	PHALCON_INIT_VAR(micro);
 	ZVAL_BOOL(micro, 1);
 	
@@ -169,10 +701,18 @@ PHP_METHOD(Phalcon_Db_Profiler, stopProfile){
  */
 PHP_METHOD(Phalcon_Db_Profiler, getNumberTotalStatements){
 
-	zval *all_profiles, *number_profiles;
+	zval *native, *all_profiles, *number_profiles;
 
 	PHALCON_MM_GROW();
 
+	PHALCON_OBS_VAR(native);
+	phalcon_read_property_this(&native, this_ptr, SL("_native"), PH_NOISY_CC);
+	if (zend_is_true(native)) {
+		PHALCON_OBS_VAR(number_profiles);
+		phalcon_read_property_this(&number_profiles, this_ptr, SL("_numberStatements"), PH_NOISY_CC);
+		RETURN_CCTOR(number_profiles);
+	}
+	
 	PHALCON_OBS_VAR(all_profiles);
 	phalcon_read_property_this(&all_profiles, this_ptr, SL("_allProfiles"), PH_NOISY_CC);
 	
@@ -217,6 +757,10 @@ PHP_METHOD(Phalcon_Db_Profiler, reset){
 	PHALCON_INIT_VAR(empty_arr);
 	array_init(empty_arr);
 	phalcon_update_property_this(this_ptr, SL("_allProfiles"), empty_arr TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_statistics") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_slowest") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_numberStatements"), 0 TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_totalSeconds"), 0 TSRMLS_CC);
 	RETURN_THIS();
 }
 
@@ -231,3 +775,138 @@ PHP_METHOD(Phalcon_Db_Profiler, getLastProfile){
 	RETURN_MEMBER(this_ptr, "_activeProfile");
 }
 
+/**
+ * Returns the statistics of a native profiler by statement fingerprint, times are in seconds
+ *
+ *<code>
+ *	foreach ($profiler->getStatistics() as $fingerprint => $statistics) {
+ *		echo $fingerprint, ' ', $statistics['count'], ' ', $statistics['p95'], PHP_EOL;
+ *	}
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Profiler, getStatistics){
+
+	zval *statistics, **entry, **value, **histogram, *item;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+	long count;
+	double total;
+
+	statistics = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_statistics"), 1 TSRMLS_CC);
+
+	array_init(return_value);
+
+	if (Z_TYPE_P(statistics) != IS_ARRAY) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(statistics), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(statistics), (void **) &entry, &pos) == SUCCESS) {
+
+		if (Z_TYPE_PP(entry) == IS_ARRAY && zend_hash_get_current_key_ex(Z_ARRVAL_P(statistics), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+
+			MAKE_STD_ZVAL(item);
+			array_init_size(item, 9);
+
+			count = zend_hash_find(Z_ARRVAL_PP(entry), SS("count"), (void **) &value) == SUCCESS ? Z_LVAL_PP(value) : 0;
+			total = zend_hash_find(Z_ARRVAL_PP(entry), SS("total"), (void **) &value) == SUCCESS ? Z_DVAL_PP(value) : 0;
+
+			add_assoc_long(item, "count", count);
+			add_assoc_double(item, "total", total / 1000000.0);
+			add_assoc_double(item, "average", count ? total / count / 1000000.0 : 0);
+
+			if (zend_hash_find(Z_ARRVAL_PP(entry), SS("min"), (void **) &value) == SUCCESS) {
+				add_assoc_double(item, "min", Z_LVAL_PP(value) / 1000000.0);
+			}
+			if (zend_hash_find(Z_ARRVAL_PP(entry), SS("max"), (void **) &value) == SUCCESS) {
+				add_assoc_double(item, "max", Z_LVAL_PP(value) / 1000000.0);
+				if (zend_hash_find(Z_ARRVAL_PP(entry), SS("histogram"), (void **) &histogram) == SUCCESS && Z_TYPE_PP(histogram) == IS_ARRAY) {
+					phalcon_db_profiler_percentiles(item, Z_ARRVAL_PP(histogram), count, Z_LVAL_PP(value));
+				}
+			}
+			if (zend_hash_find(Z_ARRVAL_PP(entry), SS("rows"), (void **) &value) == SUCCESS) {
+				add_assoc_long(item, "rows", Z_LVAL_PP(value));
+			}
+
+			add_assoc_zval_ex(return_value, key, key_length, item);
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(statistics), &pos);
+	}
+}
+
+/**
+ * Returns the slowest statements seen by a native profiler, from the slowest one
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Profiler, getSlowestProfiles){
+
+	zval *slowest, *tmp;
+
+	slowest = zend_read_property(phalcon_db_profiler_ce, this_ptr, SL("_slowest"), 1 TSRMLS_CC);
+
+	array_init(return_value);
+
+	if (Z_TYPE_P(slowest) == IS_ARRAY) {
+		zend_hash_copy(Z_ARRVAL_P(return_value), Z_ARRVAL_P(slowest), (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+		zend_hash_sort(Z_ARRVAL_P(return_value), zend_qsort, phalcon_db_profiler_compare_slowest, 1 TSRMLS_CC);
+	}
+}
+
+/**
+ * Exports the number of statements, the time spent, the statistics by fingerprint and the
+ * slowest statements of a native profiler
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Profiler, toArray){
+
+	zval *number_statements, *total_seconds, *statistics, *slowest;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(number_statements);
+	PHALCON_CALL_METHOD(number_statements, this_ptr, "getnumbertotalstatements");
+	
+	PHALCON_OBS_VAR(total_seconds);
+	phalcon_read_property_this(&total_seconds, this_ptr, SL("_totalSeconds"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(statistics);
+	PHALCON_CALL_METHOD(statistics, this_ptr, "getstatistics");
+	
+	PHALCON_INIT_VAR(slowest);
+	PHALCON_CALL_METHOD(slowest, this_ptr, "getslowestprofiles");
+	
+	array_init_size(return_value, 4);
+	phalcon_array_update_string(&return_value, SL("statements"), &number_statements, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("total"), &total_seconds, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("statistics"), &statistics, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("slowest"), &slowest, PH_COPY TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Exports the profiler as toArray() does encoded as JSON
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Profiler, toJson){
+
+	zval *data, *json;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(data);
+	PHALCON_CALL_METHOD(data, this_ptr, "toarray");
+	
+	PHALCON_INIT_VAR(json);
+	PHALCON_CALL_FUNC_PARAMS_1(json, "json_encode", data);
+	
+	RETURN_CCTOR(json);
+}
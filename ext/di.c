@@ -30,6 +30,8 @@
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
 
+#include <time.h>
+
 #include "kernel/main.h"
 #include "kernel/memory.h"
 
@@ -40,6 +42,8 @@
 #include "kernel/concat.h"
 #include "kernel/file.h"
 #include "kernel/string.h"
+#include "kernel/require.h"
+#include "kernel/persistent.h"
 
 /**
  * Phalcon\DI
@@ -72,6 +76,15 @@
  * $request = $di->getRequest();
  *
  *</code>
+ *
+ * Applications registering many services can compile their definitions, the compiled table is
+ * kept by the process between requests and the services are only created when they are requested
+ *
+ *<code>
+ * $di->setDefinitions('app/config/services.php');
+ *
+ * print_r($di->getStatistics());
+ *</code>
  */
 
 
@@ -84,6 +97,8 @@ PHALCON_INIT_CLASS(Phalcon_DI){
 
 	zend_declare_property_null(phalcon_di_ce, SL("_services"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_di_ce, SL("_sharedInstances"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_di_ce, SL("_compiled"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_di_ce, SL("_statistics"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_di_ce, SL("_freshInstance"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_di_ce, SL("_default"), ZEND_ACC_PROTECTED|ZEND_ACC_STATIC TSRMLS_CC);
 
@@ -92,6 +107,121 @@ PHALCON_INIT_CLASS(Phalcon_DI){
 	return SUCCESS;
 }
 
+/**
+ * Returns a monotonic time in seconds, the wall clock is used where there is none
+ */
+static double phalcon_di_now(void){
+
+	struct timeval tp = {0};
+
+#if defined(CLOCK_MONOTONIC) && !defined(PHP_WIN32)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec + ts.tv_nsec / 1000000000.0;
+	}
+#endif
+
+	gettimeofday(&tp, NULL);
+	return (double) tp.tv_sec + tp.tv_usec / 1000000.0;
+}
+
+/**
+ * Creates the service of a compiled definition the first time it is requested, services
+ * registered by other means are not replaced
+ */
+static void phalcon_di_lazy_service(zval *this_ptr, zval *name TSRMLS_DC){
+
+	zval *compiled, *services, *service, **entry, **definition, **shared;
+	int is_shared = 0;
+
+	if (Z_TYPE_P(name) != IS_STRING) {
+		return;
+	}
+
+	compiled = zend_read_property(phalcon_di_ce, this_ptr, SL("_compiled"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(compiled) != IS_ARRAY) {
+		return;
+	}
+
+	if (zend_symtable_find(Z_ARRVAL_P(compiled), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &entry) == FAILURE || Z_TYPE_PP(entry) != IS_ARRAY) {
+		return;
+	}
+	if (zend_hash_find(Z_ARRVAL_PP(entry), SS("definition"), (void **) &definition) == FAILURE) {
+		return;
+	}
+
+	services = zend_read_property(phalcon_di_ce, this_ptr, SL("_services"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(services) == IS_ARRAY && zend_symtable_exists(Z_ARRVAL_P(services), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1)) {
+		return;
+	}
+
+	if (zend_hash_find(Z_ARRVAL_PP(entry), SS("shared"), (void **) &shared) == SUCCESS) {
+		is_shared = zend_is_true(*shared);
+	}
+
+	MAKE_STD_ZVAL(service);
+	object_init_ex(service, phalcon_di_service_ce);
+	zend_update_property(phalcon_di_service_ce, service, SL("_name"), name TSRMLS_CC);
+	zend_update_property(phalcon_di_service_ce, service, SL("_definition"), *definition TSRMLS_CC);
+	zend_update_property_bool(phalcon_di_service_ce, service, SL("_shared"), is_shared TSRMLS_CC);
+
+	phalcon_update_property_array(this_ptr, SL("_services"), name, service TSRMLS_CC);
+	zval_ptr_dtor(&service);
+}
+
+/**
+ * Counts an instance built by a service and the seconds it took
+ */
+static void phalcon_di_record(zval *this_ptr, zval *name, double elapsed TSRMLS_DC){
+
+	zval *statistics, *copy, *entry, **current, **value;
+
+	if (Z_TYPE_P(name) != IS_STRING) {
+		return;
+	}
+
+	statistics = zend_read_property(phalcon_di_ce, this_ptr, SL("_statistics"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statistics) != IS_ARRAY || Z_REFCOUNT_P(statistics) != 1) {
+
+		MAKE_STD_ZVAL(copy);
+		if (Z_TYPE_P(statistics) == IS_ARRAY) {
+			ZVAL_ZVAL(copy, statistics, 1, 0);
+		} else {
+			array_init(copy);
+		}
+
+		zend_update_property(phalcon_di_ce, this_ptr, SL("_statistics"), copy TSRMLS_CC);
+		zval_ptr_dtor(&copy);
+
+		statistics = zend_read_property(phalcon_di_ce, this_ptr, SL("_statistics"), 1 TSRMLS_CC);
+	}
+
+	if (zend_symtable_find(Z_ARRVAL_P(statistics), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &current) == SUCCESS && Z_TYPE_PP(current) == IS_ARRAY) {
+
+		SEPARATE_ZVAL(current);
+
+		if (zend_hash_find(Z_ARRVAL_PP(current), SS("instances"), (void **) &value) == SUCCESS) {
+			SEPARATE_ZVAL(value);
+			convert_to_long(*value);
+			Z_LVAL_PP(value)++;
+		}
+		if (zend_hash_find(Z_ARRVAL_PP(current), SS("time"), (void **) &value) == SUCCESS) {
+			SEPARATE_ZVAL(value);
+			convert_to_double(*value);
+			Z_DVAL_PP(value) += elapsed;
+		}
+		return;
+	}
+
+	MAKE_STD_ZVAL(entry);
+	array_init_size(entry, 2);
+	add_assoc_long_ex(entry, SS("instances"), 1);
+	add_assoc_double_ex(entry, SS("time"), elapsed);
+
+	zend_symtable_update(Z_ARRVAL_P(statistics), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &entry, sizeof(zval *), NULL);
+}
+
 /**
  * Phalcon\DI constructor
  *
@@ -196,6 +326,7 @@ PHP_METHOD(Phalcon_DI, remove){
 		return;
 	}
 	phalcon_unset_property_array(this_ptr, SL("_services"), name TSRMLS_CC);
+	phalcon_unset_property_array(this_ptr, SL("_compiled"), name TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -228,6 +359,8 @@ PHP_METHOD(Phalcon_DI, attempt){
 		return;
 	}
 	
+	phalcon_di_lazy_service(this_ptr, name TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(services);
 	phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 	if (!phalcon_array_isset(services, name)) {
@@ -290,6 +423,8 @@ PHP_METHOD(Phalcon_DI, getRaw){
 		return;
 	}
 	
+	phalcon_di_lazy_service(this_ptr, name TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(services);
 	phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 	if (phalcon_array_isset(services, name)) {
@@ -326,6 +461,8 @@ PHP_METHOD(Phalcon_DI, getService){
 		return;
 	}
 	
+	phalcon_di_lazy_service(this_ptr, name TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(services);
 	phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 	if (phalcon_array_isset(services, name)) {
@@ -351,6 +488,8 @@ PHP_METHOD(Phalcon_DI, get){
 
 	zval *name, *parameters = NULL, *services, *service, *instance = NULL;
 	zval *exception_message;
+	double start;
+	int built;
 
 	PHALCON_MM_GROW();
 
@@ -368,6 +507,11 @@ PHP_METHOD(Phalcon_DI, get){
 		return;
 	}
 	
+	/** 
+	 * Compiled services are created the first time they are requested
+	 */
+	phalcon_di_lazy_service(this_ptr, name TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(services);
 	phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 	if (phalcon_array_isset(services, name)) {
@@ -377,8 +521,24 @@ PHP_METHOD(Phalcon_DI, get){
 		PHALCON_OBS_VAR(service);
 		phalcon_array_fetch(&service, services, name, PH_NOISY_CC);
 	
+		/** 
+		 * Shared services already resolved don't build a new instance
+		 */
+		built = 1;
+		if (Z_TYPE_P(service) == IS_OBJECT && instanceof_function(Z_OBJCE_P(service), phalcon_di_service_ce TSRMLS_CC)) {
+			if (zend_is_true(zend_read_property(phalcon_di_service_ce, service, SL("_shared"), 1 TSRMLS_CC))) {
+				built = Z_TYPE_P(zend_read_property(phalcon_di_service_ce, service, SL("_sharedInstance"), 1 TSRMLS_CC)) == IS_NULL;
+			}
+		}
+	
+		start = phalcon_di_now();
+	
 		PHALCON_INIT_VAR(instance);
 		PHALCON_CALL_METHOD_PARAMS_2(instance, service, "resolve", parameters, this_ptr);
+	
+		if (built) {
+			phalcon_di_record(this_ptr, name, phalcon_di_now() - start TSRMLS_CC);
+		}
 	} else {
 		/** 
 		 * The DI also acts as builder for any class even if it isn't defined in the DI
@@ -483,7 +643,7 @@ PHP_METHOD(Phalcon_DI, getShared){
  */
 PHP_METHOD(Phalcon_DI, has){
 
-	zval *name, *services, *is_set_service = NULL;
+	zval *name, *services, *compiled, *is_set_service = NULL;
 	zval *r0 = NULL;
 
 	PHALCON_MM_GROW();
@@ -493,8 +653,11 @@ PHP_METHOD(Phalcon_DI, has){
 	PHALCON_OBS_VAR(services);
 	phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 	
+	PHALCON_OBS_VAR(compiled);
+	phalcon_read_property_this(&compiled, this_ptr, SL("_compiled"), PH_NOISY_CC);
+	
 	PHALCON_INIT_VAR(r0);
-	ZVAL_BOOL(r0, phalcon_array_isset(services, name));
+	ZVAL_BOOL(r0, phalcon_array_isset(services, name) || phalcon_array_isset(compiled, name));
 	PHALCON_CPY_WRT(is_set_service, r0);
 	RETURN_NCTOR(is_set_service);
 }
@@ -511,13 +674,35 @@ PHP_METHOD(Phalcon_DI, wasFreshInstance){
 }
 
 /**
- * Return the services registered in the DI
+ * Return the services registered in the DI, the services of compiled definitions are created
  *
  * @return Phalcon\DI\Service[]
  */
 PHP_METHOD(Phalcon_DI, getServices){
 
+	zval *compiled, *name;
+	HashPosition pos;
+	char *str_key;
+	uint str_key_length;
+	ulong num_key;
 
+	compiled = zend_read_property(phalcon_di_ce, this_ptr, SL("_compiled"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(compiled) == IS_ARRAY) {
+	
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(compiled), &pos);
+		while (zend_hash_has_more_elements_ex(Z_ARRVAL_P(compiled), &pos) == SUCCESS) {
+	
+			if (zend_hash_get_current_key_ex(Z_ARRVAL_P(compiled), &str_key, &str_key_length, &num_key, 0, &pos) == HASH_KEY_IS_STRING) {
+				MAKE_STD_ZVAL(name);
+				ZVAL_STRINGL(name, str_key, str_key_length - 1, 1);
+				phalcon_di_lazy_service(this_ptr, name TSRMLS_CC);
+				zval_ptr_dtor(&name);
+			}
+	
+			zend_hash_move_forward_ex(Z_ARRVAL_P(compiled), &pos);
+		}
+	}
+	
 	RETURN_MEMBER(this_ptr, "_services");
 }
 
@@ -626,14 +811,16 @@ PHP_METHOD(Phalcon_DI, __call){
 	 */
 	if (phalcon_start_with_str(method, SL("get"))) {
 	
-		PHALCON_OBS_VAR(services);
-		phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
-	
 		PHALCON_INIT_VAR(service_name);
 		phalcon_substr(service_name, method, 3, 0 TSRMLS_CC);
 	
 		PHALCON_INIT_VAR(possible_service);
 		PHALCON_CALL_FUNC_PARAMS_1(possible_service, "lcfirst", service_name);
+	
+		phalcon_di_lazy_service(this_ptr, possible_service TSRMLS_CC);
+	
+		PHALCON_OBS_VAR(services);
+		phalcon_read_property_this(&services, this_ptr, SL("_services"), PH_NOISY_CC);
 		if (phalcon_array_isset(services, possible_service)) {
 			if (phalcon_fast_count_ev(arguments TSRMLS_CC)) {
 				PHALCON_INIT_VAR(instance);
@@ -674,6 +861,203 @@ PHP_METHOD(Phalcon_DI, __call){
 	return;
 }
 
+/**
+ * Registers a set of definitions compiled into a table, services are only created when they
+ * are requested. Definitions can be class names or arrays in the syntax of
+ * Phalcon\DI\Service\Builder, the key 'shared' makes the service shared. Closures and
+ * objects cannot be compiled. A path to a file returning the definitions is read once per
+ * process, the compiled table is kept between requests until the file changes. Successive
+ * calls add to the services already compiled
+ *
+ *<code>
+ * $di->setDefinitions(array(
+ *	'request' => 'Phalcon\Http\Request',
+ *	'logger' => array(
+ *		'className' => 'Phalcon\Logger\Adapter\File',
+ *		'arguments' => array(
+ *			array('type' => 'parameter', 'value' => 'app/logs/app.log')
+ *		),
+ *		'shared' => true
+ *	)
+ * ));
+ *
+ * $di->setDefinitions('app/config/services.php');
+ *</code>
+ *
+ * @param array|string $definitions
+ */
+PHP_METHOD(Phalcon_DI, setDefinitions){
+
+	zval *definitions, *path = NULL, *stamp = NULL, *entry = NULL, *cached_stamp;
+	zval *compiled = NULL, *table = NULL, *name = NULL, *definition = NULL;
+	zval *shared = NULL, *service = NULL, *current, *merged;
+	zval *exception_message = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &definitions);
+	
+	if (Z_TYPE_P(definitions) == IS_STRING) {
+	
+		/** 
+		 * Relative paths depend on the working directory and the include path, so the
+		 * compiled tables are stored under the real path of the file
+		 */
+		PHALCON_INIT_VAR(path);
+		phalcon_realpath(path, definitions TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(stamp);
+		if (Z_TYPE_P(path) == IS_STRING) {
+			phalcon_file_stamp(stamp, path TSRMLS_CC);
+		}
+	
+		if (Z_TYPE_P(stamp) != IS_STRING) {
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SVS(exception_message, "Services file '", definitions, "' does not exist");
+			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_di_exception_ce, exception_message);
+			return;
+		}
+	
+		/** 
+		 * The table compiled from a file is reused by every request served by the process
+		 * while the modification time, size and inode of the file are the same
+		 */
+		PHALCON_INIT_VAR(entry);
+		if (phalcon_persistent_cache_fetch(entry, phalcon_di_compiled_cache, Z_STRVAL_P(path), Z_STRLEN_P(path)) == SUCCESS) {
+			if (phalcon_array_isset_string(entry, SS("stamp"))) {
+				PHALCON_OBS_VAR(cached_stamp);
+				phalcon_array_fetch_string(&cached_stamp, entry, SL("stamp"), PH_NOISY_CC);
+				if (PHALCON_IS_EQUAL(cached_stamp, stamp)) {
+					PHALCON_OBS_VAR(compiled);
+					phalcon_array_fetch_string(&compiled, entry, SL("table"), PH_NOISY_CC);
+				}
+			}
+		}
+	
+		if (!compiled) {
+			PHALCON_INIT_VAR(table);
+			if (phalcon_require_ret(table, path TSRMLS_CC) == FAILURE) {
+				return;
+			}
+		}
+	} else {
+		PHALCON_CPY_WRT(table, definitions);
+	}
+	
+	if (!compiled) {
+		if (Z_TYPE_P(table) != IS_ARRAY) { 
+			PHALCON_THROW_EXCEPTION_STR(phalcon_di_exception_ce, "The service definitions must be an array");
+			return;
+		}
+	
+		PHALCON_INIT_VAR(compiled);
+		array_init_size(compiled, zend_hash_num_elements(Z_ARRVAL_P(table)));
+	
+		phalcon_is_iterable(table, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_KEY(name, ah0, hp0);
+			PHALCON_GET_FOREACH_VALUE(definition);
+	
+			if (Z_TYPE_P(name) != IS_STRING) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_di_exception_ce, "The service name must be a string");
+				return;
+			}
+	
+			PHALCON_INIT_NVAR(shared);
+			ZVAL_BOOL(shared, 0);
+	
+			/** 
+			 * Only the class name is checked here, arguments, calls and properties are still
+			 * validated by Phalcon\DI\Service\Builder when the service is built
+			 */
+			if (Z_TYPE_P(definition) == IS_ARRAY) { 
+				if (!phalcon_array_isset_string(definition, SS("className"))) {
+					PHALCON_INIT_NVAR(exception_message);
+					PHALCON_CONCAT_SVS(exception_message, "Invalid definition of the service '", name, "'. Missing 'className' parameter");
+					PHALCON_THROW_EXCEPTION_ZVAL(phalcon_di_exception_ce, exception_message);
+					return;
+				}
+	
+				if (phalcon_array_isset_string(definition, SS("shared"))) {
+					PHALCON_OBS_NVAR(shared);
+					phalcon_array_fetch_string(&shared, definition, SL("shared"), PH_NOISY_CC);
+	
+					PHALCON_SEPARATE(definition);
+					phalcon_array_unset_string(&definition, SS("shared"), 0);
+				}
+			} else {
+				if (Z_TYPE_P(definition) != IS_STRING) {
+					PHALCON_INIT_NVAR(exception_message);
+					PHALCON_CONCAT_SVS(exception_message, "The service '", name, "' cannot be compiled, only class names and array definitions are allowed");
+					PHALCON_THROW_EXCEPTION_ZVAL(phalcon_di_exception_ce, exception_message);
+					return;
+				}
+			}
+	
+			PHALCON_INIT_NVAR(service);
+			array_init_size(service, 2);
+			phalcon_array_update_string(&service, SL("definition"), &definition, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_string_bool(&service, SL("shared"), zend_is_true(shared), PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_zval(&compiled, name, &service, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+		if (path) {
+			PHALCON_INIT_NVAR(entry);
+			array_init_size(entry, 2);
+			phalcon_array_update_string(&entry, SL("stamp"), &stamp, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_string(&entry, SL("table"), &compiled, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_persistent_cache_store(phalcon_di_compiled_cache, Z_STRVAL_P(path), Z_STRLEN_P(path), entry);
+		}
+	}
+	
+	/** 
+	 * Successive calls add to the services already compiled, a service defined again
+	 * replaces the previous definition
+	 */
+	PHALCON_OBS_VAR(current);
+	phalcon_read_property_this(&current, this_ptr, SL("_compiled"), PH_NOISY_CC);
+	if (Z_TYPE_P(current) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(current))) {
+		PHALCON_INIT_VAR(merged);
+		phalcon_fast_array_merge(merged, &current, &compiled TSRMLS_CC);
+		phalcon_update_property_this(this_ptr, SL("_compiled"), merged TSRMLS_CC);
+	} else {
+		phalcon_update_property_this(this_ptr, SL("_compiled"), compiled TSRMLS_CC);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the services that built instances in this request, the number of instances built
+ * and the seconds spent building them
+ *
+ *<code>
+ * foreach ($di->getStatistics() as $name => $statistics) {
+ *	echo $name, ' ', $statistics['instances'], ' ', $statistics['time'], PHP_EOL;
+ * }
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_DI, getStatistics){
+
+	zval *statistics;
+
+	statistics = zend_read_property(phalcon_di_ce, this_ptr, SL("_statistics"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(statistics) == IS_ARRAY) {
+		RETURN_ZVAL(statistics, 1, 0);
+	}
+
+	array_init(return_value);
+}
+
 /**
  * Set a default dependency injection container to be obtained into static methods
  *
@@ -40,6 +40,8 @@ PHP_METHOD(Phalcon_DI, offsetSet);
 PHP_METHOD(Phalcon_DI, offsetGet);
 PHP_METHOD(Phalcon_DI, offsetUnset);
 PHP_METHOD(Phalcon_DI, __call);
+PHP_METHOD(Phalcon_DI, setDefinitions);
+PHP_METHOD(Phalcon_DI, getStatistics);
 PHP_METHOD(Phalcon_DI, setDefault);
 PHP_METHOD(Phalcon_DI, getDefault);
 PHP_METHOD(Phalcon_DI, reset);
@@ -114,6 +116,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_di___call, 0, 0, 1)
 	ZEND_ARG_INFO(0, arguments)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_di_setdefinitions, 0, 0, 1)
+	ZEND_ARG_INFO(0, definitions)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_di_setdefault, 0, 0, 1)
 	ZEND_ARG_INFO(0, dependencyInjector)
 ZEND_END_ARG_INFO()
@@ -137,6 +143,8 @@ PHALCON_INIT_FUNCS(phalcon_di_method_entry){
 	PHP_ME(Phalcon_DI, offsetGet, arginfo_phalcon_di_offsetget, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_DI, offsetUnset, arginfo_phalcon_di_offsetunset, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_DI, __call, arginfo_phalcon_di___call, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_DI, setDefinitions, arginfo_phalcon_di_setdefinitions, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_DI, getStatistics, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_DI, setDefault, arginfo_phalcon_di_setdefault, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_DI, getDefault, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_ME(Phalcon_DI, reset, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
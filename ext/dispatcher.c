@@ -39,6 +39,13 @@
 #include "kernel/concat.h"
 #include "kernel/operators.h"
 #include "kernel/string.h"
+#include "kernel/persistent.h"
+
+/** Methods implemented by a resolved handler */
+#define PHALCON_DISPATCHER_HAS_ACTION 1
+#define PHALCON_DISPATCHER_HAS_INITIALIZE 2
+#define PHALCON_DISPATCHER_HAS_BEFORE_EXECUTE 4
+#define PHALCON_DISPATCHER_HAS_AFTER_EXECUTE 8
 
 /**
  * Phalcon\Dispatcher
@@ -72,6 +79,7 @@ PHALCON_INIT_CLASS(Phalcon_Dispatcher){
 	zend_declare_property_string(phalcon_dispatcher_ce, SL("_defaultAction"), "", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_dispatcher_ce, SL("_handlerSuffix"), "", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_dispatcher_ce, SL("_actionSuffix"), "Action", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_dispatcher_ce, SL("_resolved"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_declare_class_constant_long(phalcon_dispatcher_ce, SL("EXCEPTION_NO_DI"), 0 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_dispatcher_ce, SL("EXCEPTION_CYCLIC_ROUTING"), 1 TSRMLS_CC);
@@ -455,6 +463,48 @@ PHP_METHOD(Phalcon_Dispatcher, getReturnedValue){
 	RETURN_MEMBER(this_ptr, "_returnedValue");
 }
 
+/**
+ * Builds the key used to cache the class name of a handler, NULL is returned if the names
+ * cannot be cached
+ */
+static char *phalcon_dispatcher_key(zval *namespace_name, zval *handler_name, zval *handler_suffix, uint *key_length){
+
+	char *key;
+
+	if (Z_TYPE_P(handler_name) != IS_STRING || Z_TYPE_P(handler_suffix) != IS_STRING) {
+		return NULL;
+	}
+	if (Z_TYPE_P(namespace_name) != IS_STRING && Z_TYPE_P(namespace_name) != IS_NULL) {
+		return NULL;
+	}
+
+	*key_length = spprintf(&key, 0, "%s|%s|%s", Z_TYPE_P(namespace_name) == IS_STRING ? Z_STRVAL_P(namespace_name) : "", Z_STRVAL_P(handler_name), Z_STRVAL_P(handler_suffix));
+	return key;
+}
+
+/**
+ * Checks which of the methods called by the dispatcher are implemented by a handler
+ */
+static long phalcon_dispatcher_flags(zval *handler, zval *action_method TSRMLS_DC){
+
+	long flags = 0;
+
+	if (phalcon_method_exists(handler, action_method TSRMLS_CC) == SUCCESS) {
+		flags |= PHALCON_DISPATCHER_HAS_ACTION;
+	}
+	if (phalcon_method_exists_ex(handler, SS("initialize") TSRMLS_CC) == SUCCESS) {
+		flags |= PHALCON_DISPATCHER_HAS_INITIALIZE;
+	}
+	if (phalcon_method_exists_ex(handler, SS("beforeexecuteroute") TSRMLS_CC) == SUCCESS) {
+		flags |= PHALCON_DISPATCHER_HAS_BEFORE_EXECUTE;
+	}
+	if (phalcon_method_exists_ex(handler, SS("afterexecuteroute") TSRMLS_CC) == SUCCESS) {
+		flags |= PHALCON_DISPATCHER_HAS_AFTER_EXECUTE;
+	}
+
+	return flags;
+}
+
 /**
  * Dispatches a handle action taking into account the routing parameters
  *
@@ -469,7 +519,11 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 	zval *namespace_name = NULL, *handler_name = NULL, *action_name = NULL;
 	zval *finished = NULL, *camelized_class = NULL, *handler_class = NULL;
 	zval *has_service = NULL, *was_fresh = NULL, *params = NULL, *action_method = NULL;
-	zval *call_object = NULL;
+	zval *call_object = NULL, *resolved_key = NULL, *resolved = NULL;
+	zval *resolved_entry = NULL, *resolved_class = NULL, *resolved_flags = NULL;
+	char *key;
+	uint key_length = 0;
+	long flags;
 
 	PHALCON_MM_GROW();
 
@@ -601,42 +655,82 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 		}
 	
 		/** 
-		 * We don't camelize the classes if they are in namespaces
+		 * Handler class names are resolved once per process when phalcon.dispatcher.cache_size is set
 		 */
-		if (!phalcon_memnstr_str(handler_name, SL("\\") TSRMLS_CC)) {
-			PHALCON_INIT_NVAR(camelized_class);
-			phalcon_camelize(camelized_class, handler_name TSRMLS_CC);
-		} else {
-			PHALCON_CPY_WRT(camelized_class, handler_name);
-		}
+		key = phalcon_dispatcher_cache ? phalcon_dispatcher_key(namespace_name, handler_name, handler_suffix, &key_length) : NULL;
 	
-		/** 
-		 * Create the complete controller class name prepending the namespace
-		 */
-		if (zend_is_true(namespace_name)) {
-			if (phalcon_end_with_str(namespace_name, SL("\\"))) {
-				PHALCON_INIT_NVAR(handler_class);
-				PHALCON_CONCAT_VVV(handler_class, namespace_name, camelized_class, handler_suffix);
+		PHALCON_INIT_NVAR(handler_class);
+		if (!key || phalcon_persistent_cache_fetch(handler_class, phalcon_dispatcher_cache, key, key_length) == FAILURE || Z_TYPE_P(handler_class) != IS_STRING) {
+	
+			/** 
+			 * We don't camelize the classes if they are in namespaces
+			 */
+			if (!phalcon_memnstr_str(handler_name, SL("\\") TSRMLS_CC)) {
+				PHALCON_INIT_NVAR(camelized_class);
+				phalcon_camelize(camelized_class, handler_name TSRMLS_CC);
+			} else {
+				PHALCON_CPY_WRT(camelized_class, handler_name);
+			}
+	
+			/** 
+			 * Create the complete controller class name prepending the namespace
+			 */
+			if (zend_is_true(namespace_name)) {
+				if (phalcon_end_with_str(namespace_name, SL("\\"))) {
+					PHALCON_INIT_NVAR(handler_class);
+					PHALCON_CONCAT_VVV(handler_class, namespace_name, camelized_class, handler_suffix);
+				} else {
+					PHALCON_INIT_NVAR(handler_class);
+					PHALCON_CONCAT_VSVV(handler_class, namespace_name, "\\", camelized_class, handler_suffix);
+				}
 			} else {
 				PHALCON_INIT_NVAR(handler_class);
-				PHALCON_CONCAT_VSVV(handler_class, namespace_name, "\\", camelized_class, handler_suffix);
+				PHALCON_CONCAT_VV(handler_class, camelized_class, handler_suffix);
+			}
+	
+			if (key) {
+				phalcon_persistent_cache_store(phalcon_dispatcher_cache, key, key_length, handler_class);
 			}
+		}
+	
+		if (key) {
+			efree(key);
+		}
+	
+		PHALCON_INIT_NVAR(action_method);
+		PHALCON_CONCAT_VV(action_method, action_name, action_suffix);
+	
+		PHALCON_INIT_NVAR(resolved_key);
+		PHALCON_CONCAT_VSV(resolved_key, handler_class, "::", action_method);
+	
+		/** 
+		 * Handlers resolved before in this dispatcher are known to be loadable
+		 */
+		PHALCON_OBS_NVAR(resolved);
+		phalcon_read_property_this(&resolved, this_ptr, SL("_resolved"), PH_NOISY_CC);
+		if (phalcon_array_isset(resolved, resolved_key)) {
+			PHALCON_OBS_NVAR(resolved_entry);
+			phalcon_array_fetch(&resolved_entry, resolved, resolved_key, PH_NOISY_CC);
 		} else {
-			PHALCON_INIT_NVAR(handler_class);
-			PHALCON_CONCAT_VV(handler_class, camelized_class, handler_suffix);
+			PHALCON_INIT_NVAR(resolved_entry);
 		}
 	
 		/** 
 		 * Handlers are retrieved as shared instances from the Service Container
 		 */
-		PHALCON_INIT_NVAR(has_service);
-		PHALCON_CALL_METHOD_PARAMS_1(has_service, dependency_injector, "has", handler_class);
-		if (!zend_is_true(has_service)) {
-			/** 
-			 * DI doesn't have a service with that name, try to load it using an autoloader
-			 */
+		if (Z_TYPE_P(resolved_entry) == IS_ARRAY) {
+			PHALCON_INIT_NVAR(has_service);
+			ZVAL_BOOL(has_service, 1);
+		} else {
 			PHALCON_INIT_NVAR(has_service);
-			PHALCON_CALL_FUNC_PARAMS_1(has_service, "class_exists", handler_class);
+			PHALCON_CALL_METHOD_PARAMS_1(has_service, dependency_injector, "has", handler_class);
+			if (!zend_is_true(has_service)) {
+				/** 
+				 * DI doesn't have a service with that name, try to load it using an autoloader
+				 */
+				PHALCON_INIT_NVAR(has_service);
+				PHALCON_CALL_FUNC_PARAMS_1(has_service, "class_exists", handler_class);
+			}
 		}
 	
 		/** 
@@ -696,13 +790,38 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 	
 		phalcon_update_property_this(this_ptr, SL("_activeHandler"), handler TSRMLS_CC);
 	
+		/** 
+		 * The methods implemented by the handler are checked once for every action, the
+		 * services container can replace the class of a handler so it's compared too
+		 */
+		flags = -1;
+		if (Z_TYPE_P(resolved_entry) == IS_ARRAY) {
+			PHALCON_OBS_NVAR(resolved_class);
+			phalcon_array_fetch_long(&resolved_class, resolved_entry, 0, PH_NOISY_CC);
+			if (Z_TYPE_P(resolved_class) == IS_STRING && !strcmp(Z_STRVAL_P(resolved_class), Z_OBJCE_P(handler)->name)) {
+				PHALCON_OBS_NVAR(resolved_flags);
+				phalcon_array_fetch_long(&resolved_flags, resolved_entry, 1, PH_NOISY_CC);
+				flags = phalcon_get_intval(resolved_flags);
+			}
+		}
+	
+		if (flags < 0) {
+			flags = phalcon_dispatcher_flags(handler, action_method TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(resolved_entry);
+			array_init_size(resolved_entry, 2);
+			add_next_index_stringl(resolved_entry, Z_OBJCE_P(handler)->name, Z_OBJCE_P(handler)->name_length, 1);
+			add_next_index_long(resolved_entry, flags);
+			phalcon_update_property_array(this_ptr, SL("_resolved"), resolved_key, resolved_entry TSRMLS_CC);
+		}
+	
 		/** 
 		 * If the object was recently created in the DI we initialize it
 		 */
 		PHALCON_INIT_NVAR(was_fresh);
 		PHALCON_CALL_METHOD(was_fresh, dependency_injector, "wasfreshinstance");
 		if (PHALCON_IS_TRUE(was_fresh)) {
-			if (phalcon_method_exists_ex(handler, SS("initialize") TSRMLS_CC) == SUCCESS) {
+			if (flags & PHALCON_DISPATCHER_HAS_INITIALIZE) {
 				PHALCON_CALL_METHOD_NORETURN(handler, "initialize");
 			}
 		}
@@ -740,9 +859,7 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 		/** 
 		 * Check if the method exists in the handler
 		 */
-		PHALCON_INIT_NVAR(action_method);
-		PHALCON_CONCAT_VV(action_method, action_name, action_suffix);
-		if (phalcon_method_exists(handler, action_method TSRMLS_CC) == FAILURE) {
+		if (!(flags & PHALCON_DISPATCHER_HAS_ACTION)) {
 	
 			/** 
 			 * Call beforeNotFoundAction
@@ -791,7 +908,7 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 		/** 
 		 * Calling beforeExecuteRoute as callback and event
 		 */
-		if (phalcon_method_exists_ex(handler, SS("beforeexecuteroute") TSRMLS_CC) == SUCCESS) {
+		if (flags & PHALCON_DISPATCHER_HAS_BEFORE_EXECUTE) {
 	
 			PHALCON_INIT_NVAR(status);
 			PHALCON_CALL_METHOD_PARAMS_1(status, handler, "beforeexecuteroute", this_ptr);
@@ -856,7 +973,7 @@ PHP_METHOD(Phalcon_Dispatcher, dispatch){
 		/** 
 		 * Calling afterExecuteRoute as callback and event
 		 */
-		if (phalcon_method_exists_ex(handler, SS("afterexecuteroute") TSRMLS_CC) == SUCCESS) {
+		if (flags & PHALCON_DISPATCHER_HAS_AFTER_EXECUTE) {
 	
 			PHALCON_INIT_NVAR(status);
 			PHALCON_CALL_METHOD_PARAMS_2(status, handler, "afterexecuteroute", this_ptr, value);
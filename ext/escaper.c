@@ -313,7 +313,7 @@ PHP_METHOD(Phalcon_Escaper, escapeHtml){
  */
 PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
 
-	zval *attribute, *normalized, *sanitized;
+	zval *attribute, *charset, *normalized, *sanitized = NULL;
 
 	PHALCON_MM_GROW();
 
@@ -321,6 +321,25 @@ PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
 	
 	if (Z_TYPE_P(attribute) == IS_STRING) {
 		if (zend_is_true(attribute)) {
+			/** 
+			 * Strings without characters to escape are returned as they are
+			 */
+			if (!phalcon_escape_needed(attribute, 1)) {
+				RETURN_CTOR(attribute);
+			}
+	
+			/** 
+			 * UTF-8 strings are escaped without converting them to UTF-32
+			 */
+			PHALCON_INIT_VAR(charset);
+			phalcon_is_basic_charset(charset, attribute);
+			if (Z_TYPE_P(charset) != IS_STRING) {
+				PHALCON_INIT_VAR(sanitized);
+				if (phalcon_escape_htmlattr_utf8(sanitized, attribute) == SUCCESS) {
+					RETURN_CTOR(sanitized);
+				}
+			}
+	
 			/** 
 			 * Normalize encoding to UTF-32
 			 */
@@ -330,7 +349,7 @@ PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
 			/** 
 			 * Escape the string
 			 */
-			PHALCON_INIT_VAR(sanitized);
+			PHALCON_INIT_NVAR(sanitized);
 			phalcon_escape_htmlattr(sanitized, normalized);
 			RETURN_CTOR(sanitized);
 		}
@@ -346,7 +365,7 @@ PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
  */
 PHP_METHOD(Phalcon_Escaper, escapeCss){
 
-	zval *css, *normalized, *sanitized;
+	zval *css, *charset, *normalized, *sanitized = NULL;
 
 	PHALCON_MM_GROW();
 
@@ -354,6 +373,25 @@ PHP_METHOD(Phalcon_Escaper, escapeCss){
 	
 	if (Z_TYPE_P(css) == IS_STRING) {
 		if (zend_is_true(css)) {
+			/** 
+			 * Strings without characters to escape are returned as they are
+			 */
+			if (!phalcon_escape_needed(css, 0)) {
+				RETURN_CTOR(css);
+			}
+	
+			/** 
+			 * UTF-8 strings are escaped without converting them to UTF-32
+			 */
+			PHALCON_INIT_VAR(charset);
+			phalcon_is_basic_charset(charset, css);
+			if (Z_TYPE_P(charset) != IS_STRING) {
+				PHALCON_INIT_VAR(sanitized);
+				if (phalcon_escape_css_utf8(sanitized, css) == SUCCESS) {
+					RETURN_CTOR(sanitized);
+				}
+			}
+	
 			/** 
 			 * Normalize encoding to UTF-32
 			 */
@@ -363,7 +401,7 @@ PHP_METHOD(Phalcon_Escaper, escapeCss){
 			/** 
 			 * Escape the string
 			 */
-			PHALCON_INIT_VAR(sanitized);
+			PHALCON_INIT_NVAR(sanitized);
 			phalcon_escape_css(sanitized, normalized);
 			RETURN_CTOR(sanitized);
 		}
@@ -379,7 +417,7 @@ PHP_METHOD(Phalcon_Escaper, escapeCss){
  */
 PHP_METHOD(Phalcon_Escaper, escapeJs){
 
-	zval *js, *normalized, *sanitized;
+	zval *js, *charset, *normalized, *sanitized = NULL;
 
 	PHALCON_MM_GROW();
 
@@ -387,6 +425,25 @@ PHP_METHOD(Phalcon_Escaper, escapeJs){
 	
 	if (Z_TYPE_P(js) == IS_STRING) {
 		if (zend_is_true(js)) {
+			/** 
+			 * Strings without characters to escape are returned as they are
+			 */
+			if (!phalcon_escape_needed(js, 1)) {
+				RETURN_CTOR(js);
+			}
+	
+			/** 
+			 * UTF-8 strings are escaped without converting them to UTF-32
+			 */
+			PHALCON_INIT_VAR(charset);
+			phalcon_is_basic_charset(charset, js);
+			if (Z_TYPE_P(charset) != IS_STRING) {
+				PHALCON_INIT_VAR(sanitized);
+				if (phalcon_escape_js_utf8(sanitized, js) == SUCCESS) {
+					RETURN_CTOR(sanitized);
+				}
+			}
+	
 			/** 
 			 * Normalize encoding to UTF-32
 			 */
@@ -396,7 +453,7 @@ PHP_METHOD(Phalcon_Escaper, escapeJs){
 			/** 
 			 * Escape the string
 			 */
-			PHALCON_INIT_VAR(sanitized);
+			PHALCON_INIT_NVAR(sanitized);
 			phalcon_escape_js(sanitized, normalized);
 			RETURN_CTOR(sanitized);
 		}
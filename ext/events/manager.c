@@ -28,6 +28,7 @@
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
+#include "Zend/zend_closures.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -61,6 +62,7 @@ PHALCON_INIT_CLASS(Phalcon_Events_Manager){
 	zend_declare_property_bool(phalcon_events_manager_ce, SL("_collect"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_events_manager_ce, SL("_enablePriorities"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_events_manager_ce, SL("_responses"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_events_manager_ce, SL("_listeners"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_events_manager_ce TSRMLS_CC, 1, phalcon_events_managerinterface_ce);
 
@@ -78,7 +80,13 @@ PHP_METHOD(Phalcon_Events_Manager, attach){
 
 	zval *event_type, *handler, *priority = NULL, *events = NULL;
 	zval *enable_priorities, *priority_queue = NULL;
-	zval *mode;
+	zval *mode, *entry, *type_listeners, *listeners, *current_listeners;
+	zval *listener = NULL, *listener_priority = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	long priority_value;
+	int sorted, inserted = 0;
 
 	PHALCON_MM_GROW();
 
@@ -162,6 +170,56 @@ PHP_METHOD(Phalcon_Events_Manager, attach){
 		phalcon_update_property_this(this_ptr, SL("_events"), events TSRMLS_CC);
 	}
 	
+	/** 
+	 * Keep a native copy of the listeners sorted by priority, listeners with the same
+	 * priority are notified in the order they were attached
+	 */
+	sorted = Z_TYPE_P(priority_queue) == IS_OBJECT;
+	priority_value = phalcon_get_intval(priority);
+	
+	PHALCON_INIT_VAR(entry);
+	array_init_size(entry, 2);
+	add_next_index_long(entry, priority_value);
+	phalcon_array_append(&entry, handler, PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(type_listeners);
+	array_init(type_listeners);
+	
+	PHALCON_OBS_VAR(listeners);
+	phalcon_read_property_this(&listeners, this_ptr, SL("_listeners"), PH_NOISY_CC);
+	if (phalcon_array_isset(listeners, event_type)) {
+	
+		PHALCON_OBS_VAR(current_listeners);
+		phalcon_array_fetch(&current_listeners, listeners, event_type, PH_NOISY_CC);
+	
+		if (phalcon_is_iterable(current_listeners, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+	
+			while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(listener);
+	
+				if (!inserted && sorted) {
+					PHALCON_OBS_NVAR(listener_priority);
+					phalcon_array_fetch_long(&listener_priority, listener, 0, PH_NOISY_CC);
+					if (priority_value > phalcon_get_intval(listener_priority)) {
+						phalcon_array_append(&type_listeners, entry, PH_SEPARATE TSRMLS_CC);
+						inserted = 1;
+					}
+				}
+	
+				phalcon_array_append(&type_listeners, listener, PH_SEPARATE TSRMLS_CC);
+	
+				zend_hash_move_forward_ex(ah0, &hp0);
+			}
+		}
+	}
+	
+	if (!inserted) {
+		phalcon_array_append(&type_listeners, entry, PH_SEPARATE TSRMLS_CC);
+	}
+	
+	phalcon_update_property_array(this_ptr, SL("_listeners"), event_type, type_listeners TSRMLS_CC);
+	
 	PHALCON_MM_RESTORE();
 }
 
@@ -249,10 +307,12 @@ PHP_METHOD(Phalcon_Events_Manager, dettachAll){
 	phalcon_read_property_this(&events, this_ptr, SL("_events"), PH_NOISY_CC);
 	if (Z_TYPE_P(type) == IS_NULL) {
 		PHALCON_INIT_NVAR(events);
+		phalcon_update_property_null(this_ptr, SL("_listeners") TSRMLS_CC);
 	} else {
 		if (phalcon_array_isset(events, type)) {
 			PHALCON_INIT_VAR(null_value);
 			phalcon_array_update_zval(&events, type, &null_value, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			phalcon_update_property_array(this_ptr, SL("_listeners"), type, null_value TSRMLS_CC);
 		}
 	}
 	
@@ -558,9 +618,16 @@ PHP_METHOD(Phalcon_Events_Manager, fireQueue){
 PHP_METHOD(Phalcon_Events_Manager, fire){
 
 	zval *event_type, *source, *data = NULL, *cancelable = NULL, *events;
-	zval *exception_message, *colon, *event_parts;
-	zval *type, *event_name, *status = NULL, *collect, *event = NULL;
-	zval *fire_events = NULL;
+	zval *exception_message, *status = NULL, *collect, *listeners;
+	zval *event, *event_name, *lower_name, *arguments = NULL;
+	zval *handler, *is_stopped = NULL;
+	zval **queue, **entry, **handler_ptr;
+	HashTable *queues[2];
+	HashPosition hp0;
+	char *type, *colon, *name_end;
+	uint type_length, name_length;
+	ulong hash;
+	int i;
 
 	PHALCON_MM_GROW();
 
@@ -589,27 +656,14 @@ PHP_METHOD(Phalcon_Events_Manager, fire){
 	/** 
 	 * All valid events must have a colon separator
 	 */
-	if (!phalcon_memnstr_str(event_type, SL(":") TSRMLS_CC)) {
+	colon = memchr(Z_STRVAL_P(event_type), ':', Z_STRLEN_P(event_type));
+	if (!colon) {
 		PHALCON_INIT_VAR(exception_message);
 		PHALCON_CONCAT_SV(exception_message, "Invalid event type ", event_type);
 		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_events_exception_ce, exception_message);
 		return;
 	}
 	
-	PHALCON_INIT_VAR(colon);
-	ZVAL_STRING(colon, ":", 1);
-	
-	PHALCON_INIT_VAR(event_parts);
-	phalcon_fast_explode(event_parts, colon, event_type TSRMLS_CC);
-	
-	PHALCON_OBS_VAR(type);
-	phalcon_array_fetch_long(&type, event_parts, 0, PH_NOISY_CC);
-	
-	PHALCON_OBS_VAR(event_name);
-	phalcon_array_fetch_long(&event_name, event_parts, 1, PH_NOISY_CC);
-	
-	PHALCON_INIT_VAR(status);
-	
 	/** 
 	 * Responses must be traced?
 	 */
@@ -619,53 +673,136 @@ PHP_METHOD(Phalcon_Events_Manager, fire){
 		phalcon_update_property_null(this_ptr, SL("_responses") TSRMLS_CC);
 	}
 	
-	PHALCON_INIT_VAR(event);
-	
 	/** 
-	 * Check if events are grouped by type
+	 * Listeners are grouped by the type and by the full name of the event, nothing is
+	 * allocated if none of them is listened
 	 */
-	if (phalcon_array_isset(events, type)) {
+	PHALCON_OBS_VAR(listeners);
+	phalcon_read_property_this(&listeners, this_ptr, SL("_listeners"), PH_NOISY_CC);
+	if (Z_TYPE_P(listeners) != IS_ARRAY) { 
+		RETURN_MM_NULL();
+	}
 	
-		PHALCON_OBS_VAR(fire_events);
-		phalcon_array_fetch(&fire_events, events, type, PH_NOISY_CC);
-		if (Z_TYPE_P(fire_events) == IS_ARRAY || Z_TYPE_P(fire_events) == IS_OBJECT) {
-			/** 
-			 * Create the event context
-			 */
-			object_init_ex(event, phalcon_events_event_ce);
-			PHALCON_CALL_METHOD_PARAMS_4_NORETURN(event, "__construct", event_name, source, data, cancelable);
+	type_length = colon - Z_STRVAL_P(event_type);
+	type = estrndup(Z_STRVAL_P(event_type), type_length);
 	
-			/** 
-			 * Call the events queue
-			 */
-			PHALCON_CALL_METHOD_PARAMS_2(status, this_ptr, "firequeue", fire_events, event);
+	queues[0] = NULL;
+	if (zend_hash_find(Z_ARRVAL_P(listeners), type, type_length + 1, (void **) &queue) == SUCCESS) {
+		if (Z_TYPE_PP(queue) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_PP(queue))) {
+			queues[0] = Z_ARRVAL_PP(queue);
+		}
+	}
+	efree(type);
+	
+	queues[1] = NULL;
+	if (zend_hash_find(Z_ARRVAL_P(listeners), Z_STRVAL_P(event_type), Z_STRLEN_P(event_type) + 1, (void **) &queue) == SUCCESS) {
+		if (Z_TYPE_PP(queue) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_PP(queue))) {
+			queues[1] = Z_ARRVAL_PP(queue);
 		}
 	}
 	
+	if (!queues[0] && !queues[1]) {
+		RETURN_MM_NULL();
+	}
+	
 	/** 
-	 * Check if there are listeners for the event type itself
+	 * The event name is the part between the first and the second colon
 	 */
-	if (phalcon_array_isset(events, event_type)) {
+	name_end = memchr(colon + 1, ':', Z_STRLEN_P(event_type) - type_length - 1);
+	name_length = name_end ? (uint) (name_end - colon - 1) : Z_STRLEN_P(event_type) - type_length - 1;
+	
+	PHALCON_INIT_VAR(event_name);
+	ZVAL_STRINGL(event_name, colon + 1, name_length, 1);
+	
+	/** 
+	 * Listener methods are looked up with the same lowercased name and hash
+	 */
+	PHALCON_INIT_VAR(lower_name);
+	ZVAL_STRINGL(lower_name, zend_str_tolower_dup(colon + 1, name_length), name_length, 0);
+	hash = zend_inline_hash_func(Z_STRVAL_P(lower_name), name_length + 1);
+	
+	/** 
+	 * Create the event context
+	 */
+	PHALCON_INIT_VAR(event);
+	object_init_ex(event, phalcon_events_event_ce);
+	phalcon_update_property_this(event, SL("_type"), event_name TSRMLS_CC);
+	phalcon_update_property_this(event, SL("_source"), source TSRMLS_CC);
+	if (Z_TYPE_P(data) != IS_NULL) {
+		phalcon_update_property_this(event, SL("_data"), data TSRMLS_CC);
+	}
+	if (PHALCON_IS_NOT_TRUE(cancelable)) {
+		phalcon_update_property_this(event, SL("_cancelable"), cancelable TSRMLS_CC);
+	}
+	
+	PHALCON_INIT_VAR(status);
+	
+	for (i = 0; i < 2; i++) {
+	
+		if (!queues[i]) {
+			continue;
+		}
+	
+		PHALCON_INIT_NVAR(status);
 	
-		PHALCON_OBS_NVAR(fire_events);
-		phalcon_array_fetch(&fire_events, events, event_type, PH_NOISY_CC);
-		if (Z_TYPE_P(fire_events) == IS_ARRAY || Z_TYPE_P(fire_events) == IS_OBJECT) {
+		zend_hash_internal_pointer_reset_ex(queues[i], &hp0);
+	
+		while (zend_hash_get_current_data_ex(queues[i], (void **) &entry, &hp0) == SUCCESS) {
+	
+			if (Z_TYPE_PP(entry) != IS_ARRAY || zend_hash_index_find(Z_ARRVAL_PP(entry), 1, (void **) &handler_ptr) == FAILURE) {
+				zend_hash_move_forward_ex(queues[i], &hp0);
+				continue;
+			}
+	
+			handler = *handler_ptr;
+	
+			if (Z_TYPE_P(handler) == IS_OBJECT && instanceof_function(Z_OBJCE_P(handler), zend_ce_closure TSRMLS_CC)) {
+	
+				/** 
+				 * Closures receive the event, the source and the data
+				 */
+				if (!arguments) {
+					PHALCON_INIT_VAR(arguments);
+					array_init_size(arguments, 3);
+					phalcon_array_append(&arguments, event, PH_SEPARATE TSRMLS_CC);
+					phalcon_array_append(&arguments, source, PH_SEPARATE TSRMLS_CC);
+					phalcon_array_append(&arguments, data, PH_SEPARATE TSRMLS_CC);
+				}
+	
+				PHALCON_INIT_NVAR(status);
+				PHALCON_CALL_USER_FUNC_ARRAY(status, handler, arguments);
+			} else {
+				/** 
+				 * Check if the listener has implemented an event with the same name
+				 */
+				if (phalcon_method_quick_exists_ex(handler, Z_STRVAL_P(lower_name), name_length + 1, hash TSRMLS_CC) == FAILURE) {
+					zend_hash_move_forward_ex(queues[i], &hp0);
+					continue;
+				}
+	
+				PHALCON_INIT_NVAR(status);
+				PHALCON_CALL_METHOD_PARAMS_3(status, handler, Z_STRVAL_P(event_name), event, source, data);
+			}
 	
 			/** 
-			 * Create the event if it wasn't created before
+			 * Collect the response
 			 */
-			if (Z_TYPE_P(event) == IS_NULL) {
-				PHALCON_INIT_NVAR(event);
-				object_init_ex(event, phalcon_events_event_ce);
-				PHALCON_CALL_METHOD_PARAMS_4_NORETURN(event, "__construct", event_name, source, data, cancelable);
-	
+			if (zend_is_true(collect)) {
+				phalcon_update_property_array_append(this_ptr, SL("_responses"), status TSRMLS_CC);
 			}
 	
 			/** 
-			 * Call the events queue
+			 * Check if the event was stopped by the user
 			 */
-			PHALCON_INIT_NVAR(status);
-			PHALCON_CALL_METHOD_PARAMS_2(status, this_ptr, "firequeue", fire_events, event);
+			if (zend_is_true(cancelable)) {
+				PHALCON_OBS_NVAR(is_stopped);
+				phalcon_read_property_this(&is_stopped, event, SL("_stopped"), PH_NOISY_CC);
+				if (zend_is_true(is_stopped)) {
+					break;
+				}
+			}
+	
+			zend_hash_move_forward_ex(queues[i], &hp0);
 		}
 	}
 	
@@ -24,6 +24,9 @@
 #include "php_phalcon.h"
 #include "phalcon.h"
 
+#include "SAPI.h"
+#include "ext/standard/md5.h"
+
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
@@ -36,6 +39,11 @@
 #include "kernel/exception.h"
 #include "kernel/concat.h"
 #include "kernel/operators.h"
+#include "kernel/array.h"
+
+/** Files are mapped in windows of this size, offsets are aligned to the allocation granularity */
+#define PHALCON_HTTP_RESPONSE_MMAP_WINDOW 4194304
+#define PHALCON_HTTP_RESPONSE_MMAP_ALIGN 65536
 
 /**
  * Phalcon\Http\Response
@@ -65,6 +73,10 @@ PHALCON_INIT_CLASS(Phalcon_Http_Response){
 	zend_declare_property_null(phalcon_http_response_ce, SL("_headers"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_response_ce, SL("_cookies"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_response_ce, SL("_file"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_http_response_ce, SL("_stream"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_http_response_ce, SL("_flush"), 1, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_http_response_ce, SL("_notModified"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_http_response_ce, SL("_autoEtag"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_response_ce, SL("_dependencyInjector"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_http_response_ce TSRMLS_CC, 2, phalcon_http_responseinterface_ce, phalcon_di_injectionawareinterface_ce);
@@ -409,6 +421,120 @@ PHP_METHOD(Phalcon_Http_Response, setExpires){
 	RETURN_THIS();
 }
 
+/**
+ * Checks whether an entity tag is in an 'If-None-Match' list, tags are compared with the
+ * weak comparison function
+ */
+static int phalcon_http_response_etag_match(const char *header, const char *etag){
+
+	const char *p = header, *start;
+	size_t etag_length, length;
+
+	if (!strncmp(etag, "W/", 2)) {
+		etag += 2;
+	}
+	etag_length = strlen(etag);
+
+	while (*p) {
+
+		while (*p == ' ' || *p == '\t' || *p == ',') {
+			p++;
+		}
+		if (!*p) {
+			break;
+		}
+
+		start = p;
+		while (*p && *p != ',') {
+			p++;
+		}
+
+		length = p - start;
+		while (length && (start[length - 1] == ' ' || start[length - 1] == '\t')) {
+			length--;
+		}
+
+		if (length == 1 && *start == '*') {
+			return 1;
+		}
+
+		if (length > 2 && !strncmp(start, "W/", 2)) {
+			start += 2;
+			length -= 2;
+		}
+
+		if (length == etag_length && !memcmp(start, etag, length)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Sets a weak entity tag computed from the body when automatic tags are enabled, the body is
+ * dropped if the client already has it
+ */
+static void phalcon_http_response_auto_etag(zval *this_ptr TSRMLS_DC){
+
+	zval *auto_etag, *not_modified, *file, *stream, *content, *headers;
+	zval *name, *etag, *current;
+	PHP_MD5_CTX context;
+	unsigned char digest[16];
+	char hex[33];
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(auto_etag);
+	phalcon_read_property_this(&auto_etag, this_ptr, SL("_autoEtag"), PH_NOISY_CC);
+
+	PHALCON_OBS_VAR(not_modified);
+	phalcon_read_property_this(&not_modified, this_ptr, SL("_notModified"), PH_NOISY_CC);
+
+	PHALCON_OBS_VAR(file);
+	phalcon_read_property_this(&file, this_ptr, SL("_file"), PH_NOISY_CC);
+
+	PHALCON_OBS_VAR(stream);
+	phalcon_read_property_this(&stream, this_ptr, SL("_stream"), PH_NOISY_CC);
+
+	PHALCON_OBS_VAR(content);
+	phalcon_read_property_this(&content, this_ptr, SL("_content"), PH_NOISY_CC);
+
+	if (!zend_is_true(auto_etag) || zend_is_true(not_modified) || Z_TYPE_P(file) != IS_NULL || Z_TYPE_P(stream) != IS_NULL || Z_TYPE_P(content) != IS_STRING) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+
+	PHALCON_INIT_VAR(headers);
+	PHALCON_CALL_METHOD(headers, this_ptr, "getheaders");
+
+	/**
+	 * Tags set by the application are never replaced
+	 */
+	PHALCON_INIT_VAR(name);
+	ZVAL_STRING(name, "Etag", 1);
+
+	PHALCON_INIT_VAR(current);
+	PHALCON_CALL_METHOD_PARAMS_1(current, headers, "get", name);
+	if (Z_TYPE_P(current) == IS_STRING) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+
+	PHP_MD5Init(&context);
+	PHP_MD5Update(&context, (unsigned char *) Z_STRVAL_P(content), Z_STRLEN_P(content));
+	PHP_MD5Final(digest, &context);
+	make_digest_ex(hex, digest, 16);
+
+	PHALCON_INIT_VAR(etag);
+	Z_STRLEN_P(etag) = spprintf(&Z_STRVAL_P(etag), 0, "W/\"%s\"", hex);
+	Z_TYPE_P(etag) = IS_STRING;
+
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "checknotmodified", etag);
+
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Sends a Not-Modified response
  *
@@ -426,9 +552,260 @@ PHP_METHOD(Phalcon_Http_Response, setNotModified){
 	PHALCON_INIT_VAR(status);
 	ZVAL_STRING(status, "Not modified", 1);
 	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "setstatuscode", code, status);
+	phalcon_update_property_bool(this_ptr, SL("_notModified"), 1 TSRMLS_CC);
 	RETURN_THIS();
 }
 
+/**
+ * Converts a modification date to a timestamp, dates can be timestamps, strings understood by
+ * strtotime() or DateTime objects
+ */
+static int phalcon_http_response_timestamp(zval *value, long *timestamp TSRMLS_DC){
+
+	zend_class_entry *ce;
+	zval *retval = NULL;
+	long lval;
+	double dval;
+	int status = FAILURE;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_LONG:
+			*timestamp = Z_LVAL_P(value);
+			return SUCCESS;
+
+		case IS_DOUBLE:
+			*timestamp = (long) Z_DVAL_P(value);
+			return SUCCESS;
+
+		case IS_STRING:
+			switch (is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &lval, &dval, 0)) {
+				case IS_LONG:
+					*timestamp = lval;
+					return SUCCESS;
+				case IS_DOUBLE:
+					*timestamp = (long) dval;
+					return SUCCESS;
+			}
+			zend_call_method_with_1_params(NULL, NULL, NULL, "strtotime", &retval, value);
+			break;
+
+		case IS_OBJECT:
+			ce = zend_fetch_class(SL("DateTime"), ZEND_FETCH_CLASS_AUTO TSRMLS_CC);
+			if (!ce || !instanceof_function(Z_OBJCE_P(value), ce TSRMLS_CC)) {
+				return FAILURE;
+			}
+			zend_call_method_with_0_params(&value, Z_OBJCE_P(value), NULL, "gettimestamp", &retval);
+			break;
+
+		default:
+			return FAILURE;
+	}
+
+	if (retval) {
+		if (Z_TYPE_P(retval) == IS_LONG) {
+			*timestamp = Z_LVAL_P(retval);
+			status = SUCCESS;
+		}
+		zval_ptr_dtor(&retval);
+	}
+
+	return status;
+}
+
+/**
+ * Sets the 'Last-Modified' header, the date is sent in GMT
+ *
+ *<code>
+ *	$response->setLastModified(filemtime($path));
+ *	$response->setLastModified(new DateTime($post->updated_at));
+ *</code>
+ *
+ * @param int|string|DateTime $lastModified
+ * @return Phalcon\Http\ResponseInterface
+ */
+PHP_METHOD(Phalcon_Http_Response, setLastModified){
+
+	zval *last_modified, *timestamp, *format, *date, *name;
+	long modified;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &last_modified);
+	
+	if (phalcon_http_response_timestamp(last_modified, &modified TSRMLS_CC) == FAILURE) {
+		if (EG(exception)) {
+			RETURN_MM_NULL();
+		}
+		PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "The last modified date must be a timestamp, a date string or an instance of DateTime");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(timestamp);
+	ZVAL_LONG(timestamp, modified);
+	
+	PHALCON_INIT_VAR(format);
+	ZVAL_STRING(format, "D, d M Y H:i:s \\G\\M\\T", 1);
+	
+	PHALCON_INIT_VAR(date);
+	PHALCON_CALL_FUNC_PARAMS_2(date, "gmdate", format, timestamp);
+	
+	PHALCON_INIT_VAR(name);
+	ZVAL_STRING(name, "Last-Modified", 1);
+	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "setheader", name, date);
+	
+	RETURN_THIS();
+}
+
+/**
+ * Sets the validators of the response and compares them with the 'If-None-Match' and
+ * 'If-Modified-Since' request headers, when the client already has the resource a 304 status
+ * is set and the body is dropped. Validators are cheap to compute so actions can call this
+ * before doing any work
+ *
+ *<code>
+ *	public function showAction($id)
+ *	{
+ *		$post = Posts::findFirst($id);
+ *		if ($this->response->checkNotModified($post->version, new DateTime($post->updated_at))) {
+ *			return $this->response;
+ *		}
+ *		$this->view->post = $post;
+ *	}
+ *</code>
+ *
+ * @param string $etag
+ * @param int|string|DateTime $lastModified
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Http_Response, checkNotModified){
+
+	zval *etag = NULL, *last_modified = NULL, *timestamp = NULL, *server;
+	zval *method, *if_none_match, *if_modified_since, *since;
+	zval *quoted, *empty_content;
+	long modified = 0;
+	int not_modified = 0;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 0, 2, &etag, &last_modified);
+	
+	if (!etag) {
+		PHALCON_INIT_VAR(etag);
+	}
+	
+	if (!last_modified) {
+		PHALCON_INIT_VAR(last_modified);
+	}
+	
+	if (Z_TYPE_P(etag) != IS_NULL) {
+		PHALCON_SEPARATE_PARAM(etag);
+		convert_to_string(etag);
+	
+		/** 
+		 * Entity tags are quoted strings
+		 */
+		if (Z_STRVAL_P(etag)[0] != '"' && strncmp(Z_STRVAL_P(etag), "W/\"", 3)) {
+			PHALCON_INIT_VAR(quoted);
+			PHALCON_CONCAT_SVS(quoted, "\"", etag, "\"");
+			PHALCON_CPY_WRT(etag, quoted);
+		}
+	
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "setetag", etag);
+	}
+	
+	if (Z_TYPE_P(last_modified) != IS_NULL) {
+		if (phalcon_http_response_timestamp(last_modified, &modified TSRMLS_CC) == FAILURE) {
+			if (EG(exception)) {
+				RETURN_MM_NULL();
+			}
+			PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "The last modified date must be a timestamp, a date string or an instance of DateTime");
+			return;
+		}
+	
+		PHALCON_INIT_VAR(timestamp);
+		ZVAL_LONG(timestamp, modified);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "setlastmodified", timestamp);
+	}
+	
+	phalcon_get_global(&server, SS("_SERVER") TSRMLS_CC);
+	
+	/** 
+	 * Only safe methods can be answered with a 304
+	 */
+	if (phalcon_array_isset_string(server, SS("REQUEST_METHOD"))) {
+		PHALCON_OBS_VAR(method);
+		phalcon_array_fetch_string(&method, server, SL("REQUEST_METHOD"), PH_NOISY_CC);
+		if (!PHALCON_IS_STRING(method, "GET") && !PHALCON_IS_STRING(method, "HEAD")) {
+			RETURN_MM_FALSE;
+		}
+	}
+	
+	/** 
+	 * 'If-None-Match' takes precedence over 'If-Modified-Since'
+	 */
+	if (phalcon_array_isset_string(server, SS("HTTP_IF_NONE_MATCH"))) {
+		if (Z_TYPE_P(etag) == IS_STRING) {
+			PHALCON_OBS_VAR(if_none_match);
+			phalcon_array_fetch_string(&if_none_match, server, SL("HTTP_IF_NONE_MATCH"), PH_NOISY_CC);
+			if (Z_TYPE_P(if_none_match) == IS_STRING) {
+				not_modified = phalcon_http_response_etag_match(Z_STRVAL_P(if_none_match), Z_STRVAL_P(etag));
+			}
+		}
+	} else {
+		if (timestamp && phalcon_array_isset_string(server, SS("HTTP_IF_MODIFIED_SINCE"))) {
+			PHALCON_OBS_VAR(if_modified_since);
+			phalcon_array_fetch_string(&if_modified_since, server, SL("HTTP_IF_MODIFIED_SINCE"), PH_NOISY_CC);
+	
+			PHALCON_INIT_VAR(since);
+			PHALCON_CALL_FUNC_PARAMS_1(since, "strtotime", if_modified_since);
+			if (Z_TYPE_P(since) == IS_LONG && Z_LVAL_P(since) >= modified) {
+				not_modified = 1;
+			}
+		}
+	}
+	
+	if (!not_modified) {
+		RETURN_MM_FALSE;
+	}
+	
+	PHALCON_CALL_METHOD_NORETURN(this_ptr, "setnotmodified");
+	
+	PHALCON_INIT_VAR(empty_content);
+	ZVAL_EMPTY_STRING(empty_content);
+	phalcon_update_property_this(this_ptr, SL("_content"), empty_content TSRMLS_CC);
+	
+	RETURN_MM_TRUE;
+}
+
+/**
+ * Checks whether the response was answered with a 304 status
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Http_Response, isNotModified){
+
+
+	RETURN_MEMBER(this_ptr, "_notModified");
+}
+
+/**
+ * Enables the automatic weak 'Etag' computed from the hash of the body, the tag is set when
+ * the headers are sent unless the application sets one
+ *
+ * @param boolean $autoEtag
+ * @return Phalcon\Http\ResponseInterface
+ */
+PHP_METHOD(Phalcon_Http_Response, setAutoEtag){
+
+	zval *auto_etag;
+
+	phalcon_fetch_params(0, 1, 0, &auto_etag);
+	
+	phalcon_update_property_this(this_ptr, SL("_autoEtag"), auto_etag TSRMLS_CC);
+	RETURN_THISW();
+}
+
 /**
  * Sets the response content-type mime, optionally the charset
  *
@@ -674,6 +1051,8 @@ PHP_METHOD(Phalcon_Http_Response, sendHeaders){
 
 	PHALCON_MM_GROW();
 
+	phalcon_http_response_auto_etag(this_ptr TSRMLS_CC);
+	
 	PHALCON_OBS_VAR(headers);
 	phalcon_read_property_this(&headers, this_ptr, SL("_headers"), PH_NOISY_CC);
 	if (Z_TYPE_P(headers) == IS_OBJECT) {
@@ -706,50 +1085,509 @@ PHP_METHOD(Phalcon_Http_Response, sendCookies){
 }
 
 /**
- * Prints out HTTP response to the client
+ * Flushes the output to the client, output buffers started by the application are respected
+ */
+static void phalcon_http_response_flush(TSRMLS_D){
+
+#if PHP_VERSION_ID < 50400
+	if (!OG(ob_nesting_level)) {
+#else
+	if (!php_output_get_level(TSRMLS_C)) {
+#endif
+		sapi_flush(TSRMLS_C);
+	}
+}
+
+/**
+ * Parses a single 'bytes=first-last' range, 1 is returned if the range can be served,
+ * 0 if the header must be ignored and -1 if the range cannot be satisfied
+ */
+static int phalcon_http_response_range(const char *range, long size, long *start, long *end){
+
+	const char *p = range;
+	long first = -1, last = -1;
+
+	if (strncmp(p, "bytes=", 6)) {
+		return 0;
+	}
+	p += 6;
+
+	/**
+	 * Multiple ranges are not supported, the whole file is sent instead
+	 */
+	if (strchr(p, ',')) {
+		return 0;
+	}
+
+	while (*p == ' ') {
+		p++;
+	}
+
+	if (*p >= '0' && *p <= '9') {
+		first = 0;
+		while (*p >= '0' && *p <= '9') {
+			first = first * 10 + (*p - '0');
+			p++;
+		}
+	}
+
+	if (*p != '-') {
+		return 0;
+	}
+	p++;
+
+	if (*p >= '0' && *p <= '9') {
+		last = 0;
+		while (*p >= '0' && *p <= '9') {
+			last = last * 10 + (*p - '0');
+			p++;
+		}
+	}
+
+	while (*p == ' ') {
+		p++;
+	}
+
+	if (*p || (first < 0 && last < 0)) {
+		return 0;
+	}
+
+	if (first < 0) {
+		/**
+		 * Suffix range, the last N bytes are requested
+		 */
+		if (!last || !size) {
+			return -1;
+		}
+		*start = last < size ? size - last : 0;
+		*end = size - 1;
+		return 1;
+	}
+
+	if (last >= 0 && last < first) {
+		return 0;
+	}
+
+	if (first >= size) {
+		return -1;
+	}
+
+	*start = first;
+	*end = (last < 0 || last >= size) ? size - 1 : last;
+	return 1;
+}
+
+/**
+ * Writes a part of a file to the client, the file is mapped in windows instead of being
+ * copied into memory, streams that cannot be mapped are read in small blocks
+ */
+static void phalcon_http_response_passthru(php_stream *stream, size_t offset, size_t length TSRMLS_DC){
+
+	char buffer[8192], *mapped;
+	size_t aligned, delta, window, mapped_length, chunk;
+
+	if (php_stream_mmap_possible(stream)) {
+
+		while (length > 0) {
+
+			aligned = offset & ~((size_t) PHALCON_HTTP_RESPONSE_MMAP_ALIGN - 1);
+			delta = offset - aligned;
+			window = MIN(length + delta, PHALCON_HTTP_RESPONSE_MMAP_WINDOW);
+
+			mapped = php_stream_mmap_range(stream, aligned, window, PHP_STREAM_MAP_MODE_SHARED_READONLY, &mapped_length);
+			if (!mapped) {
+				break;
+			}
+
+			if (mapped_length <= delta) {
+				php_stream_mmap_unmap(stream);
+				break;
+			}
+
+			chunk = MIN(mapped_length - delta, length);
+			PHPWRITE(mapped + delta, chunk);
+			php_stream_mmap_unmap(stream);
+
+			offset += chunk;
+			length -= chunk;
+
+			phalcon_http_response_flush(TSRMLS_C);
+		}
+	}
+
+	if (length > 0 && php_stream_seek(stream, offset, SEEK_SET) == 0) {
+		while (length > 0) {
+			chunk = php_stream_read(stream, buffer, MIN(length, sizeof(buffer)));
+			if (!chunk) {
+				break;
+			}
+			PHPWRITE(buffer, chunk);
+			length -= chunk;
+		}
+		phalcon_http_response_flush(TSRMLS_C);
+	}
+}
+
+/**
+ * Checks whether the 'Range' header of the request can be honoured. Ranges only apply to GET
+ * requests, and an 'If-Range' header must match the entity tag or the modification date of the
+ * response, otherwise the whole file is sent
+ */
+static int phalcon_http_response_accepts_range(zval *server, zval *headers TSRMLS_DC){
+
+	zval **method, **if_range, *name, *current = NULL;
+	int matches = 0;
+
+	if (zend_hash_find(Z_ARRVAL_P(server), SS("REQUEST_METHOD"), (void **) &method) == SUCCESS) {
+		if (Z_TYPE_PP(method) != IS_STRING || strcmp(Z_STRVAL_PP(method), "GET")) {
+			return 0;
+		}
+	}
+
+	if (zend_hash_find(Z_ARRVAL_P(server), SS("HTTP_IF_RANGE"), (void **) &if_range) == FAILURE) {
+		return 1;
+	}
+
+	if (Z_TYPE_PP(if_range) != IS_STRING) {
+		return 0;
+	}
+
+	/**
+	 * Weak tags cannot be used to build a response from parts
+	 */
+	MAKE_STD_ZVAL(name);
+	if (Z_STRVAL_PP(if_range)[0] == '"') {
+		ZVAL_STRING(name, "Etag", 1);
+	} else {
+		if (!strncmp(Z_STRVAL_PP(if_range), "W/", 2)) {
+			zval_ptr_dtor(&name);
+			return 0;
+		}
+		ZVAL_STRING(name, "Last-Modified", 1);
+	}
+
+	if (zend_call_method_with_1_params(&headers, Z_OBJCE_P(headers), NULL, "get", &current, name) && current) {
+		if (Z_TYPE_P(current) == IS_STRING && Z_STRLEN_P(current) == Z_STRLEN_PP(if_range)) {
+			matches = !memcmp(Z_STRVAL_P(current), Z_STRVAL_PP(if_range), Z_STRLEN_P(current));
+		}
+		zval_ptr_dtor(&current);
+	}
+
+	zval_ptr_dtor(&name);
+
+	return matches;
+}
+
+/**
+ * Prints out HTTP response to the client, files are sent honoring the 'Range' header and
+ * streamed contents are written as they are produced
  *
  * @return Phalcon\Http\ResponseInterface
  */
 PHP_METHOD(Phalcon_Http_Response, send){
 
-	zval *sent, *headers, *cookies, *content;
+	zval *sent, *headers, *cookies, *content, *file, *stream;
+	zval *file_headers, *server, *range, *header_name, *header_value, *code, *message;
+	zval *params, *iterator = NULL, *valid = NULL, *chunk = NULL, *flush;
+	zval *not_modified, *file_handle;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	php_stream *file_stream = NULL;
+	php_stream_statbuf ssb;
+	long size = -1, start = 0, end = -1;
+	int status = 0;
 
 	PHALCON_MM_GROW();
 
 	PHALCON_OBS_VAR(sent);
 	phalcon_read_property_this(&sent, this_ptr, SL("_sent"), PH_NOISY_CC);
-	if (PHALCON_IS_FALSE(sent)) {
+	if (!PHALCON_IS_FALSE(sent)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "Response was already sent");
+		return;
+	}
+	
+	phalcon_http_response_auto_etag(this_ptr TSRMLS_CC);
+	
+	/** 
+	 * Files are opened before the headers are sent so the length and the range can be set
+	 */
+	PHALCON_OBS_VAR(file);
+	phalcon_read_property_this(&file, this_ptr, SL("_file"), PH_NOISY_CC);
+	if (Z_TYPE_P(file) == IS_STRING) {
+	
+		file_stream = php_stream_open_wrapper(Z_STRVAL_P(file), "rb", REPORT_ERRORS, NULL);
+		if (!file_stream) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "The file to send cannot be opened");
+			return;
+		}
+	
+		/** 
+		 * The stream is owned by a resource in the memory frame, it is closed on every return
+		 */
+		PHALCON_INIT_VAR(file_handle);
+		php_stream_to_zval(file_stream, file_handle);
+	
+		if (php_stream_stat(file_stream, &ssb) == 0) {
+			size = (long) ssb.sb.st_size;
+			end = size - 1;
+		}
+	
+		PHALCON_INIT_VAR(file_headers);
+		PHALCON_CALL_METHOD(file_headers, this_ptr, "getheaders");
+	
+		PHALCON_INIT_VAR(header_name);
+		PHALCON_INIT_VAR(header_value);
 	
 		/** 
-		 * Send headers
+		 * Streams without a known size are sent whole and without a length
 		 */
-		PHALCON_OBS_VAR(headers);
-		phalcon_read_property_this(&headers, this_ptr, SL("_headers"), PH_NOISY_CC);
-		if (Z_TYPE_P(headers) == IS_OBJECT) {
-			PHALCON_CALL_METHOD_NORETURN(headers, "send");
+		if (size >= 0) {
+			ZVAL_STRING(header_name, "Accept-Ranges", 1);
+			ZVAL_STRING(header_value, "bytes", 1);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(file_headers, "set", header_name, header_value);
+		}
+	
+		phalcon_get_global(&server, SS("_SERVER") TSRMLS_CC);
+		if (size >= 0 && Z_TYPE_P(server) == IS_ARRAY && phalcon_array_isset_string(server, SS("HTTP_RANGE")) && phalcon_http_response_accepts_range(server, file_headers TSRMLS_CC)) {
+			PHALCON_OBS_VAR(range);
+			phalcon_array_fetch_string(&range, server, SL("HTTP_RANGE"), PH_NOISY_CC);
+			if (Z_TYPE_P(range) == IS_STRING) {
+				status = phalcon_http_response_range(Z_STRVAL_P(range), size, &start, &end);
+			}
+		}
+	
+		PHALCON_INIT_VAR(code);
+		PHALCON_INIT_VAR(message);
+		PHALCON_INIT_NVAR(header_value);
+		if (status > 0) {
+			ZVAL_LONG(code, 206);
+			ZVAL_STRING(message, "Partial Content", 1);
+			Z_STRLEN_P(header_value) = spprintf(&Z_STRVAL_P(header_value), 0, "bytes %ld-%ld/%ld", start, end, size);
+			Z_TYPE_P(header_value) = IS_STRING;
+		} else {
+			if (status < 0) {
+				ZVAL_LONG(code, 416);
+				ZVAL_STRING(message, "Requested Range Not Satisfiable", 1);
+				Z_STRLEN_P(header_value) = spprintf(&Z_STRVAL_P(header_value), 0, "bytes */%ld", size);
+				Z_TYPE_P(header_value) = IS_STRING;
+				end = start - 1;
+			}
+		}
+	
+		if (status != 0) {
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "setstatuscode", code, message);
+	
+			PHALCON_INIT_NVAR(header_name);
+			ZVAL_STRING(header_name, "Content-Range", 1);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(file_headers, "set", header_name, header_value);
+		}
+	
+		if (size >= 0) {
+			PHALCON_INIT_NVAR(header_name);
+			ZVAL_STRING(header_name, "Content-Length", 1);
+	
+			PHALCON_INIT_NVAR(header_value);
+			ZVAL_LONG(header_value, end - start + 1);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(file_headers, "set", header_name, header_value);
 		}
+	}
+	
+	/** 
+	 * Send headers
+	 */
+	PHALCON_OBS_VAR(headers);
+	phalcon_read_property_this(&headers, this_ptr, SL("_headers"), PH_NOISY_CC);
+	if (Z_TYPE_P(headers) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(headers, "send");
+	}
+	
+	PHALCON_OBS_VAR(cookies);
+	phalcon_read_property_this(&cookies, this_ptr, SL("_cookies"), PH_NOISY_CC);
+	if (Z_TYPE_P(cookies) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_NORETURN(cookies, "send");
+	}
+	
+	phalcon_update_property_bool(this_ptr, SL("_sent"), 1 TSRMLS_CC);
 	
-		PHALCON_OBS_VAR(cookies);
-		phalcon_read_property_this(&cookies, this_ptr, SL("_cookies"), PH_NOISY_CC);
-		if (Z_TYPE_P(cookies) == IS_OBJECT) {
-			PHALCON_CALL_METHOD_NORETURN(cookies, "send");
+	/** 
+	 * 304 responses don't have a body
+	 */
+	PHALCON_OBS_VAR(not_modified);
+	phalcon_read_property_this(&not_modified, this_ptr, SL("_notModified"), PH_NOISY_CC);
+	if (zend_is_true(not_modified)) {
+		RETURN_THIS();
+	}
+	
+	/** 
+	 * Output the file
+	 */
+	if (file_stream) {
+		if (size < 0) {
+			php_stream_passthru(file_stream);
+			phalcon_http_response_flush(TSRMLS_C);
+		} else {
+			if (end >= start) {
+				phalcon_http_response_passthru(file_stream, (size_t) start, (size_t) (end - start + 1) TSRMLS_CC);
+			}
 		}
+		RETURN_THIS();
+	}
+	
+	PHALCON_OBS_VAR(stream);
+	phalcon_read_property_this(&stream, this_ptr, SL("_stream"), PH_NOISY_CC);
+	if (Z_TYPE_P(stream) != IS_NULL) {
+	
+		PHALCON_OBS_VAR(flush);
+		phalcon_read_property_this(&flush, this_ptr, SL("_flush"), PH_NOISY_CC);
 	
 		/** 
-		 * Output the response body
+		 * Callbacks receive the response, they can write the output or return the chunks
 		 */
-		PHALCON_OBS_VAR(content);
-		phalcon_read_property_this(&content, this_ptr, SL("_content"), PH_NOISY_CC);
-		zend_print_zval(content, 0);
-		phalcon_update_property_bool(this_ptr, SL("_sent"), 1 TSRMLS_CC);
+		if (phalcon_is_callable(stream TSRMLS_CC)) {
+			PHALCON_INIT_VAR(params);
+			array_init_size(params, 1);
+			phalcon_array_append(&params, this_ptr, PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_INIT_VAR(iterator);
+			PHALCON_CALL_USER_FUNC_ARRAY(iterator, stream, params);
+		} else {
+			PHALCON_CPY_WRT(iterator, stream);
+		}
+	
+		if (Z_TYPE_P(iterator) == IS_ARRAY) {
+	
+			phalcon_is_iterable(iterator, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(chunk);
+				zend_print_zval(chunk, 0);
+	
+				if (zend_is_true(flush)) {
+					phalcon_http_response_flush(TSRMLS_C);
+				}
+	
+				zend_hash_move_forward_ex(ah0, &hp0);
+			}
+		}
+	
+		while (Z_TYPE_P(iterator) == IS_OBJECT && instanceof_function(Z_OBJCE_P(iterator), zend_ce_aggregate TSRMLS_CC)) {
+			PHALCON_INIT_NVAR(chunk);
+			PHALCON_CALL_METHOD(chunk, iterator, "getiterator");
+			PHALCON_CPY_WRT(iterator, chunk);
+		}
+	
+		if (Z_TYPE_P(iterator) == IS_OBJECT && instanceof_function(Z_OBJCE_P(iterator), zend_ce_iterator TSRMLS_CC)) {
+	
+			PHALCON_CALL_METHOD_NORETURN(iterator, "rewind");
+	
+			while (1) {
+	
+				PHALCON_INIT_NVAR(valid);
+				PHALCON_CALL_METHOD(valid, iterator, "valid");
+				if (!zend_is_true(valid)) {
+					break;
+				}
+	
+				PHALCON_INIT_NVAR(chunk);
+				PHALCON_CALL_METHOD(chunk, iterator, "current");
+				zend_print_zval(chunk, 0);
+	
+				if (zend_is_true(flush)) {
+					phalcon_http_response_flush(TSRMLS_C);
+				}
+	
+				PHALCON_CALL_METHOD_NORETURN(iterator, "next");
+			}
+		}
+	
+		if (zend_is_true(flush)) {
+			phalcon_http_response_flush(TSRMLS_C);
+		}
 	
 		RETURN_THIS();
 	}
 	
-	PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "Response was already sent");
-	return;
+	/** 
+	 * Output the response body
+	 */
+	PHALCON_OBS_VAR(content);
+	phalcon_read_property_this(&content, this_ptr, SL("_content"), PH_NOISY_CC);
+	zend_print_zval(content, 0);
+	
+	RETURN_THIS();
+}
+
+/**
+ * Sets a callback or an iterator producing the HTTP response body, chunks are written to the
+ * client as they are produced instead of being joined in memory. Without a 'Content-Length'
+ * header HTTP/1.1 servers use the chunked transfer encoding
+ *
+ *<code>
+ *	$response->setStreamContent(function($response) use ($robots) {
+ *		foreach ($robots as $robot) {
+ *			yield $robot->id . ',' . $robot->name . "\n";
+ *		}
+ *	});
+ *</code>
+ *
+ * @param callable|Traversable|array $stream
+ * @param boolean $flush
+ * @return Phalcon\Http\ResponseInterface
+ */
+PHP_METHOD(Phalcon_Http_Response, setStreamContent){
+
+	zval *stream, *flush = NULL;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &stream, &flush);
+	
+	if (!flush) {
+		PHALCON_INIT_VAR(flush);
+		ZVAL_BOOL(flush, 1);
+	}
+	
+	if (Z_TYPE_P(stream) != IS_ARRAY && Z_TYPE_P(stream) != IS_OBJECT && !phalcon_is_callable(stream TSRMLS_CC)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "The stream must be a callback or an iterator");
+		return;
+	}
+	if (Z_TYPE_P(stream) == IS_OBJECT && !phalcon_is_callable(stream TSRMLS_CC)) {
+		if (!instanceof_function(Z_OBJCE_P(stream), zend_ce_traversable TSRMLS_CC)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_http_response_exception_ce, "The stream must be a callback or an iterator");
+			return;
+		}
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_stream"), stream TSRMLS_CC);
+	phalcon_update_property_this(this_ptr, SL("_flush"), flush TSRMLS_CC);
+	RETURN_THIS();
+}
+
+/**
+ * Returns the callback or the iterator producing the HTTP response body
+ *
+ * @return callable|Traversable|array
+ */
+PHP_METHOD(Phalcon_Http_Response, getStreamContent){
+
+
+	RETURN_MEMBER(this_ptr, "_stream");
 }
 
+/**
+ * Sets an attached file to be sent at the end of the request, the file is mapped into memory
+ * instead of being read and single byte ranges requested by the client are honored
+ *
+ *<code>
+ *	$response->setFileToSend("/var/exports/robots.csv", "robots.csv");
+ *</code>
+ *
+ * @param string $filePath
+ * @param string $attachmentName
+ * @return Phalcon\Http\ResponseInterface
+ */
 PHP_METHOD(Phalcon_Http_Response, setFileToSend){
 
 	zval *file_path, *attachment_name = NULL, *base_path = NULL;
@@ -34,6 +34,10 @@ PHP_METHOD(Phalcon_Http_Response, setRawHeader);
 PHP_METHOD(Phalcon_Http_Response, resetHeaders);
 PHP_METHOD(Phalcon_Http_Response, setExpires);
 PHP_METHOD(Phalcon_Http_Response, setNotModified);
+PHP_METHOD(Phalcon_Http_Response, setLastModified);
+PHP_METHOD(Phalcon_Http_Response, checkNotModified);
+PHP_METHOD(Phalcon_Http_Response, isNotModified);
+PHP_METHOD(Phalcon_Http_Response, setAutoEtag);
 PHP_METHOD(Phalcon_Http_Response, setContentType);
 PHP_METHOD(Phalcon_Http_Response, setEtag);
 PHP_METHOD(Phalcon_Http_Response, redirect);
@@ -46,6 +50,8 @@ PHP_METHOD(Phalcon_Http_Response, sendHeaders);
 PHP_METHOD(Phalcon_Http_Response, sendCookies);
 PHP_METHOD(Phalcon_Http_Response, send);
 PHP_METHOD(Phalcon_Http_Response, setFileToSend);
+PHP_METHOD(Phalcon_Http_Response, setStreamContent);
+PHP_METHOD(Phalcon_Http_Response, getStreamContent);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, content)
@@ -83,6 +89,19 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setexpires, 0, 0, 1)
 	ZEND_ARG_INFO(0, datetime)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setlastmodified, 0, 0, 1)
+	ZEND_ARG_INFO(0, lastModified)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_checknotmodified, 0, 0, 0)
+	ZEND_ARG_INFO(0, etag)
+	ZEND_ARG_INFO(0, lastModified)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setautoetag, 0, 0, 1)
+	ZEND_ARG_INFO(0, autoEtag)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setcontenttype, 0, 0, 1)
 	ZEND_ARG_INFO(0, contentType)
 	ZEND_ARG_INFO(0, charset)
@@ -115,6 +134,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setfiletosend, 0, 0, 1)
 	ZEND_ARG_INFO(0, attachmentName)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_http_response_setstreamcontent, 0, 0, 1)
+	ZEND_ARG_INFO(0, stream)
+	ZEND_ARG_INFO(0, flush)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_http_response_method_entry){
 	PHP_ME(Phalcon_Http_Response, __construct, arginfo_phalcon_http_response___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Http_Response, setDI, arginfo_phalcon_http_response_setdi, ZEND_ACC_PUBLIC) 
@@ -129,6 +153,10 @@ PHALCON_INIT_FUNCS(phalcon_http_response_method_entry){
 	PHP_ME(Phalcon_Http_Response, resetHeaders, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, setExpires, arginfo_phalcon_http_response_setexpires, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, setNotModified, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, setLastModified, arginfo_phalcon_http_response_setlastmodified, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, checkNotModified, arginfo_phalcon_http_response_checknotmodified, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, isNotModified, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, setAutoEtag, arginfo_phalcon_http_response_setautoetag, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, setContentType, arginfo_phalcon_http_response_setcontenttype, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, setEtag, arginfo_phalcon_http_response_setetag, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, redirect, arginfo_phalcon_http_response_redirect, ZEND_ACC_PUBLIC) 
@@ -141,6 +169,8 @@ PHALCON_INIT_FUNCS(phalcon_http_response_method_entry){
 	PHP_ME(Phalcon_Http_Response, sendCookies, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, send, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Http_Response, setFileToSend, arginfo_phalcon_http_response_setfiletosend, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, setStreamContent, arginfo_phalcon_http_response_setstreamcontent, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Http_Response, getStreamContent, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -186,3 +186,106 @@ void phalcon_realpath(zval *return_value, zval *filename TSRMLS_DC) {
 
 	RETURN_FALSE;
 }
+
+/**
+ * Returns a string identifying the current version of a file (modification time, size and inode),
+ * false is returned if the file cannot be stat'ed
+ */
+void phalcon_file_stamp(zval *return_value, zval *filename TSRMLS_DC) {
+
+	struct stat sb;
+	char stamp[96];
+	int length;
+
+	if (Z_TYPE_P(filename) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	if (VCWD_STAT(Z_STRVAL_P(filename), &sb) != 0) {
+		RETURN_FALSE;
+	}
+
+	length = snprintf(stamp, sizeof(stamp), "%ld:%ld:%ld", (long) sb.st_mtime, (long) sb.st_size, (long) sb.st_ino);
+	RETURN_STRINGL(stamp, length, 1);
+}
+
+/**
+ * Scans a directory recursively, the callback receives every directory (before its entries) and
+ * every file found with its path relative to the directory scanned. Hidden entries are skipped
+ */
+static int phalcon_file_scan_tree(HashTable *visited, const char *directory, const char *relative, phalcon_file_scan_callback callback, void *arg, int options TSRMLS_DC){
+
+	char resolved[MAXPATHLEN];
+	php_stream *stream;
+	php_stream_dirent entry;
+	php_stream_statbuf ssb;
+	char *path, *name;
+	uint path_length, name_length;
+
+	/**
+	 * Directories reached again through symbolic links are only scanned once, a link to a
+	 * parent directory would never end otherwise
+	 */
+	if (VCWD_REALPATH(directory, resolved)) {
+		if (zend_hash_exists(visited, resolved, strlen(resolved) + 1)) {
+			return SUCCESS;
+		}
+		zend_hash_add_empty_element(visited, resolved, strlen(resolved) + 1);
+	}
+
+	stream = php_stream_opendir(directory, options, NULL);
+	if (!stream) {
+		return FAILURE;
+	}
+
+	if (php_stream_stat_path_ex(directory, 0, &ssb, NULL) == 0) {
+		callback(directory, strlen(directory), relative, strlen(relative), &ssb, arg TSRMLS_CC);
+	}
+
+	while (php_stream_readdir(stream, &entry)) {
+
+		/**
+		 * This includes '.' and '..'
+		 */
+		if (entry.d_name[0] == '.') {
+			continue;
+		}
+
+		path_length = spprintf(&path, 0, "%s%s", directory, entry.d_name);
+
+		if (php_stream_stat_path_ex(path, 0, &ssb, NULL) == 0) {
+			if (S_ISDIR(ssb.sb.st_mode)) {
+				efree(path);
+				spprintf(&path, 0, "%s%s%c", directory, entry.d_name, DEFAULT_SLASH);
+				spprintf(&name, 0, "%s%s/", relative, entry.d_name);
+				phalcon_file_scan_tree(visited, path, name, callback, arg, options TSRMLS_CC);
+			} else {
+				name_length = spprintf(&name, 0, "%s%s", relative, entry.d_name);
+				callback(path, path_length, name, name_length, &ssb, arg TSRMLS_CC);
+			}
+			efree(name);
+		}
+
+		efree(path);
+	}
+
+	php_stream_closedir(stream);
+
+	return SUCCESS;
+}
+
+/**
+ * Scans a directory tree, the directories visited are tracked by their real path. Returns
+ * FAILURE if the directory cannot be opened
+ */
+int phalcon_file_scan(const char *directory, phalcon_file_scan_callback callback, void *arg, int options TSRMLS_DC){
+
+	HashTable visited;
+	int status;
+
+	zend_hash_init(&visited, 16, NULL, NULL, 0);
+	status = phalcon_file_scan_tree(&visited, directory, "", callback, arg, options TSRMLS_CC);
+	zend_hash_destroy(&visited);
+
+	return status;
+}
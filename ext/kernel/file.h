@@ -23,6 +23,10 @@ extern void phalcon_fix_path(zval **return_value, zval *path, zval *directory_se
 extern void phalcon_prepare_virtual_path(zval *return_value, zval *path, zval *virtual_separator TSRMLS_DC);
 extern void phalcon_unique_path_key(zval *return_value, zval *path TSRMLS_DC);
 extern void phalcon_realpath(zval *return_value, zval *filename TSRMLS_DC);
+extern void phalcon_file_stamp(zval *return_value, zval *filename TSRMLS_DC);
+
+typedef void (*phalcon_file_scan_callback)(const char *path, uint path_length, const char *relative, uint relative_length, php_stream_statbuf *ssb, void *arg TSRMLS_DC);
+extern int phalcon_file_scan(const char *directory, phalcon_file_scan_callback callback, void *arg, int options TSRMLS_DC);
 
 #ifdef TSRM_WIN32
 #define PHALCON_DIRECTORY_SEPARATOR "\\"
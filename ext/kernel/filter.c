@@ -34,6 +34,12 @@
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /**
  * Filter alphanum string
  */
@@ -172,6 +178,239 @@ char *phalcon_longtohex(unsigned long value) {
 	return estrndup(ptr, end - ptr);
 }
 
+/**
+ * Checks if a character is left as it is by the escapers, the whitelist is used by escapeJs
+ * and escapeHtmlAttr
+ */
+static inline int phalcon_escape_is_safe(unsigned long value, int use_whitelist) {
+
+	if ((value >= 'A' && value <= 'Z') || (value >= 'a' && value <= 'z') || (value >= '0' && value <= '9')) {
+		return 1;
+	}
+
+	if (use_whitelist) {
+		switch (value) {
+			case ' ':
+			case '/':
+			case '*':
+			case '+':
+			case '-':
+			case '\t':
+			case '\n':
+			case '^':
+			case '$':
+			case '!':
+			case '?':
+			case '\\':
+			case '#':
+			case '}':
+			case '{':
+			case ')':
+			case '(':
+			case ']':
+			case '[':
+			case '.':
+			case ',':
+			case ':':
+			case ';':
+			case '_':
+				return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Appends a code point as an escape sequence, the hexadecimal digits are written without allocations
+ */
+static inline void phalcon_escape_append(smart_str *escaped_str, unsigned long value, char *escape_char, unsigned int escape_length, char escape_extra) {
+
+	static const char digits[] = "0123456789abcdef";
+	char buf[(sizeof(unsigned long) << 1) + 1];
+	char *ptr, *end;
+
+	end = ptr = buf + sizeof(buf);
+	do {
+		*--ptr = digits[value % 16];
+		value /= 16;
+	} while (ptr > buf && value);
+
+	smart_str_appendl(escaped_str, escape_char, escape_length);
+	smart_str_appendl(escaped_str, ptr, end - ptr);
+	if (escape_extra != '\0') {
+		smart_str_appendc(escaped_str, escape_extra);
+	}
+}
+
+/**
+ * Returns the number of bytes at the beginning of 'str' that are known to be alphanumeric
+ * ASCII characters, whole vectors are checked at once so the result is a multiple of the
+ * vector size and zero if vector instructions are not available
+ */
+static inline unsigned int phalcon_escape_alnum_span(const unsigned char *str, unsigned int length) {
+
+	unsigned int i = 0;
+
+#if defined(__AVX2__)
+	const __m256i case_bit = _mm256_set1_epi8(0x20);
+	const __m256i before_a = _mm256_set1_epi8('a' - 1), after_z = _mm256_set1_epi8('z' + 1);
+	const __m256i before_0 = _mm256_set1_epi8('0' - 1), after_9 = _mm256_set1_epi8('9' + 1);
+	__m256i chunk, folded, alpha, digit;
+
+	for (; i + 32 <= length; i += 32) {
+		chunk = _mm256_loadu_si256((const __m256i *) (str + i));
+		folded = _mm256_or_si256(chunk, case_bit);
+		alpha = _mm256_and_si256(_mm256_cmpgt_epi8(folded, before_a), _mm256_cmpgt_epi8(after_z, folded));
+		digit = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, before_0), _mm256_cmpgt_epi8(after_9, chunk));
+		if ((unsigned int) _mm256_movemask_epi8(_mm256_or_si256(alpha, digit)) != 0xFFFFFFFFU) {
+			break;
+		}
+	}
+#elif defined(__SSE2__)
+	const __m128i case_bit = _mm_set1_epi8(0x20);
+	const __m128i before_a = _mm_set1_epi8('a' - 1), after_z = _mm_set1_epi8('z' + 1);
+	const __m128i before_0 = _mm_set1_epi8('0' - 1), after_9 = _mm_set1_epi8('9' + 1);
+	__m128i chunk, folded, alpha, digit;
+
+	for (; i + 16 <= length; i += 16) {
+		chunk = _mm_loadu_si128((const __m128i *) (str + i));
+		folded = _mm_or_si128(chunk, case_bit);
+		alpha = _mm_and_si128(_mm_cmpgt_epi8(folded, before_a), _mm_cmpgt_epi8(after_z, folded));
+		digit = _mm_and_si128(_mm_cmpgt_epi8(chunk, before_0), _mm_cmpgt_epi8(after_9, chunk));
+		if (_mm_movemask_epi8(_mm_or_si128(alpha, digit)) != 0xFFFF) {
+			break;
+		}
+	}
+#endif
+
+	return i;
+}
+
+/**
+ * Checks if a string has characters that must be escaped by phalcon_escape_multi, vectors of
+ * alphanumeric characters are skipped and the rest is checked character by character
+ */
+int phalcon_escape_needed(zval *param, int use_whitelist) {
+
+	const unsigned char *str;
+	unsigned int i = 0, end, length;
+
+	if (Z_TYPE_P(param) != IS_STRING) {
+		return 1;
+	}
+
+	str = (const unsigned char *) Z_STRVAL_P(param);
+	length = Z_STRLEN_P(param);
+
+	while (i < length) {
+
+		i += phalcon_escape_alnum_span(str + i, length - i);
+
+		end = i + 32;
+		if (end > length) {
+			end = length;
+		}
+
+		for (; i < end; i++) {
+			if (!phalcon_escape_is_safe(str[i], use_whitelist)) {
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Escapes an UTF-8 string producing the same result phalcon_escape_multi produces for its
+ * UTF-32 representation, this avoids the conversion with mb_convert_encoding. FAILURE is
+ * returned if the string is not valid UTF-8 so the caller can convert it
+ */
+int phalcon_escape_utf8(zval *return_value, zval *param, char *escape_char, unsigned int escape_length, char escape_extra, int use_whitelist) {
+
+	const unsigned char *str;
+	unsigned int i = 0, length, needed, j;
+	unsigned long value, minimum;
+	smart_str escaped_str = {0};
+
+	if (Z_TYPE_P(param) != IS_STRING || Z_STRLEN_P(param) <= 0) {
+		return FAILURE;
+	}
+
+	str = (const unsigned char *) Z_STRVAL_P(param);
+	length = Z_STRLEN_P(param);
+
+	while (i < length) {
+
+		value = str[i];
+
+		if (value < 0x80) {
+			needed = 0;
+			minimum = 0;
+		} else if ((value & 0xE0) == 0xC0) {
+			value &= 0x1F;
+			needed = 1;
+			minimum = 0x80;
+		} else if ((value & 0xF0) == 0xE0) {
+			value &= 0x0F;
+			needed = 2;
+			minimum = 0x800;
+		} else if ((value & 0xF8) == 0xF0) {
+			value &= 0x07;
+			needed = 3;
+			minimum = 0x10000;
+		} else {
+			smart_str_free(&escaped_str);
+			return FAILURE;
+		}
+
+		if (i + needed >= length && needed) {
+			smart_str_free(&escaped_str);
+			return FAILURE;
+		}
+
+		for (j = 1; j <= needed; j++) {
+			if ((str[i + j] & 0xC0) != 0x80) {
+				smart_str_free(&escaped_str);
+				return FAILURE;
+			}
+			value = (value << 6) | (str[i + j] & 0x3F);
+		}
+
+		/**
+		 * Overlong sequences, surrogates and code points out of range are not valid UTF-8
+		 */
+		if (value < minimum || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+			smart_str_free(&escaped_str);
+			return FAILURE;
+		}
+
+		i += needed + 1;
+
+		/**
+		 * CSS 2.1 section 4.1.3: "It is undefined in CSS 2.1 what happens if a
+		 * style sheet does contain a character with Unicode codepoint zero."
+		 */
+		if (value == '\0') {
+			smart_str_free(&escaped_str);
+			ZVAL_FALSE(return_value);
+			return SUCCESS;
+		}
+
+		if (phalcon_escape_is_safe(value, use_whitelist)) {
+			smart_str_appendc(&escaped_str, (unsigned char) value);
+		} else {
+			phalcon_escape_append(&escaped_str, value, escape_char, escape_length, escape_extra);
+		}
+	}
+
+	smart_str_0(&escaped_str);
+	ZVAL_STRINGL(return_value, escaped_str.c, escaped_str.len, 0);
+
+	return SUCCESS;
+}
+
 /**
  * Perform escaping of non-alphanumeric characters to different formats
  */
@@ -180,7 +419,7 @@ void phalcon_escape_multi(zval *return_value, zval *param, char *escape_char, un
 	unsigned int i;
 	zval copy;
 	smart_str escaped_str = {0};
-	char machine_little_endian, *hex;
+	char machine_little_endian;
 	int big_endian_long_map[4];
 	int use_copy = 0, machine_endian_check = 1;
 	int issigned = 0;
@@ -244,70 +483,17 @@ void phalcon_escape_multi(zval *return_value, zval *param, char *escape_char, un
 		}
 
 		/**
-		 * Alphanumeric characters are not escaped
+		 * Alphanumeric characters and characters in the whitelist are left as they are
 		 */
-		if ((value >= 'A' && value <= 'Z') || (value >= 'a' && value <= 'z')) {
+		if (phalcon_escape_is_safe(value, use_whitelist)) {
 			smart_str_appendc(&escaped_str, (unsigned char) value);
 			continue;
 		}
 
 		/**
-		 * Escape numbers here
+		 * Append the character as an hexadecimal escape sequence
 		 */
-		if (value >= '0' && value <= '9') {
-			smart_str_appendc(&escaped_str, (unsigned char) value);
-			continue;
-		}
-
-		/**
-		 * Chararters in the whitelist are leave as they are
-		 */
-		if (use_whitelist) {
-			switch (value) {
-				case ' ':
-				case '/':
-				case '*':
-				case '+':
-				case '-':
-				case '\t':
-				case '\n':
-				case '^':
-				case '$':
-				case '!':
-				case '?':
-				case '\\':
-				case '#':
-				case '}':
-				case '{':
-				case ')':
-				case '(':
-				case ']':
-				case '[':
-				case '.':
-				case ',':
-				case ':':
-				case ';':
-				case '_':
-					smart_str_appendc(&escaped_str, (unsigned char) value);
-					continue;
-			}
-		}
-
-		/**
-		 * Convert character to hexadecimal
-		 */
-		hex = phalcon_longtohex(value);
-
-		/**
-		 * Append the escaped character
-		 */
-		smart_str_appendl(&escaped_str, escape_char, escape_length);
-		smart_str_appendl(&escaped_str, hex, strlen(hex));
-		if (escape_extra != '\0') {
-			smart_str_appendc(&escaped_str, escape_extra);
-		}
-
-		efree(hex);
+		phalcon_escape_append(&escaped_str, value, escape_char, escape_length, escape_extra);
 	}
 
 	if (use_copy) {
@@ -332,6 +518,13 @@ void phalcon_escape_css(zval *return_value, zval *param) {
 	phalcon_escape_multi(return_value, param, "\\", sizeof("\\")-1, ' ', 0);
 }
 
+/**
+ * Escapes non-alphanumeric characters of an UTF-8 string to \HH+
+ */
+int phalcon_escape_css_utf8(zval *return_value, zval *param) {
+	return phalcon_escape_utf8(return_value, param, "\\", sizeof("\\")-1, ' ', 0);
+}
+
 /**
  * Escapes non-alphanumeric characters to \xHH+
  */
@@ -339,6 +532,13 @@ void phalcon_escape_js(zval *return_value, zval *param) {
 	phalcon_escape_multi(return_value, param, "\\x", sizeof("\\x")-1, '\0', 1);
 }
 
+/**
+ * Escapes non-alphanumeric characters of an UTF-8 string to \xHH+
+ */
+int phalcon_escape_js_utf8(zval *return_value, zval *param) {
+	return phalcon_escape_utf8(return_value, param, "\\x", sizeof("\\x")-1, '\0', 1);
+}
+
 /**
  * Escapes non-alphanumeric characters to &xHH;
  */
@@ -346,6 +546,13 @@ void phalcon_escape_htmlattr(zval *return_value, zval *param) {
 	phalcon_escape_multi(return_value, param, "&#x", sizeof("&#x")-1, ';', 1);
 }
 
+/**
+ * Escapes non-alphanumeric characters of an UTF-8 string to &xHH;
+ */
+int phalcon_escape_htmlattr_utf8(zval *return_value, zval *param) {
+	return phalcon_escape_utf8(return_value, param, "&#x", sizeof("&#x")-1, ';', 1);
+}
+
 /**
  * Escapes HTML replacing special chars by entities
  */
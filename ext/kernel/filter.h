@@ -28,4 +28,9 @@ extern void phalcon_is_basic_charset(zval *return_value, zval *param);
 extern void phalcon_escape_css(zval *return_value, zval *param);
 extern void phalcon_escape_js(zval *return_value, zval *param);
 extern void phalcon_escape_htmlattr(zval *return_value, zval *param);
+extern int phalcon_escape_needed(zval *param, int use_whitelist);
+extern int phalcon_escape_utf8(zval *return_value, zval *param, char *escape_char, unsigned int escape_length, char escape_extra, int use_whitelist);
+extern int phalcon_escape_css_utf8(zval *return_value, zval *param);
+extern int phalcon_escape_js_utf8(zval *return_value, zval *param);
+extern int phalcon_escape_htmlattr_utf8(zval *return_value, zval *param);
 extern void phalcon_escape_html(zval *return_value, zval *str, zval *quote_style, zval *charset TSRMLS_DC);
\ No newline at end of file
@@ -66,6 +66,13 @@ void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC) {
 
 	/* DB options */
 	phalcon_globals->db.escape_identifiers = 1;
+
+	/* Logger options */
+	phalcon_globals->logger_flush_registered = 0;
+	phalcon_globals->logger_buffers = NULL;
+
+	/* Router options */
+	phalcon_globals->router_generation = 0;
 }
 
 /**
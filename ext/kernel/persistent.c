@@ -24,35 +24,363 @@
 #include "php.h"
 #include "php_phalcon.h"
 
-/* represents a connection to a database */
-struct _phalcon_persist_obj {
-	char *data;
-} phalcon_persist_obj;
+#include "kernel/main.h"
+#include "kernel/persistent.h"
 
-int phalcon_persistent_fetch(zval *return_value, zval *service TSRMLS_DC){
-	zend_rsrc_list_entry *le;
+#ifdef ZTS
+#define PHALCON_PERSISTENT_LOCK(cache) tsrm_mutex_lock(cache->mutex)
+#define PHALCON_PERSISTENT_UNLOCK(cache) tsrm_mutex_unlock(cache->mutex)
+#else
+#define PHALCON_PERSISTENT_LOCK(cache)
+#define PHALCON_PERSISTENT_UNLOCK(cache)
+#endif
+
+static void phalcon_persistent_zval_dtor(void *data){
+	phalcon_persistent_zval_free(*((zval **) data));
+}
+
+/**
+ * Copies a zval into persistent memory, only nulls, scalars, strings and arrays of them
+ * can be copied, NULL is returned for any other value
+ */
+zval *phalcon_persistent_zval(zval *value){
+
+	zval *copy, **item, *item_copy;
+	HashTable *source;
+	HashPosition pos;
+	char *str_key;
+	uint str_key_length;
+	ulong num_key;
+
+	copy = pemalloc(sizeof(zval), 1);
+	INIT_PZVAL(copy);
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+		case IS_BOOL:
+		case IS_LONG:
+		case IS_DOUBLE:
+			ZVAL_COPY_VALUE(copy, value);
+			break;
+
+		case IS_STRING:
+			Z_TYPE_P(copy) = IS_STRING;
+			Z_STRLEN_P(copy) = Z_STRLEN_P(value);
+			Z_STRVAL_P(copy) = pemalloc(Z_STRLEN_P(value) + 1, 1);
+			memcpy(Z_STRVAL_P(copy), Z_STRVAL_P(value), Z_STRLEN_P(value) + 1);
+			break;
+
+		case IS_ARRAY:
+			source = Z_ARRVAL_P(value);
+			Z_TYPE_P(copy) = IS_ARRAY;
+			Z_ARRVAL_P(copy) = pemalloc(sizeof(HashTable), 1);
+			zend_hash_init(Z_ARRVAL_P(copy), zend_hash_num_elements(source), NULL, phalcon_persistent_zval_dtor, 1);
+
+			zend_hash_internal_pointer_reset_ex(source, &pos);
+			while (zend_hash_get_current_data_ex(source, (void **) &item, &pos) == SUCCESS) {
+
+				item_copy = phalcon_persistent_zval(*item);
+				if (!item_copy) {
+					phalcon_persistent_zval_free(copy);
+					return NULL;
+				}
+
+				if (zend_hash_get_current_key_ex(source, &str_key, &str_key_length, &num_key, 0, &pos) == HASH_KEY_IS_STRING) {
+					/* Interned keys are stored by reference and could be released at the end of the request */
+					if (IS_INTERNED(str_key)) {
+						str_key = estrndup(str_key, str_key_length - 1);
+						zend_hash_update(Z_ARRVAL_P(copy), str_key, str_key_length, &item_copy, sizeof(zval *), NULL);
+						efree(str_key);
+					} else {
+						zend_hash_update(Z_ARRVAL_P(copy), str_key, str_key_length, &item_copy, sizeof(zval *), NULL);
+					}
+				} else {
+					zend_hash_index_update(Z_ARRVAL_P(copy), num_key, &item_copy, sizeof(zval *), NULL);
+				}
+
+				zend_hash_move_forward_ex(source, &pos);
+			}
+			break;
+
+		default:
+			pefree(copy, 1);
+			return NULL;
+	}
+
+	return copy;
+}
+
+/**
+ * Releases a zval created by phalcon_persistent_zval
+ */
+void phalcon_persistent_zval_free(zval *value){
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			pefree(Z_STRVAL_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			zend_hash_destroy(Z_ARRVAL_P(value));
+			pefree(Z_ARRVAL_P(value), 1);
+			break;
+	}
+
+	pefree(value, 1);
+}
+
+/**
+ * Copies a persistent zval back to the request memory
+ */
+void phalcon_persistent_zval_copy(zval *destiny, zval *value){
+
+	zval **item, *item_copy;
+	HashTable *source;
+	HashPosition pos;
+	char *str_key;
+	uint str_key_length;
+	ulong num_key;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			ZVAL_STRINGL(destiny, Z_STRVAL_P(value), Z_STRLEN_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			source = Z_ARRVAL_P(value);
+			array_init_size(destiny, zend_hash_num_elements(source));
+
+			zend_hash_internal_pointer_reset_ex(source, &pos);
+			while (zend_hash_get_current_data_ex(source, (void **) &item, &pos) == SUCCESS) {
+
+				MAKE_STD_ZVAL(item_copy);
+				phalcon_persistent_zval_copy(item_copy, *item);
+
+				if (zend_hash_get_current_key_ex(source, &str_key, &str_key_length, &num_key, 0, &pos) == HASH_KEY_IS_STRING) {
+					zend_hash_update(Z_ARRVAL_P(destiny), str_key, str_key_length, &item_copy, sizeof(zval *), NULL);
+				} else {
+					zend_hash_index_update(Z_ARRVAL_P(destiny), num_key, &item_copy, sizeof(zval *), NULL);
+				}
+
+				zend_hash_move_forward_ex(source, &pos);
+			}
+			break;
+
+		default:
+			ZVAL_COPY_VALUE(destiny, value);
+	}
+}
+
+static void phalcon_persistent_cache_unlink(phalcon_persistent_cache *cache, phalcon_persistent_cache_entry *entry){
+
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	} else {
+		cache->head = entry->next;
+	}
+
+	if (entry->next) {
+		entry->next->prev = entry->prev;
+	} else {
+		cache->tail = entry->prev;
+	}
+
+	entry->prev = NULL;
+	entry->next = NULL;
+}
+
+static void phalcon_persistent_cache_link(phalcon_persistent_cache *cache, phalcon_persistent_cache_entry *entry){
+
+	entry->prev = NULL;
+	entry->next = cache->head;
+	if (cache->head) {
+		cache->head->prev = entry;
+	}
+	cache->head = entry;
+
+	if (!cache->tail) {
+		cache->tail = entry;
+	}
+}
+
+static void phalcon_persistent_cache_entry_dtor(void *data){
 
-	/* try to find if we already have this link in our persistent list */
-	if (zend_hash_find(&EG(persistent_list), Z_STRVAL_P(service), Z_STRLEN_P(service)+1, (void **) &le)==FAILURE) {
+	phalcon_persistent_cache_entry *entry = *((phalcon_persistent_cache_entry **) data);
 
+	phalcon_persistent_zval_free(entry->value);
+	pefree(entry->key, 1);
+	pefree(entry, 1);
+}
+
+/**
+ * Allocates a cache able to hold up to 'size' entries, a size of zero disables the cache
+ */
+phalcon_persistent_cache *phalcon_persistent_cache_init(ulong size){
+
+	phalcon_persistent_cache *cache;
+
+	if (!size) {
+		return NULL;
+	}
+
+	cache = pemalloc(sizeof(phalcon_persistent_cache), 1);
+	memset(cache, 0, sizeof(phalcon_persistent_cache));
+
+	zend_hash_init(&cache->entries, size < 1024 ? size : 1024, NULL, phalcon_persistent_cache_entry_dtor, 1);
+	cache->size = size;
+
+#ifdef ZTS
+	cache->mutex = tsrm_mutex_alloc();
+#endif
+
+	return cache;
+}
+
+/**
+ * Releases a cache and all of its entries
+ */
+void phalcon_persistent_cache_destroy(phalcon_persistent_cache *cache){
+
+	if (!cache) {
+		return;
 	}
+
+	zend_hash_destroy(&cache->entries);
+
+#ifdef ZTS
+	tsrm_mutex_free(cache->mutex);
+#endif
+
+	pefree(cache, 1);
 }
 
-int phalcon_persistent_store(zval *service, zval *object TSRMLS_DC){
+/**
+ * Copies the value stored under 'key' into return_value, the entry becomes the most recently used
+ */
+int phalcon_persistent_cache_fetch(zval *return_value, phalcon_persistent_cache *cache, const char *key, uint key_length){
 
-	//pdo_dbh_t *dbh = NULL;
+	phalcon_persistent_cache_entry **entry;
 
-	//zend_object_store_set_object(object, dbh TSRMLS_CC);
+	if (!cache || !key_length) {
+		return FAILURE;
+	}
 
+	PHALCON_PERSISTENT_LOCK(cache);
 
-	zend_rsrc_list_entry new_le;
+	if (zend_hash_find(&cache->entries, key, key_length, (void **) &entry) == FAILURE) {
+		cache->misses++;
+		PHALCON_PERSISTENT_UNLOCK(cache);
+		return FAILURE;
+	}
 
-	Z_TYPE(new_le) = 1;
-	new_le.ptr = pestrdup("hello", 1);
-	if (zend_hash_update(&EG(persistent_list), Z_STRVAL_P(service), Z_STRLEN_P(service)+1, (void *) &new_le, sizeof(zend_rsrc_list_entry), NULL)==FAILURE) {
-		//goto err;
+	if (cache->head != *entry) {
+		phalcon_persistent_cache_unlink(cache, *entry);
+		phalcon_persistent_cache_link(cache, *entry);
 	}
 
-	//phalcon_persistent_store
+	phalcon_persistent_zval_copy(return_value, (*entry)->value);
+	cache->hits++;
+
+	PHALCON_PERSISTENT_UNLOCK(cache);
+
+	return SUCCESS;
+}
+
+/**
+ * Stores a copy of 'value' under 'key' evicting the least recently used entries when the cache is full
+ */
+int phalcon_persistent_cache_store(phalcon_persistent_cache *cache, const char *key, uint key_length, zval *value){
+
+	phalcon_persistent_cache_entry *entry, **current;
+	zval *copy;
+
+	if (!cache || !key_length) {
+		return FAILURE;
+	}
+
+	copy = phalcon_persistent_zval(value);
+	if (!copy) {
+		return FAILURE;
+	}
+
+	PHALCON_PERSISTENT_LOCK(cache);
+
+	if (zend_hash_find(&cache->entries, key, key_length, (void **) &current) == SUCCESS) {
+		phalcon_persistent_zval_free((*current)->value);
+		(*current)->value = copy;
+		if (cache->head != *current) {
+			phalcon_persistent_cache_unlink(cache, *current);
+			phalcon_persistent_cache_link(cache, *current);
+		}
+		PHALCON_PERSISTENT_UNLOCK(cache);
+		return SUCCESS;
+	}
+
+	while (cache->tail && zend_hash_num_elements(&cache->entries) >= cache->size) {
+		entry = cache->tail;
+		phalcon_persistent_cache_unlink(cache, entry);
+		zend_hash_del(&cache->entries, entry->key, entry->key_length);
+		cache->evictions++;
+	}
+
+	entry = pemalloc(sizeof(phalcon_persistent_cache_entry), 1);
+	entry->key = pemalloc(key_length, 1);
+	memcpy(entry->key, key, key_length);
+	entry->key_length = key_length;
+	entry->value = copy;
+
+	zend_hash_update(&cache->entries, entry->key, key_length, &entry, sizeof(phalcon_persistent_cache_entry *), NULL);
+	phalcon_persistent_cache_link(cache, entry);
+
+	PHALCON_PERSISTENT_UNLOCK(cache);
+
+	return SUCCESS;
+}
+
+/**
+ * Removes every entry in the cache
+ */
+void phalcon_persistent_cache_clear(phalcon_persistent_cache *cache){
+
+	if (!cache) {
+		return;
+	}
+
+	PHALCON_PERSISTENT_LOCK(cache);
+
+	zend_hash_clean(&cache->entries);
+	cache->head = NULL;
+	cache->tail = NULL;
+
+	PHALCON_PERSISTENT_UNLOCK(cache);
+}
+
+/**
+ * Returns an array with the size, number of entries, hits, misses and evictions of a cache
+ */
+void phalcon_persistent_cache_stats(zval *return_value, phalcon_persistent_cache *cache){
+
+	array_init_size(return_value, 5);
+
+	if (!cache) {
+		add_assoc_long_ex(return_value, SS("size"), 0);
+		add_assoc_long_ex(return_value, SS("count"), 0);
+		add_assoc_long_ex(return_value, SS("hits"), 0);
+		add_assoc_long_ex(return_value, SS("misses"), 0);
+		add_assoc_long_ex(return_value, SS("evictions"), 0);
+		return;
+	}
+
+	PHALCON_PERSISTENT_LOCK(cache);
+
+	add_assoc_long_ex(return_value, SS("size"), cache->size);
+	add_assoc_long_ex(return_value, SS("count"), zend_hash_num_elements(&cache->entries));
+	add_assoc_long_ex(return_value, SS("hits"), cache->hits);
+	add_assoc_long_ex(return_value, SS("misses"), cache->misses);
+	add_assoc_long_ex(return_value, SS("evictions"), cache->evictions);
 
+	PHALCON_PERSISTENT_UNLOCK(cache);
 }
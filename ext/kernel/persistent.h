@@ -1,3 +1,69 @@
 
-int phalcon_persistent_store(zval *service, zval *object TSRMLS_DC);
-int phalcon_persistent_fetch(zval *return_value, zval *service TSRMLS_DC);
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/** Entry of a persistent cache, entries are linked from the most to the least recently used */
+typedef struct _phalcon_persistent_cache_entry {
+	char *key;
+	uint key_length;
+	zval *value;
+	struct _phalcon_persistent_cache_entry *prev;
+	struct _phalcon_persistent_cache_entry *next;
+} phalcon_persistent_cache_entry;
+
+/** Process-wide LRU cache whose values survive between requests */
+typedef struct _phalcon_persistent_cache {
+	HashTable entries;
+	phalcon_persistent_cache_entry *head;
+	phalcon_persistent_cache_entry *tail;
+	ulong size;
+	ulong hits;
+	ulong misses;
+	ulong evictions;
+#ifdef ZTS
+	MUTEX_T mutex;
+#endif
+} phalcon_persistent_cache;
+
+/** Intermediate representations of PHQL statements */
+extern phalcon_persistent_cache *phalcon_orm_ir_cache;
+
+/** Manifests of precompiled views */
+extern phalcon_persistent_cache *phalcon_mvc_view_manifest_cache;
+
+/** Compiled ACL lists */
+extern phalcon_persistent_cache *phalcon_acl_compiled_cache;
+
+/** Handler class names resolved by the dispatchers */
+extern phalcon_persistent_cache *phalcon_dispatcher_cache;
+
+/** Compiled service definitions */
+extern phalcon_persistent_cache *phalcon_di_compiled_cache;
+
+/** Persistent zvals */
+extern zval *phalcon_persistent_zval(zval *value);
+extern void phalcon_persistent_zval_free(zval *value);
+extern void phalcon_persistent_zval_copy(zval *destiny, zval *value);
+
+/** Persistent caches */
+extern phalcon_persistent_cache *phalcon_persistent_cache_init(ulong size);
+extern void phalcon_persistent_cache_destroy(phalcon_persistent_cache *cache);
+extern int phalcon_persistent_cache_fetch(zval *return_value, phalcon_persistent_cache *cache, const char *key, uint key_length);
+extern int phalcon_persistent_cache_store(phalcon_persistent_cache *cache, const char *key, uint key_length, zval *value);
+extern void phalcon_persistent_cache_clear(phalcon_persistent_cache *cache);
+extern void phalcon_persistent_cache_stats(zval *return_value, phalcon_persistent_cache *cache);
@@ -0,0 +1,492 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+
+#include "ext/standard/php_var.h"
+#include "ext/standard/php_smart_str.h"
+
+#ifndef PHP_WIN32
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "kernel/main.h"
+#include "kernel/shm.h"
+
+#if !defined(MAP_ANON) && defined(MAP_ANONYMOUS)
+#define MAP_ANON MAP_ANONYMOUS
+#endif
+
+/** Number of attempts to acquire the lock before giving up */
+#define PHALCON_SHM_SPINS 1024
+
+#define PHALCON_SHM_ALIGN(size) (((size) + 7) & ~((size_t) 7))
+#define PHALCON_SHM_BUCKETS(shm) ((volatile size_t *) ((char *) (shm) + PHALCON_SHM_ALIGN(sizeof(phalcon_shm_header))))
+#define PHALCON_SHM_ENTRY(shm, offset) ((phalcon_shm_entry *) ((char *) (shm) + (offset)))
+#define PHALCON_SHM_ENTRY_KEY(entry) ((char *) (entry) + sizeof(phalcon_shm_entry))
+#define PHALCON_SHM_ENTRY_COUNTER(entry) ((volatile long *) ((char *) (entry) + PHALCON_SHM_ALIGN(sizeof(phalcon_shm_entry) + (entry)->key_length)))
+
+#ifndef PHP_WIN32
+
+/**
+ * Removes every entry of a shared segment, the caller must hold the lock. The generation is
+ * odd while the entries are removed so readers started before never return them
+ */
+static void phalcon_shm_clear(phalcon_shm_header *shm){
+
+	if (!(shm->generation & 1)) {
+		shm->generation++;
+	}
+	__sync_synchronize();
+
+	memset((void *) PHALCON_SHM_BUCKETS(shm), 0, (shm->mask + 1) * sizeof(size_t));
+	shm->used = shm->start;
+	shm->entries = 0;
+
+	__sync_synchronize();
+	shm->generation++;
+}
+
+/**
+ * Writers are serialized by a spin lock holding the pid of its owner, readers never take it.
+ * A lock whose owner died is taken over and, as the dead writer could have left an entry half
+ * written, the segment is cleared
+ */
+static int phalcon_shm_lock(phalcon_shm_header *shm){
+
+	int i, pid = (int) getpid(), owner;
+
+	for (i = 0; i < PHALCON_SHM_SPINS; i++) {
+
+		owner = __sync_val_compare_and_swap(&shm->lock, 0, pid);
+		if (!owner) {
+			return 1;
+		}
+
+		if (owner != pid && kill((pid_t) owner, 0) == -1 && errno == ESRCH) {
+			if (__sync_bool_compare_and_swap(&shm->lock, owner, pid)) {
+				phalcon_shm_clear(shm);
+				return 1;
+			}
+		}
+
+		sched_yield();
+	}
+
+	return 0;
+}
+
+static void phalcon_shm_unlock(phalcon_shm_header *shm){
+	__sync_lock_release(&shm->lock);
+}
+
+#endif
+
+/**
+ * Maps an anonymous shared segment, processes forked after this call see the same memory.
+ * NULL is returned if the segment cannot be created
+ */
+phalcon_shm_header *phalcon_shm_init(size_t size){
+
+#ifndef PHP_WIN32
+
+	phalcon_shm_header *shm;
+	ulong buckets = 64;
+	size_t start;
+	void *segment;
+
+	while (buckets < size / 1024 && buckets < 65536) {
+		buckets <<= 1;
+	}
+
+	start = PHALCON_SHM_ALIGN(sizeof(phalcon_shm_header)) + buckets * sizeof(size_t);
+	if (size <= start + sizeof(phalcon_shm_entry)) {
+		return NULL;
+	}
+
+	segment = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0);
+	if (segment == MAP_FAILED) {
+		return NULL;
+	}
+
+	shm = (phalcon_shm_header *) segment;
+	memset(shm, 0, start);
+	shm->size = size;
+	shm->start = start;
+	shm->used = start;
+	shm->mask = buckets - 1;
+
+	return shm;
+#else
+	return NULL;
+#endif
+}
+
+/**
+ * Unmaps a shared segment
+ */
+void phalcon_shm_destroy(phalcon_shm_header *shm){
+
+#ifndef PHP_WIN32
+	if (shm) {
+		munmap((void *) shm, shm->size);
+	}
+#endif
+}
+
+/**
+ * Reads a value from a shared segment without locking it. The generation is checked before
+ * and after copying the serialized value so entries removed meanwhile are never returned
+ */
+int phalcon_shm_fetch(zval *return_value, phalcon_shm_header *shm, const char *key, uint key_length TSRMLS_DC){
+
+#ifndef PHP_WIN32
+
+	phalcon_shm_entry *entry;
+	ulong generation, hash;
+	size_t offset, end;
+	char *data = NULL;
+	uint data_length = 0;
+	const unsigned char *p;
+	php_unserialize_data_t var_hash;
+	int status;
+
+	if (!shm) {
+		return FAILURE;
+	}
+
+	generation = shm->generation;
+	if (generation & 1) {
+		return FAILURE;
+	}
+
+	__sync_synchronize();
+
+	hash = zend_inline_hash_func(key, key_length);
+	offset = PHALCON_SHM_BUCKETS(shm)[hash & shm->mask];
+
+	/**
+	 * Entries always point to previous entries, so a torn read cannot loop forever
+	 */
+	while (offset >= shm->start && offset + sizeof(phalcon_shm_entry) <= shm->size) {
+
+		entry = PHALCON_SHM_ENTRY(shm, offset);
+
+		if (entry->hash == hash && entry->key_length == key_length) {
+			end = offset + sizeof(phalcon_shm_entry) + entry->key_length + entry->data_length;
+			if (end <= shm->size && !memcmp(PHALCON_SHM_ENTRY_KEY(entry), key, key_length)) {
+				data_length = entry->data_length;
+				data = emalloc(data_length + 1);
+				memcpy(data, PHALCON_SHM_ENTRY_KEY(entry) + key_length, data_length);
+				data[data_length] = '\0';
+				break;
+			}
+		}
+
+		if (entry->next >= offset) {
+			break;
+		}
+		offset = entry->next;
+	}
+
+	__sync_synchronize();
+
+	if (!data) {
+		return FAILURE;
+	}
+
+	if (shm->generation != generation) {
+		efree(data);
+		return FAILURE;
+	}
+
+	p = (const unsigned char *) data;
+
+	PHP_VAR_UNSERIALIZE_INIT(var_hash);
+	status = php_var_unserialize(&return_value, &p, p + data_length, &var_hash TSRMLS_CC) ? SUCCESS : FAILURE;
+	PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+
+	if (status == FAILURE) {
+		zval_dtor(return_value);
+		ZVAL_NULL(return_value);
+	}
+
+	efree(data);
+	return status;
+#else
+	return FAILURE;
+#endif
+}
+
+/**
+ * Appends a value to a shared segment, values already stored in the current generation are
+ * not replaced. FAILURE is returned if the segment is full or busy
+ */
+int phalcon_shm_store(phalcon_shm_header *shm, const char *key, uint key_length, zval *value TSRMLS_DC){
+
+#ifndef PHP_WIN32
+
+	phalcon_shm_entry *entry;
+	volatile size_t *buckets;
+	smart_str buffer = {0};
+	php_serialize_data_t var_hash;
+	size_t needed, offset;
+	ulong hash;
+	int status = FAILURE;
+
+	if (!shm) {
+		return FAILURE;
+	}
+
+	PHP_VAR_SERIALIZE_INIT(var_hash);
+	php_var_serialize(&buffer, &value, &var_hash TSRMLS_CC);
+	PHP_VAR_SERIALIZE_DESTROY(var_hash);
+
+	if (!buffer.c) {
+		return FAILURE;
+	}
+
+	needed = PHALCON_SHM_ALIGN(sizeof(phalcon_shm_entry) + key_length + buffer.len);
+	hash = zend_inline_hash_func(key, key_length);
+
+	if (phalcon_shm_lock(shm)) {
+
+		if (!(shm->generation & 1) && shm->used + needed <= shm->size) {
+
+			buckets = PHALCON_SHM_BUCKETS(shm);
+
+			offset = buckets[hash & shm->mask];
+			while (offset) {
+				entry = PHALCON_SHM_ENTRY(shm, offset);
+				if (entry->hash == hash && entry->key_length == key_length) {
+					if (!memcmp(PHALCON_SHM_ENTRY_KEY(entry), key, key_length)) {
+						status = SUCCESS;
+						break;
+					}
+				}
+				offset = entry->next;
+			}
+
+			if (status == FAILURE) {
+
+				offset = shm->used;
+
+				entry = PHALCON_SHM_ENTRY(shm, offset);
+				entry->next = buckets[hash & shm->mask];
+				entry->hash = hash;
+				entry->key_length = key_length;
+				entry->data_length = buffer.len;
+				memcpy(PHALCON_SHM_ENTRY_KEY(entry), key, key_length);
+				memcpy(PHALCON_SHM_ENTRY_KEY(entry) + key_length, buffer.c, buffer.len);
+
+				/**
+				 * The entry must be complete before readers can reach it
+				 */
+				__sync_synchronize();
+
+				buckets[hash & shm->mask] = offset;
+				shm->used = offset + needed;
+				shm->entries++;
+
+				status = SUCCESS;
+			}
+		}
+
+		phalcon_shm_unlock(shm);
+	}
+
+	smart_str_free(&buffer);
+	return status;
+#else
+	return FAILURE;
+#endif
+}
+
+/**
+ * Removes every entry of a shared segment starting a new generation
+ */
+int phalcon_shm_invalidate(phalcon_shm_header *shm){
+
+#ifndef PHP_WIN32
+
+	if (!shm) {
+		return FAILURE;
+	}
+
+	if (!phalcon_shm_lock(shm)) {
+		return FAILURE;
+	}
+
+	phalcon_shm_clear(shm);
+
+	phalcon_shm_unlock(shm);
+
+	return SUCCESS;
+#else
+	return FAILURE;
+#endif
+}
+
+#ifndef PHP_WIN32
+
+/**
+ * Looks up a counter in a shared segment without locking it
+ */
+static phalcon_shm_entry *phalcon_shm_find_counter(phalcon_shm_header *shm, const char *key, uint key_length, ulong hash){
+
+	phalcon_shm_entry *entry;
+	size_t offset;
+
+	offset = PHALCON_SHM_BUCKETS(shm)[hash & shm->mask];
+	while (offset >= shm->start && offset + sizeof(phalcon_shm_entry) <= shm->size) {
+
+		entry = PHALCON_SHM_ENTRY(shm, offset);
+		if (entry->hash == hash && entry->key_length == key_length && entry->data_length == sizeof(long)) {
+			if (!memcmp(PHALCON_SHM_ENTRY_KEY(entry), key, key_length)) {
+				return entry;
+			}
+		}
+
+		if (entry->next >= offset) {
+			break;
+		}
+		offset = entry->next;
+	}
+
+	return NULL;
+}
+
+#endif
+
+/**
+ * Returns the value of a counter stored in a shared segment, the counter is created with zero
+ * the first time and incremented atomically if 'increment' is set. The generation of the segment
+ * is returned in 'generation' since counters restart when the segment is cleared. -1 is returned
+ * if the counter cannot be created
+ */
+long phalcon_shm_counter(phalcon_shm_header *shm, const char *key, uint key_length, int increment, ulong *generation){
+
+#ifndef PHP_WIN32
+
+	phalcon_shm_entry *entry;
+	volatile size_t *buckets;
+	size_t needed, offset;
+	ulong hash, current;
+	long value = -1;
+
+	if (!shm) {
+		return -1;
+	}
+
+	hash = zend_inline_hash_func(key, key_length);
+
+	/**
+	 * Counters already created are read without taking the lock
+	 */
+	if (!increment) {
+		current = shm->generation;
+		if (!(current & 1)) {
+			__sync_synchronize();
+			entry = phalcon_shm_find_counter(shm, key, key_length, hash);
+			if (entry) {
+				value = *PHALCON_SHM_ENTRY_COUNTER(entry);
+				__sync_synchronize();
+				if (shm->generation == current) {
+					*generation = current >> 1;
+					return value;
+				}
+				value = -1;
+			}
+		}
+	}
+
+	if (!phalcon_shm_lock(shm)) {
+		return -1;
+	}
+
+	buckets = PHALCON_SHM_BUCKETS(shm);
+
+	entry = phalcon_shm_find_counter(shm, key, key_length, hash);
+	if (!entry) {
+		needed = PHALCON_SHM_ALIGN(sizeof(phalcon_shm_entry) + key_length) + sizeof(long);
+		if (shm->used + needed <= shm->size) {
+
+			offset = shm->used;
+
+			entry = PHALCON_SHM_ENTRY(shm, offset);
+			entry->next = buckets[hash & shm->mask];
+			entry->hash = hash;
+			entry->key_length = key_length;
+			entry->data_length = sizeof(long);
+			memcpy(PHALCON_SHM_ENTRY_KEY(entry), key, key_length);
+			*PHALCON_SHM_ENTRY_COUNTER(entry) = 0;
+
+			__sync_synchronize();
+
+			buckets[hash & shm->mask] = offset;
+			shm->used = offset + needed;
+			shm->entries++;
+		}
+	}
+
+	if (entry) {
+		if (increment) {
+			value = __sync_add_and_fetch(PHALCON_SHM_ENTRY_COUNTER(entry), 1);
+		} else {
+			value = *PHALCON_SHM_ENTRY_COUNTER(entry);
+		}
+		*generation = shm->generation >> 1;
+	}
+
+	phalcon_shm_unlock(shm);
+
+	return value;
+#else
+	return -1;
+#endif
+}
+
+/**
+ * Returns the size, used bytes, number of entries and generation of a shared segment
+ */
+void phalcon_shm_stats(zval *return_value, phalcon_shm_header *shm){
+
+	array_init_size(return_value, 4);
+
+	if (shm) {
+		add_assoc_long(return_value, "size", shm->size);
+		add_assoc_long(return_value, "used", shm->used);
+		add_assoc_long(return_value, "count", shm->entries);
+		add_assoc_long(return_value, "generation", shm->generation >> 1);
+	} else {
+		add_assoc_long(return_value, "size", 0);
+		add_assoc_long(return_value, "used", 0);
+		add_assoc_long(return_value, "count", 0);
+		add_assoc_long(return_value, "generation", 0);
+	}
+}
@@ -0,0 +1,52 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/**
+ * Header of a shared memory segment, it is followed by the buckets and the entries.
+ * The generation is odd while the segment is being invalidated, the lock holds the pid of the writer
+ */
+typedef struct _phalcon_shm_header {
+	volatile ulong generation;
+	volatile int lock;
+	size_t size;
+	size_t start;
+	volatile size_t used;
+	volatile ulong entries;
+	ulong mask;
+} phalcon_shm_header;
+
+/** Entry of a shared memory segment, the key and the serialized value follow it */
+typedef struct _phalcon_shm_entry {
+	size_t next;
+	ulong hash;
+	uint key_length;
+	uint data_length;
+} phalcon_shm_entry;
+
+/** Models meta-data shared by every process forked from the same parent */
+extern phalcon_shm_header *phalcon_orm_metadata_shm;
+
+/** Shared memory segments */
+extern phalcon_shm_header *phalcon_shm_init(size_t size);
+extern void phalcon_shm_destroy(phalcon_shm_header *shm);
+extern int phalcon_shm_fetch(zval *return_value, phalcon_shm_header *shm, const char *key, uint key_length TSRMLS_DC);
+extern int phalcon_shm_store(phalcon_shm_header *shm, const char *key, uint key_length, zval *value TSRMLS_DC);
+extern int phalcon_shm_invalidate(phalcon_shm_header *shm);
+extern long phalcon_shm_counter(phalcon_shm_header *shm, const char *key, uint key_length, int increment, ulong *generation);
+extern void phalcon_shm_stats(zval *return_value, phalcon_shm_header *shm);
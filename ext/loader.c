@@ -64,8 +64,109 @@
  * //Requiring this class will automatically include file vendor/example/adapter/Some.php
  * $adapter = Example\Adapter\Some();
  *</code>
+ *
+ * A class map can be generated scanning the registered directories once, then classes are
+ * resolved with a single lookup without checking the file system
+ *
+ *<code>
+ * $loader->setClassMapFile('app/cache/classmap.php', Phalcon\Loader::CLASSMAP_CHECK_MTIME);
+ *</code>
  */
 
+typedef struct {
+	zval *classes;
+	zval *directories;
+	zval *extensions;
+	const char *prefix;
+	char separator;
+} phalcon_loader_scan_context;
+
+/**
+ * Adds every file having one of the extensions to the class map, the modification time of every
+ * directory scanned is stored to detect stale class maps
+ */
+static void phalcon_loader_scan_entry(const char *path, uint path_length, const char *relative, uint relative_length, php_stream_statbuf *ssb, void *arg TSRMLS_DC){
+
+	phalcon_loader_scan_context *context = (phalcon_loader_scan_context *) arg;
+	const char *base, *dot;
+	char *class_name, *c;
+	uint class_name_length;
+	zval **extension;
+	HashPosition pos;
+
+	if (S_ISDIR(ssb->sb.st_mode)) {
+		add_assoc_long_ex(context->directories, (char *) path, path_length + 1, ssb->sb.st_mtime);
+		return;
+	}
+
+	base = strrchr(relative, '/');
+	base = base ? base + 1 : relative;
+
+	dot = strrchr(base, '.');
+	if (!dot || dot == base) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(context->extensions), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(context->extensions), (void**) &extension, &pos) == SUCCESS) {
+
+		if (Z_TYPE_PP(extension) == IS_STRING && Z_STRLEN_PP(extension) == strlen(dot + 1) && !memcmp(Z_STRVAL_PP(extension), dot + 1, Z_STRLEN_PP(extension))) {
+
+			class_name_length = spprintf(&class_name, 0, "%s%.*s", context->prefix, (int) (dot - relative), relative);
+			for (c = class_name + strlen(context->prefix); *c; c++) {
+				if (*c == '/') {
+					*c = context->separator;
+				}
+			}
+
+			/**
+			 * The first directory registered having the class wins, just like in autoLoad
+			 */
+			if (!zend_hash_exists(Z_ARRVAL_P(context->classes), class_name, class_name_length + 1)) {
+				add_assoc_stringl_ex(context->classes, class_name, class_name_length + 1, (char *) path, path_length, 1);
+			}
+			efree(class_name);
+			break;
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(context->extensions), &pos);
+	}
+}
+
+/**
+ * Scans a registered directory, sub-directories are mapped to the prefix joined by the separator
+ */
+static void phalcon_loader_scan_directory(zval *classes, zval *directories, const char *directory, const char *prefix, char separator, zval *extensions TSRMLS_DC){
+
+	phalcon_loader_scan_context context;
+
+	context.classes = classes;
+	context.directories = directories;
+	context.extensions = extensions;
+	context.prefix = prefix;
+	context.separator = separator;
+
+	phalcon_file_scan(directory, phalcon_loader_scan_entry, &context, 0 TSRMLS_CC);
+}
+
+/**
+ * Returns the modification time of a file or -1 if it cannot be checked
+ */
+static long phalcon_loader_mtime(zval *path TSRMLS_DC){
+
+	php_stream_statbuf ssb;
+
+	if (Z_TYPE_P(path) != IS_STRING) {
+		return -1;
+	}
+
+	if (php_stream_stat_path_ex(Z_STRVAL_P(path), 0, &ssb, NULL)) {
+		return -1;
+	}
+
+	return (long) ssb.sb.st_mtime;
+}
+
 
 /**
  * Phalcon\Loader initializer
@@ -83,6 +184,15 @@ PHALCON_INIT_CLASS(Phalcon_Loader){
 	zend_declare_property_null(phalcon_loader_ce, SL("_namespaces"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_loader_ce, SL("_directories"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_loader_ce, SL("_registered"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_loader_ce, SL("_classMapFile"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_loader_ce, SL("_classMapCheck"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_loader_ce, SL("_classMap"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_loader_ce, SL("_hits"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_loader_ce, SL("_misses"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_loader_ce, SL("_stats"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	zend_declare_class_constant_long(phalcon_loader_ce, SL("CLASSMAP_CHECK_NONE"), 0 TSRMLS_CC);
+	zend_declare_class_constant_long(phalcon_loader_ce, SL("CLASSMAP_CHECK_MTIME"), 1 TSRMLS_CC);
 
 	zend_class_implements(phalcon_loader_ce TSRMLS_CC, 1, phalcon_events_eventsawareinterface_ce);
 
@@ -436,6 +546,7 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 	zval *fixed_directory = NULL, *extension = NULL, *complete_path = NULL;
 	zval *pseudo_separator, *prefixes, *no_prefix_class = NULL;
 	zval *ds_class_name, *ns_class_name, *directories;
+	zval *class_map_file, *class_map;
 	HashTable *ah0, *ah1, *ah2, *ah3, *ah4, *ah5;
 	HashPosition hp0, hp1, hp2, hp3, hp4, hp5;
 	zval **hd;
@@ -477,6 +588,46 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 		}
 	}
 	
+	/** 
+	 * When a class map is used it is the only source of classes, the file system is not checked
+	 */
+	PHALCON_OBS_VAR(class_map_file);
+	phalcon_read_property_this(&class_map_file, this_ptr, SL("_classMapFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(class_map_file) != IS_NULL) {
+	
+		PHALCON_INIT_VAR(class_map);
+		PHALCON_CALL_METHOD(class_map, this_ptr, "getclassmap");
+		if (phalcon_array_isset(class_map, class_name)) {
+	
+			phalcon_property_incr(this_ptr, SL("_hits") TSRMLS_CC);
+	
+			PHALCON_OBS_NVAR(file_path);
+			phalcon_array_fetch(&file_path, class_map, class_name, PH_NOISY_CC);
+			if (Z_TYPE_P(events_manager) == IS_OBJECT) {
+				phalcon_update_property_this(this_ptr, SL("_foundPath"), file_path TSRMLS_CC);
+	
+				PHALCON_INIT_NVAR(event_name);
+				ZVAL_STRING(event_name, "loader:pathFound", 1);
+				PHALCON_CALL_METHOD_PARAMS_3_NORETURN(events_manager, "fire", event_name, this_ptr, file_path);
+			}
+	
+			if (phalcon_require(file_path TSRMLS_CC) == FAILURE) {
+				return;
+			}
+			RETURN_MM_TRUE;
+		}
+	
+		phalcon_property_incr(this_ptr, SL("_misses") TSRMLS_CC);
+	
+		if (Z_TYPE_P(events_manager) == IS_OBJECT) {
+			PHALCON_INIT_NVAR(event_name);
+			ZVAL_STRING(event_name, "loader:afterCheckClass", 1);
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(events_manager, "fire", event_name, this_ptr, class_name);
+		}
+	
+		RETURN_MM_FALSE;
+	}
+	
 	PHALCON_OBS_VAR(extensions);
 	phalcon_read_property_this(&extensions, this_ptr, SL("_extensions"), PH_NOISY_CC);
 	
@@ -557,6 +708,7 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 						/** 
 						 * This is probably a good path, let's check if the file exist
 						 */
+						phalcon_property_incr(this_ptr, SL("_stats") TSRMLS_CC);
 						if (phalcon_file_exists(file_path TSRMLS_CC) == SUCCESS) {
 							if (Z_TYPE_P(events_manager) == IS_OBJECT) {
 								phalcon_update_property_this(this_ptr, SL("_foundPath"), file_path TSRMLS_CC);
@@ -654,6 +806,7 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 							PHALCON_CALL_METHOD_PARAMS_3_NORETURN(events_manager, "fire", event_name, this_ptr, file_path);
 						}
 	
+						phalcon_property_incr(this_ptr, SL("_stats") TSRMLS_CC);
 						if (phalcon_file_exists(file_path TSRMLS_CC) == SUCCESS) {
 	
 							/** 
@@ -740,6 +893,7 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 				/** 
 				 * Check in every directory if the class exists here
 				 */
+				phalcon_property_incr(this_ptr, SL("_stats") TSRMLS_CC);
 				if (phalcon_file_exists(file_path TSRMLS_CC) == SUCCESS) {
 	
 					/** 
@@ -812,3 +966,327 @@ PHP_METHOD(Phalcon_Loader, getCheckedPath){
 	RETURN_MEMBER(this_ptr, "_checkedPath");
 }
 
+
+/**
+ * Sets the file where the class map is stored, the class map is generated the first time a class is
+ * requested if the file doesn't exist. With Phalcon\Loader::CLASSMAP_CHECK_MTIME the class map is
+ * generated again when any of the scanned directories is modified
+ *
+ * @param string $classMapFile
+ * @param int $check
+ * @return Phalcon\Loader
+ */
+PHP_METHOD(Phalcon_Loader, setClassMapFile){
+
+	zval *class_map_file, *check = NULL;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &class_map_file, &check);
+	
+	if (Z_TYPE_P(class_map_file) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "Parameter $classMapFile must be a string");
+		return;
+	}
+	phalcon_update_property_this(this_ptr, SL("_classMapFile"), class_map_file TSRMLS_CC);
+	
+	if (check) {
+		phalcon_update_property_long(this_ptr, SL("_classMapCheck"), phalcon_get_intval(check) TSRMLS_CC);
+	}
+	
+	phalcon_update_property_null(this_ptr, SL("_classMap") TSRMLS_CC);
+	
+	RETURN_THIS();
+}
+
+/**
+ * Returns the file where the class map is stored
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Loader, getClassMapFile){
+
+
+	RETURN_MEMBER(this_ptr, "_classMapFile");
+}
+
+/**
+ * Returns the class map, it's read from the class map file or generated if the file doesn't exist
+ * or is stale
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Loader, getClassMap){
+
+	zval *class_map, *class_map_file, *data, *check, *directories;
+	zval *mtime = NULL, *directory = NULL, *classes;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int stale = 0;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(class_map);
+	phalcon_read_property_this(&class_map, this_ptr, SL("_classMap"), PH_NOISY_CC);
+	if (Z_TYPE_P(class_map) == IS_ARRAY) { 
+		RETURN_CCTOR(class_map);
+	}
+	
+	PHALCON_OBS_VAR(class_map_file);
+	phalcon_read_property_this(&class_map_file, this_ptr, SL("_classMapFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(class_map_file) == IS_STRING) {
+	
+		phalcon_property_incr(this_ptr, SL("_stats") TSRMLS_CC);
+		if (phalcon_file_exists(class_map_file TSRMLS_CC) == SUCCESS) {
+	
+			PHALCON_INIT_VAR(data);
+			if (phalcon_require_ret(data, class_map_file TSRMLS_CC) == FAILURE) {
+				return;
+			}
+	
+			if (phalcon_array_isset_string(data, SS("classes"))) {
+				if (phalcon_array_isset_string(data, SS("directories"))) {
+	
+					/** 
+					 * The class map is stale if any of the directories scanned was modified
+					 */
+					PHALCON_OBS_VAR(check);
+					phalcon_read_property_this(&check, this_ptr, SL("_classMapCheck"), PH_NOISY_CC);
+					if (PHALCON_IS_LONG(check, 1)) {
+	
+						PHALCON_OBS_VAR(directories);
+						phalcon_array_fetch_string(&directories, data, SL("directories"), PH_NOISY_CC);
+	
+						phalcon_is_iterable(directories, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+						while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+							PHALCON_GET_FOREACH_KEY(directory, ah0, hp0);
+							PHALCON_GET_FOREACH_VALUE(mtime);
+	
+							phalcon_property_incr(this_ptr, SL("_stats") TSRMLS_CC);
+							if (phalcon_loader_mtime(directory TSRMLS_CC) != phalcon_get_intval(mtime)) {
+								stale = 1;
+								break;
+							}
+	
+							zend_hash_move_forward_ex(ah0, &hp0);
+						}
+					}
+	
+					if (!stale) {
+						PHALCON_OBS_VAR(classes);
+						phalcon_array_fetch_string(&classes, data, SL("classes"), PH_NOISY_CC);
+						phalcon_update_property_this(this_ptr, SL("_classMap"), classes TSRMLS_CC);
+						RETURN_CCTOR(classes);
+					}
+				}
+			}
+		}
+	}
+	
+	PHALCON_INIT_NVAR(class_map);
+	PHALCON_CALL_METHOD(class_map, this_ptr, "buildclassmap");
+	
+	RETURN_CCTOR(class_map);
+}
+
+/**
+ * Scans the registered namespaces, prefixes and directories generating the class map, it is written
+ * to the class map file if there is one
+ *
+ *<code>
+ * $loader->registerNamespaces(array('Example\Base' => 'vendor/example/base/'));
+ * print_r($loader->buildClassMap());
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Loader, buildClassMap){
+
+	zval *classes, *directories, *extensions, *ds, *namespaces;
+	zval *prefixes, *registered_directories, *prefix = NULL, *directory = NULL;
+	zval *fixed_directory = NULL, *class_prefix = NULL, *class_map_file;
+	zval *data, *to_string, *export, *php_export, *status = NULL;
+	zval *unique_id, *temporary_file;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(classes);
+	array_init(classes);
+	
+	PHALCON_INIT_VAR(directories);
+	array_init(directories);
+	
+	PHALCON_OBS_VAR(extensions);
+	phalcon_read_property_this(&extensions, this_ptr, SL("_extensions"), PH_NOISY_CC);
+	if (Z_TYPE_P(extensions) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "Extensions must be an Array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(ds);
+	ZVAL_STRING(ds, PHALCON_DIRECTORY_SEPARATOR, 1);
+	
+	/** 
+	 * Classes are added in the same order autoLoad checks them: namespaces, prefixes and directories
+	 */
+	PHALCON_OBS_VAR(namespaces);
+	phalcon_read_property_this(&namespaces, this_ptr, SL("_namespaces"), PH_NOISY_CC);
+	if (Z_TYPE_P(namespaces) == IS_ARRAY) { 
+	
+		phalcon_is_iterable(namespaces, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_KEY(prefix, ah0, hp0);
+			PHALCON_GET_FOREACH_VALUE(directory);
+	
+			PHALCON_INIT_NVAR(fixed_directory);
+			phalcon_fix_path(&fixed_directory, directory, ds TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(class_prefix);
+			PHALCON_CONCAT_VS(class_prefix, prefix, "\\");
+			phalcon_loader_scan_directory(classes, directories, Z_STRVAL_P(fixed_directory), Z_STRVAL_P(class_prefix), '\\', extensions TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+	}
+	
+	/** 
+	 * Prefixes are separated from the rest of the class name by the pseudo-separator
+	 */
+	PHALCON_OBS_VAR(prefixes);
+	phalcon_read_property_this(&prefixes, this_ptr, SL("_prefixes"), PH_NOISY_CC);
+	if (Z_TYPE_P(prefixes) == IS_ARRAY) { 
+	
+		phalcon_is_iterable(prefixes, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_KEY(prefix, ah1, hp1);
+			PHALCON_GET_FOREACH_VALUE(directory);
+	
+			PHALCON_INIT_NVAR(fixed_directory);
+			phalcon_fix_path(&fixed_directory, directory, ds TSRMLS_CC);
+	
+			if (phalcon_end_with_str(prefix, SL("_"))) {
+				PHALCON_CPY_WRT(class_prefix, prefix);
+			} else {
+				PHALCON_INIT_NVAR(class_prefix);
+				PHALCON_CONCAT_VS(class_prefix, prefix, "_");
+			}
+			phalcon_loader_scan_directory(classes, directories, Z_STRVAL_P(fixed_directory), Z_STRVAL_P(class_prefix), '_', extensions TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah1, &hp1);
+		}
+	
+	}
+	
+	/** 
+	 * Classes in directories can use both namespaces and pseudo-namespaces
+	 */
+	PHALCON_OBS_VAR(registered_directories);
+	phalcon_read_property_this(&registered_directories, this_ptr, SL("_directories"), PH_NOISY_CC);
+	if (Z_TYPE_P(registered_directories) == IS_ARRAY) { 
+	
+		phalcon_is_iterable(registered_directories, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(directory);
+	
+			PHALCON_INIT_NVAR(fixed_directory);
+			phalcon_fix_path(&fixed_directory, directory, ds TSRMLS_CC);
+			phalcon_loader_scan_directory(classes, directories, Z_STRVAL_P(fixed_directory), "", '\\', extensions TSRMLS_CC);
+			phalcon_loader_scan_directory(classes, directories, Z_STRVAL_P(fixed_directory), "", '_', extensions TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+	
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_classMap"), classes TSRMLS_CC);
+	
+	/** 
+	 * The class map is exported as a PHP file so opcode caches can keep it in memory
+	 */
+	PHALCON_OBS_VAR(class_map_file);
+	phalcon_read_property_this(&class_map_file, this_ptr, SL("_classMapFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(class_map_file) == IS_STRING) {
+	
+		PHALCON_INIT_VAR(data);
+		array_init_size(data, 2);
+		phalcon_array_update_string(&data, SL("classes"), &classes, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		phalcon_array_update_string(&data, SL("directories"), &directories, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(to_string);
+		ZVAL_BOOL(to_string, 1);
+	
+		PHALCON_INIT_VAR(export);
+		PHALCON_CALL_FUNC_PARAMS_2(export, "var_export", data, to_string);
+	
+		PHALCON_INIT_VAR(php_export);
+		PHALCON_CONCAT_SVS(php_export, "<?php return ", export, "; ");
+	
+		/**
+		 * The file is written aside and renamed, so other processes never include a partial one
+		 */
+		PHALCON_INIT_VAR(unique_id);
+		PHALCON_CALL_FUNC(unique_id, "uniqid");
+	
+		PHALCON_INIT_VAR(temporary_file);
+		PHALCON_CONCAT_VSVS(temporary_file, class_map_file, ".", unique_id, ".tmp");
+	
+		PHALCON_INIT_VAR(status);
+		PHALCON_CALL_FUNC_PARAMS_2(status, "file_put_contents", temporary_file, php_export);
+		if (PHALCON_IS_FALSE(status)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "The class map file cannot be written");
+			return;
+		}
+	
+		PHALCON_INIT_NVAR(status);
+		PHALCON_CALL_FUNC_PARAMS_2(status, "rename", temporary_file, class_map_file);
+		if (PHALCON_IS_FALSE(status)) {
+			VCWD_UNLINK(Z_STRVAL_P(temporary_file));
+			PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "The class map file cannot be written");
+			return;
+		}
+	}
+	
+	RETURN_CTOR(classes);
+}
+
+/**
+ * Returns the number of classes found in the class map (hits), classes not found in the class map
+ * (misses) and file system checks performed (stats)
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Loader, getStats){
+
+	zval *hits, *misses, *stats;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(hits);
+	phalcon_read_property_this(&hits, this_ptr, SL("_hits"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(misses);
+	phalcon_read_property_this(&misses, this_ptr, SL("_misses"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(stats);
+	phalcon_read_property_this(&stats, this_ptr, SL("_stats"), PH_NOISY_CC);
+	
+	array_init_size(return_value, 3);
+	phalcon_array_update_string(&return_value, SL("hits"), &hits, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("misses"), &misses, PH_COPY TSRMLS_CC);
+	phalcon_array_update_string(&return_value, SL("stats"), &stats, PH_COPY TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
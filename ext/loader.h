@@ -39,6 +39,11 @@ PHP_METHOD(Phalcon_Loader, unregister);
 PHP_METHOD(Phalcon_Loader, autoLoad);
 PHP_METHOD(Phalcon_Loader, getFoundPath);
 PHP_METHOD(Phalcon_Loader, getCheckedPath);
+PHP_METHOD(Phalcon_Loader, setClassMapFile);
+PHP_METHOD(Phalcon_Loader, getClassMapFile);
+PHP_METHOD(Phalcon_Loader, getClassMap);
+PHP_METHOD(Phalcon_Loader, buildClassMap);
+PHP_METHOD(Phalcon_Loader, getStats);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_seteventsmanager, 0, 0, 1)
 	ZEND_ARG_INFO(0, eventsManager)
@@ -72,6 +77,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_autoload, 0, 0, 1)
 	ZEND_ARG_INFO(0, className)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_setclassmapfile, 0, 0, 1)
+	ZEND_ARG_INFO(0, classMapFile)
+	ZEND_ARG_INFO(0, check)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_loader_method_entry){
 	PHP_ME(Phalcon_Loader, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Loader, setEventsManager, arginfo_phalcon_loader_seteventsmanager, ZEND_ACC_PUBLIC) 
@@ -91,6 +101,11 @@ PHALCON_INIT_FUNCS(phalcon_loader_method_entry){
 	PHP_ME(Phalcon_Loader, autoLoad, arginfo_phalcon_loader_autoload, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Loader, getFoundPath, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Loader, getCheckedPath, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Loader, setClassMapFile, arginfo_phalcon_loader_setclassmapfile, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Loader, getClassMapFile, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Loader, getClassMap, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Loader, buildClassMap, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Loader, getStats, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -37,10 +37,27 @@
 #include "kernel/fcall.h"
 #include "kernel/operators.h"
 
+#ifndef PHP_WIN32
+#include <unistd.h>
+#endif
+
 /**
  * Phalcon\Logger\Adapter
  *
  * Base class for Phalcon\Logger adapters
+ *
+ * Adapters writing to files and streams accept the options 'buffer', the size in bytes of a
+ * buffer where the messages are kept until it is full, and 'flushLevel', messages of this level
+ * or more severe are written at once with the pending ones (Phalcon\Logger::ERROR by default).
+ * Buffers are written with a single write when the logger is closed, destroyed or the request ends,
+ * even if it ends with a fatal error
+ *
+ *<code>
+ *	$logger = new \Phalcon\Logger\Adapter\File("app/logs/test.log", array(
+ *		'buffer' => 65536,
+ *		'flushLevel' => \Phalcon\Logger::WARNING
+ *	));
+ *</code>
  */
 
 
@@ -55,10 +72,256 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter){
 	zend_declare_property_null(phalcon_logger_adapter_ce, SL("_queue"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_logger_adapter_ce, SL("_formatter"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_long(phalcon_logger_adapter_ce, SL("_logLevel"), 9, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_logger_adapter_ce, SL("_bufferSize"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_logger_adapter_ce, SL("_flushLevel"), 3, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
 
+/**
+ * Buffer of an adapter, buffers are kept per request by the handle of their adapter. The adapter is
+ * not referenced, it is removed from the list by its destructor or when it is closed
+ */
+typedef struct {
+	zval adapter;
+	char *data;
+	size_t length;
+	size_t capacity;
+} phalcon_logger_buffer;
+
+static void phalcon_logger_buffer_dtor(void *data){
+
+	phalcon_logger_buffer *entry = (phalcon_logger_buffer *) data;
+
+	if (entry->data) {
+		efree(entry->data);
+	}
+}
+
+/**
+ * Returns the buffer of an adapter, a buffer is added for buffered adapters not having one yet
+ */
+static phalcon_logger_buffer *phalcon_logger_adapter_get_buffer(zval *this_ptr, int create TSRMLS_DC){
+
+	phalcon_logger_buffer *entry, new_entry;
+	HashTable *buffers;
+
+	buffers = PHALCON_GLOBAL(logger_buffers);
+	if (buffers && zend_hash_index_find(buffers, Z_OBJ_HANDLE_P(this_ptr), (void **) &entry) == SUCCESS) {
+		return entry;
+	}
+
+	if (!create) {
+		return NULL;
+	}
+
+	if (!buffers) {
+		ALLOC_HASHTABLE(buffers);
+		zend_hash_init(buffers, 8, NULL, phalcon_logger_buffer_dtor, 0);
+		PHALCON_GLOBAL(logger_buffers) = buffers;
+	}
+
+	new_entry.adapter = *this_ptr;
+	new_entry.data = NULL;
+	new_entry.length = 0;
+	new_entry.capacity = 0;
+
+	if (zend_hash_index_update(buffers, Z_OBJ_HANDLE_P(this_ptr), &new_entry, sizeof(phalcon_logger_buffer), (void **) &entry) == FAILURE) {
+		return NULL;
+	}
+
+	return entry;
+}
+
+/**
+ * Reads the buffering options of an adapter
+ */
+void phalcon_logger_adapter_options(zval *this_ptr, zval *options TSRMLS_DC){
+
+	zval **value;
+
+	if (Z_TYPE_P(options) != IS_ARRAY) {
+		return;
+	}
+
+	if (zend_hash_find(Z_ARRVAL_P(options), SS("buffer"), (void **) &value) == SUCCESS) {
+		zend_update_property_long(phalcon_logger_adapter_ce, this_ptr, SL("_bufferSize"), phalcon_get_intval(*value) TSRMLS_CC);
+	}
+
+	if (zend_hash_find(Z_ARRVAL_P(options), SS("flushLevel"), (void **) &value) == SUCCESS) {
+		zend_update_property_long(phalcon_logger_adapter_ce, this_ptr, SL("_flushLevel"), phalcon_get_intval(*value) TSRMLS_CC);
+	}
+
+	phalcon_logger_adapter_register(this_ptr TSRMLS_CC);
+}
+
+/**
+ * Adds a buffered adapter to the buffers of the request. Phalcon\Logger\Adapter::flushBuffers() is
+ * registered as a shutdown function the first time, destructors are skipped after a fatal error but
+ * shutdown functions still run, so the messages explaining the error are not lost
+ */
+void phalcon_logger_adapter_register(zval *this_ptr TSRMLS_DC){
+
+	zval *buffer_size, *function_name, *callback, *retval = NULL;
+	zval **params[1];
+
+	buffer_size = zend_read_property(phalcon_logger_adapter_ce, this_ptr, SL("_bufferSize"), 1 TSRMLS_CC);
+	if (phalcon_get_intval(buffer_size) <= 0) {
+		return;
+	}
+
+	phalcon_logger_adapter_get_buffer(this_ptr, 1 TSRMLS_CC);
+
+	if (PHALCON_GLOBAL(logger_flush_registered)) {
+		return;
+	}
+
+	MAKE_STD_ZVAL(function_name);
+	ZVAL_STRING(function_name, "register_shutdown_function", 1);
+
+	MAKE_STD_ZVAL(callback);
+	array_init_size(callback, 2);
+	add_next_index_stringl(callback, SL("Phalcon\\Logger\\Adapter"), 1);
+	add_next_index_stringl(callback, SL("flushBuffers"), 1);
+
+	params[0] = &callback;
+	if (call_user_function_ex(EG(function_table), NULL, function_name, &retval, 1, params, 1, NULL TSRMLS_CC) == SUCCESS) {
+		PHALCON_GLOBAL(logger_flush_registered) = 1;
+		if (retval) {
+			zval_ptr_dtor(&retval);
+		}
+	}
+
+	zval_ptr_dtor(&callback);
+	zval_ptr_dtor(&function_name);
+}
+
+/**
+ * Removes an adapter from the buffers of the request, the messages still pending are discarded
+ */
+void phalcon_logger_adapter_unregister(zval *this_ptr TSRMLS_DC){
+
+	if (PHALCON_GLOBAL(logger_buffers)) {
+		zend_hash_index_del(PHALCON_GLOBAL(logger_buffers), Z_OBJ_HANDLE_P(this_ptr));
+	}
+}
+
+/**
+ * Writes data to the stream of an adapter. Streams backed by a descriptor, as files opened in
+ * append mode, receive the data in a single write so concurrent processes never interleave
+ * partial lines
+ */
+int phalcon_logger_adapter_write(zval *handler, const char *data, size_t length TSRMLS_DC){
+
+	php_stream *stream;
+#ifndef PHP_WIN32
+	int fd;
+	ssize_t written;
+#endif
+
+	if (Z_TYPE_P(handler) != IS_RESOURCE) {
+		return FAILURE;
+	}
+
+	php_stream_from_zval_no_verify(stream, &handler);
+	if (!stream) {
+		return FAILURE;
+	}
+
+#ifndef PHP_WIN32
+	if (php_stream_can_cast(stream, PHP_STREAM_AS_FD) == SUCCESS) {
+		if (php_stream_cast(stream, PHP_STREAM_AS_FD, (void **) &fd, 0) == SUCCESS) {
+			while (length > 0) {
+				written = write(fd, data, length);
+				if (written < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					return FAILURE;
+				}
+				data += written;
+				length -= written;
+			}
+			return SUCCESS;
+		}
+	}
+#endif
+
+	return php_stream_write(stream, data, length) == length ? SUCCESS : FAILURE;
+}
+
+/**
+ * Writes the buffered messages of an adapter
+ */
+int phalcon_logger_adapter_flush(zval *this_ptr, zval *handler TSRMLS_DC){
+
+	phalcon_logger_buffer *entry;
+	int status = SUCCESS;
+
+	entry = phalcon_logger_adapter_get_buffer(this_ptr, 0 TSRMLS_CC);
+	if (entry && entry->length > 0) {
+		status = phalcon_logger_adapter_write(handler, entry->data, entry->length TSRMLS_CC);
+		entry->length = 0;
+	}
+
+	return status;
+}
+
+/**
+ * Adds a formatted message to the buffer of an adapter, the buffer is written when it is full
+ * or the message is severe enough. Unbuffered adapters write the message at once
+ */
+int phalcon_logger_adapter_buffer(zval *this_ptr, zval *handler, zval *message, zval *type TSRMLS_DC){
+
+	zval *buffer_size, *flush_level;
+	phalcon_logger_buffer *entry;
+	long size;
+	int status = SUCCESS;
+
+	if (Z_TYPE_P(message) != IS_STRING) {
+		return FAILURE;
+	}
+
+	buffer_size = zend_read_property(phalcon_logger_adapter_ce, this_ptr, SL("_bufferSize"), 1 TSRMLS_CC);
+	size = phalcon_get_intval(buffer_size);
+	if (size <= 0) {
+		return phalcon_logger_adapter_write(handler, Z_STRVAL_P(message), Z_STRLEN_P(message) TSRMLS_CC);
+	}
+
+	entry = phalcon_logger_adapter_get_buffer(this_ptr, 1 TSRMLS_CC);
+	if (!entry) {
+		return phalcon_logger_adapter_write(handler, Z_STRVAL_P(message), Z_STRLEN_P(message) TSRMLS_CC);
+	}
+
+	/**
+	 * Buffers are allocated with their whole size so appending never reallocates them
+	 */
+	if (entry->length + Z_STRLEN_P(message) > entry->capacity) {
+		status = phalcon_logger_adapter_flush(this_ptr, handler TSRMLS_CC);
+		if (Z_STRLEN_P(message) > size) {
+			return phalcon_logger_adapter_write(handler, Z_STRVAL_P(message), Z_STRLEN_P(message) TSRMLS_CC);
+		}
+
+		if (entry->capacity != (size_t) size) {
+			if (entry->data) {
+				efree(entry->data);
+			}
+			entry->data = emalloc(size);
+			entry->capacity = size;
+		}
+	}
+
+	memcpy(entry->data + entry->length, Z_STRVAL_P(message), Z_STRLEN_P(message));
+	entry->length += Z_STRLEN_P(message);
+
+	flush_level = zend_read_property(phalcon_logger_adapter_ce, this_ptr, SL("_flushLevel"), 1 TSRMLS_CC);
+	if (phalcon_get_intval(type) <= phalcon_get_intval(flush_level)) {
+		status = phalcon_logger_adapter_flush(this_ptr, handler TSRMLS_CC);
+	}
+
+	return status;
+}
+
 /**
  * Filters the logs sent to the handlers to be less or equals than a specific level
  *
@@ -396,3 +659,66 @@ PHP_METHOD(Phalcon_Logger_Adapter, log){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Clones the adapter without the pending messages, they are written by the original adapter only
+ */
+PHP_METHOD(Phalcon_Logger_Adapter, __clone){
+
+
+	phalcon_logger_adapter_unregister(this_ptr TSRMLS_CC);
+	phalcon_logger_adapter_register(this_ptr TSRMLS_CC);
+}
+
+/**
+ * Writes the buffered messages of every adapter alive. It is registered as a shutdown function by
+ * the buffered adapters, destroying them remains the usual way their buffers are written
+ */
+PHP_METHOD(Phalcon_Logger_Adapter, flushBuffers){
+
+	HashTable *buffers;
+	HashPosition pos;
+	phalcon_logger_buffer *entry;
+	zval *adapters, *adapter, **item;
+
+	buffers = PHALCON_GLOBAL(logger_buffers);
+	if (!buffers) {
+		return;
+	}
+
+	/**
+	 * The adapters are referenced while they are flushed, so flushing one of them never destroys
+	 * another adapter in the list
+	 */
+	MAKE_STD_ZVAL(adapters);
+	array_init_size(adapters, zend_hash_num_elements(buffers));
+
+	zend_hash_internal_pointer_reset_ex(buffers, &pos);
+	while (zend_hash_get_current_data_ex(buffers, (void**) &entry, &pos) == SUCCESS) {
+
+		if (entry->length > 0) {
+			MAKE_STD_ZVAL(adapter);
+			*adapter = entry->adapter;
+			zval_copy_ctor(adapter);
+			INIT_PZVAL(adapter);
+			add_next_index_zval(adapters, adapter);
+		}
+
+		zend_hash_move_forward_ex(buffers, &pos);
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(adapters), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(adapters), (void**) &item, &pos) == SUCCESS) {
+
+		if (zend_hash_exists(&Z_OBJCE_PP(item)->function_table, SS("flush"))) {
+			zend_call_method_with_0_params(item, Z_OBJCE_PP(item), NULL, "flush", NULL);
+			if (EG(exception)) {
+				break;
+			}
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(adapters), &pos);
+	}
+
+	zval_ptr_dtor(&adapters);
+}
+
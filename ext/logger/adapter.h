@@ -21,6 +21,13 @@ extern zend_class_entry *phalcon_logger_adapter_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Logger_Adapter);
 
+extern void phalcon_logger_adapter_options(zval *this_ptr, zval *options TSRMLS_DC);
+extern int phalcon_logger_adapter_write(zval *handler, const char *data, size_t length TSRMLS_DC);
+extern void phalcon_logger_adapter_register(zval *this_ptr TSRMLS_DC);
+extern void phalcon_logger_adapter_unregister(zval *this_ptr TSRMLS_DC);
+extern int phalcon_logger_adapter_flush(zval *this_ptr, zval *handler TSRMLS_DC);
+extern int phalcon_logger_adapter_buffer(zval *this_ptr, zval *handler, zval *message, zval *type TSRMLS_DC);
+
 PHP_METHOD(Phalcon_Logger_Adapter, setLogLevel);
 PHP_METHOD(Phalcon_Logger_Adapter, getLogLevel);
 PHP_METHOD(Phalcon_Logger_Adapter, setFormatter);
@@ -35,6 +42,8 @@ PHP_METHOD(Phalcon_Logger_Adapter, notice);
 PHP_METHOD(Phalcon_Logger_Adapter, warning);
 PHP_METHOD(Phalcon_Logger_Adapter, alert);
 PHP_METHOD(Phalcon_Logger_Adapter, log);
+PHP_METHOD(Phalcon_Logger_Adapter, __clone);
+PHP_METHOD(Phalcon_Logger_Adapter, flushBuffers);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_setloglevel, 0, 0, 1)
 	ZEND_ARG_INFO(0, level)
@@ -92,6 +101,8 @@ PHALCON_INIT_FUNCS(phalcon_logger_adapter_method_entry){
 	PHP_ME(Phalcon_Logger_Adapter, warning, arginfo_phalcon_logger_adapter_warning, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter, alert, arginfo_phalcon_logger_adapter_alert, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter, log, arginfo_phalcon_logger_adapter_log, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter, __clone, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter, flushBuffers, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_FE_END
 };
 
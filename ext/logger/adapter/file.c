@@ -118,6 +118,7 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, __construct){
 	phalcon_update_property_this(this_ptr, SL("_path"), name TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_options"), options TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_fileHandler"), handler TSRMLS_CC);
+	phalcon_logger_adapter_options(this_ptr, options TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -177,7 +178,7 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, logInternal){
 	
 	PHALCON_INIT_VAR(applied_format);
 	PHALCON_CALL_METHOD_PARAMS_3(applied_format, formatter, "format", message, type, time);
-	PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, applied_format);
+	phalcon_logger_adapter_buffer(this_ptr, file_handler, applied_format, type TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -195,12 +196,55 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, close){
 
 	PHALCON_OBS_VAR(file_handler);
 	phalcon_read_property_this(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
+	phalcon_logger_adapter_flush(this_ptr, file_handler TSRMLS_CC);
+	phalcon_logger_adapter_unregister(this_ptr TSRMLS_CC);
 	
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_FUNC_PARAMS_1(success, "fclose", file_handler);
 	RETURN_CCTOR(success);
 }
 
+/**
+ * Writes the buffered messages to the file
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_File, flush){
+
+	zval *file_handler;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(file_handler);
+	phalcon_read_property_this(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
+	if (phalcon_logger_adapter_flush(this_ptr, file_handler TSRMLS_CC) == SUCCESS) {
+		RETURN_MM_TRUE;
+	}
+	
+	RETURN_MM_FALSE;
+}
+
+/**
+ * Writes the buffered messages when the logger is destroyed, the messages pending when the request
+ * ends are written by the flush registered as shutdown function. Adapters overriding it must call it,
+ * the buffer of the adapter is released here
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_File, __destruct){
+
+	zval *file_handler;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(file_handler);
+	phalcon_read_property_this(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
+	if (Z_TYPE_P(file_handler) == IS_RESOURCE) {
+		phalcon_logger_adapter_flush(this_ptr, file_handler TSRMLS_CC);
+	}
+	phalcon_logger_adapter_unregister(this_ptr TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Opens the internal file handler after unserialization
  *
@@ -230,6 +274,7 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, __wakeup){
 	PHALCON_INIT_VAR(file_handler);
 	PHALCON_CALL_FUNC_PARAMS_2(file_handler, "fopen", path, mode);
 	phalcon_update_property_this(this_ptr, SL("_fileHandler"), file_handler TSRMLS_CC);
+	phalcon_logger_adapter_register(this_ptr TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -113,6 +113,7 @@ PHP_METHOD(Phalcon_Logger_Adapter_Stream, __construct){
 	}
 	
 	phalcon_update_property_this(this_ptr, SL("_stream"), stream TSRMLS_CC);
+	phalcon_logger_adapter_options(this_ptr, options TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -171,7 +172,7 @@ PHP_METHOD(Phalcon_Logger_Adapter_Stream, logInternal){
 	
 	PHALCON_INIT_VAR(applied_format);
 	PHALCON_CALL_METHOD_PARAMS_3(applied_format, formatter, "format", message, type, time);
-	PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", stream, applied_format);
+	phalcon_logger_adapter_buffer(this_ptr, stream, applied_format, type TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -189,9 +190,51 @@ PHP_METHOD(Phalcon_Logger_Adapter_Stream, close){
 
 	PHALCON_OBS_VAR(stream);
 	phalcon_read_property_this(&stream, this_ptr, SL("_stream"), PH_NOISY_CC);
+	phalcon_logger_adapter_flush(this_ptr, stream TSRMLS_CC);
+	phalcon_logger_adapter_unregister(this_ptr TSRMLS_CC);
 	
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_FUNC_PARAMS_1(success, "fclose", stream);
 	RETURN_CCTOR(success);
 }
 
+/**
+ * Writes the buffered messages to the stream
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_Stream, flush){
+
+	zval *stream;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(stream);
+	phalcon_read_property_this(&stream, this_ptr, SL("_stream"), PH_NOISY_CC);
+	if (phalcon_logger_adapter_flush(this_ptr, stream TSRMLS_CC) == SUCCESS) {
+		RETURN_MM_TRUE;
+	}
+	
+	RETURN_MM_FALSE;
+}
+
+/**
+ * Writes the buffered messages when the logger is destroyed, the messages pending when the request
+ * ends are written by the flush registered as shutdown function. Adapters overriding it must call it,
+ * the buffer of the adapter is released here
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_Stream, __destruct){
+
+	zval *stream;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(stream);
+	phalcon_read_property_this(&stream, this_ptr, SL("_stream"), PH_NOISY_CC);
+	if (Z_TYPE_P(stream) == IS_RESOURCE) {
+		phalcon_logger_adapter_flush(this_ptr, stream TSRMLS_CC);
+	}
+	phalcon_logger_adapter_unregister(this_ptr TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
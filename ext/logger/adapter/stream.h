@@ -25,6 +25,8 @@ PHP_METHOD(Phalcon_Logger_Adapter_Stream, __construct);
 PHP_METHOD(Phalcon_Logger_Adapter_Stream, getFormatter);
 PHP_METHOD(Phalcon_Logger_Adapter_Stream, logInternal);
 PHP_METHOD(Phalcon_Logger_Adapter_Stream, close);
+PHP_METHOD(Phalcon_Logger_Adapter_Stream, flush);
+PHP_METHOD(Phalcon_Logger_Adapter_Stream, __destruct);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_stream___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, name)
@@ -42,6 +44,8 @@ PHALCON_INIT_FUNCS(phalcon_logger_adapter_stream_method_entry){
 	PHP_ME(Phalcon_Logger_Adapter_Stream, getFormatter, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_Stream, logInternal, arginfo_phalcon_logger_adapter_stream_loginternal, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_Stream, close, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter_Stream, flush, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter_Stream, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR) 
 	PHP_FE_END
 };
 
@@ -36,6 +36,9 @@
 #include "kernel/string.h"
 #include "kernel/fcall.h"
 #include "kernel/concat.h"
+#include "kernel/operators.h"
+
+#include "ext/standard/php_smart_str.h"
 
 /**
  * Phalcon\Logger\Formatter\Line
@@ -53,12 +56,36 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Formatter_Line){
 
 	zend_declare_property_string(phalcon_logger_formatter_line_ce, SL("_dateFormat"), "D, d M y H:i:s O", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_logger_formatter_line_ce, SL("_format"), "[%date%][%type%] %message%", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_formatter_line_ce, SL("_cachedTimestamp"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_formatter_line_ce, SL("_cachedDate"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_logger_formatter_line_ce TSRMLS_CC, 1, phalcon_logger_formatterinterface_ce);
 
 	return SUCCESS;
 }
 
+/**
+ * Appends the string value of a zval to a line
+ */
+static void phalcon_logger_formatter_line_append(smart_str *line, zval *value){
+
+	zval copy;
+	int use_copy = 0;
+
+	if (Z_TYPE_P(value) == IS_STRING) {
+		smart_str_appendl(line, Z_STRVAL_P(value), Z_STRLEN_P(value));
+		return;
+	}
+
+	zend_make_printable_zval(value, &copy, &use_copy);
+	if (use_copy) {
+		smart_str_appendl(line, Z_STRVAL(copy), Z_STRLEN(copy));
+		zval_dtor(&copy);
+	} else {
+		smart_str_appendl(line, Z_STRVAL_P(value), Z_STRLEN_P(value));
+	}
+}
+
 /**
  * Phalcon\Logger\Formatter\Line construct
  *
@@ -135,6 +162,7 @@ PHP_METHOD(Phalcon_Logger_Formatter_Line, setDateFormat){
 	}
 
 	phalcon_update_property_this(this_ptr, SL("_dateFormat"), date TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_cachedTimestamp") TSRMLS_CC);
 	
 }
 
@@ -150,7 +178,8 @@ PHP_METHOD(Phalcon_Logger_Formatter_Line, getDateFormat){
 }
 
 /**
- * Applies a format to a message before sent it to the internal log
+ * Applies a format to a message before sent it to the internal log. Dates are formatted once
+ * per second and the placeholders are replaced in a single pass
  *
  * @param string $message
  * @param int $type
@@ -158,9 +187,10 @@ PHP_METHOD(Phalcon_Logger_Formatter_Line, getDateFormat){
  */
 PHP_METHOD(Phalcon_Logger_Formatter_Line, format){
 
-	zval *message, *type, *timestamp, *format = NULL, *date_format;
-	zval *date, *date_wildcard, *new_format = NULL, *type_string;
-	zval *type_wildcard, *message_wildcard, *eol;
+	zval *message, *type, *timestamp, *format, *date_format;
+	zval *cached_timestamp, *date = NULL, *type_string = NULL;
+	smart_str line = {0};
+	char *p, *end, *placeholder;
 
 	PHALCON_MM_GROW();
 
@@ -170,24 +200,31 @@ PHP_METHOD(Phalcon_Logger_Formatter_Line, format){
 
 	PHALCON_OBS_VAR(format);
 	phalcon_read_property_this(&format, this_ptr, SL("_format"), PH_NOISY_CC);
+	if (Z_TYPE_P(format) != IS_STRING) {
+		PHALCON_SEPARATE(format);
+		convert_to_string(format);
+	}
 	
 	/** 
-	 * Check if the format has the %date% placeholder
+	 * Check if the format has the %date% placeholder, the last date formatted is reused
+	 * during the same second
 	 */
 	if (phalcon_memnstr_str(format, SL("%date%") TSRMLS_CC)) {
-		PHALCON_OBS_VAR(date_format);
-		phalcon_read_property_this(&date_format, this_ptr, SL("_dateFormat"), PH_NOISY_CC);
 	
-		PHALCON_INIT_VAR(date);
-		PHALCON_CALL_FUNC_PARAMS_2(date, "date", date_format, timestamp);
+		PHALCON_OBS_VAR(cached_timestamp);
+		phalcon_read_property_this(&cached_timestamp, this_ptr, SL("_cachedTimestamp"), PH_NOISY_CC);
+		if (Z_TYPE_P(cached_timestamp) != IS_NULL && PHALCON_IS_EQUAL(cached_timestamp, timestamp)) {
+			PHALCON_OBS_VAR(date);
+			phalcon_read_property_this(&date, this_ptr, SL("_cachedDate"), PH_NOISY_CC);
+		} else {
+			PHALCON_OBS_VAR(date_format);
+			phalcon_read_property_this(&date_format, this_ptr, SL("_dateFormat"), PH_NOISY_CC);
 	
-		PHALCON_INIT_VAR(date_wildcard);
-		ZVAL_STRING(date_wildcard, "%date%", 1);
-	
-		PHALCON_INIT_VAR(new_format);
-		phalcon_fast_str_replace(new_format, date_wildcard, date, format TSRMLS_CC);
-	} else {
-		PHALCON_CPY_WRT(new_format, format);
+			PHALCON_INIT_VAR(date);
+			PHALCON_CALL_FUNC_PARAMS_2(date, "date", date_format, timestamp);
+			phalcon_update_property_this(this_ptr, SL("_cachedTimestamp"), timestamp TSRMLS_CC);
+			phalcon_update_property_this(this_ptr, SL("_cachedDate"), date TSRMLS_CC);
+		}
 	}
 	
 	/** 
@@ -196,28 +233,47 @@ PHP_METHOD(Phalcon_Logger_Formatter_Line, format){
 	if (phalcon_memnstr_str(format, SL("%type%") TSRMLS_CC)) {
 		PHALCON_INIT_VAR(type_string);
 		PHALCON_CALL_METHOD_PARAMS_1(type_string, this_ptr, "gettypestring", type);
+	}
 	
-		PHALCON_INIT_VAR(type_wildcard);
-		ZVAL_STRING(type_wildcard, "%type%", 1);
+	p = Z_STRVAL_P(format);
+	end = p + Z_STRLEN_P(format);
 	
-		PHALCON_INIT_NVAR(format);
-		phalcon_fast_str_replace(format, type_wildcard, type_string, new_format TSRMLS_CC);
-	} else {
-		PHALCON_CPY_WRT(format, new_format);
-	}
+	while (p < end) {
+	
+		placeholder = memchr(p, '%', end - p);
+		if (!placeholder) {
+			smart_str_appendl(&line, p, end - p);
+			break;
+		}
 	
-	PHALCON_INIT_VAR(message_wildcard);
-	ZVAL_STRING(message_wildcard, "%message%", 1);
+		smart_str_appendl(&line, p, placeholder - p);
+		p = placeholder;
 	
-	PHALCON_INIT_NVAR(new_format);
-	phalcon_fast_str_replace(new_format, message_wildcard, message, format TSRMLS_CC);
+		if (date && end - p >= 6 && !memcmp(p, "%date%", 6)) {
+			phalcon_logger_formatter_line_append(&line, date);
+			p += 6;
+			continue;
+		}
 	
-	PHALCON_INIT_VAR(eol);
-	ZVAL_STRING(eol, PHP_EOL, 1);
+		if (type_string && end - p >= 6 && !memcmp(p, "%type%", 6)) {
+			phalcon_logger_formatter_line_append(&line, type_string);
+			p += 6;
+			continue;
+		}
 	
-	PHALCON_INIT_NVAR(format);
-	PHALCON_CONCAT_VV(format, new_format, eol);
+		if (end - p >= 9 && !memcmp(p, "%message%", 9)) {
+			phalcon_logger_formatter_line_append(&line, message);
+			p += 9;
+			continue;
+		}
 	
-	RETURN_CCTOR(format);
+		smart_str_appendc(&line, *p);
+		p++;
+	}
+	
+	smart_str_appendl(&line, PHP_EOL, sizeof(PHP_EOL) - 1);
+	smart_str_0(&line);
+	
+	RETVAL_STRINGL(line.c, line.len, 0);
+	PHALCON_MM_RESTORE();
 }
-
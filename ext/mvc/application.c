@@ -229,7 +229,7 @@ PHP_METHOD(Phalcon_Mvc_Application, handle){
 	zval *view, *namespace_name, *controller_name = NULL;
 	zval *action_name = NULL, *params = NULL, *dispatcher, *controller;
 	zval *returned_response = NULL, *possible_response;
-	zval *response = NULL, *content;
+	zval *response = NULL, *content, *not_modified = NULL;
 
 	PHALCON_MM_GROW();
 
@@ -472,11 +472,27 @@ PHP_METHOD(Phalcon_Mvc_Application, handle){
 		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(events_manager, "fire", event_name, this_ptr, controller);
 	}
 	
+	if (PHALCON_IS_FALSE(returned_response)) {
+		PHALCON_INIT_NVAR(service);
+		ZVAL_STRING(service, "response", 1);
+	
+		PHALCON_INIT_VAR(response);
+		PHALCON_CALL_METHOD_PARAMS_1(response, dependency_injector, "getshared", service);
+	
+		/** 
+		 * Actions validating the request with checkNotModified() skip the rendering
+		 */
+		if (Z_TYPE_P(response) == IS_OBJECT && instanceof_function(Z_OBJCE_P(response), phalcon_http_response_ce TSRMLS_CC)) {
+			PHALCON_INIT_VAR(not_modified);
+			PHALCON_CALL_METHOD(not_modified, response, "isnotmodified");
+		}
+	}
+	
 	/** 
 	 * If the dispatcher returns an object we try to render the view in auto-rendering
 	 * mode
 	 */
-	if (PHALCON_IS_FALSE(returned_response)) {
+	if (PHALCON_IS_FALSE(returned_response) && !(not_modified && zend_is_true(not_modified))) {
 		if (Z_TYPE_P(controller) == IS_OBJECT) {
 			PHALCON_INIT_NVAR(controller_name);
 			PHALCON_CALL_METHOD(controller_name, dispatcher, "getcontrollername");
@@ -499,18 +515,14 @@ PHP_METHOD(Phalcon_Mvc_Application, handle){
 	 */
 	PHALCON_CALL_METHOD_NORETURN(view, "finish");
 	if (PHALCON_IS_FALSE(returned_response)) {
-		PHALCON_INIT_NVAR(service);
-		ZVAL_STRING(service, "response", 1);
-	
-		PHALCON_INIT_VAR(response);
-		PHALCON_CALL_METHOD_PARAMS_1(response, dependency_injector, "getshared", service);
-	
 		/** 
 		 * The content returned by the view is passed to the response service
 		 */
-		PHALCON_INIT_VAR(content);
-		PHALCON_CALL_METHOD(content, view, "getcontent");
-		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(response, "setcontent", content);
+		if (!(not_modified && zend_is_true(not_modified))) {
+			PHALCON_INIT_VAR(content);
+			PHALCON_CALL_METHOD(content, view, "getcontent");
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(response, "setcontent", content);
+		}
 	} else {
 		/** 
 		 * We don't need to create a response because there is an already created one
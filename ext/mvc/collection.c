@@ -64,6 +64,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Collection){
 	zend_declare_property_long(phalcon_mvc_collection_ce, SL("_operationMade"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_collection_ce, SL("_connection"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_collection_ce, SL("_errorMessages"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_collection_ce, SL("_projection"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_collection_ce, SL("_reserved"), ZEND_ACC_PROTECTED|ZEND_ACC_STATIC TSRMLS_CC);
 	zend_declare_property_bool(phalcon_mvc_collection_ce, SL("_disableEvents"), 0, ZEND_ACC_PROTECTED|ZEND_ACC_STATIC TSRMLS_CC);
 
@@ -292,12 +293,13 @@ PHP_METHOD(Phalcon_Mvc_Collection, getReservedAttributes){
 	phalcon_read_static_property(&reserved, SL("phalcon\\mvc\\collection"), SL("_reserved") TSRMLS_CC);
 	if (Z_TYPE_P(reserved) == IS_NULL) {
 		PHALCON_INIT_NVAR(reserved);
-		array_init_size(reserved, 5);
+		array_init_size(reserved, 6);
 		add_assoc_bool_ex(reserved, SS("_connection"), 1);
 		add_assoc_bool_ex(reserved, SS("_dependencyInjector"), 1);
 		add_assoc_bool_ex(reserved, SS("_source"), 1);
 		add_assoc_bool_ex(reserved, SS("_operationMade"), 1);
 		add_assoc_bool_ex(reserved, SS("_errorMessages"), 1);
+		add_assoc_bool_ex(reserved, SS("_projection"), 1);
 		phalcon_update_static_property(SL("phalcon\\mvc\\collection"), SL("_reserved"), reserved TSRMLS_CC);
 	}
 	
@@ -544,6 +546,7 @@ PHP_METHOD(Phalcon_Mvc_Collection, _getResultset){
 	zval *source, *mongo_collection, *conditions = NULL;
 	zval *documents_cursor, *limit, *sort = NULL, *document = NULL;
 	zval *collection_cloned = NULL, *collections, *documents_array;
+	zval *fields, *batch_size, *resultset;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -579,10 +582,21 @@ PHP_METHOD(Phalcon_Mvc_Collection, _getResultset){
 	}
 	
 	/** 
-	 * Perform the find
+	 * Perform the find, 'fields' limits the attributes returned by the server
 	 */
 	PHALCON_INIT_VAR(documents_cursor);
-	PHALCON_CALL_METHOD_PARAMS_1(documents_cursor, mongo_collection, "find", conditions);
+	if (phalcon_array_isset_string(params, SS("fields"))) {
+		PHALCON_OBS_VAR(fields);
+		phalcon_array_fetch_string(&fields, params, SL("fields"), PH_NOISY_CC);
+		PHALCON_CALL_METHOD_PARAMS_2(documents_cursor, mongo_collection, "find", conditions, fields);
+	
+		/** 
+		 * Documents hydrated from this prototype are partial
+		 */
+		phalcon_update_property_bool(collection, SL("_projection"), 1 TSRMLS_CC);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_1(documents_cursor, mongo_collection, "find", conditions);
+	}
 	
 	/** 
 	 * Check if a 'limit' clause was defined
@@ -611,6 +625,15 @@ PHP_METHOD(Phalcon_Mvc_Collection, _getResultset){
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(documents_cursor, "skip", sort);
 	}
 	
+	/** 
+	 * Check if a 'batchSize' was defined
+	 */
+	if (phalcon_array_isset_string(params, SS("batchSize"))) {
+		PHALCON_OBS_VAR(batch_size);
+		phalcon_array_fetch_string(&batch_size, params, SL("batchSize"), PH_NOISY_CC);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(documents_cursor, "batchsize", batch_size);
+	}
+	
 	if (PHALCON_IS_TRUE(unique)) {
 	
 		/** 
@@ -629,6 +652,22 @@ PHP_METHOD(Phalcon_Mvc_Collection, _getResultset){
 		RETURN_MM_FALSE;
 	}
 	
+	/** 
+	 * Requesting a cursor, documents are hydrated while the resultset is traversed
+	 */
+	if (phalcon_array_isset_string(params, SS("cursor"))) {
+	
+		PHALCON_OBS_VAR(resultset);
+		phalcon_array_fetch_string(&resultset, params, SL("cursor"), PH_NOISY_CC);
+		if (zend_is_true(resultset)) {
+			PHALCON_INIT_NVAR(resultset);
+			object_init_ex(resultset, phalcon_mvc_collection_resultset_ce);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(resultset, "__construct", collection, documents_cursor);
+	
+			RETURN_CTOR(resultset);
+		}
+	}
+	
 	/** 
 	 * Requesting a complete resultset
 	 */
@@ -1285,8 +1324,9 @@ PHP_METHOD(Phalcon_Mvc_Collection, save){
 	zval *collection, *exists, *empty_array, *disable_events;
 	zval *status = NULL, *data, *reserved, *properties, *value = NULL;
 	zval *key = NULL, *success = NULL, *options, *ok, *id, *post_success;
-	HashTable *ah0;
-	HashPosition hp0;
+	zval *projection, *fields, *criteria, *new_object;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
 	zval **hd;
 
 	PHALCON_MM_GROW();
@@ -1390,11 +1430,56 @@ PHP_METHOD(Phalcon_Mvc_Collection, save){
 	array_init_size(options, 1);
 	add_assoc_bool_ex(options, SS("safe"), 1);
 	
-	/** 
-	 * Save the document
-	 */
-	PHALCON_INIT_NVAR(status);
-	PHALCON_CALL_METHOD_PARAMS_2(status, collection, "save", data, options);
+	PHALCON_OBS_VAR(projection);
+	phalcon_read_property_this(&projection, this_ptr, SL("_projection"), PH_NOISY_CC);
+	if (PHALCON_IS_TRUE(exists) && zend_is_true(projection)) {
+	
+		/** 
+		 * Documents loaded with a projection update the fields they hold with '$set',
+		 * replacing them would drop the fields that were not fetched
+		 */
+		PHALCON_INIT_VAR(fields);
+		array_init(fields);
+	
+		phalcon_is_iterable(data, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_KEY(key, ah1, hp1);
+			PHALCON_GET_FOREACH_VALUE(value);
+	
+			if (!PHALCON_IS_STRING(key, "_id")) {
+				phalcon_array_update_zval(&fields, key, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			}
+	
+			zend_hash_move_forward_ex(ah1, &hp1);
+		}
+	
+		PHALCON_INIT_NVAR(status);
+		if (zend_hash_num_elements(Z_ARRVAL_P(fields))) {
+			PHALCON_OBS_VAR(id);
+			phalcon_read_property_this(&id, this_ptr, SL("_id"), PH_NOISY_CC);
+	
+			PHALCON_INIT_VAR(criteria);
+			array_init_size(criteria, 1);
+			phalcon_array_update_string(&criteria, SL("_id"), &id, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_INIT_VAR(new_object);
+			array_init_size(new_object, 1);
+			phalcon_array_update_string(&new_object, SL("$set"), &fields, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_CALL_METHOD_PARAMS_3(status, collection, "update", criteria, new_object, options);
+		} else {
+			array_init_size(status, 1);
+			add_assoc_bool_ex(status, SS("ok"), 1);
+		}
+	} else {
+		/** 
+		 * Save the document
+		 */
+		PHALCON_INIT_NVAR(status);
+		PHALCON_CALL_METHOD_PARAMS_2(status, collection, "save", data, options);
+	}
 	if (Z_TYPE_P(status) == IS_ARRAY) { 
 		if (phalcon_array_isset_string(status, SS("ok"))) {
 	
@@ -1593,10 +1678,21 @@ PHP_METHOD(Phalcon_Mvc_Collection, findFirst){
  * foreach ($robots as $robot) {
  *	   echo $robot->name, "\n";
  * }
+ *
+ * //Traverse every robot without loading them in memory, only the name is fetched and saving
+ * //one of these robots keeps the fields that were not fetched
+ * $robots = Robots::find(array(
+ *     "fields" => array("name" => true),
+ *     "batchSize" => 1000,
+ *     "cursor" => true
+ * ));
+ * foreach ($robots as $robot) {
+ *	   echo $robot->name, "\n";
+ * }
  * </code>
  *
  * @param 	array $parameters
- * @return  array
+ * @return  array|Phalcon\Mvc\Collection\Resultset
  */
 PHP_METHOD(Phalcon_Mvc_Collection, find){
 
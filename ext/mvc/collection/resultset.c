@@ -0,0 +1,278 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/object.h"
+#include "kernel/fcall.h"
+#include "kernel/array.h"
+#include "kernel/exception.h"
+
+/**
+ * Phalcon\Mvc\Collection\Resultset
+ *
+ * Wraps a MongoCursor hydrating one document at a time, documents are requested to the
+ * server in batches so large collections can be traversed with a constant memory usage
+ *
+ *<code>
+ *	$songs = Songs::find(array(
+ *		"conditions" => array("artist" => "Radiohead"),
+ *		"fields" => array("name" => true),
+ *		"batchSize" => 500,
+ *		"cursor" => true
+ *	));
+ *
+ *	echo count($songs), " songs\n";
+ *	foreach ($songs as $song) {
+ *		echo $song->name, "\n";
+ *	}
+ *</code>
+ */
+
+
+/**
+ * Phalcon\Mvc\Collection\Resultset initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Mvc_Collection_Resultset){
+
+	PHALCON_REGISTER_CLASS(Phalcon\\Mvc\\Collection, Resultset, mvc_collection_resultset, phalcon_mvc_collection_resultset_method_entry, 0);
+
+	zend_declare_property_null(phalcon_mvc_collection_resultset_ce, SL("_collection"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_collection_resultset_ce, SL("_cursor"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_mvc_collection_resultset_ce, SL("_pointer"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_collection_resultset_ce, SL("_activeRow"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_collection_resultset_ce, SL("_count"), ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	zend_class_implements(phalcon_mvc_collection_resultset_ce TSRMLS_CC, 2, zend_ce_iterator, spl_ce_Countable);
+
+	return SUCCESS;
+}
+
+/**
+ * Phalcon\Mvc\Collection\Resultset constructor
+ *
+ * @param Phalcon\Mvc\CollectionInterface $collection
+ * @param \MongoCursor $cursor
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, __construct){
+
+	zval *collection, *cursor;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &collection, &cursor);
+	
+	if (Z_TYPE_P(collection) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_collection_exception_ce, "Invalid collection");
+		return;
+	}
+	if (Z_TYPE_P(cursor) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_collection_exception_ce, "Invalid cursor");
+		return;
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_collection"), collection TSRMLS_CC);
+	phalcon_update_property_this(this_ptr, SL("_cursor"), cursor TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Rewinds the cursor, the query is sent again to the server
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, rewind){
+
+	zval *cursor;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(cursor);
+	phalcon_read_property_this(&cursor, this_ptr, SL("_cursor"), PH_NOISY_CC);
+	PHALCON_CALL_METHOD_NORETURN(cursor, "rewind");
+
+	phalcon_update_property_long(this_ptr, SL("_pointer"), 0 TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_activeRow") TSRMLS_CC);
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Check whether the cursor has more documents
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, valid){
+
+	zval *cursor, *valid;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(cursor);
+	phalcon_read_property_this(&cursor, this_ptr, SL("_cursor"), PH_NOISY_CC);
+
+	PHALCON_INIT_VAR(valid);
+	PHALCON_CALL_METHOD(valid, cursor, "valid");
+
+	if (zend_is_true(valid)) {
+		RETURN_MM_TRUE;
+	}
+
+	RETURN_MM_FALSE;
+}
+
+/**
+ * Returns the current document as a collection, documents are hydrated only once
+ *
+ * @return Phalcon\Mvc\CollectionInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, current){
+
+	zval *active_row, *cursor, *document, *collection;
+	zval *cloned_collection;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(active_row);
+	phalcon_read_property_this(&active_row, this_ptr, SL("_activeRow"), PH_NOISY_CC);
+	if (Z_TYPE_P(active_row) == IS_OBJECT) {
+		RETURN_CCTOR(active_row);
+	}
+
+	PHALCON_OBS_VAR(cursor);
+	phalcon_read_property_this(&cursor, this_ptr, SL("_cursor"), PH_NOISY_CC);
+
+	PHALCON_INIT_VAR(document);
+	PHALCON_CALL_METHOD(document, cursor, "current");
+	if (Z_TYPE_P(document) != IS_ARRAY) {
+		RETURN_MM_FALSE;
+	}
+
+	PHALCON_OBS_VAR(collection);
+	phalcon_read_property_this(&collection, this_ptr, SL("_collection"), PH_NOISY_CC);
+
+	PHALCON_INIT_VAR(cloned_collection);
+	PHALCON_CALL_METHOD_PARAMS_2(cloned_collection, collection, "cloneresult", collection, document);
+
+	phalcon_update_property_this(this_ptr, SL("_activeRow"), cloned_collection TSRMLS_CC);
+
+	RETURN_CCTOR(cloned_collection);
+}
+
+/**
+ * Gets the position of the current document
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, key){
+
+
+	RETURN_MEMBER(this_ptr, "_pointer");
+}
+
+/**
+ * Moves the cursor to the next document, the previous one is released
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, next){
+
+	zval *cursor;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(cursor);
+	phalcon_read_property_this(&cursor, this_ptr, SL("_cursor"), PH_NOISY_CC);
+	PHALCON_CALL_METHOD_NORETURN(cursor, "next");
+
+	phalcon_property_incr(this_ptr, SL("_pointer") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_activeRow") TSRMLS_CC);
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Counts the documents matched by the query taking 'limit' and 'skip' into account,
+ * the documents are not fetched
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, count){
+
+	zval *count = NULL, *cursor, *found_only;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_OBS_VAR(count);
+	phalcon_read_property_this(&count, this_ptr, SL("_count"), PH_NOISY_CC);
+	if (Z_TYPE_P(count) == IS_NULL) {
+
+		PHALCON_OBS_VAR(cursor);
+		phalcon_read_property_this(&cursor, this_ptr, SL("_cursor"), PH_NOISY_CC);
+
+		PHALCON_INIT_VAR(found_only);
+		ZVAL_BOOL(found_only, 1);
+
+		PHALCON_INIT_NVAR(count);
+		PHALCON_CALL_METHOD_PARAMS_1(count, cursor, "count", found_only);
+		phalcon_update_property_this(this_ptr, SL("_count"), count TSRMLS_CC);
+	}
+
+	RETURN_CCTOR(count);
+}
+
+/**
+ * Returns the first document, false is returned if the query doesn't match any document
+ *
+ * @return Phalcon\Mvc\CollectionInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, getFirst){
+
+	zval *first;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_CALL_METHOD_NORETURN(this_ptr, "rewind");
+
+	PHALCON_INIT_VAR(first);
+	PHALCON_CALL_METHOD(first, this_ptr, "current");
+
+	RETURN_CCTOR(first);
+}
+
+/**
+ * Returns the cursor used by the resultset
+ *
+ * @return \MongoCursor
+ */
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, getCursor){
+
+
+	RETURN_MEMBER(this_ptr, "_cursor");
+}
@@ -0,0 +1,51 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+extern zend_class_entry *phalcon_mvc_collection_resultset_ce;
+
+PHALCON_INIT_CLASS(Phalcon_Mvc_Collection_Resultset);
+
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, __construct);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, rewind);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, valid);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, current);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, key);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, next);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, count);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, getFirst);
+PHP_METHOD(Phalcon_Mvc_Collection_Resultset, getCursor);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_collection_resultset___construct, 0, 0, 2)
+	ZEND_ARG_INFO(0, collection)
+	ZEND_ARG_INFO(0, cursor)
+ZEND_END_ARG_INFO()
+
+PHALCON_INIT_FUNCS(phalcon_mvc_collection_resultset_method_entry){
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, __construct, arginfo_phalcon_mvc_collection_resultset___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, rewind, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, valid, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, current, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, key, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, next, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, count, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, getFirst, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_Collection_Resultset, getCursor, NULL, ZEND_ACC_PUBLIC) 
+	PHP_FE_END
+};
+
@@ -109,6 +109,64 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model){
 	return SUCCESS;
 }
 
+/**
+ * Discards the records of the model loaded in advance by the models manager, they could be
+ * stale after the record is saved or deleted
+ */
+static void phalcon_mvc_model_clear_preloaded(zval *this_ptr TSRMLS_DC){
+
+	zval *models_manager, *preloaded, *class_name;
+
+	models_manager = zend_read_property(phalcon_mvc_model_ce, this_ptr, SL("_modelsManager"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(models_manager) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(models_manager), phalcon_mvc_model_manager_ce TSRMLS_CC)) {
+		return;
+	}
+
+	preloaded = zend_read_property(phalcon_mvc_model_manager_ce, models_manager, SL("_preloaded"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(preloaded) != IS_ARRAY) {
+		return;
+	}
+
+	MAKE_STD_ZVAL(class_name);
+	ZVAL_STRINGL(class_name, Z_OBJCE_P(this_ptr)->name, Z_OBJCE_P(this_ptr)->name_length, 1);
+	zend_call_method_with_1_params(&models_manager, Z_OBJCE_P(models_manager), NULL, "clearpreloaded", NULL, class_name);
+	zval_ptr_dtor(&class_name);
+}
+
+/**
+ * Inserts a group of rows with Phalcon\Db\Adapter::insertMany, if it throws an exception the
+ * transaction started by saveMany (if any) is rolled back before the exception reaches the caller
+ */
+static int phalcon_mvc_model_insert_many(zval *success, zval *connection, zval *table, zval *rows, zval *fields, zval *bind_types, zval *options, int implicit TSRMLS_DC){
+
+	zval *method, *params[5];
+	int status;
+
+	params[0] = table;
+	params[1] = rows;
+	params[2] = fields;
+	params[3] = bind_types;
+	params[4] = options;
+
+	MAKE_STD_ZVAL(method);
+	ZVAL_STRING(method, "insertMany", 1);
+	status = call_user_function(NULL, &connection, method, success, 5, params TSRMLS_CC);
+	zval_ptr_dtor(&method);
+
+	if (status == FAILURE || EG(exception)) {
+		if (implicit) {
+			if (EG(exception)) {
+				zend_exception_save(TSRMLS_C);
+			}
+			zend_call_method_with_0_params(&connection, Z_OBJCE_P(connection), NULL, "rollback", NULL);
+			zend_exception_restore(TSRMLS_C);
+		}
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
 /**
  * Phalcon\Mvc\Model constructor
  *
@@ -963,6 +1021,20 @@ PHP_METHOD(Phalcon_Mvc_Model, cloneResult){
  * foreach ($robots as $robot) {
  *	   echo $robot->name, "\n";
  * }
+ *
+ * //Traverse all the robots reading them from the database cursor one by one
+ * $robots = Robots::find(array("stream" => true));
+ * foreach ($robots as $robot) {
+ *	   echo $robot->name, "\n";
+ * }
+ *
+ * //Load the parts of every robot with a single query per relation
+ * $robots = Robots::find(array("with" => array("robotsParts.parts")));
+ * foreach ($robots as $robot) {
+ *	   foreach ($robot->robotsParts as $robotPart) {
+ *		   echo $robotPart->parts->name, "\n";
+ *	   }
+ * }
  * </code>
  *
  * @param 	array $parameters
@@ -972,7 +1044,7 @@ PHP_METHOD(Phalcon_Mvc_Model, find){
 
 	zval *parameters = NULL, *model_name, *params = NULL, *builder;
 	zval *query, *bind_params = NULL, *bind_types = NULL, *cache;
-	zval *resultset, *hydration;
+	zval *stream, *resultset, *with, *hydration;
 
 	PHALCON_MM_GROW();
 
@@ -1033,12 +1105,32 @@ PHP_METHOD(Phalcon_Mvc_Model, find){
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(query, "cache", cache);
 	}
 	
+	/** 
+	 * Read the rows from the database cursor as they are traversed
+	 */
+	if (phalcon_array_isset_string(params, SS("stream"))) {
+		PHALCON_OBS_VAR(stream);
+		phalcon_array_fetch_string(&stream, params, SL("stream"), PH_NOISY_CC);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(query, "setstreaming", stream);
+	}
+	
 	/** 
 	 * Execute the query passing the bind-params and casting-types
 	 */
 	PHALCON_INIT_VAR(resultset);
 	PHALCON_CALL_METHOD_PARAMS_2(resultset, query, "execute", bind_params, bind_types);
 	
+	/** 
+	 * Load the related records in advance
+	 */
+	if (Z_TYPE_P(resultset) == IS_OBJECT) {
+		if (phalcon_array_isset_string(params, SS("with"))) {
+			PHALCON_OBS_VAR(with);
+			phalcon_array_fetch_string(&with, params, SL("with"), PH_NOISY_CC);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(resultset, "load", with);
+		}
+	}
+	
 	/** 
 	 * Define an hydration mode
 	 */
@@ -2793,30 +2885,30 @@ PHP_METHOD(Phalcon_Mvc_Model, _postSave){
 }
 
 /**
- * Sends a pre-build INSERT SQL statement to the relational database system
+ * Collects the fields, values and bind types used to INSERT the record. The attribute
+ * that receives the identity value is returned in the fourth position
  *
  * @param Phalcon\Mvc\Model\MetadataInterface $metaData
  * @param Phalcon\Db\AdapterInterface $connection
- * @param string $table
- * @return boolean
+ * @param string|boolean $identityField
+ * @return array
  */
-PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert){
+PHP_METHOD(Phalcon_Mvc_Model, _prepareLowInsert){
 
-	zval *meta_data, *connection, *table, *identity_field;
+	zval *meta_data, *connection, *identity_field;
 	zval *null_value, *bind_skip, *fields, *values;
 	zval *bind_types, *attributes, *bind_data_types;
 	zval *automatic_attributes, *column_map = NULL, *field = NULL;
 	zval *attribute_field = NULL, *exception_message = NULL;
 	zval *value = NULL, *bind_type = NULL, *default_value, *use_explicit_identity;
-	zval *success, *sequence_name = NULL, *support_sequences;
-	zval *source, *last_insert_id;
+	zval *insert;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
 
 	PHALCON_MM_GROW();
 
-	phalcon_fetch_params(1, 4, 0, &meta_data, &connection, &table, &identity_field);
+	phalcon_fetch_params(1, 3, 0, &meta_data, &connection, &identity_field);
 	
 	PHALCON_INIT_VAR(null_value);
 	
@@ -2986,6 +3078,54 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert){
 		}
 	}
 	
+	PHALCON_INIT_VAR(insert);
+	array_init_size(insert, 4);
+	phalcon_array_append(&insert, fields, PH_SEPARATE TSRMLS_CC);
+	phalcon_array_append(&insert, values, PH_SEPARATE TSRMLS_CC);
+	phalcon_array_append(&insert, bind_types, PH_SEPARATE TSRMLS_CC);
+	if (PHALCON_IS_NOT_FALSE(identity_field)) {
+		phalcon_array_append(&insert, attribute_field, PH_SEPARATE TSRMLS_CC);
+	} else {
+		phalcon_array_append(&insert, null_value, PH_SEPARATE TSRMLS_CC);
+	}
+	
+	RETURN_CTOR(insert);
+}
+
+/**
+ * Sends a pre-build INSERT SQL statement to the relational database system
+ *
+ * @param Phalcon\Mvc\Model\MetadataInterface $metaData
+ * @param Phalcon\Db\AdapterInterface $connection
+ * @param string $table
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert){
+
+	zval *meta_data, *connection, *table, *identity_field;
+	zval *insert, *fields, *values, *bind_types, *attribute_field;
+	zval *success, *sequence_name = NULL, *support_sequences;
+	zval *source, *last_insert_id;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 4, 0, &meta_data, &connection, &table, &identity_field);
+	
+	PHALCON_INIT_VAR(insert);
+	PHALCON_CALL_METHOD_PARAMS_3(insert, this_ptr, "_preparelowinsert", meta_data, connection, identity_field);
+	
+	PHALCON_OBS_VAR(fields);
+	phalcon_array_fetch_long(&fields, insert, 0, PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(values);
+	phalcon_array_fetch_long(&values, insert, 1, PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(bind_types);
+	phalcon_array_fetch_long(&bind_types, insert, 2, PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(attribute_field);
+	phalcon_array_fetch_long(&attribute_field, insert, 3, PH_NOISY_CC);
+	
 	/** 
 	 * The low level insert is performed
 	 */
@@ -3817,6 +3957,7 @@ PHP_METHOD(Phalcon_Mvc_Model, save){
 	 */
 	if (zend_is_true(success)) {
 		phalcon_update_property_long(this_ptr, SL("_dirtyState"), 0 TSRMLS_CC);
+		phalcon_mvc_model_clear_preloaded(this_ptr TSRMLS_CC);
 	}
 	
 	/** 
@@ -3852,6 +3993,300 @@ PHP_METHOD(Phalcon_Mvc_Model, save){
 	RETURN_CCTOR(success);
 }
 
+/**
+ * Inserts many records using multi-row INSERT statements. Records can be instances of the model
+ * or arrays assigned to new instances. All the records are validated before sending anything to
+ * the database, the events beforeCreate/afterCreate are fired for every record. The options are
+ * passed to Phalcon\Db\Adapter::insertMany, the identity of the inserted records isn't recovered.
+ * The statements run in an implicit transaction unless the connection is already under one, in
+ * that case a failure is left to the caller to roll back
+ *
+ *<code>
+ *	$robot = new Robots();
+ *	$robot->type = 'mechanical';
+ *	$robot->name = 'Astro Boy';
+ *	$robot->year = 1952;
+ *
+ *	//Inserting an instance and an array in a single statement
+ *	Robots::saveMany(array(
+ *		$robot,
+ *		array('type' => 'cyborg', 'name' => 'Terminator', 'year' => 1984)
+ *	));
+ *
+ *	//Updating the year of the robots that already exist
+ *	Robots::saveMany($robots, array(
+ *		'onDuplicate' => array('year'),
+ *		'conflict' => array('name')
+ *	));
+ *</code>
+ *
+ * @param array $records
+ * @param array $options
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model, saveMany){
+
+	zval *records, *options = NULL, *model_name, *models, *record = NULL;
+	zval *model = NULL, *first_model, *meta_data, *write_connection;
+	zval *schema, *source, *table = NULL, *identity_field, *bind_data_types;
+	zval *exists, *bind_skip, *error_messages = NULL, *status = NULL;
+	zval *exception, *group_fields, *group_rows, *insert = NULL;
+	zval *fields = NULL, *values = NULL, *key = NULL, *field = NULL;
+	zval *bind_types = NULL, *bind_type = NULL, *rows = NULL, *success = NULL;
+	zval *is_model = NULL, *created, *under_transaction;
+	zend_class_entry *ce0;
+	HashTable *ah0, *ah1, *ah2, *ah3, *ah4;
+	int implicit;
+	HashPosition hp0, hp1, hp2, hp3, hp4;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &records, &options);
+	
+	if (!options) {
+		PHALCON_INIT_VAR(options);
+	}
+	
+	if (Z_TYPE_P(records) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Records passed to saveMany() must be an array");
+		return;
+	}
+	
+	if (!phalcon_fast_count_ev(records TSRMLS_CC)) {
+		RETURN_MM_TRUE;
+	}
+	
+	PHALCON_INIT_VAR(model_name);
+	phalcon_get_called_class(model_name  TSRMLS_CC);
+	ce0 = phalcon_fetch_class(model_name TSRMLS_CC);
+	
+	/** 
+	 * Arrays are assigned to new instances of the model
+	 */
+	PHALCON_INIT_VAR(models);
+	array_init(models);
+	
+	phalcon_is_iterable(records, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(record);
+	
+		if (Z_TYPE_P(record) == IS_ARRAY) { 
+			PHALCON_INIT_NVAR(model);
+			object_init_ex(model, ce0);
+			if (phalcon_has_constructor(model TSRMLS_CC)) {
+				PHALCON_CALL_METHOD_NORETURN(model, "__construct");
+			}
+	
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(model, "assign", record);
+		} else {
+			PHALCON_INIT_NVAR(is_model);
+			if (Z_TYPE_P(record) == IS_OBJECT) {
+				phalcon_instance_of(is_model, record, ce0 TSRMLS_CC);
+			}
+			if (!zend_is_true(is_model)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Records passed to saveMany() must be arrays or instances of the model");
+				return;
+			}
+			PHALCON_CPY_WRT(model, record);
+		}
+	
+		phalcon_array_append(&models, model, PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_OBS_VAR(first_model);
+	phalcon_array_fetch_long(&first_model, models, 0, PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(meta_data);
+	PHALCON_CALL_METHOD(meta_data, first_model, "getmodelsmetadata");
+	
+	PHALCON_INIT_VAR(write_connection);
+	PHALCON_CALL_METHOD(write_connection, first_model, "getwriteconnection");
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, first_model, "getschema");
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, first_model, "getsource");
+	if (zend_is_true(schema)) {
+		PHALCON_INIT_VAR(table);
+		array_init_size(table, 2);
+		phalcon_array_append(&table, schema, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&table, source, PH_SEPARATE TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(table, source);
+	}
+	
+	PHALCON_INIT_VAR(identity_field);
+	PHALCON_CALL_METHOD_PARAMS_1(identity_field, meta_data, "getidentityfield", first_model);
+	
+	PHALCON_INIT_VAR(bind_data_types);
+	PHALCON_CALL_METHOD_PARAMS_1(bind_data_types, meta_data, "getbindtypes", first_model);
+	
+	PHALCON_INIT_VAR(exists);
+	ZVAL_BOOL(exists, 0);
+	
+	PHALCON_INIT_VAR(bind_skip);
+	ZVAL_LONG(bind_skip, 1024);
+	
+	PHALCON_INIT_VAR(group_fields);
+	array_init(group_fields);
+	
+	PHALCON_INIT_VAR(group_rows);
+	array_init(group_rows);
+	
+	/** 
+	 * Every record is validated in memory before sending anything to the database,
+	 * records are grouped by the fields they insert
+	 */
+	phalcon_is_iterable(models, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(model);
+	
+		phalcon_update_property_long(model, SL("_operationMade"), 1 TSRMLS_CC);
+	
+		PHALCON_INIT_NVAR(error_messages);
+		array_init(error_messages);
+		phalcon_update_property_zval(model, SL("_errorMessages"), error_messages TSRMLS_CC);
+	
+		/** 
+		 * _preSave() makes all the validations and fires beforeCreate
+		 */
+		PHALCON_INIT_NVAR(status);
+		PHALCON_CALL_METHOD_PARAMS_3(status, model, "_presave", meta_data, exists, identity_field);
+		if (PHALCON_IS_FALSE(status)) {
+	
+			/** 
+			 * Throw exceptions on failed saves?
+			 */
+			if (PHALCON_GLOBAL(orm).exception_on_failed_save) {
+				PHALCON_OBS_NVAR(error_messages);
+				phalcon_read_property(&error_messages, model, SL("_errorMessages"), PH_NOISY_CC);
+	
+				PHALCON_INIT_VAR(exception);
+				object_init_ex(exception, phalcon_mvc_model_validationfailed_ce);
+				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(exception, "__construct", model, error_messages);
+	
+				phalcon_throw_exception(exception TSRMLS_CC);
+				return;
+			}
+	
+			RETURN_MM_FALSE;
+		}
+	
+		PHALCON_INIT_NVAR(insert);
+		PHALCON_CALL_METHOD_PARAMS_3(insert, model, "_preparelowinsert", meta_data, write_connection, identity_field);
+	
+		PHALCON_OBS_NVAR(fields);
+		phalcon_array_fetch_long(&fields, insert, 0, PH_NOISY_CC);
+	
+		PHALCON_OBS_NVAR(values);
+		phalcon_array_fetch_long(&values, insert, 1, PH_NOISY_CC);
+	
+		PHALCON_INIT_NVAR(key);
+		phalcon_fast_join_str(key, SL(","), fields TSRMLS_CC);
+		if (!phalcon_array_isset(group_fields, key)) {
+			phalcon_array_update_zval(&group_fields, key, &fields, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+		phalcon_array_update_append_multi_2(&group_rows, key, values, 0 TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah1, &hp1);
+	}
+	
+	/** 
+	 * Every group is inserted using multi-row statements in an implicit transaction, a transaction
+	 * opened by the caller is never committed or rolled back here
+	 */
+	PHALCON_INIT_VAR(under_transaction);
+	PHALCON_CALL_METHOD(under_transaction, write_connection, "isundertransaction");
+	
+	implicit = !zend_is_true(under_transaction);
+	if (implicit) {
+		PHALCON_CALL_METHOD_NORETURN(write_connection, "begin");
+	}
+	
+	phalcon_is_iterable(group_fields, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(key, ah2, hp2);
+		PHALCON_GET_FOREACH_VALUE(fields);
+	
+		/** 
+		 * Values without a bind type are null or raw values that are never bound
+		 */
+		PHALCON_INIT_NVAR(bind_types);
+		array_init(bind_types);
+	
+		phalcon_is_iterable(fields, &ah3, &hp3, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah3, (void**) &hd, &hp3) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(field);
+	
+			if (phalcon_array_isset(bind_data_types, field)) {
+				PHALCON_OBS_NVAR(bind_type);
+				phalcon_array_fetch(&bind_type, bind_data_types, field, PH_NOISY_CC);
+				phalcon_array_append(&bind_types, bind_type, PH_SEPARATE TSRMLS_CC);
+			} else {
+				phalcon_array_append(&bind_types, bind_skip, PH_SEPARATE TSRMLS_CC);
+			}
+	
+			zend_hash_move_forward_ex(ah3, &hp3);
+		}
+	
+		PHALCON_OBS_NVAR(rows);
+		phalcon_array_fetch(&rows, group_rows, key, PH_NOISY_CC);
+	
+		PHALCON_INIT_NVAR(success);
+		if (phalcon_mvc_model_insert_many(success, write_connection, table, rows, fields, bind_types, options, implicit TSRMLS_CC) == FAILURE) {
+			RETURN_MM_NULL();
+		}
+		if (PHALCON_IS_FALSE(success)) {
+			if (implicit) {
+				PHALCON_CALL_METHOD_NORETURN(write_connection, "rollback");
+			}
+			RETURN_MM_FALSE;
+		}
+	
+		zend_hash_move_forward_ex(ah2, &hp2);
+	}
+	
+	if (implicit) {
+		PHALCON_CALL_METHOD_NORETURN(write_connection, "commit");
+	}
+	
+	phalcon_mvc_model_clear_preloaded(first_model TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(created);
+	ZVAL_BOOL(created, 1);
+	
+	/** 
+	 * Change the dirty state to persistent, _postSave() fires afterCreate
+	 */
+	phalcon_is_iterable(models, &ah4, &hp4, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah4, (void**) &hd, &hp4) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(model);
+	
+		phalcon_update_property_long(model, SL("_dirtyState"), 0 TSRMLS_CC);
+		if (PHALCON_GLOBAL(orm).events) {
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(model, "_postsave", created, exists);
+		}
+	
+		zend_hash_move_forward_ex(ah4, &hp4);
+	}
+	
+	RETURN_MM_TRUE;
+}
+
 /**
  * Inserts a model instance. If the instance already exists in the persistance it will throw an exception
  * Returning true on success or false otherwise.
@@ -4396,6 +4831,9 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	 */
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD_PARAMS_4(success, write_connection, "delete", table, delete_conditions, values, bind_types);
+	if (zend_is_true(success)) {
+		phalcon_mvc_model_clear_preloaded(this_ptr TSRMLS_CC);
+	}
 	if (PHALCON_GLOBAL(orm).events) {
 		if (zend_is_true(success)) {
 			PHALCON_INIT_NVAR(event_name);
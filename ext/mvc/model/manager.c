@@ -41,6 +41,8 @@
 #include "kernel/concat.h"
 #include "kernel/operators.h"
 
+#include "ext/standard/php_rand.h"
+
 /**
  * Phalcon\Mvc\Model\Manager
  *
@@ -60,6 +62,8 @@
  * </code>
  */
 
+/** Maximum number of values bound by every query preloading a relation */
+#define PHALCON_MVC_MODEL_MANAGER_PRELOAD_CHUNK 500
 
 /**
  * Phalcon\Mvc\Model\Manager initializer
@@ -87,14 +91,308 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Manager){
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_lastInitialized"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_lastQuery"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_reusable"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_preloaded"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_keepSnapshots"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_dynamicUpdate"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_readConnectionOptions"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_readConnectionSelected"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_readConnectionStatus"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_primaryConnections"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_model_manager_ce TSRMLS_CC, 3, phalcon_mvc_model_managerinterface_ce, phalcon_di_injectionawareinterface_ce, phalcon_events_eventsawareinterface_ce);
 
 	return SUCCESS;
 }
 
+/**
+ * Requests a replica from the DI, failures resolving it are not propagated and NULL is
+ * returned instead
+ */
+static zval *phalcon_mvc_model_manager_replica(zval *dependency_injector, zval *service TSRMLS_DC){
+
+	zval *connection = NULL;
+
+	zend_call_method_with_1_params(&dependency_injector, Z_OBJCE_P(dependency_injector), NULL, "getshared", &connection, service);
+
+	if (EG(exception)) {
+		zend_clear_exception(TSRMLS_C);
+		if (connection) {
+			zval_ptr_dtor(&connection);
+		}
+		return NULL;
+	}
+
+	if (connection && Z_TYPE_P(connection) != IS_OBJECT) {
+		zval_ptr_dtor(&connection);
+		return NULL;
+	}
+
+	return connection;
+}
+
+/**
+ * Measures the replication lag of a connection in seconds, -1 is returned if the replication
+ * is stopped or the server cannot be queried. Servers that are not replicas have no lag
+ */
+static long phalcon_mvc_model_manager_lag(zval *connection TSRMLS_DC){
+
+	zval *type = NULL, *sql, *fetch_mode, *status = NULL, **seconds;
+	const char *query = NULL, *column = NULL;
+	long lag = 0;
+
+	zend_call_method_with_0_params(&connection, Z_OBJCE_P(connection), NULL, "gettype", &type);
+	if (EG(exception)) {
+		zend_clear_exception(TSRMLS_C);
+		lag = -1;
+	} else {
+		if (type && Z_TYPE_P(type) == IS_STRING) {
+			if (PHALCON_IS_STRING(type, "mysql")) {
+				query = "SHOW SLAVE STATUS";
+				column = "Seconds_Behind_Master";
+			} else {
+				if (PHALCON_IS_STRING(type, "pgsql")) {
+					query = "SELECT CASE WHEN pg_is_in_recovery() THEN EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) ELSE 0 END AS lag";
+					column = "lag";
+				}
+			}
+		}
+	}
+
+	if (type) {
+		zval_ptr_dtor(&type);
+	}
+
+	if (!query) {
+		return lag;
+	}
+
+	MAKE_STD_ZVAL(sql);
+	ZVAL_STRING(sql, query, 1);
+
+	/**
+	 * Phalcon\Db::FETCH_ASSOC
+	 */
+	MAKE_STD_ZVAL(fetch_mode);
+	ZVAL_LONG(fetch_mode, 1);
+
+	zend_call_method_with_2_params(&connection, Z_OBJCE_P(connection), NULL, "fetchone", &status, sql, fetch_mode);
+	if (EG(exception)) {
+		zend_clear_exception(TSRMLS_C);
+		lag = -1;
+	} else {
+		if (status && Z_TYPE_P(status) == IS_ARRAY) {
+			if (zend_hash_find(Z_ARRVAL_P(status), (char *) column, strlen(column) + 1, (void **) &seconds) == SUCCESS) {
+				lag = Z_TYPE_PP(seconds) == IS_NULL ? -1 : phalcon_get_intval(*seconds);
+			}
+		}
+	}
+
+	if (status) {
+		zval_ptr_dtor(&status);
+	}
+	zval_ptr_dtor(&sql);
+	zval_ptr_dtor(&fetch_mode);
+
+	return lag;
+}
+
+/**
+ * Checks a replica with the health check of the options or, if there is none, compares its
+ * lag with the maximum allowed
+ */
+static int phalcon_mvc_model_manager_healthy(zval *connection, zval *service, zval *options TSRMLS_DC){
+
+	zval **health_check = NULL, **max_lag = NULL, *params[2], retval;
+	long lag;
+
+	if (Z_TYPE_P(options) == IS_ARRAY) {
+		zend_hash_find(Z_ARRVAL_P(options), SS("healthCheck"), (void **) &health_check);
+		if (zend_hash_find(Z_ARRVAL_P(options), SS("maxLag"), (void **) &max_lag) == SUCCESS && Z_TYPE_PP(max_lag) == IS_NULL) {
+			max_lag = NULL;
+		}
+	}
+
+	if (health_check && Z_TYPE_PP(health_check) != IS_NULL) {
+
+		params[0] = connection;
+		params[1] = service;
+
+		INIT_ZVAL(retval);
+		if (call_user_function(EG(function_table), NULL, *health_check, &retval, 2, params TSRMLS_CC) == FAILURE || EG(exception)) {
+			if (EG(exception)) {
+				zend_clear_exception(TSRMLS_C);
+			}
+			zval_dtor(&retval);
+			return 0;
+		}
+
+		/**
+		 * Health checks return a boolean or the lag of the replica in seconds
+		 */
+		if (Z_TYPE(retval) == IS_BOOL || Z_TYPE(retval) == IS_NULL) {
+			return Z_TYPE(retval) == IS_BOOL && Z_BVAL(retval);
+		}
+
+		lag = phalcon_get_intval(&retval);
+		zval_dtor(&retval);
+	} else {
+		if (!max_lag) {
+			return 1;
+		}
+		lag = phalcon_mvc_model_manager_lag(connection TSRMLS_CC);
+	}
+
+	if (lag < 0) {
+		return 0;
+	}
+
+	if (max_lag && lag > phalcon_get_intval(*max_lag)) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * Returns the weight of the current replica in a pool, pools are arrays of service => weight
+ * or lists of services weighing 1
+ */
+static long phalcon_mvc_model_manager_weight(HashTable *pool, HashPosition *pos, char **name, uint *name_length){
+
+	zval **value;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	if (zend_hash_get_current_data_ex(pool, (void **) &value, pos) == FAILURE) {
+		return 0;
+	}
+
+	if (zend_hash_get_current_key_ex(pool, &key, &key_length, &index, 0, pos) == HASH_KEY_IS_STRING) {
+		*name = key;
+		*name_length = key_length - 1;
+		return phalcon_get_intval(*value);
+	}
+
+	if (Z_TYPE_PP(value) != IS_STRING) {
+		return 0;
+	}
+
+	*name = Z_STRVAL_PP(value);
+	*name_length = Z_STRLEN_PP(value);
+	return 1;
+}
+
+/**
+ * Picks a replica from a pool at random in proportion to its weight. Replicas that cannot be
+ * resolved or fail the health checks are skipped for the rest of the request, NULL is returned
+ * if no replica is left
+ */
+static zval *phalcon_mvc_model_manager_route(zval *this_ptr, zval *pool, zval *dependency_injector TSRMLS_DC){
+
+	zval *options, *status, **known, *service, *connection = NULL, *healthy;
+	HashPosition pos;
+	char *name;
+	uint name_length;
+	long total, pick, weight;
+	int ok;
+
+	options = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_readConnectionOptions"), 1 TSRMLS_CC);
+
+	/**
+	 * Health checks run user code, which could replace the pool or the options
+	 */
+	Z_ADDREF_P(pool);
+	Z_ADDREF_P(options);
+
+	while (!connection) {
+
+		status = zend_read_property(phalcon_mvc_model_manager_ce, this_ptr, SL("_readConnectionStatus"), 1 TSRMLS_CC);
+
+		total = 0;
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(pool), &pos);
+		while (zend_hash_has_more_elements_ex(Z_ARRVAL_P(pool), &pos) == SUCCESS) {
+			weight = phalcon_mvc_model_manager_weight(Z_ARRVAL_P(pool), &pos, &name, &name_length);
+			if (weight > 0) {
+				if (Z_TYPE_P(status) != IS_ARRAY || zend_hash_find(Z_ARRVAL_P(status), name, name_length + 1, (void **) &known) == FAILURE || zend_is_true(*known)) {
+					total += weight;
+				}
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(pool), &pos);
+		}
+
+		if (total <= 0) {
+			break;
+		}
+
+		pick = php_rand(TSRMLS_C) % total;
+
+		ok = -1;
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(pool), &pos);
+		while (zend_hash_has_more_elements_ex(Z_ARRVAL_P(pool), &pos) == SUCCESS) {
+			weight = phalcon_mvc_model_manager_weight(Z_ARRVAL_P(pool), &pos, &name, &name_length);
+			if (weight > 0) {
+				if (Z_TYPE_P(status) != IS_ARRAY || zend_hash_find(Z_ARRVAL_P(status), name, name_length + 1, (void **) &known) == FAILURE) {
+					if (pick < weight) {
+						ok = 0;
+						break;
+					}
+					pick -= weight;
+				} else {
+					if (zend_is_true(*known)) {
+						if (pick < weight) {
+							ok = 1;
+							break;
+						}
+						pick -= weight;
+					}
+				}
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(pool), &pos);
+		}
+
+		if (ok < 0) {
+			break;
+		}
+
+		MAKE_STD_ZVAL(service);
+		ZVAL_STRINGL(service, name, name_length, 1);
+
+		connection = phalcon_mvc_model_manager_replica(dependency_injector, service TSRMLS_CC);
+
+		/**
+		 * Replicas are checked once per request
+		 */
+		if (!ok) {
+			ok = connection && phalcon_mvc_model_manager_healthy(connection, service, options TSRMLS_CC);
+
+			MAKE_STD_ZVAL(healthy);
+			ZVAL_BOOL(healthy, ok);
+			phalcon_update_property_array(this_ptr, SL("_readConnectionStatus"), service, healthy TSRMLS_CC);
+			zval_ptr_dtor(&healthy);
+		} else {
+			if (!connection) {
+				MAKE_STD_ZVAL(healthy);
+				ZVAL_FALSE(healthy);
+				phalcon_update_property_array(this_ptr, SL("_readConnectionStatus"), service, healthy TSRMLS_CC);
+				zval_ptr_dtor(&healthy);
+			}
+		}
+
+		zval_ptr_dtor(&service);
+
+		if (!ok && connection) {
+			zval_ptr_dtor(&connection);
+			connection = NULL;
+		}
+	}
+
+	zval_ptr_dtor(&pool);
+	zval_ptr_dtor(&options);
+
+	return connection;
+}
+
 /**
  * Sets the DependencyInjector container
  *
@@ -571,10 +869,18 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setWriteConnectionService){
 }
 
 /**
- * Sets read connection service for a model
+ * Sets read connection service for a model, a pool of replicas can be passed as an array
+ * of services with their weights
+ *
+ *<code>
+ * $this->getModelsManager()->setReadConnectionService($this, array(
+ *     'dbReplicaOne' => 2,
+ *     'dbReplicaTwo' => 1
+ * ));
+ *</code>
  *
  * @param Phalcon\Mvc\ModelInterface $model
- * @param string $connectionService
+ * @param string|array $connectionService
  */
 PHP_METHOD(Phalcon_Mvc_Model_Manager, setReadConnectionService){
 
@@ -584,8 +890,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setReadConnectionService){
 
 	phalcon_fetch_params(1, 2, 0, &model, &connection_service);
 	
-	if (Z_TYPE_P(connection_service) != IS_STRING) {
-		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The connection service must be a string");
+	if (Z_TYPE_P(connection_service) != IS_STRING && Z_TYPE_P(connection_service) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The connection service must be a string or an array of services");
 		return;
 	}
 	
@@ -647,42 +953,59 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getWriteConnection){
 		return;
 	}
 	
+	/** 
+	 * Reads of the models sharing this service go to the primary from now on
+	 */
+	phalcon_update_property_array(this_ptr, SL("_primaryConnections"), service, connection TSRMLS_CC);
 	
 	RETURN_CCTOR(connection);
 }
 
 /**
- * Returns the connection to read data related to a model
+ * Returns the connection to read data related to a model. When the model reads from a pool
+ * of replicas one is picked per request, replicas that fail are skipped and the primary is
+ * used if none is left. Reads stick to the primary once the request wrote to it
  *
  * @param Phalcon\Mvc\ModelInterface $model
  * @return Phalcon\Db\AdapterInterface
  */
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnection){
 
-	zval *model, *service = NULL, *connection_services;
-	zval *entity_name, *dependency_injector, *connection;
+	zval *model, *entity_name, *service = NULL, *write_service = NULL;
+	zval *connection_services = NULL, *dependency_injector, *options;
+	zval *primary_connections, *primary_connection, *sticky = NULL;
+	zval *under_transaction, *selected, *pool = NULL, *connection = NULL;
+	zval *replica;
 
 	PHALCON_MM_GROW();
 
 	phalcon_fetch_params(1, 1, 0, &model);
 	
+	PHALCON_INIT_VAR(entity_name);
+	phalcon_get_class(entity_name, model, 1 TSRMLS_CC);
+	
 	PHALCON_INIT_VAR(service);
 	ZVAL_STRING(service, "db", 1);
 	
 	PHALCON_OBS_VAR(connection_services);
 	phalcon_read_property_this(&connection_services, this_ptr, SL("_readConnectionServices"), PH_NOISY_CC);
-	if (Z_TYPE_P(connection_services) == IS_ARRAY) { 
 	
-		PHALCON_INIT_VAR(entity_name);
-		phalcon_get_class(entity_name, model, 1 TSRMLS_CC);
+	/** 
+	 * Check if the model has a custom connection service
+	 */
+	if (phalcon_array_isset(connection_services, entity_name)) {
+		PHALCON_OBS_NVAR(service);
+		phalcon_array_fetch(&service, connection_services, entity_name, PH_NOISY_CC);
+	}
 	
-		/** 
-		 * Check if the model has a custom connection service
-		 */
-		if (phalcon_array_isset(connection_services, entity_name)) {
-			PHALCON_OBS_NVAR(service);
-			phalcon_array_fetch(&service, connection_services, entity_name, PH_NOISY_CC);
-		}
+	PHALCON_INIT_VAR(write_service);
+	ZVAL_STRING(write_service, "db", 1);
+	
+	PHALCON_OBS_NVAR(connection_services);
+	phalcon_read_property_this(&connection_services, this_ptr, SL("_writeConnectionServices"), PH_NOISY_CC);
+	if (phalcon_array_isset(connection_services, entity_name)) {
+		PHALCON_OBS_NVAR(write_service);
+		phalcon_array_fetch(&write_service, connection_services, entity_name, PH_NOISY_CC);
 	}
 	
 	PHALCON_OBS_VAR(dependency_injector);
@@ -692,25 +1015,104 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnection){
 		return;
 	}
 	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_readConnectionOptions"), PH_NOISY_CC);
+	
 	/** 
-	 * Request the connection service from the DI
+	 * Once the request wrote to the primary reads stick to it, unless that is disabled in
+	 * the options, in that case they only stick to it while a transaction is open
 	 */
-	PHALCON_INIT_VAR(connection);
-	PHALCON_CALL_METHOD_PARAMS_1(connection, dependency_injector, "getshared", service);
-	if (Z_TYPE_P(connection) != IS_OBJECT) {
-		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid injected connection service");
-		return;
+	PHALCON_OBS_VAR(primary_connections);
+	phalcon_read_property_this(&primary_connections, this_ptr, SL("_primaryConnections"), PH_NOISY_CC);
+	if (phalcon_array_isset(primary_connections, write_service)) {
+	
+		PHALCON_OBS_VAR(primary_connection);
+		phalcon_array_fetch(&primary_connection, primary_connections, write_service, PH_NOISY_CC);
+	
+		if (phalcon_array_isset_string(options, SS("sticky"))) {
+			PHALCON_OBS_VAR(sticky);
+			phalcon_array_fetch_string(&sticky, options, SL("sticky"), PH_NOISY_CC);
+		}
+	
+		if (!sticky || zend_is_true(sticky)) {
+			RETURN_CCTOR(primary_connection);
+		}
+	
+		PHALCON_INIT_VAR(under_transaction);
+		PHALCON_CALL_METHOD(under_transaction, primary_connection, "isundertransaction");
+		if (zend_is_true(under_transaction)) {
+			RETURN_CCTOR(primary_connection);
+		}
+	}
+	
+	if (Z_TYPE_P(service) == IS_ARRAY) {
+		PHALCON_CPY_WRT(pool, service);
+	} else {
+		/** 
+		 * A single replica is only checked if there are health checks or a maximum lag
+		 */
+		if (!PHALCON_IS_EQUAL(service, write_service)) {
+			if (phalcon_array_isset_string(options, SS("healthCheck")) || phalcon_array_isset_string(options, SS("maxLag"))) {
+				PHALCON_INIT_VAR(pool);
+				array_init_size(pool, 1);
+				phalcon_array_append(&pool, service, PH_SEPARATE TSRMLS_CC);
+			}
+		}
+	}
+	
+	if (!pool) {
+	
+		/** 
+		 * Request the connection service from the DI
+		 */
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD_PARAMS_1(connection, dependency_injector, "getshared", service);
+		if (Z_TYPE_P(connection) != IS_OBJECT) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid injected connection service");
+			return;
+		}
+	
+		RETURN_CCTOR(connection);
 	}
 	
+	/** 
+	 * The replica picked for a model is reused for the rest of the request
+	 */
+	PHALCON_OBS_VAR(selected);
+	phalcon_read_property_this(&selected, this_ptr, SL("_readConnectionSelected"), PH_NOISY_CC);
+	if (phalcon_array_isset(selected, entity_name)) {
+		PHALCON_OBS_NVAR(connection);
+		phalcon_array_fetch(&connection, selected, entity_name, PH_NOISY_CC);
+		RETURN_CCTOR(connection);
+	}
+	
+	replica = phalcon_mvc_model_manager_route(this_ptr, pool, dependency_injector TSRMLS_CC);
+	if (replica) {
+		PHALCON_INIT_VAR(connection);
+		ZVAL_ZVAL(connection, replica, 1, 1);
+	} else {
+		/** 
+		 * No replica is available, reads go to the primary
+		 */
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD_PARAMS_1(connection, dependency_injector, "getshared", write_service);
+		if (Z_TYPE_P(connection) != IS_OBJECT) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid injected connection service");
+			return;
+		}
+	}
+	
+	phalcon_update_property_array(this_ptr, SL("_readConnectionSelected"), entity_name, connection TSRMLS_CC);
 	
 	RETURN_CCTOR(connection);
 }
 
 /**
- * Returns the connection service name used to read data related to a model
+ * Returns the connection service name used to read data related to a model, pools of
+ * replicas are returned as they were set
  *
  * @param Phalcon\Mvc\ModelInterface $model
- * @param string
+ * @param string|array
  */
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnectionService){
 
@@ -778,6 +1180,63 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getWriteConnectionService){
 	RETURN_STRING("db", 1);
 }
 
+/**
+ * Sets the options used to route reads to the replicas of a pool
+ *
+ * 'healthCheck' is a callable receiving the connection and its service name, it returns
+ * false to skip the replica, true to use it or its lag in seconds. 'maxLag' is the maximum lag
+ * in seconds, without a health check it is measured on MySQL and PostgreSQL replicas.
+ * 'sticky' set to false makes reads stick to the primary only while a transaction is open
+ *
+ *<code>
+ * $modelsManager->setReadConnectionOptions(array(
+ *     'maxLag' => 5
+ * ));
+ *</code>
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, setReadConnectionOptions){
+
+	zval *options;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &options);
+	
+	if (Z_TYPE_P(options) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The options must be an array");
+		return;
+	}
+	phalcon_update_property_this(this_ptr, SL("_readConnectionOptions"), options TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the options used to route reads to the replicas of a pool
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnectionOptions){
+
+
+	RETURN_MEMBER(this_ptr, "_readConnectionOptions");
+}
+
+/**
+ * Forgets the replicas picked, their health and the writes done to the primaries, long
+ * running processes should call it between requests
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, resetReadConnections){
+
+
+	phalcon_update_property_null(this_ptr, SL("_readConnectionSelected") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_readConnectionStatus") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_primaryConnections") TSRMLS_CC);
+	
+}
+
 /**
  * Receives events generated in the models and dispatches them to a events-manager if available
  * Notify the behaviors that are listening in the model
@@ -1709,9 +2168,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	zval *value = NULL, *referenced_field = NULL, *condition = NULL, *referenced_fields;
 	zval *position = NULL, *join_conditions, *has_through;
 	zval *dependency_injector, *find_params, *find_arguments = NULL;
-	zval *arguments, *referenced_model, *type, *retrieve_method = NULL;
+	zval *arguments, *referenced_model = NULL, *type, *retrieve_method = NULL;
 	zval *reusable, *unique_key, *records = NULL, *referenced_entity;
-	zval *call_object;
+	zval *call_object, *preloaded, *preload_key, *entity_name;
+	zval *model_preloaded;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -1824,6 +2284,36 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	
 	}
 	
+	/** 
+	 * Records loaded in advance by preloadRelations() don't need a query
+	 */
+	if (Z_TYPE_P(method) == IS_NULL && Z_TYPE_P(parameters) == IS_NULL) {
+	
+		PHALCON_OBS_VAR(preloaded);
+		phalcon_read_property_this(&preloaded, this_ptr, SL("_preloaded"), PH_NOISY_CC);
+		if (Z_TYPE_P(preloaded) == IS_ARRAY) { 
+	
+			PHALCON_INIT_VAR(referenced_model);
+			PHALCON_CALL_METHOD(referenced_model, relation, "getreferencedmodel");
+	
+			PHALCON_INIT_VAR(entity_name);
+			phalcon_fast_strtolower(entity_name, referenced_model);
+			if (phalcon_array_isset(preloaded, entity_name)) {
+	
+				PHALCON_OBS_VAR(model_preloaded);
+				phalcon_array_fetch(&model_preloaded, preloaded, entity_name, PH_NOISY_CC);
+	
+				PHALCON_INIT_VAR(preload_key);
+				PHALCON_CALL_METHOD_PARAMS_2(preload_key, this_ptr, "_getpreloadkey", relation, placeholders);
+				if (phalcon_array_isset(model_preloaded, preload_key)) {
+					PHALCON_OBS_VAR(records);
+					phalcon_array_fetch(&records, model_preloaded, preload_key, PH_NOISY_CC);
+					RETURN_CCTOR(records);
+				}
+			}
+		}
+	}
+	
 	/** 
 	 * We don't trust the user or the database so we use bound parameters
 	 */
@@ -1836,7 +2326,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	PHALCON_INIT_VAR(has_through);
 	PHALCON_CALL_METHOD(has_through, relation, "hasthrough");
 	if (zend_is_true(has_through)) {
-		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Not implemented");
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Relations through an intermediate model are not supported");
 		return;
 	}
 	
@@ -1865,7 +2355,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	/** 
 	 * Perform the query on the referenced model
 	 */
-	PHALCON_INIT_VAR(referenced_model);
+	PHALCON_INIT_NVAR(referenced_model);
 	PHALCON_CALL_METHOD(referenced_model, relation, "getreferencedmodel");
 	
 	/** 
@@ -1942,6 +2432,531 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	RETURN_CCTOR(records);
 }
 
+/**
+ * Builds the key of records loaded in advance, relations with the same type, referenced
+ * model and referenced fields produce the same records so they share the key
+ *
+ * @param Phalcon\Mvc\Model\Relation $relation
+ * @param array $values
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, _getPreloadKey){
+
+	zval *relation, *values, *type, *referenced_model, *referenced_fields;
+	zval *joined_fields = NULL, *prefix, *key;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &relation, &values);
+	
+	PHALCON_INIT_VAR(type);
+	PHALCON_CALL_METHOD(type, relation, "gettype");
+	
+	PHALCON_INIT_VAR(referenced_model);
+	PHALCON_CALL_METHOD(referenced_model, relation, "getreferencedmodel");
+	
+	PHALCON_INIT_VAR(referenced_fields);
+	PHALCON_CALL_METHOD(referenced_fields, relation, "getreferencedfields");
+	if (Z_TYPE_P(referenced_fields) == IS_ARRAY) { 
+		PHALCON_INIT_VAR(joined_fields);
+		phalcon_fast_join_str(joined_fields, SL(","), referenced_fields TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(joined_fields, referenced_fields);
+	}
+	
+	PHALCON_INIT_VAR(prefix);
+	PHALCON_CONCAT_VSVSVS(prefix, referenced_model, "$", type, "$", joined_fields, "$");
+	
+	PHALCON_INIT_VAR(key);
+	phalcon_unique_key(key, prefix, values TSRMLS_CC);
+	
+	RETURN_CTOR(key);
+}
+
+/**
+ * Loads in advance the records of a relation for a set of records, the keys are queried in
+ * chunks of a bounded number of values. Returns the related records found
+ *
+ * @param string $modelName
+ * @param array $records
+ * @param string $alias
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, _preloadRelation){
+
+	zval *model_name, *records, *alias, *relation, *exception_message = NULL;
+	zval *has_through, *fields, *referenced_fields, *referenced_model, *type;
+	zval *fields_list = NULL, *referenced_list = NULL, *keys, *lookups;
+	zval *placeholders = NULL, *conditions = NULL, *in_placeholders = NULL;
+	zval *record = NULL, *values = NULL, *lookup = NULL;
+	zval *field = NULL, *value = NULL, *preload_key = NULL, *position = NULL;
+	zval *placeholder = NULL, *referenced_field = NULL, *condition = NULL;
+	zval *compound_conditions = NULL, *joined_conditions = NULL, *first_record = NULL;
+	zval *referenced_entity, *related, *groups, *dependency_injector = NULL;
+	zval *find_params = NULL, *arguments = NULL, *call_object = NULL, *resultset = NULL, *valid = NULL;
+	zval *related_record = NULL, *group = NULL, *records_group = NULL;
+	zval *joined_placeholders = NULL, *entity_name, *preloaded, *model_preloaded = NULL;
+	int has_null, has_lookup;
+	long number_placeholders = 0, number_fields;
+	HashTable *ah0, *ah1, *ah2, *ah3, *ah4;
+	HashPosition hp0, hp1, hp2, hp3, hp4;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 3, 0, &model_name, &records, &alias);
+	
+	PHALCON_INIT_VAR(relation);
+	PHALCON_CALL_METHOD_PARAMS_2(relation, this_ptr, "getrelationbyalias", model_name, alias);
+	if (Z_TYPE_P(relation) != IS_OBJECT) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVSVS(exception_message, "There is no defined relations for the model \"", model_name, "\" using alias \"", alias, "\"");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, exception_message);
+		return;
+	}
+	
+	/** 
+	 * Relations through an intermediate model are rejected before querying anything
+	 */
+	PHALCON_INIT_VAR(has_through);
+	PHALCON_CALL_METHOD(has_through, relation, "hasthrough");
+	if (zend_is_true(has_through)) {
+		PHALCON_INIT_NVAR(exception_message);
+		PHALCON_CONCAT_SVSVS(exception_message, "The relation \"", alias, "\" of the model \"", model_name, "\" uses an intermediate model and cannot be preloaded");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, exception_message);
+		return;
+	}
+	
+	PHALCON_INIT_VAR(fields);
+	PHALCON_CALL_METHOD(fields, relation, "getfields");
+	
+	PHALCON_INIT_VAR(referenced_fields);
+	PHALCON_CALL_METHOD(referenced_fields, relation, "getreferencedfields");
+	
+	PHALCON_INIT_VAR(referenced_model);
+	PHALCON_CALL_METHOD(referenced_model, relation, "getreferencedmodel");
+	
+	PHALCON_INIT_VAR(type);
+	PHALCON_CALL_METHOD(type, relation, "gettype");
+	
+	/** 
+	 * Simple relations are treated as compound relations with a single field
+	 */
+	if (Z_TYPE_P(fields) != IS_ARRAY) { 
+		PHALCON_INIT_VAR(fields_list);
+		array_init_size(fields_list, 1);
+		phalcon_array_append(&fields_list, fields, PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(referenced_list);
+		array_init_size(referenced_list, 1);
+		phalcon_array_append(&referenced_list, referenced_fields, PH_SEPARATE TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(fields_list, fields);
+		PHALCON_CPY_WRT(referenced_list, referenced_fields);
+	}
+	
+	PHALCON_INIT_VAR(keys);
+	array_init(keys);
+	
+	PHALCON_INIT_VAR(lookups);
+	array_init(lookups);
+	
+	/** 
+	 * Collect the distinct values of the fields in the relation, records having null
+	 * values don't have related records
+	 */
+	phalcon_is_iterable(records, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(record);
+	
+		if (!first_record) {
+			PHALCON_CPY_WRT(first_record, record);
+		}
+	
+		PHALCON_INIT_NVAR(values);
+		array_init(values);
+	
+		has_null = 0;
+	
+		phalcon_is_iterable(fields_list, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(field);
+	
+			PHALCON_INIT_NVAR(value);
+			PHALCON_CALL_METHOD_PARAMS_1(value, record, "readattribute", field);
+			if (Z_TYPE_P(value) == IS_NULL) {
+				has_null = 1;
+			}
+			phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah1, &hp1);
+		}
+	
+		PHALCON_INIT_NVAR(preload_key);
+		PHALCON_CALL_METHOD_PARAMS_2(preload_key, this_ptr, "_getpreloadkey", relation, values);
+		if (!phalcon_array_isset(keys, preload_key)) {
+			phalcon_array_update_zval(&keys, preload_key, &values, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			if (!has_null) {
+				phalcon_array_append(&lookups, values, PH_SEPARATE TSRMLS_CC);
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(referenced_entity);
+	PHALCON_CALL_METHOD_PARAMS_1(referenced_entity, this_ptr, "load", referenced_model);
+	
+	PHALCON_INIT_VAR(related);
+	array_init(related);
+	
+	PHALCON_INIT_VAR(groups);
+	array_init(groups);
+	
+	if (zend_hash_num_elements(Z_ARRVAL_P(lookups))) {
+	
+		PHALCON_INIT_VAR(dependency_injector);
+		PHALCON_CALL_METHOD(dependency_injector, first_record, "getdi");
+	
+		number_fields = zend_hash_num_elements(Z_ARRVAL_P(fields_list));
+	
+		PHALCON_INIT_VAR(placeholders);
+		array_init(placeholders);
+	
+		PHALCON_INIT_VAR(conditions);
+		array_init(conditions);
+	
+		PHALCON_INIT_VAR(in_placeholders);
+		array_init(in_placeholders);
+	
+		/** 
+		 * The keys are queried in chunks, databases limit the number of values bound to
+		 * a statement and the length of the statement itself
+		 */
+		phalcon_is_iterable(lookups, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+		while (1) {
+	
+			has_lookup = zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS;
+			if (has_lookup) {
+				PHALCON_GET_FOREACH_VALUE(lookup);
+			}
+	
+			if (number_placeholders && (!has_lookup || number_placeholders + number_fields > PHALCON_MVC_MODEL_MANAGER_PRELOAD_CHUNK)) {
+	
+				/** 
+				 * Simple relations use IN, compound relations use a disjunction of every key
+				 */
+				PHALCON_INIT_NVAR(joined_conditions);
+				if (Z_TYPE_P(fields) != IS_ARRAY) { 
+					PHALCON_INIT_NVAR(joined_placeholders);
+					phalcon_fast_join_str(joined_placeholders, SL(", "), in_placeholders TSRMLS_CC);
+					PHALCON_CONCAT_VSVS(joined_conditions, referenced_fields, " IN (", joined_placeholders, ")");
+				} else {
+					phalcon_fast_join_str(joined_conditions, SL(" OR "), conditions TSRMLS_CC);
+				}
+	
+				PHALCON_INIT_NVAR(find_params);
+				array_init_size(find_params, 3);
+				phalcon_array_append(&find_params, joined_conditions, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_update_string(&find_params, SL("bind"), &placeholders, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				phalcon_array_update_string(&find_params, SL("di"), &dependency_injector, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+				PHALCON_INIT_NVAR(arguments);
+				array_init_size(arguments, 1);
+				phalcon_array_append(&arguments, find_params, PH_SEPARATE TSRMLS_CC);
+	
+				PHALCON_INIT_NVAR(call_object);
+				array_init_size(call_object, 2);
+				phalcon_array_append(&call_object, referenced_entity, PH_SEPARATE TSRMLS_CC);
+				add_next_index_stringl(call_object, SL("find"), 1);
+	
+				PHALCON_INIT_NVAR(resultset);
+				PHALCON_CALL_USER_FUNC_ARRAY(resultset, call_object, arguments);
+	
+				/** 
+				 * Group the related records by the values of the referenced fields
+				 */
+				PHALCON_CALL_METHOD_NORETURN(resultset, "rewind");
+	
+				while (1) {
+	
+					PHALCON_INIT_NVAR(valid);
+					PHALCON_CALL_METHOD(valid, resultset, "valid");
+					if (!zend_is_true(valid)) {
+						break;
+					}
+	
+					PHALCON_INIT_NVAR(related_record);
+					PHALCON_CALL_METHOD(related_record, resultset, "current");
+	
+					PHALCON_INIT_NVAR(values);
+					array_init(values);
+	
+					phalcon_is_iterable(referenced_list, &ah3, &hp3, 0, 0 TSRMLS_CC);
+	
+					while (zend_hash_get_current_data_ex(ah3, (void**) &hd, &hp3) == SUCCESS) {
+	
+						PHALCON_GET_FOREACH_VALUE(referenced_field);
+	
+						PHALCON_INIT_NVAR(value);
+						PHALCON_CALL_METHOD_PARAMS_1(value, related_record, "readattribute", referenced_field);
+						phalcon_array_append(&values, value, PH_SEPARATE TSRMLS_CC);
+	
+						zend_hash_move_forward_ex(ah3, &hp3);
+					}
+	
+					PHALCON_INIT_NVAR(preload_key);
+					PHALCON_CALL_METHOD_PARAMS_2(preload_key, this_ptr, "_getpreloadkey", relation, values);
+					phalcon_array_update_append_multi_2(&groups, preload_key, related_record, 0 TSRMLS_CC);
+					phalcon_array_append(&related, related_record, PH_SEPARATE TSRMLS_CC);
+	
+					PHALCON_CALL_METHOD_NORETURN(resultset, "next");
+				}
+	
+				PHALCON_INIT_NVAR(placeholders);
+				array_init(placeholders);
+	
+				PHALCON_INIT_NVAR(conditions);
+				array_init(conditions);
+	
+				PHALCON_INIT_NVAR(in_placeholders);
+				array_init(in_placeholders);
+	
+				number_placeholders = 0;
+			}
+	
+			if (!has_lookup) {
+				break;
+			}
+	
+			PHALCON_INIT_NVAR(compound_conditions);
+			array_init(compound_conditions);
+	
+			phalcon_is_iterable(lookup, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_KEY(position, ah1, hp1);
+				PHALCON_GET_FOREACH_VALUE(value);
+	
+				PHALCON_INIT_NVAR(placeholder);
+				ZVAL_LONG(placeholder, number_placeholders);
+	
+				PHALCON_OBS_NVAR(referenced_field);
+				phalcon_array_fetch(&referenced_field, referenced_list, position, PH_NOISY_CC);
+	
+				PHALCON_INIT_NVAR(condition);
+				PHALCON_CONCAT_VSV(condition, referenced_field, " = ?", placeholder);
+				phalcon_array_append(&compound_conditions, condition, PH_SEPARATE TSRMLS_CC);
+	
+				PHALCON_INIT_NVAR(condition);
+				PHALCON_CONCAT_SV(condition, "?", placeholder);
+				phalcon_array_append(&in_placeholders, condition, PH_SEPARATE TSRMLS_CC);
+	
+				phalcon_array_append(&placeholders, value, PH_SEPARATE TSRMLS_CC);
+				number_placeholders++;
+	
+				zend_hash_move_forward_ex(ah1, &hp1);
+			}
+	
+			PHALCON_INIT_NVAR(joined_conditions);
+			phalcon_fast_join_str(joined_conditions, SL(" AND "), compound_conditions TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(condition);
+			PHALCON_CONCAT_SVS(condition, "(", joined_conditions, ")");
+			phalcon_array_append(&conditions, condition, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+	}
+	
+	/** 
+	 * Store the records of every key, hasMany relations receive a resultset and the
+	 * rest of relations the first record found or false. Records are grouped by the
+	 * referenced model so saving or deleting one of its records discards them
+	 */
+	PHALCON_INIT_VAR(entity_name);
+	phalcon_fast_strtolower(entity_name, referenced_model);
+	
+	PHALCON_OBS_VAR(preloaded);
+	phalcon_read_property_this(&preloaded, this_ptr, SL("_preloaded"), PH_NOISY_CC);
+	if (phalcon_array_isset(preloaded, entity_name)) {
+		PHALCON_OBS_VAR(model_preloaded);
+		phalcon_array_fetch(&model_preloaded, preloaded, entity_name, PH_NOISY_CC);
+		PHALCON_SEPARATE(model_preloaded);
+	} else {
+		PHALCON_INIT_VAR(model_preloaded);
+		array_init(model_preloaded);
+	}
+	
+	phalcon_is_iterable(keys, &ah4, &hp4, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah4, (void**) &hd, &hp4) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(preload_key, ah4, hp4);
+	
+		if (phalcon_array_isset(groups, preload_key)) {
+			PHALCON_OBS_NVAR(group);
+			phalcon_array_fetch(&group, groups, preload_key, PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_NVAR(group);
+			array_init(group);
+		}
+	
+		if (PHALCON_IS_LONG(type, 2)) {
+			PHALCON_INIT_NVAR(records_group);
+			object_init_ex(records_group, phalcon_mvc_model_resultset_simple_ce);
+			PHALCON_INIT_NVAR(value);
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(records_group, "__construct", value, referenced_entity, group);
+		} else {
+			if (phalcon_array_isset_long(group, 0)) {
+				PHALCON_OBS_NVAR(records_group);
+				phalcon_array_fetch_long(&records_group, group, 0, PH_NOISY_CC);
+			} else {
+				PHALCON_INIT_NVAR(records_group);
+				ZVAL_BOOL(records_group, 0);
+			}
+		}
+	
+		phalcon_array_update_zval(&model_preloaded, preload_key, &records_group, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah4, &hp4);
+	}
+	
+	phalcon_update_property_array(this_ptr, SL("_preloaded"), entity_name, model_preloaded TSRMLS_CC);
+	
+	RETURN_CTOR(related);
+}
+
+/**
+ * Loads in advance the records related to a set of records, every relation is loaded with a
+ * query per chunk of keys and further access to the relation in any of the records doesn't
+ * query the database. Nested relations are separated by dots
+ *
+ *<code>
+ * $robots = Robots::find();
+ * $manager->preloadRelations('Robots', $robots, array('robotsParts.parts'));
+ *
+ * foreach ($robots as $robot) {
+ *     foreach ($robot->robotsParts as $robotPart) {
+ *         echo $robotPart->parts->name, PHP_EOL;
+ *     }
+ * }
+ *</code>
+ *
+ * @param string $modelName
+ * @param array|Phalcon\Mvc\Model\ResultsetInterface $records
+ * @param string|array $relations
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, preloadRelations){
+
+	zval *model_name, *records, *relations, *models = NULL, *valid = NULL;
+	zval *record = NULL, *relation_paths = NULL, *relation_path = NULL;
+	zval *alias = NULL, *nested = NULL, *related = NULL, *relation = NULL;
+	zval *referenced_model = NULL;
+	char *dot;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 3, 0, &model_name, &records, &relations);
+	
+	/** 
+	 * Resultsets are traversed to get the records
+	 */
+	if (Z_TYPE_P(records) == IS_OBJECT) {
+	
+		PHALCON_INIT_VAR(models);
+		array_init(models);
+	
+		PHALCON_CALL_METHOD_NORETURN(records, "rewind");
+	
+		while (1) {
+	
+			PHALCON_INIT_NVAR(valid);
+			PHALCON_CALL_METHOD(valid, records, "valid");
+			if (!zend_is_true(valid)) {
+				break;
+			}
+	
+			PHALCON_INIT_NVAR(record);
+			PHALCON_CALL_METHOD(record, records, "current");
+			phalcon_array_append(&models, record, PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_CALL_METHOD_NORETURN(records, "next");
+		}
+	} else {
+		if (Z_TYPE_P(records) != IS_ARRAY) { 
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Records to preload must be an array or a resultset");
+			return;
+		}
+		PHALCON_CPY_WRT(models, records);
+	}
+	
+	if (!phalcon_fast_count_ev(models TSRMLS_CC)) {
+		RETURN_MM_NULL();
+	}
+	
+	if (Z_TYPE_P(relations) != IS_ARRAY) { 
+		PHALCON_INIT_VAR(relation_paths);
+		array_init_size(relation_paths, 1);
+		phalcon_array_append(&relation_paths, relations, PH_SEPARATE TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(relation_paths, relations);
+	}
+	
+	phalcon_is_iterable(relation_paths, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(relation_path);
+	
+		if (Z_TYPE_P(relation_path) != IS_STRING) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Relations to preload must be strings");
+			return;
+		}
+	
+		/** 
+		 * The first alias is loaded here, the rest of the path is loaded from the related model
+		 */
+		PHALCON_INIT_NVAR(alias);
+		PHALCON_INIT_NVAR(nested);
+	
+		dot = memchr(Z_STRVAL_P(relation_path), '.', Z_STRLEN_P(relation_path));
+		if (dot) {
+			ZVAL_STRINGL(alias, Z_STRVAL_P(relation_path), dot - Z_STRVAL_P(relation_path), 1);
+			ZVAL_STRINGL(nested, dot + 1, Z_STRLEN_P(relation_path) - (dot - Z_STRVAL_P(relation_path)) - 1, 1);
+		} else {
+			ZVAL_STRINGL(alias, Z_STRVAL_P(relation_path), Z_STRLEN_P(relation_path), 1);
+		}
+	
+		PHALCON_INIT_NVAR(related);
+		PHALCON_CALL_METHOD_PARAMS_3(related, this_ptr, "_preloadrelation", model_name, models, alias);
+	
+		if (Z_TYPE_P(nested) == IS_STRING) {
+	
+			PHALCON_INIT_NVAR(relation);
+			PHALCON_CALL_METHOD_PARAMS_2(relation, this_ptr, "getrelationbyalias", model_name, alias);
+	
+			PHALCON_INIT_NVAR(referenced_model);
+			PHALCON_CALL_METHOD(referenced_model, relation, "getreferencedmodel");
+	
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "preloadrelations", referenced_model, related, nested);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Returns a reusable object from the internal list
  *
@@ -1986,7 +3001,42 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setReusableRecords){
 }
 
 /**
- * Clears the internal reusable list
+ * Discards the records loaded in advance by preloadRelations(), only the records of a model
+ * are discarded if its name is passed. Models call it every time one of their records is
+ * saved or deleted
+ *
+ * @param string $modelName
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearPreloaded){
+
+	zval *model_name = NULL, *preloaded, *entity_name;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 0, 1, &model_name);
+	
+	PHALCON_OBS_VAR(preloaded);
+	phalcon_read_property_this(&preloaded, this_ptr, SL("_preloaded"), PH_NOISY_CC);
+	if (Z_TYPE_P(preloaded) != IS_ARRAY) { 
+		RETURN_MM_NULL();
+	}
+	
+	if (!model_name || Z_TYPE_P(model_name) != IS_STRING) {
+		phalcon_update_property_null(this_ptr, SL("_preloaded") TSRMLS_CC);
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_INIT_VAR(entity_name);
+	phalcon_fast_strtolower(entity_name, model_name);
+	if (phalcon_array_isset(preloaded, entity_name)) {
+		phalcon_unset_property_array(this_ptr, SL("_preloaded"), entity_name TSRMLS_CC);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Clears the internal reusable list and the records loaded in advance
  *
  * @param
  */
@@ -1994,6 +3044,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, clearReusableObjects){
 
 
 	phalcon_update_property_null(this_ptr, SL("_reusable") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_preloaded") TSRMLS_CC);
 	
 }
 
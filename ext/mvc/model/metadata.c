@@ -39,6 +39,7 @@
 #include "kernel/exception.h"
 #include "kernel/string.h"
 #include "kernel/file.h"
+#include "kernel/persistent.h"
 
 /**
  * Phalcon\Mvc\Model\MetaData
@@ -1102,7 +1103,8 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, isEmpty){
 }
 
 /**
- * Resets internal meta-data in order to regenerate it
+ * Resets internal meta-data in order to regenerate it, the PHQL intermediate
+ * representations kept by the process are discarded too
  *
  *<code>
  *	$metaData->reset();
@@ -1119,6 +1121,11 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, reset){
 	phalcon_update_property_this(this_ptr, SL("_metaData"), empty_array TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_columnMap"), empty_array TSRMLS_CC);
 	
+	/** 
+	 * The PHQL intermediate representations depend on the meta-data
+	 */
+	phalcon_persistent_cache_clear(phalcon_orm_ir_cache);
+	
 	PHALCON_MM_RESTORE();
 }
 
@@ -0,0 +1,255 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/array.h"
+#include "kernel/object.h"
+#include "kernel/concat.h"
+#include "kernel/fcall.h"
+#include "kernel/shm.h"
+
+#include "ext/standard/php_smart_str.h"
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Shm
+ *
+ * Stores model meta-data in a memory segment shared by every process started by the same
+ * server (PHP-FPM pools, Apache prefork children). The meta-data is built once, readers
+ * don't take any lock and don't hit the disk
+ *
+ * The size of the segment is set by the phalcon.orm.metadata_shm_size INI setting, if it
+ * is zero or the platform doesn't support shared segments this adapter behaves like
+ * Phalcon\Mvc\Model\MetaData\Memory
+ *
+ *<code>
+ *	$metaData = new Phalcon\Mvc\Model\Metadata\Shm(array(
+ *		'prefix' => 'my-app-id'
+ *	));
+ *</code>
+ */
+
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Shm initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Mvc_Model_MetaData_Shm){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Mvc\\Model\\MetaData, Shm, mvc_model_metadata_shm, "phalcon\\mvc\\model\\metadata", phalcon_mvc_model_metadata_shm_method_entry, 0);
+
+	zend_declare_property_string(phalcon_mvc_model_metadata_shm_ce, SL("_prefix"), "", ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	zend_class_implements(phalcon_mvc_model_metadata_shm_ce TSRMLS_CC, 1, phalcon_mvc_model_metadatainterface_ce);
+
+	return SUCCESS;
+}
+
+/**
+ * Builds the key of an entry in the shared segment. Every prefix has a counter in the segment
+ * that is part of the keys, resetting the meta-data of an application only increments its counter.
+ * FAILURE is returned if the counter is not available
+ */
+static int phalcon_mvc_model_metadata_shm_key(zval *shm_key, zval *prefix, zval *key, int increment TSRMLS_DC){
+
+	smart_str counter_key = {0}, entry_key = {0};
+	zval prefix_copy, key_copy;
+	int use_prefix_copy = 0, use_key_copy = 0;
+	ulong generation = 0;
+	long counter;
+
+	zend_make_printable_zval(prefix, &prefix_copy, &use_prefix_copy);
+	if (use_prefix_copy) {
+		prefix = &prefix_copy;
+	}
+
+	smart_str_appendl(&counter_key, "$PMG$", 5);
+	smart_str_appendl(&counter_key, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix));
+	smart_str_0(&counter_key);
+
+	counter = phalcon_shm_counter(phalcon_orm_metadata_shm, counter_key.c, counter_key.len, increment, &generation);
+	smart_str_free(&counter_key);
+
+	if (counter < 0 || !shm_key) {
+		if (use_prefix_copy) {
+			zval_dtor(&prefix_copy);
+		}
+		return counter < 0 ? FAILURE : SUCCESS;
+	}
+
+	zend_make_printable_zval(key, &key_copy, &use_key_copy);
+	if (use_key_copy) {
+		key = &key_copy;
+	}
+
+	smart_str_appendl(&entry_key, "$PMM$", 5);
+	smart_str_appendl(&entry_key, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix));
+	smart_str_appendc(&entry_key, '$');
+	smart_str_append_unsigned(&entry_key, generation);
+	smart_str_appendc(&entry_key, '.');
+	smart_str_append_long(&entry_key, counter);
+	smart_str_appendc(&entry_key, '$');
+	smart_str_appendl(&entry_key, Z_STRVAL_P(key), Z_STRLEN_P(key));
+	smart_str_0(&entry_key);
+
+	ZVAL_STRINGL(shm_key, entry_key.c, entry_key.len, 0);
+
+	if (use_prefix_copy) {
+		zval_dtor(&prefix_copy);
+	}
+	if (use_key_copy) {
+		zval_dtor(&key_copy);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Shm constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Shm, __construct){
+
+	zval *options = NULL, *prefix, *empty_array;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 0, 1, &options);
+	
+	if (!options) {
+		PHALCON_INIT_VAR(options);
+	}
+	
+	if (Z_TYPE_P(options) == IS_ARRAY) { 
+		if (phalcon_array_isset_string(options, SS("prefix"))) {
+			PHALCON_OBS_VAR(prefix);
+			phalcon_array_fetch_string(&prefix, options, SL("prefix"), PH_NOISY_CC);
+			phalcon_update_property_this(this_ptr, SL("_prefix"), prefix TSRMLS_CC);
+		}
+	}
+	
+	PHALCON_INIT_VAR(empty_array);
+	array_init(empty_array);
+	phalcon_update_property_this(this_ptr, SL("_metaData"), empty_array TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Reads meta-data from the shared segment
+ *
+ * @param  string $key
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Shm, read){
+
+	zval *key, *prefix, *shm_key, *data;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &key);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(shm_key);
+	if (phalcon_mvc_model_metadata_shm_key(shm_key, prefix, key, 0 TSRMLS_CC) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_INIT_VAR(data);
+	if (phalcon_shm_fetch(data, phalcon_orm_metadata_shm, Z_STRVAL_P(shm_key), Z_STRLEN_P(shm_key) TSRMLS_CC) == SUCCESS) {
+		if (Z_TYPE_P(data) == IS_ARRAY) { 
+			RETURN_CCTOR(data);
+		}
+	}
+	
+	RETURN_MM_NULL();
+}
+
+/**
+ * Writes the meta-data to the shared segment, meta-data already stored is kept until the
+ * segment is reset
+ *
+ * @param string $key
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Shm, write){
+
+	zval *key, *data, *prefix, *shm_key;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &key, &data);
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(shm_key);
+	if (phalcon_mvc_model_metadata_shm_key(shm_key, prefix, key, 0 TSRMLS_CC) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+	
+	phalcon_shm_store(phalcon_orm_metadata_shm, Z_STRVAL_P(shm_key), Z_STRLEN_P(shm_key), data TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Resets the internal meta-data and the entries stored under the prefix of the adapter, the next
+ * request of every process rebuilds the meta-data of this application only
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Shm, reset){
+
+	zval *prefix;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_CALL_PARENT_NORETURN(this_ptr, "Phalcon\\Mvc\\Model\\MetaData\\Shm", "reset");
+	
+	PHALCON_OBS_VAR(prefix);
+	phalcon_read_property_this(&prefix, this_ptr, SL("_prefix"), PH_NOISY_CC);
+	phalcon_mvc_model_metadata_shm_key(NULL, prefix, NULL, 1 TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the size, used bytes, number of entries and generation of the shared segment, the
+ * generation is incremented every time the whole segment is cleared
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Shm, getStats){
+
+	phalcon_shm_stats(return_value, phalcon_orm_metadata_shm);
+}
@@ -41,6 +41,8 @@
 #include "kernel/operators.h"
 #include "kernel/string.h"
 #include "kernel/file.h"
+#include "kernel/persistent.h"
+#include "ext/standard/php_smart_str.h"
 #include "mvc/model/query/scanner.h"
 #include "mvc/model/query/phql.h"
 
@@ -92,6 +94,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Query){
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_cache"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_cacheOptions"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_uniqueRow"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_model_query_ce, SL("_streaming"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_bindParams"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_bindTypes"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
@@ -105,6 +108,48 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Query){
 	return SUCCESS;
 }
 
+/**
+ * Builds the key of an intermediate representation in the persistent cache. Besides the PHQL
+ * the key carries the column renaming setting and the identity of the models manager and the
+ * meta-data storage. Sources chosen per request by getSource()/getSchema() are not part of the
+ * key, which is why the cache is only enabled on demand through phalcon.orm.ir_cache_size
+ */
+static void phalcon_mvc_model_query_ir_key(zval *cache_key, zval *manager, zval *meta_data, zval *phql TSRMLS_DC){
+
+	smart_str key = {0};
+	zval *storage = NULL;
+
+	smart_str_appendl(&key, PHALCON_GLOBAL(orm).column_renaming ? "r:" : "n:", 2);
+
+	if (Z_TYPE_P(manager) == IS_OBJECT) {
+		smart_str_appendl(&key, Z_OBJCE_P(manager)->name, Z_OBJCE_P(manager)->name_length);
+	}
+	smart_str_appendc(&key, ':');
+
+	if (Z_TYPE_P(meta_data) == IS_OBJECT) {
+		smart_str_appendl(&key, Z_OBJCE_P(meta_data)->name, Z_OBJCE_P(meta_data)->name_length);
+
+		/** 
+		 * Adapters storing the meta-data are told apart by their prefix or their directory
+		 */
+		if (phalcon_isset_property(meta_data, SS("_prefix") TSRMLS_CC)) {
+			storage = zend_read_property(Z_OBJCE_P(meta_data), meta_data, SL("_prefix"), 1 TSRMLS_CC);
+		} else if (phalcon_isset_property(meta_data, SS("_metaDataDir") TSRMLS_CC)) {
+			storage = zend_read_property(Z_OBJCE_P(meta_data), meta_data, SL("_metaDataDir"), 1 TSRMLS_CC);
+		}
+		if (storage && Z_TYPE_P(storage) == IS_STRING) {
+			smart_str_appendc(&key, ':');
+			smart_str_appendl(&key, Z_STRVAL_P(storage), Z_STRLEN_P(storage));
+		}
+	}
+	smart_str_appendc(&key, ':');
+
+	smart_str_appendl(&key, Z_STRVAL_P(phql), Z_STRLEN_P(phql));
+	smart_str_0(&key);
+
+	ZVAL_STRINGL(cache_key, key.c, key.len, 0);
+}
+
 /**
  * Phalcon\Mvc\Model\Query constructor
  *
@@ -213,6 +258,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, getUniqueRow){
 	RETURN_MEMBER(this_ptr, "_uniqueRow");
 }
 
+/**
+ * Tells to the query if the SELECT must return a forward-only resultset that reads the rows
+ * from the database cursor as they are traversed. Streaming resultsets reuse the same record
+ * on every iteration, and they can't be counted, rewound, serialized or cached
+ *
+ *<code>
+ * $query = $manager->createQuery('SELECT * FROM Robots');
+ * $query->setStreaming(true);
+ * foreach ($query->execute() as $robot) {
+ *     fputcsv($fp, $robot->toArray());
+ * }
+ *</code>
+ *
+ * @param boolean $streaming
+ * @return Phalcon\Mvc\Model\Query
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, setStreaming){
+
+	zval *streaming;
+
+	phalcon_fetch_params(0, 1, 0, &streaming);
+	
+	phalcon_update_property_this(this_ptr, SL("_streaming"), streaming TSRMLS_CC);
+	RETURN_THISW();
+}
+
+/**
+ * Check if the query returns a streaming resultset
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getStreaming){
+
+
+	RETURN_MEMBER(this_ptr, "_streaming");
+}
+
 /**
  * Replaces the model's name to its source name in a qualifed-name expression
  *
@@ -2773,7 +2855,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _prepareDelete){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 
-	zval *intermediate, *phql, *ast, *ir_phql = NULL, *type, *exception_message;
+	zval *intermediate, *phql, *cache_key = NULL, *cached = NULL;
+	zval *manager, *meta_data, *ast, *ir_phql = NULL, *type = NULL;
+	zval *exception_message;
 
 	PHALCON_MM_GROW();
 
@@ -2786,6 +2870,36 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 	PHALCON_OBS_VAR(phql);
 	phalcon_read_property_this(&phql, this_ptr, SL("_phql"), PH_NOISY_CC);
 	
+	/** 
+	 * Check if the intermediate representation was produced by a previous request
+	 * in this process with the same models manager and meta-data
+	 */
+	if (phalcon_orm_ir_cache != NULL && Z_TYPE_P(phql) == IS_STRING) {
+	
+		PHALCON_OBS_VAR(manager);
+		phalcon_read_property_this(&manager, this_ptr, SL("_manager"), PH_NOISY_CC);
+	
+		PHALCON_OBS_VAR(meta_data);
+		phalcon_read_property_this(&meta_data, this_ptr, SL("_metaData"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(cache_key);
+		phalcon_mvc_model_query_ir_key(cache_key, manager, meta_data, phql TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(cached);
+		if (phalcon_persistent_cache_fetch(cached, phalcon_orm_ir_cache, Z_STRVAL_P(cache_key), Z_STRLEN_P(cache_key)) == SUCCESS) {
+	
+			PHALCON_OBS_NVAR(type);
+			phalcon_array_fetch_long(&type, cached, 0, PH_NOISY_CC);
+			phalcon_update_property_this(this_ptr, SL("_type"), type TSRMLS_CC);
+	
+			PHALCON_OBS_NVAR(ir_phql);
+			phalcon_array_fetch_long(&ir_phql, cached, 1, PH_NOISY_CC);
+			phalcon_update_property_this(this_ptr, SL("_intermediate"), ir_phql TSRMLS_CC);
+	
+			RETURN_CCTOR(ir_phql);
+		}
+	}
+	
 	/** 
 	 * This function parses the PHQL statement
 	 */
@@ -2801,7 +2915,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 			/** 
 			 * Produce an independent database system representation
 			 */
-			PHALCON_OBS_VAR(type);
+			PHALCON_OBS_NVAR(type);
 			phalcon_array_fetch_string(&type, ast, SL("type"), PH_NOISY_CC);
 			phalcon_update_property_this(this_ptr, SL("_type"), type TSRMLS_CC);
 	
@@ -2843,6 +2957,17 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 	
 	phalcon_update_property_this(this_ptr, SL("_intermediate"), ir_phql TSRMLS_CC);
 	
+	/** 
+	 * Store the intermediate representation for the next requests
+	 */
+	if (cache_key) {
+		PHALCON_INIT_NVAR(cached);
+		array_init_size(cached, 2);
+		phalcon_array_append(&cached, type, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&cached, ir_phql, PH_SEPARATE TSRMLS_CC);
+		phalcon_persistent_cache_store(phalcon_orm_ir_cache, Z_STRVAL_P(cache_key), Z_STRLEN_P(cache_key), cached);
+	}
+	
 	RETURN_CCTOR(ir_phql);
 }
 
@@ -2907,7 +3032,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	zval *sql_select, *processed = NULL, *value = NULL, *wildcard = NULL;
 	zval *string_wildcard = NULL, *processed_types = NULL, *result;
 	zval *count, *result_data = NULL, *cache, *result_object = NULL;
-	zval *resultset = NULL;
+	zval *resultset = NULL, *streaming, *pdo, *buffered_attribute, *buffered;
+	zval *p0[] = { NULL, NULL, NULL, NULL, NULL, NULL };
+	int status;
 	HashTable *ah0, *ah1, *ah2, *ah3, *ah4, *ah5, *ah6;
 	HashPosition hp0, hp1, hp2, hp3, hp4, hp5, hp6;
 	zval **hd;
@@ -3332,22 +3459,74 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 		PHALCON_CPY_WRT(processed_types, bind_types);
 	}
 	
-	/** 
-	 * Execute the query
-	 */
-	PHALCON_INIT_VAR(result);
-	PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", sql_select, processed, processed_types);
+	PHALCON_OBS_VAR(streaming);
+	phalcon_read_property_this(&streaming, this_ptr, SL("_streaming"), PH_NOISY_CC);
+	if (zend_is_true(streaming)) {
 	
-	/** 
-	 * Check if the query has data
-	 */
-	PHALCON_INIT_VAR(count);
-	PHALCON_CALL_METHOD_PARAMS_1(count, result, "numrows", result);
-	if (zend_is_true(count)) {
+		if (PHALCON_IS_TRUE(is_complex)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Only resultsets of complete objects or scalars can be streamed");
+			return;
+		}
+	
+		/** 
+		 * MySQL buffers the whole result in the client by default, the statement is
+		 * executed unbuffered so the rows are read from the server as they are fetched
+		 */
+		PHALCON_INIT_NVAR(type);
+		PHALCON_CALL_METHOD(type, connection, "gettype");
+		if (PHALCON_IS_STRING(type, "mysql")) {
+	
+			PHALCON_INIT_VAR(pdo);
+			PHALCON_CALL_METHOD(pdo, connection, "getinternalhandler");
+	
+			/** 
+			 * PDO::MYSQL_ATTR_USE_BUFFERED_QUERY
+			 */
+			PHALCON_INIT_VAR(buffered_attribute);
+			ZVAL_LONG(buffered_attribute, 1000);
+	
+			PHALCON_INIT_VAR(buffered);
+			ZVAL_BOOL(buffered, 0);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(pdo, "setattribute", buffered_attribute, buffered);
+	
+			PHALCON_INIT_VAR(result);
+			status = phalcon_call_method_three_params(result, connection, SL("query"), sql_select, processed, processed_types, 1 PH_MEHASH_C TSRMLS_CC);
+	
+			/** 
+			 * The connection is restored even if the query failed
+			 */
+			ZVAL_BOOL(buffered, 1);
+			PHALCON_CALL_METHOD_PARAMS_2_NORETURN(pdo, "setattribute", buffered_attribute, buffered);
+			if (status == FAILURE) {
+				return;
+			}
+		} else {
+			PHALCON_INIT_VAR(result);
+			PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", sql_select, processed, processed_types);
+		}
+	
+		/** 
+		 * The number of rows is unknown until the cursor is exhausted
+		 */
 		PHALCON_CPY_WRT(result_data, result);
 	} else {
-		PHALCON_INIT_VAR(result_data);
-		ZVAL_BOOL(result_data, 0);
+		/** 
+		 * Execute the query
+		 */
+		PHALCON_INIT_VAR(result);
+		PHALCON_CALL_METHOD_PARAMS_3(result, connection, "query", sql_select, processed, processed_types);
+	
+		/** 
+		 * Check if the query has data
+		 */
+		PHALCON_INIT_VAR(count);
+		PHALCON_CALL_METHOD_PARAMS_1(count, result, "numrows", result);
+		if (zend_is_true(count)) {
+			PHALCON_CPY_WRT(result_data, result);
+		} else {
+			PHALCON_INIT_VAR(result_data);
+			ZVAL_BOOL(result_data, 0);
+		}
 	}
 	
 	/** 
@@ -3393,7 +3572,17 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 		 */
 		PHALCON_INIT_VAR(resultset);
 		object_init_ex(resultset, phalcon_mvc_model_resultset_simple_ce);
-		PHALCON_CALL_METHOD_PARAMS_5_NORETURN(resultset, "__construct", simple_column_map, result_object, result_data, cache, is_keeping_snapshots);
+		if (zend_is_true(streaming)) {
+			p0[0] = simple_column_map;
+			p0[1] = result_object;
+			p0[2] = result_data;
+			p0[3] = cache;
+			p0[4] = is_keeping_snapshots;
+			p0[5] = streaming;
+			PHALCON_CALL_METHOD_PARAMS_NORETURN(resultset, "__construct", 6, p0);
+		} else {
+			PHALCON_CALL_METHOD_PARAMS_5_NORETURN(resultset, "__construct", simple_column_map, result_object, result_data, cache, is_keeping_snapshots);
+		}
 	
 	
 		RETURN_CTOR(resultset);
@@ -4169,7 +4358,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 	zval *dependency_injector, *cache, *result = NULL, *is_fresh;
 	zval *prepared_result = NULL, *intermediate, *default_bind_params;
 	zval *merged_params = NULL, *default_bind_types;
-	zval *merged_types = NULL, *type, *exception_message;
+	zval *merged_types = NULL, *type, *exception_message, *streaming;
 
 	PHALCON_MM_GROW();
 
@@ -4186,6 +4375,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 	PHALCON_OBS_VAR(unique_row);
 	phalcon_read_property_this(&unique_row, this_ptr, SL("_uniqueRow"), PH_NOISY_CC);
 	
+	PHALCON_OBS_VAR(streaming);
+	phalcon_read_property_this(&streaming, this_ptr, SL("_streaming"), PH_NOISY_CC);
+	
 	PHALCON_OBS_VAR(cache_options);
 	phalcon_read_property_this(&cache_options, this_ptr, SL("_cacheOptions"), PH_NOISY_CC);
 	if (Z_TYPE_P(cache_options) != IS_NULL) {
@@ -4194,6 +4386,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 			return;
 		}
 	
+		if (zend_is_true(streaming)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets cannot be cached");
+			return;
+		}
+	
 		/** 
 		 * The user must set a cache key
 		 */
@@ -4533,3 +4730,25 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, getIntermediate){
 	RETURN_MEMBER(this_ptr, "_intermediate");
 }
 
+/**
+ * Removes the intermediate representations kept between requests by this process.
+ * It must be called when the structure of the models changes without restarting the process
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, clearIntermediateCache){
+
+
+	phalcon_persistent_cache_clear(phalcon_orm_ir_cache);
+}
+
+/**
+ * Returns the size, the number of entries, hits, misses and evictions of the
+ * intermediate representations cache (phalcon.orm.ir_cache_size)
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getIntermediateCacheStats){
+
+
+	phalcon_persistent_cache_stats(return_value, phalcon_orm_ir_cache);
+}
+
@@ -87,6 +87,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset){
 
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_FULL"), 0 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_PARTIAL"), 1 TSRMLS_CC);
+	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_STREAM"), 2 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_RECORDS"), 0 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_OBJECTS"), 2 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_ARRAYS"), 1 TSRMLS_CC);
@@ -124,13 +125,24 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, key){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 
-	zval *type, *result = NULL, *active_row, *zero, *rows = NULL;
+	zval *type, *result = NULL, *active_row = NULL, *zero, *rows = NULL;
 
 	PHALCON_MM_GROW();
 
 	PHALCON_OBS_VAR(type);
 	phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
-	if (zend_is_true(type)) {
+	if (PHALCON_IS_LONG(type, 2)) {
+	
+		/** 
+		 * Streaming resultsets can only be traversed once
+		 */
+		PHALCON_OBS_VAR(active_row);
+		phalcon_read_property_this(&active_row, this_ptr, SL("_activeRow"), PH_NOISY_CC);
+		if (Z_TYPE_P(active_row) != IS_NULL) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets are forward-only and cannot be rewound");
+			return;
+		}
+	} else if (zend_is_true(type)) {
 	
 		/** 
 		 * Here, the resultset act as a result that is fetched one by one
@@ -139,7 +151,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 		phalcon_read_property_this(&result, this_ptr, SL("_result"), PH_NOISY_CC);
 		if (PHALCON_IS_NOT_FALSE(result)) {
 	
-			PHALCON_OBS_VAR(active_row);
+			PHALCON_OBS_NVAR(active_row);
 			phalcon_read_property_this(&active_row, this_ptr, SL("_activeRow"), PH_NOISY_CC);
 			if (Z_TYPE_P(active_row) != IS_NULL) {
 				PHALCON_INIT_VAR(zero);
@@ -207,6 +219,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 
 		PHALCON_OBS_VAR(type);
 		phalcon_read_property(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+		if (PHALCON_IS_LONG(type, 2)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets are forward-only and cannot be seeked");
+			return;
+		}
+
 		if (zend_is_true(type)) {
 
 			/**
@@ -281,11 +298,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, count){
 	 */
 	if (Z_TYPE_P(count) == IS_NULL) {
 	
+		PHALCON_OBS_VAR(type);
+		phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+		if (PHALCON_IS_LONG(type, 2)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The number of rows in a streaming resultset is unknown, use a COUNT query instead");
+			return;
+		}
+	
 		PHALCON_INIT_NVAR(count);
 		ZVAL_LONG(count, 0);
 	
-		PHALCON_OBS_VAR(type);
-		phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
 		if (zend_is_true(type)) {
 	
 			/** 
@@ -44,6 +44,9 @@
  *
  * Simple resultsets only contains a complete objects
  * This class builds every complete object as it is required
+ *
+ * Streaming resultsets (TYPE_RESULT_STREAM) read the rows from the cursor as they are
+ * traversed and hydrate them into the same record, so they can be traversed only once
  */
 
 
@@ -71,15 +74,16 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset_Simple){
  * @param Phalcon\Db\Result\Pdo $result
  * @param Phalcon\Cache\BackendInterface $cache
  * @param boolean $keepSnapshots
+ * @param boolean $streaming
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 
 	zval *column_map, *model, *result, *cache = NULL, *keep_snapshots = NULL;
-	zval *fetch_assoc, *limit, *row_count, *big_resultset;
+	zval *streaming = NULL, *fetch_assoc, *limit, *row_count = NULL, *big_resultset;
 
 	PHALCON_MM_GROW();
 
-	phalcon_fetch_params(1, 3, 2, &column_map, &model, &result, &cache, &keep_snapshots);
+	phalcon_fetch_params(1, 3, 3, &column_map, &model, &result, &cache, &keep_snapshots, &streaming);
 	
 	if (!cache) {
 		PHALCON_INIT_VAR(cache);
@@ -89,11 +93,30 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 		PHALCON_INIT_VAR(keep_snapshots);
 	}
 	
+	if (!streaming) {
+		PHALCON_INIT_VAR(streaming);
+		ZVAL_BOOL(streaming, 0);
+	}
+	
 	phalcon_update_property_this(this_ptr, SL("_model"), model TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_result"), result TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_cache"), cache TSRMLS_CC);
 	phalcon_update_property_this(this_ptr, SL("_columnMap"), column_map TSRMLS_CC);
 	if (Z_TYPE_P(result) != IS_OBJECT) {
+	
+		/** 
+		 * Resultsets can be built from records already hydrated, as the ones loaded in advance
+		 */
+		if (Z_TYPE_P(result) == IS_ARRAY) { 
+			phalcon_update_property_bool(this_ptr, SL("_result"), 0 TSRMLS_CC);
+			phalcon_update_property_long(this_ptr, SL("_type"), 0 TSRMLS_CC);
+			phalcon_update_property_this(this_ptr, SL("_rows"), result TSRMLS_CC);
+	
+			PHALCON_INIT_VAR(row_count);
+			phalcon_fast_count(row_count, result TSRMLS_CC);
+			phalcon_update_property_this(this_ptr, SL("_count"), row_count TSRMLS_CC);
+		}
+	
 		RETURN_MM_NULL();
 	}
 	
@@ -104,10 +127,19 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 	ZVAL_LONG(fetch_assoc, 1);
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "setfetchmode", fetch_assoc);
 	
+	/** 
+	 * Streaming resultsets are read from the cursor without counting the rows
+	 */
+	if (zend_is_true(streaming)) {
+		phalcon_update_property_long(this_ptr, SL("_type"), 2 TSRMLS_CC);
+		phalcon_update_property_this(this_ptr, SL("_keepSnapshots"), keep_snapshots TSRMLS_CC);
+		RETURN_MM_NULL();
+	}
+	
 	PHALCON_INIT_VAR(limit);
 	ZVAL_LONG(limit, 32);
 	
-	PHALCON_INIT_VAR(row_count);
+	PHALCON_INIT_NVAR(row_count);
 	PHALCON_CALL_METHOD(row_count, result, "numrows");
 	
 	/** 
@@ -143,6 +175,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 
 	zval *type, *result = NULL, *row = NULL, *rows = NULL, *dirty_state, *hydrate_mode;
 	zval *keep_snapshots, *column_map, *model, *active_row = NULL;
+	zval *key = NULL, *value = NULL, *attribute = NULL, *exception_message = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
 
 	PHALCON_MM_GROW();
 
@@ -186,6 +222,14 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 		}
 	}
 	
+	/** 
+	 * Records hydrated in advance are returned as they are
+	 */
+	if (Z_TYPE_P(row) == IS_OBJECT) {
+		phalcon_update_property_this(this_ptr, SL("_activeRow"), row TSRMLS_CC);
+		RETURN_MM_TRUE;
+	}
+	
 	if (Z_TYPE_P(row) != IS_ARRAY) { 
 		phalcon_update_property_bool(this_ptr, SL("_activeRow"), 0 TSRMLS_CC);
 		RETURN_MM_FALSE;
@@ -222,6 +266,49 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 	switch (phalcon_get_intval(hydrate_mode)) {
 	
 		case 0:
+			/** 
+			 * Streaming resultsets reuse the record hydrated in the previous iteration
+			 */
+			if (PHALCON_IS_LONG(type, 2)) {
+	
+				PHALCON_OBS_VAR(active_row);
+				phalcon_read_property_this(&active_row, this_ptr, SL("_activeRow"), PH_NOISY_CC);
+				if (Z_TYPE_P(active_row) == IS_OBJECT) {
+	
+					if (!phalcon_is_iterable(row, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+						return;
+					}
+	
+					while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+						PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
+						PHALCON_GET_FOREACH_VALUE(value);
+	
+						if (Z_TYPE_P(column_map) == IS_ARRAY) { 
+							if (!phalcon_array_isset(column_map, key)) {
+								PHALCON_INIT_NVAR(exception_message);
+								PHALCON_CONCAT_SVS(exception_message, "Column \"", key, "\" doesn't make part of the column map");
+								PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, exception_message);
+								return;
+							}
+	
+							PHALCON_OBS_NVAR(attribute);
+							phalcon_array_fetch(&attribute, column_map, key, PH_NOISY_CC);
+							phalcon_update_property_zval_zval(active_row, attribute, value TSRMLS_CC);
+						} else {
+							phalcon_update_property_zval_zval(active_row, key, value TSRMLS_CC);
+						}
+	
+						zend_hash_move_forward_ex(ah0, &hp0);
+					}
+	
+					if (zend_is_true(keep_snapshots)) {
+						PHALCON_CALL_METHOD_PARAMS_2_NORETURN(active_row, "setsnapshotdata", row, column_map);
+					}
+					RETURN_MM_TRUE;
+				}
+			}
+	
 			/** 
 			 * this_ptr->model is the base entity
 			 */
@@ -231,7 +318,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 			/** 
 			 * Performs the standard hydration based on objects
 			 */
-			PHALCON_INIT_VAR(active_row);
+			PHALCON_INIT_NVAR(active_row);
 			PHALCON_CALL_STATIC_PARAMS_5(active_row, "phalcon\\mvc\\model", "cloneresultmap", model, row, column_map, dirty_state, keep_snapshots);
 			break;
 	
@@ -261,9 +348,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, toArray){
 	zval *rename_columns = NULL, *type, *result = NULL, *active_row = NULL;
 	zval *records = NULL, *row_count, *column_map, *renamed_records;
 	zval *record = NULL, *renamed = NULL, *value = NULL, *key = NULL, *exception_message = NULL;
-	zval *renamed_key = NULL;
-	HashTable *ah0, *ah1;
-	HashPosition hp0, hp1;
+	zval *renamed_key = NULL, *exported;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
 	zval **hd;
 
 	PHALCON_MM_GROW();
@@ -277,6 +364,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, toArray){
 	
 	PHALCON_OBS_VAR(type);
 	phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+	if (PHALCON_IS_LONG(type, 2)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets cannot be exported to an array, traverse them instead");
+		return;
+	}
+	
 	if (zend_is_true(type)) {
 	
 		PHALCON_OBS_VAR(result);
@@ -338,6 +430,36 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, toArray){
 		}
 	}
 	
+	/** 
+	 * Records hydrated in advance are exported by themselves
+	 */
+	if (Z_TYPE_P(records) == IS_ARRAY) { 
+	
+		PHALCON_INIT_VAR(exported);
+		array_init(exported);
+	
+		phalcon_is_iterable(records, &ah2, &hp2, 0, 0 TSRMLS_CC);
+	
+		while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(record);
+	
+			if (Z_TYPE_P(record) != IS_OBJECT) {
+				break;
+			}
+	
+			PHALCON_INIT_NVAR(renamed);
+			PHALCON_CALL_METHOD(renamed, record, "toarray");
+			phalcon_array_append(&exported, renamed, PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+	
+		if (phalcon_fast_count_ev(exported TSRMLS_CC)) {
+			RETURN_CTOR(exported);
+		}
+	}
+	
 	/** 
 	 * We need to rename the whole set here, this could be slow
 	 */
@@ -415,6 +537,45 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, toArray){
 	RETURN_CCTOR(records);
 }
 
+/**
+ * Loads in advance the records related to the records in the resultset, every relation
+ * is loaded with a single query. Nested relations are separated by dots
+ *
+ *<code>
+ * $robots = Robots::find()->load(array('robotsParts.parts'));
+ *</code>
+ *
+ * @param string|array $relations
+ * @return Phalcon\Mvc\Model\Resultset\Simple
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, load){
+
+	zval *relations, *type, *model, *manager, *model_name;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &relations);
+	
+	PHALCON_OBS_VAR(type);
+	phalcon_read_property_this(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+	if (PHALCON_IS_LONG(type, 2)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Relations of streaming resultsets cannot be loaded in advance");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(model);
+	phalcon_read_property_this(&model, this_ptr, SL("_model"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD(manager, model, "getmodelsmanager");
+	
+	PHALCON_INIT_VAR(model_name);
+	phalcon_get_class(model_name, model, 0 TSRMLS_CC);
+	PHALCON_CALL_METHOD_PARAMS_3_NORETURN(manager, "preloadrelations", model_name, this_ptr, relations);
+	
+	RETURN_THIS();
+}
+
 /**
  * Serializing a resultset will dump all related rows into a big array
  *
@@ -41,6 +41,140 @@
 #include "kernel/concat.h"
 #include "kernel/file.h"
 
+/**
+ * Maximum length of the source of a combined regular expression, larger groups of
+ * routes are split in several expressions to stay under the PCRE compiled size limits
+ */
+#define PHALCON_MVC_ROUTER_MAX_COMBINED 8192
+
+/**
+ * Checks if a compiled pattern can be merged into a combined alternation. Only patterns
+ * in the form #^...$# without modifiers, top-level alternations, back-references or
+ * special groups can be merged. The literal first segment of the pattern (if any) is
+ * returned in segment/segment_length
+ */
+static int phalcon_mvc_router_is_mergeable(const char *pattern, unsigned int length, const char **segment, unsigned int *segment_length){
+
+	unsigned int i, depth = 0;
+	const char *body;
+	char c;
+
+	*segment = NULL;
+	*segment_length = 0;
+
+	if (length < 5) {
+		return 0;
+	}
+
+	if (pattern[0] != '#' || pattern[1] != '^' || pattern[length - 1] != '#' || pattern[length - 2] != '$' || pattern[length - 3] == '\\') {
+		return 0;
+	}
+
+	body = pattern + 2;
+	length -= 4;
+
+	for (i = 0; i < length; i++) {
+
+		c = body[i];
+
+		if (c == '\\') {
+			if (i + 1 >= length) {
+				return 0;
+			}
+			c = body[++i];
+			if ((c >= '0' && c <= '9') || c == 'g' || c == 'k' || c == 'Q' || c == 'E') {
+				return 0;
+			}
+			continue;
+		}
+
+		switch (c) {
+
+			case '[':
+				/**
+				 * Skip the character class, a ']' at its start is a literal
+				 */
+				i++;
+				if (i < length && body[i] == '^') {
+					i++;
+				}
+				if (i < length && body[i] == ']') {
+					i++;
+				}
+				while (i < length && body[i] != ']') {
+					if (body[i] == '\\') {
+						i++;
+					}
+					i++;
+				}
+				if (i >= length) {
+					return 0;
+				}
+				break;
+
+			case '(':
+				if (i + 1 < length && (body[i + 1] == '?' || body[i + 1] == '*')) {
+					if (body[i + 1] == '*' || i + 2 >= length) {
+						return 0;
+					}
+					c = body[i + 2];
+					if (c != ':' && c != '=' && c != '!') {
+						return 0;
+					}
+				}
+				depth++;
+				break;
+
+			case ')':
+				if (!depth) {
+					return 0;
+				}
+				depth--;
+				break;
+
+			case '|':
+				if (!depth) {
+					return 0;
+				}
+				break;
+
+			case '#':
+				return 0;
+		}
+	}
+
+	if (depth) {
+		return 0;
+	}
+
+	/**
+	 * Look for a literal first segment: /products/... or /products$
+	 */
+	if (length && body[0] == '/') {
+		for (i = 1; i < length; i++) {
+			c = body[i];
+			if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')) {
+				break;
+			}
+		}
+		if (i > 1) {
+			if (i == length) {
+				*segment = body + 1;
+				*segment_length = i - 1;
+			} else {
+				if (body[i] == '/') {
+					if (i + 1 == length || (body[i + 1] != '?' && body[i + 1] != '*' && body[i + 1] != '+' && body[i + 1] != '{')) {
+						*segment = body + 1;
+						*segment_length = i - 1;
+					}
+				}
+			}
+		}
+	}
+
+	return 1;
+}
+
 /**
  * Phalcon\Mvc\Router
  *
@@ -66,6 +200,15 @@
  *	echo $router->getControllerName();
  *</code>
  *
+ * <p>Applications with many routes can enable the compiled matching mode. Static routes are
+ * resolved with a hash lookup and regular expression routes sharing the same HTTP method and
+ * hostname constraints are merged into combined expressions indexed by their first literal
+ * segment, so a request runs one or two regular expressions instead of one per route</p>
+ *
+ *<code>
+ *	$router->setCompiledMatching(true);
+ *</code>
+ *
  */
 
 
@@ -94,6 +237,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Router){
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_defaultParams"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_mvc_router_ce, SL("_removeExtraSlashes"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_notFoundPaths"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_router_ce, SL("_compiledMatching"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_compiledRoutes"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_declare_class_constant_long(phalcon_mvc_router_ce, SL("URI_SOURCE_GET_URL"), 0 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_router_ce, SL("URI_SOURCE_SERVER_REQUEST_URI"), 1 TSRMLS_CC);
@@ -455,9 +600,15 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 	zval *module, *default_module = NULL, *controller, *default_controller = NULL;
 	zval *action, *default_action = NULL, *params_str, *str_params;
 	zval *slash, *params_merge = NULL, *default_params;
+	zval *compiled_matching, *candidate;
 	HashTable *ah0, *ah1;
 	HashPosition hp0, hp1;
 	zval **hd;
+	char *str_key;
+	uint str_key_len;
+	ulong num_key;
+	int compiled = 0;
+	long max_position = 0;
 
 	PHALCON_MM_GROW();
 
@@ -505,6 +656,25 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 	PHALCON_INIT_VAR(matches);
 	phalcon_update_property_bool(this_ptr, SL("_wasMatched"), 0 TSRMLS_CC);
 	
+	/** 
+	 * In compiled mode the index returns the position of the first route that could match,
+	 * the routes registered after it are skipped without being evaluated
+	 */
+	PHALCON_OBS_VAR(compiled_matching);
+	phalcon_read_property_this(&compiled_matching, this_ptr, SL("_compiledMatching"), PH_NOISY_CC);
+	if (zend_is_true(compiled_matching)) {
+	
+		PHALCON_INIT_VAR(candidate);
+		PHALCON_CALL_METHOD_PARAMS_1(candidate, this_ptr, "_findcompiledroute", handled_uri);
+	
+		compiled = 1;
+		if (Z_TYPE_P(candidate) == IS_LONG) {
+			max_position = Z_LVAL_P(candidate);
+		} else {
+			max_position = -1;
+		}
+	}
+	
 	/** 
 	 * Routes are traversed in reversed order
 	 */
@@ -517,6 +687,23 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 	
 	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
 	
+		if (compiled) {
+	
+			/** 
+			 * None of the routes can match the URI
+			 */
+			if (max_position < 0) {
+				break;
+			}
+	
+			if (zend_hash_get_current_key_ex(ah0, &str_key, &str_key_len, &num_key, 0, &hp0) == HASH_KEY_IS_LONG) {
+				if ((long) num_key > max_position) {
+					zend_hash_move_backwards_ex(ah0, &hp0);
+					continue;
+				}
+			}
+		}
+	
 		PHALCON_GET_FOREACH_VALUE(route);
 	
 		/** 
@@ -970,6 +1157,7 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 	PHALCON_CALL_METHOD_PARAMS_3_NORETURN(route, "__construct", pattern, paths, http_methods);
 	
 	phalcon_update_property_array_append(this_ptr, SL("_routes"), route TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_compiledRoutes") TSRMLS_CC);
 	RETURN_CTOR(route);
 }
 
@@ -1246,6 +1434,7 @@ PHP_METHOD(Phalcon_Mvc_Router, mount){
 		phalcon_update_property_this(this_ptr, SL("_routes"), group_routes TSRMLS_CC);
 	}
 	
+	phalcon_update_property_null(this_ptr, SL("_compiledRoutes") TSRMLS_CC);
 	
 	RETURN_THIS();
 }
@@ -1287,6 +1476,7 @@ PHP_METHOD(Phalcon_Mvc_Router, clear){
 	PHALCON_INIT_VAR(empty_routes);
 	array_init(empty_routes);
 	phalcon_update_property_this(this_ptr, SL("_routes"), empty_routes TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_compiledRoutes") TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -1470,3 +1660,540 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteByName){
 	RETURN_MM_FALSE;
 }
 
+
+/**
+ * Enables/disables the compiled matching mode. Routes added, mounted or changed after
+ * enabling it are indexed again the next time a URI is handled
+ *
+ *<code>
+ * $router->setCompiledMatching(true);
+ *</code>
+ *
+ * @param boolean $compiled
+ * @return Phalcon\Mvc\Router
+ */
+PHP_METHOD(Phalcon_Mvc_Router, setCompiledMatching){
+
+	zval *compiled;
+
+	phalcon_fetch_params(0, 1, 0, &compiled);
+	
+	phalcon_update_property_this(this_ptr, SL("_compiledMatching"), compiled TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_compiledRoutes") TSRMLS_CC);
+	RETURN_THISW();
+}
+
+/**
+ * Checks if the compiled matching mode is enabled
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Router, isCompiledMatching){
+
+
+	RETURN_MEMBER(this_ptr, "_compiledMatching");
+}
+
+/**
+ * Builds the index used by the compiled matching mode. Routes are grouped by their
+ * HTTP method and hostname constraints, static patterns are stored in a hash and
+ * regular expressions are merged into combined alternations by their first segment
+ */
+PHP_METHOD(Phalcon_Mvc_Router, _compileRoutes){
+
+	zval *groups, *statics, *pending, *buckets, *routes;
+	zval *route = NULL, *position = NULL, *methods = NULL, *hostname = NULL;
+	zval *methods_key = NULL, *group_key = NULL, *group = NULL, *pattern = NULL;
+	zval *static_key = NULL, *bucket_key = NULL, *body = NULL, *source = NULL;
+	zval *alternative = NULL, *alternatives = NULL, *chunks = NULL, *chunk = NULL;
+	zval *chunk_source = NULL, *chunk_max = NULL, *mergeable = NULL;
+	zval *compiled;
+	HashTable *ah0, *ah1, *ah2;
+	HashPosition hp0, hp1, hp2;
+	zval **hd;
+	const char *segment;
+	unsigned int segment_length;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(groups);
+	array_init(groups);
+	
+	PHALCON_INIT_VAR(statics);
+	array_init(statics);
+	
+	PHALCON_INIT_VAR(pending);
+	array_init(pending);
+	
+	PHALCON_INIT_VAR(buckets);
+	array_init(buckets);
+	
+	PHALCON_OBS_VAR(routes);
+	phalcon_read_property_this(&routes, this_ptr, SL("_routes"), PH_NOISY_CC);
+	
+	/** 
+	 * Routes are indexed in the same order they're traversed by handle()
+	 */
+	if (!phalcon_is_iterable(routes, &ah0, &hp0, 0, 1 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(position, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(route);
+	
+		PHALCON_INIT_NVAR(methods);
+		PHALCON_CALL_METHOD(methods, route, "gethttpmethods");
+	
+		PHALCON_INIT_NVAR(hostname);
+		PHALCON_CALL_METHOD(hostname, route, "gethostname");
+	
+		/** 
+		 * Routes sharing the same constraints are grouped together
+		 */
+		if (Z_TYPE_P(methods) == IS_ARRAY) { 
+			PHALCON_INIT_NVAR(methods_key);
+			phalcon_fast_join_str(methods_key, SL(","), methods TSRMLS_CC);
+		} else {
+			PHALCON_CPY_WRT(methods_key, methods);
+		}
+	
+		PHALCON_INIT_NVAR(group_key);
+		PHALCON_CONCAT_VSV(group_key, methods_key, "|", hostname);
+		if (!phalcon_array_isset(groups, group_key)) {
+			PHALCON_INIT_NVAR(group);
+			array_init_size(group, 2);
+			phalcon_array_append(&group, methods, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&group, hostname, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_update_zval(&groups, group_key, &group, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		PHALCON_INIT_NVAR(pattern);
+		PHALCON_CALL_METHOD(pattern, route, "getcompiledpattern");
+	
+		/** 
+		 * Static patterns are resolved with a single hash lookup, only the first route
+		 * traversed for a pattern is stored
+		 */
+		if (!phalcon_memnstr_str(pattern, SL("^") TSRMLS_CC)) {
+			PHALCON_INIT_NVAR(static_key);
+			PHALCON_CONCAT_VSV(static_key, group_key, " ", pattern);
+			if (!phalcon_array_isset(statics, static_key)) {
+				phalcon_array_update_zval(&statics, static_key, &position, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			}
+	
+			zend_hash_move_backwards_ex(ah0, &hp0);
+			continue;
+		}
+	
+		PHALCON_INIT_NVAR(mergeable);
+		ZVAL_BOOL(mergeable, phalcon_mvc_router_is_mergeable(Z_STRVAL_P(pattern), Z_STRLEN_P(pattern), &segment, &segment_length));
+	
+		PHALCON_INIT_NVAR(bucket_key);
+		PHALCON_CONCAT_VS(bucket_key, group_key, " ");
+		if (segment_length) {
+			phalcon_concat_self_str(&bucket_key, (char *) segment, segment_length TSRMLS_CC);
+		}
+	
+		if (zend_is_true(mergeable)) {
+	
+			/** 
+			 * Every alternative ends with an empty named group that identifies the route
+			 */
+			PHALCON_INIT_NVAR(body);
+			ZVAL_STRINGL(body, Z_STRVAL_P(pattern) + 2, Z_STRLEN_P(pattern) - 4, 1);
+	
+			PHALCON_INIT_NVAR(source);
+			PHALCON_CONCAT_SVSVS(source, "(?:^", body, "$)(?<r", position, ">)");
+		} else {
+			PHALCON_CPY_WRT(source, pattern);
+		}
+	
+		PHALCON_INIT_NVAR(alternative);
+		array_init_size(alternative, 3);
+		phalcon_array_append(&alternative, source, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&alternative, position, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_append(&alternative, mergeable, PH_SEPARATE TSRMLS_CC);
+		phalcon_array_update_append_multi_2(&pending, bucket_key, alternative, 0 TSRMLS_CC);
+	
+		zend_hash_move_backwards_ex(ah0, &hp0);
+	}
+	
+	/** 
+	 * Merge the alternatives of every bucket into combined regular expressions
+	 */
+	if (!phalcon_is_iterable(pending, &ah1, &hp1, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(bucket_key, ah1, hp1);
+		PHALCON_GET_FOREACH_VALUE(alternatives);
+	
+		PHALCON_INIT_NVAR(chunks);
+		array_init(chunks);
+	
+		PHALCON_INIT_NVAR(chunk_source);
+	
+		PHALCON_INIT_NVAR(chunk_max);
+	
+		if (!phalcon_is_iterable(alternatives, &ah2, &hp2, 0, 0 TSRMLS_CC)) {
+			return;
+		}
+	
+		while (zend_hash_get_current_data_ex(ah2, (void**) &hd, &hp2) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(alternative);
+	
+			PHALCON_OBS_NVAR(source);
+			phalcon_array_fetch_long(&source, alternative, 0, PH_NOISY_CC);
+	
+			PHALCON_OBS_NVAR(position);
+			phalcon_array_fetch_long(&position, alternative, 1, PH_NOISY_CC);
+	
+			PHALCON_OBS_NVAR(mergeable);
+			phalcon_array_fetch_long(&mergeable, alternative, 2, PH_NOISY_CC);
+	
+			/** 
+			 * Patterns that cannot be merged are evaluated alone
+			 */
+			if (!zend_is_true(mergeable)) {
+				PHALCON_INIT_NVAR(chunk);
+				array_init_size(chunk, 3);
+				phalcon_array_append(&chunk, source, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&chunk, position, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&chunk, position, PH_SEPARATE TSRMLS_CC);
+				phalcon_array_append(&chunks, chunk, PH_SEPARATE TSRMLS_CC);
+				zend_hash_move_forward_ex(ah2, &hp2);
+				continue;
+			}
+	
+			/** 
+			 * Close the current expression if it's getting too big
+			 */
+			if (Z_TYPE_P(chunk_source) == IS_STRING) {
+				if ((Z_STRLEN_P(chunk_source) + Z_STRLEN_P(source)) > PHALCON_MVC_ROUTER_MAX_COMBINED) {
+					phalcon_concat_self_str(&chunk_source, SL("#") TSRMLS_CC);
+	
+					PHALCON_INIT_NVAR(chunk);
+					array_init_size(chunk, 3);
+					phalcon_array_append(&chunk, chunk_source, PH_SEPARATE TSRMLS_CC);
+					phalcon_array_append(&chunk, chunk_max, PH_SEPARATE TSRMLS_CC);
+					add_next_index_null(chunk);
+					phalcon_array_append(&chunks, chunk, PH_SEPARATE TSRMLS_CC);
+	
+					PHALCON_INIT_NVAR(chunk_source);
+				}
+			}
+	
+			/** 
+			 * Alternatives are added in traversal order, so the first one in each
+			 * expression has the highest position
+			 */
+			if (Z_TYPE_P(chunk_source) == IS_NULL) {
+				PHALCON_INIT_NVAR(chunk_source);
+				PHALCON_CONCAT_SV(chunk_source, "#", source);
+				PHALCON_CPY_WRT(chunk_max, position);
+			} else {
+				PHALCON_SCONCAT_SV(chunk_source, "|", source);
+			}
+	
+			zend_hash_move_forward_ex(ah2, &hp2);
+		}
+	
+		if (Z_TYPE_P(chunk_source) == IS_STRING) {
+			phalcon_concat_self_str(&chunk_source, SL("#") TSRMLS_CC);
+	
+			PHALCON_INIT_NVAR(chunk);
+			array_init_size(chunk, 3);
+			phalcon_array_append(&chunk, chunk_source, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&chunk, chunk_max, PH_SEPARATE TSRMLS_CC);
+			add_next_index_null(chunk);
+			phalcon_array_append(&chunks, chunk, PH_SEPARATE TSRMLS_CC);
+		}
+	
+		phalcon_array_update_zval(&buckets, bucket_key, &chunks, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah1, &hp1);
+	}
+	
+	PHALCON_INIT_VAR(compiled);
+	array_init_size(compiled, 4);
+	phalcon_array_append(&compiled, groups, PH_SEPARATE TSRMLS_CC);
+	phalcon_array_append(&compiled, statics, PH_SEPARATE TSRMLS_CC);
+	phalcon_array_append(&compiled, buckets, PH_SEPARATE TSRMLS_CC);
+	add_next_index_long(compiled, PHALCON_GLOBAL(router_generation));
+	phalcon_update_property_this(this_ptr, SL("_compiledRoutes"), compiled TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the position of the first route, in traversal order, whose constraints and pattern
+ * match the URI according to the compiled index, or false if no route can match it
+ *
+ * @param string $uri
+ * @return int|boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Router, _findCompiledRoute){
+
+	zval *uri, *compiled = NULL, *groups, *statics, *buckets, *segment;
+	zval *group = NULL, *group_key = NULL, *methods = NULL, *hostname = NULL;
+	zval *request = NULL, *current_host_name = NULL, *dependency_injector = NULL;
+	zval *service = NULL, *match_method = NULL, *regex_host_name = NULL;
+	zval *matched = NULL, *static_key = NULL, *position = NULL, *bucket_key = NULL;
+	zval *chunks = NULL, *chunk = NULL, *chunk_max = NULL, *regex = NULL;
+	zval *matches = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1, hp2;
+	zval **hd, **generation;
+	char *str_key, *slash;
+	uint str_key_len;
+	ulong num_key;
+	long best = -1;
+	int i, key_type;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &uri);
+	
+	/** 
+	 * The index is built again if any route changed its pattern or constraints after it
+	 * was built
+	 */
+	PHALCON_OBS_VAR(compiled);
+	phalcon_read_property_this(&compiled, this_ptr, SL("_compiledRoutes"), PH_NOISY_CC);
+	if (Z_TYPE_P(compiled) != IS_ARRAY || zend_hash_index_find(Z_ARRVAL_P(compiled), 3, (void **) &generation) == FAILURE || Z_TYPE_PP(generation) != IS_LONG || (unsigned long) Z_LVAL_PP(generation) != PHALCON_GLOBAL(router_generation)) { 
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_compileroutes");
+	
+		PHALCON_OBS_NVAR(compiled);
+		phalcon_read_property_this(&compiled, this_ptr, SL("_compiledRoutes"), PH_NOISY_CC);
+	}
+	
+	PHALCON_OBS_VAR(groups);
+	phalcon_array_fetch_long(&groups, compiled, 0, PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(statics);
+	phalcon_array_fetch_long(&statics, compiled, 1, PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(buckets);
+	phalcon_array_fetch_long(&buckets, compiled, 2, PH_NOISY_CC);
+	
+	/** 
+	 * Extract the first segment of the URI
+	 */
+	PHALCON_INIT_VAR(segment);
+	if (Z_TYPE_P(uri) == IS_STRING && Z_STRLEN_P(uri) > 1 && Z_STRVAL_P(uri)[0] == '/') {
+		slash = memchr(Z_STRVAL_P(uri) + 1, '/', Z_STRLEN_P(uri) - 1);
+		if (slash) {
+			ZVAL_STRINGL(segment, Z_STRVAL_P(uri) + 1, slash - Z_STRVAL_P(uri) - 1, 1);
+		} else {
+			ZVAL_STRINGL(segment, Z_STRVAL_P(uri) + 1, Z_STRLEN_P(uri) - 1, 1);
+		}
+	} else {
+		ZVAL_EMPTY_STRING(segment);
+	}
+	
+	PHALCON_INIT_VAR(request);
+	
+	PHALCON_INIT_VAR(current_host_name);
+	
+	if (!phalcon_is_iterable(groups, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(group_key, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(group);
+	
+		PHALCON_OBS_NVAR(methods);
+		phalcon_array_fetch_long(&methods, group, 0, PH_NOISY_CC);
+	
+		PHALCON_OBS_NVAR(hostname);
+		phalcon_array_fetch_long(&hostname, group, 1, PH_NOISY_CC);
+	
+		/** 
+		 * The constraints are checked once for the whole group
+		 */
+		if (Z_TYPE_P(methods) != IS_NULL || Z_TYPE_P(hostname) != IS_NULL) {
+			if (Z_TYPE_P(request) == IS_NULL) {
+	
+				PHALCON_OBS_NVAR(dependency_injector);
+				phalcon_read_property_this(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+				if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+					PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_router_exception_ce, "A dependency injection container is required to access the 'request' service");
+					return;
+				}
+	
+				PHALCON_INIT_NVAR(service);
+				ZVAL_STRING(service, "request", 1);
+	
+				PHALCON_INIT_NVAR(request);
+				PHALCON_CALL_METHOD_PARAMS_1(request, dependency_injector, "getshared", service);
+			}
+		}
+	
+		if (Z_TYPE_P(methods) != IS_NULL) {
+			PHALCON_INIT_NVAR(match_method);
+			PHALCON_CALL_METHOD_PARAMS_1(match_method, request, "ismethod", methods);
+			if (PHALCON_IS_FALSE(match_method)) {
+				zend_hash_move_forward_ex(ah0, &hp0);
+				continue;
+			}
+		}
+	
+		if (Z_TYPE_P(hostname) != IS_NULL) {
+	
+			if (Z_TYPE_P(current_host_name) == IS_NULL) {
+				PHALCON_INIT_NVAR(current_host_name);
+				PHALCON_CALL_METHOD(current_host_name, request, "gethttphost");
+			}
+	
+			if (Z_TYPE_P(current_host_name) == IS_NULL) {
+				zend_hash_move_forward_ex(ah0, &hp0);
+				continue;
+			}
+	
+			if (phalcon_memnstr_str(hostname, SL("(") TSRMLS_CC)) {
+				if (!phalcon_memnstr_str(hostname, SL("#") TSRMLS_CC)) {
+					PHALCON_INIT_NVAR(regex_host_name);
+					PHALCON_CONCAT_SVS(regex_host_name, "#^", hostname, "$#");
+				} else {
+					PHALCON_CPY_WRT(regex_host_name, hostname);
+				}
+	
+				PHALCON_INIT_NVAR(matched);
+	
+				#if HAVE_BUNDLED_PCRE
+				phalcon_preg_match(matched, regex_host_name, current_host_name, NULL TSRMLS_CC);
+				#else
+				PHALCON_CALL_FUNC_PARAMS_2(matched, "preg_match", regex_host_name, current_host_name);
+				#endif
+	
+			} else {
+				PHALCON_INIT_NVAR(matched);
+				is_equal_function(matched, current_host_name, hostname TSRMLS_CC);
+			}
+	
+			if (!zend_is_true(matched)) {
+				zend_hash_move_forward_ex(ah0, &hp0);
+				continue;
+			}
+		}
+	
+		/** 
+		 * Static routes
+		 */
+		PHALCON_INIT_NVAR(static_key);
+		PHALCON_CONCAT_VSV(static_key, group_key, " ", uri);
+		if (phalcon_array_isset(statics, static_key)) {
+			PHALCON_OBS_NVAR(position);
+			phalcon_array_fetch(&position, statics, static_key, PH_NOISY_CC);
+			if (phalcon_get_intval(position) > best) {
+				best = phalcon_get_intval(position);
+			}
+		}
+	
+		/** 
+		 * Regular expression routes in the bucket of the URI segment and in the bucket
+		 * of the routes without a literal first segment
+		 */
+		for (i = 0; i < 2; i++) {
+	
+			PHALCON_INIT_NVAR(bucket_key);
+			if (i == 0) {
+				PHALCON_CONCAT_VSV(bucket_key, group_key, " ", segment);
+			} else {
+				if (!Z_STRLEN_P(segment)) {
+					break;
+				}
+				PHALCON_CONCAT_VS(bucket_key, group_key, " ");
+			}
+	
+			if (!phalcon_array_isset(buckets, bucket_key)) {
+				continue;
+			}
+	
+			PHALCON_OBS_NVAR(chunks);
+			phalcon_array_fetch(&chunks, buckets, bucket_key, PH_NOISY_CC);
+	
+			if (!phalcon_is_iterable(chunks, &ah1, &hp1, 0, 0 TSRMLS_CC)) {
+				return;
+			}
+	
+			while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(chunk);
+	
+				/** 
+				 * Skip expressions that cannot improve the current candidate
+				 */
+				PHALCON_OBS_NVAR(chunk_max);
+				phalcon_array_fetch_long(&chunk_max, chunk, 1, PH_NOISY_CC);
+				if (phalcon_get_intval(chunk_max) <= best) {
+					zend_hash_move_forward_ex(ah1, &hp1);
+					continue;
+				}
+	
+				PHALCON_OBS_NVAR(regex);
+				phalcon_array_fetch_long(&regex, chunk, 0, PH_NOISY_CC);
+	
+				PHALCON_INIT_NVAR(matches);
+	
+				PHALCON_INIT_NVAR(matched);
+	
+				Z_SET_ISREF_P(matches);
+	
+				#if HAVE_BUNDLED_PCRE
+				phalcon_preg_match(matched, regex, uri, matches TSRMLS_CC);
+				#else
+				PHALCON_CALL_FUNC_PARAMS_3(matched, "preg_match", regex, uri, matches);
+				#endif
+	
+				Z_UNSET_ISREF_P(matches);
+	
+				if (zend_is_true(matched)) {
+	
+					PHALCON_OBS_NVAR(position);
+					phalcon_array_fetch_long(&position, chunk, 2, PH_NOISY_CC);
+					if (Z_TYPE_P(position) == IS_NULL) {
+	
+						/** 
+						 * The last named group set in the matches identifies the route
+						 */
+						if (Z_TYPE_P(matches) == IS_ARRAY) { 
+							zend_hash_internal_pointer_end_ex(Z_ARRVAL_P(matches), &hp2);
+							while ((key_type = zend_hash_get_current_key_ex(Z_ARRVAL_P(matches), &str_key, &str_key_len, &num_key, 0, &hp2)) != HASH_KEY_NON_EXISTANT) {
+								if (key_type == HASH_KEY_IS_STRING && str_key_len > 2 && str_key[0] == 'r') {
+									if (strtol(str_key + 1, NULL, 10) > best) {
+										best = strtol(str_key + 1, NULL, 10);
+									}
+									break;
+								}
+								zend_hash_move_backwards_ex(Z_ARRVAL_P(matches), &hp2);
+							}
+						}
+					} else {
+						if (phalcon_get_intval(position) > best) {
+							best = phalcon_get_intval(position);
+						}
+					}
+				}
+	
+				zend_hash_move_forward_ex(ah1, &hp1);
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	if (best < 0) {
+		RETURN_MM_FALSE;
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(best);
+}
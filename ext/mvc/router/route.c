@@ -278,6 +278,7 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, via){
 	phalcon_fetch_params(0, 1, 0, &http_methods);
 	
 	phalcon_update_property_this(this_ptr, SL("_methods"), http_methods TSRMLS_CC);
+	PHALCON_GLOBAL(router_generation)++;
 	RETURN_THISW();
 }
 
@@ -470,6 +471,11 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, reConfigure){
 	 */
 	phalcon_update_property_this(this_ptr, SL("_paths"), route_paths TSRMLS_CC);
 	
+	/** 
+	 * Routers using the compiled matching mode index their routes again
+	 */
+	PHALCON_GLOBAL(router_generation)++;
+	
 	PHALCON_MM_RESTORE();
 }
 
@@ -521,6 +527,7 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, beforeMatch){
 	phalcon_fetch_params(0, 1, 0, &callback);
 	
 	phalcon_update_property_this(this_ptr, SL("_beforeMatch"), callback TSRMLS_CC);
+	PHALCON_GLOBAL(router_generation)++;
 	RETURN_THISW();
 }
 
@@ -635,6 +642,7 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, setHttpMethods){
 	phalcon_fetch_params(0, 1, 0, &http_methods);
 	
 	phalcon_update_property_this(this_ptr, SL("_methods"), http_methods TSRMLS_CC);
+	PHALCON_GLOBAL(router_generation)++;
 	RETURN_THISW();
 }
 
@@ -666,6 +674,7 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, setHostname){
 	phalcon_fetch_params(0, 1, 0, &hostname);
 	
 	phalcon_update_property_this(this_ptr, SL("_hostname"), hostname TSRMLS_CC);
+	PHALCON_GLOBAL(router_generation)++;
 	RETURN_THISW();
 }
 
@@ -40,6 +40,7 @@
 #include "kernel/concat.h"
 #include "kernel/file.h"
 #include "kernel/string.h"
+#include "kernel/persistent.h"
 
 /**
  * Phalcon\Mvc\View
@@ -94,6 +95,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View){
 	zend_declare_property_long(phalcon_mvc_view_ce, SL("_cacheLevel"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_ce, SL("_activeRenderPath"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_disabled"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_manifest"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_MAIN_LAYOUT"), 5 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_AFTER_TEMPLATE"), 4 TSRMLS_CC);
@@ -709,9 +711,12 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 	zval *cache_options, *cached_view, *is_fresh;
 	zval *engine = NULL, *extension = NULL, *view_engine_path = NULL;
 	zval *event_name = NULL, *status = NULL, *exception_message;
+	zval *manifest, *render_engines = NULL, *manifest_views;
+	zval *manifest_extension, *manifest_engine;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
+	int check_exists;
 
 	PHALCON_MM_GROW();
 
@@ -815,11 +820,41 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 		}
 	}
 	
+	PHALCON_OBS_VAR(manifest);
+	phalcon_read_property_this(&manifest, this_ptr, SL("_manifest"), PH_NOISY_CC);
+	if (Z_TYPE_P(manifest) == IS_ARRAY) { 
+	
+		/** 
+		 * In production mode the manifest tells which engine renders the view, views
+		 * that aren't in the manifest don't exist and the file system is never checked
+		 */
+		PHALCON_INIT_VAR(render_engines);
+		array_init(render_engines);
+	
+		PHALCON_OBS_VAR(manifest_views);
+		phalcon_array_fetch_string(&manifest_views, manifest, SL("views"), PH_NOISY_CC);
+		if (phalcon_array_isset(manifest_views, view_path)) {
+	
+			PHALCON_OBS_VAR(manifest_extension);
+			phalcon_array_fetch(&manifest_extension, manifest_views, view_path, PH_NOISY_CC);
+			if (phalcon_array_isset(engines, manifest_extension)) {
+				PHALCON_OBS_VAR(manifest_engine);
+				phalcon_array_fetch(&manifest_engine, engines, manifest_extension, PH_NOISY_CC);
+				phalcon_array_update_zval(&render_engines, manifest_extension, &manifest_engine, PH_COPY | PH_SEPARATE TSRMLS_CC);
+			}
+		}
+	
+		check_exists = 0;
+	} else {
+		PHALCON_CPY_WRT(render_engines, engines);
+		check_exists = 1;
+	}
+	
 	/** 
 	 * Views are rendered in each engine
 	 */
 	
-	if (!phalcon_is_iterable(engines, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+	if (!phalcon_is_iterable(render_engines, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
 		return;
 	}
 	
@@ -830,7 +865,7 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 	
 		PHALCON_INIT_NVAR(view_engine_path);
 		PHALCON_CONCAT_VV(view_engine_path, views_dir_path, extension);
-		if (phalcon_file_exists(view_engine_path TSRMLS_CC) == SUCCESS) {
+		if (!check_exists || phalcon_file_exists(view_engine_path TSRMLS_CC) == SUCCESS) {
 	
 			/** 
 			 * Call beforeRenderView if there is a events manager available
@@ -873,7 +908,15 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 		 * Notify about not found views
 		 */
 		if (Z_TYPE_P(events_manager) == IS_OBJECT) {
-			phalcon_update_property_this(this_ptr, SL("_activeRenderPath"), view_engine_path TSRMLS_CC);
+	
+			/** 
+			 * Views missing from the manifest are reported without trying any engine
+			 */
+			if (view_engine_path) {
+				phalcon_update_property_this(this_ptr, SL("_activeRenderPath"), view_engine_path TSRMLS_CC);
+			} else {
+				phalcon_update_property_this(this_ptr, SL("_activeRenderPath"), views_dir_path TSRMLS_CC);
+			}
 	
 			PHALCON_INIT_NVAR(event_name);
 			ZVAL_STRING(event_name, "view:notFoundView", 1);
@@ -920,6 +963,316 @@ PHP_METHOD(Phalcon_Mvc_View, registerEngines){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Appends to the list the path, relative to the views directory, of every file found
+ */
+static void phalcon_mvc_view_scan_entry(const char *path, uint path_length, const char *relative, uint relative_length, php_stream_statbuf *ssb, void *arg TSRMLS_DC){
+
+	if (!S_ISDIR(ssb->sb.st_mode)) {
+		add_next_index_stringl((zval *) arg, (char *) relative, relative_length, 1);
+	}
+}
+
+/**
+ * Compiles every template under the views directory and writes a manifest with the engine
+ * that renders each view and the compiled file of each Volt template. Templates are always
+ * recompiled, so extended and included templates are resolved again when the manifest is built
+ *
+ *<code>
+ * //Run once per deploy, the manifest is loaded later with setManifest()
+ * $view->precompile('app/cache/views.manifest');
+ *</code>
+ *
+ * @param string $manifestPath
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View, precompile){
+
+	zval *manifest_path, *base_path, *views_dir, *directory;
+	zval *exception_message = NULL, *files, *engines, *views;
+	zval *compiled, *engine = NULL, *extension = NULL, *is_volt = NULL;
+	zval *compiler = NULL, *options = NULL, *build_options = NULL;
+	zval *file = NULL, *view_name = NULL, *template_path = NULL;
+	zval *compiled_path = NULL, *manifest, *serialized, *status, *real_path;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+	int extension_length, file_length;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &manifest_path);
+	
+	if (Z_TYPE_P(manifest_path) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "The manifest path must be a string");
+		return;
+	}
+	
+	PHALCON_OBS_VAR(base_path);
+	phalcon_read_property_this(&base_path, this_ptr, SL("_basePath"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(views_dir);
+	phalcon_read_property_this(&views_dir, this_ptr, SL("_viewsDir"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(directory);
+	PHALCON_CONCAT_VV(directory, base_path, views_dir);
+	
+	PHALCON_INIT_VAR(files);
+	array_init(files);
+	if (phalcon_file_scan(Z_STRVAL_P(directory), phalcon_mvc_view_scan_entry, files, REPORT_ERRORS TSRMLS_CC) == FAILURE) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Views directory '", directory, "' cannot be read");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+		return;
+	}
+	
+	PHALCON_INIT_VAR(engines);
+	PHALCON_CALL_METHOD(engines, this_ptr, "_loadtemplateengines");
+	
+	PHALCON_INIT_VAR(views);
+	array_init(views);
+	
+	PHALCON_INIT_VAR(compiled);
+	array_init(compiled);
+	
+	/** 
+	 * Engines are traversed in the same order used by _engineRender, the first engine
+	 * that has a template for a view is the one that renders it
+	 */
+	if (!phalcon_is_iterable(engines, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+		return;
+	}
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(extension, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(engine);
+	
+		if (Z_TYPE_P(extension) != IS_STRING) {
+			zend_hash_move_forward_ex(ah0, &hp0);
+			continue;
+		}
+	
+		PHALCON_INIT_NVAR(is_volt);
+		ZVAL_BOOL(is_volt, 0);
+		if (Z_TYPE_P(engine) == IS_OBJECT) {
+			phalcon_instance_of(is_volt, engine, phalcon_mvc_view_engine_volt_ce TSRMLS_CC);
+		}
+	
+		/** 
+		 * Volt templates are compiled even if they're up to date
+		 */
+		if (PHALCON_IS_TRUE(is_volt)) {
+	
+			PHALCON_INIT_NVAR(compiler);
+			PHALCON_CALL_METHOD(compiler, engine, "getcompiler");
+	
+			PHALCON_INIT_NVAR(options);
+			PHALCON_CALL_METHOD(options, compiler, "getoptions");
+			if (Z_TYPE_P(options) == IS_ARRAY) { 
+				PHALCON_CPY_WRT_CTOR(build_options, options);
+			} else {
+				PHALCON_INIT_NVAR(build_options);
+				array_init(build_options);
+			}
+	
+			phalcon_array_update_string_bool(&build_options, SL("compileAlways"), 1, PH_SEPARATE TSRMLS_CC);
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", build_options);
+		}
+	
+		extension_length = Z_STRLEN_P(extension);
+	
+		if (!phalcon_is_iterable(files, &ah1, &hp1, 0, 0 TSRMLS_CC)) {
+			return;
+		}
+	
+		while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(file);
+	
+			file_length = Z_STRLEN_P(file);
+			if (file_length > extension_length && !memcmp(Z_STRVAL_P(file) + file_length - extension_length, Z_STRVAL_P(extension), extension_length)) {
+	
+				PHALCON_INIT_NVAR(view_name);
+				ZVAL_STRINGL(view_name, Z_STRVAL_P(file), file_length - extension_length, 1);
+				if (!phalcon_array_isset(views, view_name)) {
+					phalcon_array_update_zval(&views, view_name, &extension, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				}
+	
+				if (PHALCON_IS_TRUE(is_volt)) {
+	
+					/** 
+					 * The template path is built the same way _engineRender does
+					 */
+					PHALCON_INIT_NVAR(template_path);
+					PHALCON_CONCAT_VV(template_path, directory, file);
+					PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "compile", template_path);
+	
+					PHALCON_INIT_NVAR(compiled_path);
+					PHALCON_CALL_METHOD(compiled_path, compiler, "getcompiledtemplatepath");
+					phalcon_array_update_zval(&compiled, template_path, &compiled_path, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				}
+			}
+	
+			zend_hash_move_forward_ex(ah1, &hp1);
+		}
+	
+		/** 
+		 * Restore the compiler options
+		 */
+		if (PHALCON_IS_TRUE(is_volt)) {
+			if (Z_TYPE_P(options) == IS_ARRAY) { 
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", options);
+			} else {
+				PHALCON_INIT_NVAR(build_options);
+				array_init(build_options);
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", build_options);
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(manifest);
+	array_init_size(manifest, 2);
+	phalcon_array_update_string(&manifest, SL("views"), &views, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&manifest, SL("compiled"), &compiled, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(serialized);
+	PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", manifest);
+	
+	/** 
+	 * Always use file_put_contents to write files instead of write the file directly,
+	 * this respect the open_basedir directive
+	 */
+	PHALCON_INIT_VAR(status);
+	PHALCON_CALL_FUNC_PARAMS_2(status, "file_put_contents", manifest_path, serialized);
+	if (PHALCON_IS_FALSE(status)) {
+		PHALCON_INIT_NVAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Manifest file '", manifest_path, "' cannot be written");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+		return;
+	}
+	
+	/** 
+	 * Replace any copy of the manifest loaded by this process
+	 */
+	PHALCON_INIT_VAR(real_path);
+	phalcon_realpath(real_path, manifest_path TSRMLS_CC);
+	if (Z_TYPE_P(real_path) == IS_STRING) {
+		phalcon_persistent_cache_store(phalcon_mvc_view_manifest_cache, Z_STRVAL_P(real_path), Z_STRLEN_P(real_path), manifest);
+	}
+	phalcon_update_property_this(this_ptr, SL("_manifest"), manifest TSRMLS_CC);
+	
+	RETURN_CTOR(manifest);
+}
+
+/**
+ * Puts the view in production mode loading a manifest built by precompile(). The manifest is
+ * read once per process, views and compiled templates are resolved from it without checking
+ * the file system, so the manifest must be rebuilt and the processes restarted when views change
+ *
+ *<code>
+ * $view->setManifest('app/cache/views.manifest');
+ *</code>
+ *
+ * @param string $manifestPath
+ */
+PHP_METHOD(Phalcon_Mvc_View, setManifest){
+
+	zval *manifest_path, *manifest, *exception_message = NULL;
+	zval *real_path, *contents;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &manifest_path);
+	
+	if (Z_TYPE_P(manifest_path) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "The manifest path must be a string");
+		return;
+	}
+	
+	/** 
+	 * Manifests are cached under their real path, so relative paths resolved from another
+	 * working directory never share an entry
+	 */
+	PHALCON_INIT_VAR(real_path);
+	phalcon_realpath(real_path, manifest_path TSRMLS_CC);
+	if (Z_TYPE_P(real_path) != IS_STRING) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Manifest file '", manifest_path, "' does not exist");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+		return;
+	}
+	
+	PHALCON_INIT_VAR(manifest);
+	if (phalcon_persistent_cache_fetch(manifest, phalcon_mvc_view_manifest_cache, Z_STRVAL_P(real_path), Z_STRLEN_P(real_path)) == FAILURE) {
+	
+		PHALCON_INIT_VAR(contents);
+		PHALCON_CALL_FUNC_PARAMS_1(contents, "file_get_contents", manifest_path);
+	
+		PHALCON_INIT_NVAR(manifest);
+		if (Z_TYPE_P(contents) == IS_STRING) {
+			PHALCON_CALL_FUNC_PARAMS_1(manifest, "unserialize", contents);
+		}
+	
+		if (Z_TYPE_P(manifest) != IS_ARRAY || !phalcon_array_isset_string(manifest, SS("views")) || !phalcon_array_isset_string(manifest, SS("compiled"))) {
+			PHALCON_INIT_NVAR(exception_message);
+			PHALCON_CONCAT_SVS(exception_message, "Manifest file '", manifest_path, "' is not valid");
+			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+			return;
+		}
+	
+		phalcon_persistent_cache_store(phalcon_mvc_view_manifest_cache, Z_STRVAL_P(real_path), Z_STRLEN_P(real_path), manifest);
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_manifest"), manifest TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the manifest used in production mode
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View, getManifest){
+
+
+	RETURN_MEMBER(this_ptr, "_manifest");
+}
+
+/**
+ * Returns the compiled file of a template according to the manifest, null is returned if
+ * the view isn't in production mode or the template isn't in the manifest
+ *
+ * @param string $templatePath
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_View, getCompiledPath){
+
+	zval *template_path, *manifest, *compiled, *compiled_path;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &template_path);
+	
+	PHALCON_OBS_VAR(manifest);
+	phalcon_read_property_this(&manifest, this_ptr, SL("_manifest"), PH_NOISY_CC);
+	if (Z_TYPE_P(manifest) == IS_ARRAY) { 
+	
+		PHALCON_OBS_VAR(compiled);
+		phalcon_array_fetch_string(&compiled, manifest, SL("compiled"), PH_NOISY_CC);
+		if (phalcon_array_isset(compiled, template_path)) {
+			PHALCON_OBS_VAR(compiled_path);
+			phalcon_array_fetch(&compiled_path, compiled, template_path, PH_NOISY_CC);
+			RETURN_CCTOR(compiled_path);
+		}
+	}
+	
+	RETURN_MM_NULL();
+}
+
 /**
  * Executes render process from dispatching data
  *
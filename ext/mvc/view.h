@@ -51,6 +51,10 @@ PHP_METHOD(Phalcon_Mvc_View, start);
 PHP_METHOD(Phalcon_Mvc_View, _loadTemplateEngines);
 PHP_METHOD(Phalcon_Mvc_View, _engineRender);
 PHP_METHOD(Phalcon_Mvc_View, registerEngines);
+PHP_METHOD(Phalcon_Mvc_View, precompile);
+PHP_METHOD(Phalcon_Mvc_View, setManifest);
+PHP_METHOD(Phalcon_Mvc_View, getManifest);
+PHP_METHOD(Phalcon_Mvc_View, getCompiledPath);
 PHP_METHOD(Phalcon_Mvc_View, render);
 PHP_METHOD(Phalcon_Mvc_View, pick);
 PHP_METHOD(Phalcon_Mvc_View, partial);
@@ -136,6 +140,18 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_registerengines, 0, 0, 1)
 	ZEND_ARG_INFO(0, engines)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_precompile, 0, 0, 1)
+	ZEND_ARG_INFO(0, manifestPath)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_setmanifest, 0, 0, 1)
+	ZEND_ARG_INFO(0, manifestPath)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_getcompiledpath, 0, 0, 1)
+	ZEND_ARG_INFO(0, templatePath)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_render, 0, 0, 2)
 	ZEND_ARG_INFO(0, controllerName)
 	ZEND_ARG_INFO(0, actionName)
@@ -205,6 +221,10 @@ PHALCON_INIT_FUNCS(phalcon_mvc_view_method_entry){
 	PHP_ME(Phalcon_Mvc_View, _loadTemplateEngines, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_View, _engineRender, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_View, registerEngines, arginfo_phalcon_mvc_view_registerengines, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View, precompile, arginfo_phalcon_mvc_view_precompile, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View, setManifest, arginfo_phalcon_mvc_view_setmanifest, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View, getManifest, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View, getCompiledPath, arginfo_phalcon_mvc_view_getcompiledpath, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View, render, arginfo_phalcon_mvc_view_render, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View, pick, arginfo_phalcon_mvc_view_pick, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View, partial, arginfo_phalcon_mvc_view_partial, ZEND_ACC_PUBLIC) 
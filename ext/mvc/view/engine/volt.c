@@ -157,7 +157,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 
 	zval *template_path, *params, *must_clean = NULL, *compiler;
 	zval *compiled_template_path, *value = NULL, *key = NULL, *contents;
-	zval *view;
+	zval *view, *is_view;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -177,15 +177,34 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 		PHALCON_CALL_FUNC_NORETURN("ob_clean");
 	}
 	
+	PHALCON_OBS_VAR(view);
+	phalcon_read_property_this(&view, this_ptr, SL("_view"), PH_NOISY_CC);
+	
 	/** 
-	 * The compilation process is done by Phalcon\Mvc\View\Engine\Volt\Compiler
+	 * Views in production mode know the compiled template from their manifest
 	 */
-	PHALCON_INIT_VAR(compiler);
-	PHALCON_CALL_METHOD(compiler, this_ptr, "getcompiler");
-	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "compile", template_path);
-	
 	PHALCON_INIT_VAR(compiled_template_path);
-	PHALCON_CALL_METHOD(compiled_template_path, compiler, "getcompiledtemplatepath");
+	if (Z_TYPE_P(view) == IS_OBJECT) {
+	
+		PHALCON_INIT_VAR(is_view);
+		phalcon_instance_of(is_view, view, phalcon_mvc_view_ce TSRMLS_CC);
+		if (PHALCON_IS_TRUE(is_view)) {
+			PHALCON_CALL_METHOD_PARAMS_1(compiled_template_path, view, "getcompiledpath", template_path);
+		}
+	}
+	
+	if (Z_TYPE_P(compiled_template_path) != IS_STRING) {
+	
+		/** 
+		 * The compilation process is done by Phalcon\Mvc\View\Engine\Volt\Compiler
+		 */
+		PHALCON_INIT_VAR(compiler);
+		PHALCON_CALL_METHOD(compiler, this_ptr, "getcompiler");
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "compile", template_path);
+	
+		PHALCON_INIT_NVAR(compiled_template_path);
+		PHALCON_CALL_METHOD(compiled_template_path, compiler, "getcompiledtemplatepath");
+	}
 	
 	/** 
 	 * Export the variables the current symbol table
@@ -216,9 +235,6 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 	if (PHALCON_IS_TRUE(must_clean)) {
 		PHALCON_INIT_VAR(contents);
 		PHALCON_CALL_FUNC(contents, "ob_get_contents");
-	
-		PHALCON_OBS_VAR(view);
-		phalcon_read_property_this(&view, this_ptr, SL("_view"), PH_NOISY_CC);
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(view, "setcontent", contents);
 	}
 	
@@ -84,6 +84,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View_Engine_Volt_Compiler){
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_prefix"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_currentPath"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_compiledTemplatePath"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_view_engine_volt_compiler_ce, SL("_forceCompile"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_dependencies"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_view_engine_volt_compiler_ce TSRMLS_CC, 1, phalcon_di_injectionawareinterface_ce);
 
@@ -2173,7 +2175,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileEcho){
 
 	zval *statement, *compilation, *expr, *expr_code;
 	zval *expr_type, *name, *name_type, *name_value;
-	zval *autoescape;
+	zval *autoescape, *inlined;
 
 	PHALCON_MM_GROW();
 
@@ -2213,6 +2215,17 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileEcho){
 			if (PHALCON_IS_STRING(name_value, "super")) {
 				RETURN_CCTOR(expr_code);
 			}
+	
+			/** 
+			 * Static partials can be replaced by their compiled code
+			 */
+			if (PHALCON_IS_STRING(name_value, "partial")) {
+				PHALCON_INIT_VAR(inlined);
+				PHALCON_CALL_METHOD_PARAMS_1(inlined, this_ptr, "_inlinepartial", expr);
+				if (Z_TYPE_P(inlined) == IS_STRING) {
+					RETURN_CCTOR(inlined);
+				}
+			}
 		}
 	}
 	
@@ -2234,7 +2247,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileEcho){
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileInclude){
 
 	zval *statement, *compilation = NULL, *path, *view, *views_dir;
-	zval *final_path = NULL, *extended, *sub_compiler, *compiled_path;
+	zval *final_path = NULL, *extended;
 
 	PHALCON_MM_GROW();
 
@@ -2269,13 +2282,44 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileInclude){
 	PHALCON_INIT_VAR(extended);
 	ZVAL_BOOL(extended, 0);
 	
+	PHALCON_INIT_NVAR(compilation);
+	PHALCON_CALL_METHOD_PARAMS_2(compilation, this_ptr, "_compiledependency", final_path, extended);
+	
+	RETURN_CCTOR(compilation);
+}
+
+/**
+ * Compiles a template extended or included by the current template, the template is always
+ * compiled again and recorded as a dependency of the current template
+ *
+ * @param string $path
+ * @param boolean $extendsMode
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileDependency){
+
+	zval *path, *extends_mode, *sub_compiler, *compilation = NULL;
+	zval *compiled_path, *dependencies, *dependency = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 2, 0, &path, &extends_mode);
+	
 	PHALCON_INIT_VAR(sub_compiler);
 	if (phalcon_clone(sub_compiler, this_ptr TSRMLS_CC) == FAILURE) {
 		return;
 	}
 	
-	PHALCON_INIT_NVAR(compilation);
-	PHALCON_CALL_METHOD_PARAMS_2(compilation, sub_compiler, "compile", final_path, extended);
+	/** 
+	 * The compiled files of the dependencies could be outdated if their own dependencies changed
+	 */
+	phalcon_update_property_bool(sub_compiler, SL("_forceCompile"), 1 TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(compilation);
+	PHALCON_CALL_METHOD_PARAMS_2(compilation, sub_compiler, "compile", path, extends_mode);
 	
 	/** 
 	 * If the compilation doesn't return anything we include the compiled path
@@ -2288,10 +2332,146 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileInclude){
 		PHALCON_CALL_FUNC_PARAMS_1(compilation, "file_get_contents", compiled_path);
 	}
 	
+	/** 
+	 * The dependencies of the dependency are dependencies of the current template too
+	 */
+	phalcon_update_property_array(this_ptr, SL("_dependencies"), path, path TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(dependencies);
+	PHALCON_CALL_METHOD(dependencies, sub_compiler, "getdependencies");
+	if (Z_TYPE_P(dependencies) == IS_ARRAY) { 
+	
+		if (!phalcon_is_iterable(dependencies, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+			return;
+		}
+	
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(dependency);
+	
+			phalcon_update_property_array(this_ptr, SL("_dependencies"), dependency, dependency TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+	}
+	
+	RETURN_CCTOR(compilation);
+}
+
+/**
+ * Returns the compiled code of a partial called with a literal path if the 'inlinePartials'
+ * option is enabled and the partial is a Volt template, null is returned otherwise
+ *
+ * @param array $expr
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _inlinePartial){
+
+	zval *expr, *options, *inline_partials, *extension = NULL, *view;
+	zval *arguments, *argument, *argument_expr, *argument_type;
+	zval *partial_path, *views_dir, *partials_dir, *final_path;
+	zval *extended, *compilation;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &expr);
+	
+	PHALCON_OBS_VAR(options);
+	phalcon_read_property_this(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	if (Z_TYPE_P(options) != IS_ARRAY || !phalcon_array_isset_string(options, SS("inlinePartials"))) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_OBS_VAR(inline_partials);
+	phalcon_array_fetch_string(&inline_partials, options, SL("inlinePartials"), PH_NOISY_CC);
+	if (!zend_is_true(inline_partials)) {
+		RETURN_MM_NULL();
+	}
+	
+	/** 
+	 * The option can be the extension registered for Volt
+	 */
+	if (Z_TYPE_P(inline_partials) == IS_STRING) {
+		PHALCON_CPY_WRT(extension, inline_partials);
+	} else {
+		PHALCON_INIT_VAR(extension);
+		ZVAL_STRING(extension, ".volt", 1);
+	}
+	
+	PHALCON_OBS_VAR(view);
+	phalcon_read_property_this(&view, this_ptr, SL("_view"), PH_NOISY_CC);
+	if (Z_TYPE_P(view) != IS_OBJECT) {
+		RETURN_MM_NULL();
+	}
+	
+	/** 
+	 * Only partials with a single string literal argument are known at compile time
+	 */
+	if (!phalcon_array_isset_string(expr, SS("arguments"))) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_OBS_VAR(arguments);
+	phalcon_array_fetch_string(&arguments, expr, SL("arguments"), PH_NOISY_CC);
+	if (Z_TYPE_P(arguments) != IS_ARRAY || phalcon_array_isset_string(arguments, SS("type")) || zend_hash_num_elements(Z_ARRVAL_P(arguments)) != 1) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_OBS_VAR(argument);
+	phalcon_array_fetch_long(&argument, arguments, 0, PH_NOISY_CC);
+	if (phalcon_array_isset_string(argument, SS("name"))) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_OBS_VAR(argument_expr);
+	phalcon_array_fetch_string(&argument_expr, argument, SL("expr"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(argument_type);
+	phalcon_array_fetch_string(&argument_type, argument_expr, SL("type"), PH_NOISY_CC);
+	if (!PHALCON_IS_LONG(argument_type, 260)) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_OBS_VAR(partial_path);
+	phalcon_array_fetch_string(&partial_path, argument_expr, SL("value"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(views_dir);
+	PHALCON_CALL_METHOD(views_dir, view, "getviewsdir");
+	
+	PHALCON_INIT_VAR(partials_dir);
+	PHALCON_CALL_METHOD(partials_dir, view, "getpartialsdir");
+	
+	PHALCON_INIT_VAR(final_path);
+	PHALCON_CONCAT_VVVV(final_path, views_dir, partials_dir, partial_path, extension);
+	
+	/** 
+	 * Partials rendered by other engines are still rendered at runtime
+	 */
+	if (phalcon_file_exists(final_path TSRMLS_CC) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+	
+	PHALCON_INIT_VAR(extended);
+	ZVAL_BOOL(extended, 0);
+	
+	PHALCON_INIT_VAR(compilation);
+	PHALCON_CALL_METHOD_PARAMS_2(compilation, this_ptr, "_compiledependency", final_path, extended);
 	
 	RETURN_CCTOR(compilation);
 }
 
+/**
+ * Returns the templates extended or included by the last compiled template
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getDependencies){
+
+
+	RETURN_MEMBER(this_ptr, "_dependencies");
+}
+
 /**
  *
  */
@@ -2385,7 +2565,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 	zval *compilation = NULL, *statement = NULL, *line = NULL, *file = NULL, *exception_message = NULL;
 	zval *type = NULL, *temp_compilation = NULL, *block_name = NULL, *block_statements = NULL;
 	zval *blocks = NULL, *code = NULL, *path = NULL, *view = NULL, *views_dir = NULL, *final_path = NULL;
-	zval *sub_compiler = NULL, *compiled_path = NULL, *level;
+	zval *level;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -2572,24 +2752,8 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 				/** 
 				 * Perform a subcompilation of the extended file
 				 */
-				PHALCON_INIT_NVAR(sub_compiler);
-				if (phalcon_clone(sub_compiler, this_ptr TSRMLS_CC) == FAILURE) {
-					return;
-				}
-	
 				PHALCON_INIT_NVAR(temp_compilation);
-				PHALCON_CALL_METHOD_PARAMS_2(temp_compilation, sub_compiler, "compile", final_path, extended);
-	
-				/** 
-				 * If the compilation doesn't return anything we include the compiled path
-				 */
-				if (Z_TYPE_P(temp_compilation) == IS_NULL) {
-					PHALCON_INIT_NVAR(compiled_path);
-					PHALCON_CALL_METHOD(compiled_path, sub_compiler, "getcompiledtemplatepath");
-	
-					PHALCON_INIT_NVAR(temp_compilation);
-					PHALCON_CALL_FUNC_PARAMS_1(temp_compilation, "file_get_contents", compiled_path);
-				}
+				PHALCON_CALL_METHOD_PARAMS_2(temp_compilation, this_ptr, "_compiledependency", final_path, extended);
 	
 				phalcon_update_property_bool(this_ptr, SL("_extended"), 1 TSRMLS_CC);
 				phalcon_update_property_this(this_ptr, SL("_extendedBlocks"), temp_compilation TSRMLS_CC);
@@ -2892,7 +3056,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFile){
 
 	zval *path, *compiled_path, *extends_mode = NULL, *exception_message = NULL;
 	zval *view_code, *compilation, *final_compilation = NULL;
-	zval *status;
+	zval *status, *dependencies, *dependencies_path, *dependencies_code;
 
 	PHALCON_MM_GROW();
 
@@ -2934,6 +3098,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFile){
 	}
 	
 	phalcon_update_property_this(this_ptr, SL("_currentPath"), path TSRMLS_CC);
+	phalcon_update_property_empty_array(phalcon_mvc_view_engine_volt_compiler_ce, this_ptr, SL("_dependencies") TSRMLS_CC);
 	
 	PHALCON_INIT_VAR(compilation);
 	PHALCON_CALL_METHOD_PARAMS_2(compilation, this_ptr, "_compilesource", view_code, extends_mode);
@@ -2959,6 +3124,31 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFile){
 		return;
 	}
 	
+	/** 
+	 * The templates extended or included are stored next to the compiled file, the
+	 * compiled file is outdated when any of them changes
+	 */
+	PHALCON_OBS_VAR(dependencies);
+	phalcon_read_property_this(&dependencies, this_ptr, SL("_dependencies"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(dependencies_path);
+	PHALCON_CONCAT_VS(dependencies_path, compiled_path, ".deps");
+	if (phalcon_fast_count_ev(dependencies TSRMLS_CC)) {
+	
+		PHALCON_INIT_VAR(dependencies_code);
+		PHALCON_CALL_FUNC_PARAMS_1(dependencies_code, "serialize", dependencies);
+	
+		PHALCON_INIT_NVAR(status);
+		PHALCON_CALL_FUNC_PARAMS_2(status, "file_put_contents", dependencies_path, dependencies_code);
+		if (PHALCON_IS_FALSE(status)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "Volt directory can't be written");
+			return;
+		}
+	} else {
+		if (phalcon_file_exists(dependencies_path TSRMLS_CC) == SUCCESS) {
+			PHALCON_CALL_FUNC_PARAMS_1_NORETURN("unlink", dependencies_path);
+		}
+	}
 	
 	RETURN_CCTOR(compilation);
 }
@@ -2983,7 +3173,13 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile){
 	zval *compiled_extension = NULL, *compilation = NULL, *options;
 	zval *real_template_path, *template_sep_path = NULL;
 	zval *compiled_template_path = NULL, *real_compiled_path = NULL;
-	zval *blocks_code, *exception_message = NULL;
+	zval *blocks_code, *exception_message = NULL, *force_compile;
+	zval *dependencies_path, *dependencies_code, *dependencies = NULL;
+	zval *dependency = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int outdated;
 
 	PHALCON_MM_GROW();
 
@@ -3127,11 +3323,17 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile){
 		PHALCON_CONCAT_VVVV(compiled_template_path, compiled_path, prefix, template_sep_path, compiled_extension);
 	}
 	
+	/** 
+	 * Templates extended or included by other template being compiled are compiled again
+	 */
+	PHALCON_OBS_VAR(force_compile);
+	phalcon_read_property_this(&force_compile, this_ptr, SL("_forceCompile"), PH_NOISY_CC);
+	
 	/** 
 	 * Use the real path to avoid collisions
 	 */
 	PHALCON_CPY_WRT(real_compiled_path, compiled_template_path);
-	if (zend_is_true(compile_always)) {
+	if (zend_is_true(compile_always) || zend_is_true(force_compile)) {
 		/** 
 		 * Compile always must be used only in the development stage
 		 */
@@ -3143,7 +3345,47 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile){
 				/** 
 				 * Compare modification timestamps to check if the file needs to be recompiled
 				 */
-				if (phalcon_compare_mtime(template_path, real_compiled_path TSRMLS_CC)) {
+				outdated = phalcon_compare_mtime(template_path, real_compiled_path TSRMLS_CC);
+				if (!outdated) {
+	
+					/** 
+					 * The file also needs to be recompiled if an extended or included template changed
+					 */
+					PHALCON_INIT_VAR(dependencies_path);
+					PHALCON_CONCAT_VS(dependencies_path, real_compiled_path, ".deps");
+					if (phalcon_file_exists(dependencies_path TSRMLS_CC) == SUCCESS) {
+	
+						PHALCON_INIT_VAR(dependencies_code);
+						PHALCON_CALL_FUNC_PARAMS_1(dependencies_code, "file_get_contents", dependencies_path);
+	
+						PHALCON_INIT_VAR(dependencies);
+						if (Z_TYPE_P(dependencies_code) == IS_STRING) {
+							PHALCON_CALL_FUNC_PARAMS_1(dependencies, "unserialize", dependencies_code);
+						}
+	
+						if (Z_TYPE_P(dependencies) == IS_ARRAY) { 
+	
+							if (!phalcon_is_iterable(dependencies, &ah0, &hp0, 0, 0 TSRMLS_CC)) {
+								return;
+							}
+	
+							while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+								PHALCON_GET_FOREACH_VALUE(dependency);
+	
+								if (phalcon_file_exists(dependency TSRMLS_CC) == FAILURE || phalcon_compare_mtime(dependency, real_compiled_path TSRMLS_CC)) {
+									outdated = 1;
+									break;
+								}
+	
+								zend_hash_move_forward_ex(ah0, &hp0);
+							}
+	
+						}
+					}
+				}
+	
+				if (outdated) {
 					PHALCON_INIT_NVAR(compilation);
 					PHALCON_CALL_METHOD_PARAMS_3(compilation, this_ptr, "compilefile", template_path, real_compiled_path, extends_mode);
 				} else {
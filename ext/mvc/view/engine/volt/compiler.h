@@ -45,6 +45,9 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileElseIf);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileCache);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileEcho);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileInclude);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileDependency);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _inlinePartial);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getDependencies);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileSet);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileDo);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileAutoEscape);
@@ -185,6 +188,9 @@ PHALCON_INIT_FUNCS(phalcon_mvc_view_engine_volt_compiler_method_entry){
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileCache, arginfo_phalcon_mvc_view_engine_volt_compiler_compilecache, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileEcho, arginfo_phalcon_mvc_view_engine_volt_compiler_compileecho, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileInclude, arginfo_phalcon_mvc_view_engine_volt_compiler_compileinclude, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileDependency, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _inlinePartial, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, getDependencies, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileSet, arginfo_phalcon_mvc_view_engine_volt_compiler_compileset, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileDo, arginfo_phalcon_mvc_view_engine_volt_compiler_compiledo, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileAutoEscape, arginfo_phalcon_mvc_view_engine_volt_compiler_compileautoescape, ZEND_ACC_PUBLIC) 
@@ -31,6 +31,8 @@
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
+#include "kernel/persistent.h"
+#include "kernel/shm.h"
 
 
 zend_class_entry *phalcon_text_ce;
@@ -51,6 +53,7 @@ zend_class_entry *phalcon_cache_backend_file_ce;
 zend_class_entry *phalcon_cache_frontendinterface_ce;
 zend_class_entry *phalcon_cache_frontend_base64_ce;
 zend_class_entry *phalcon_cache_backendinterface_ce;
+zend_class_entry *phalcon_cache_batchinterface_ce;
 zend_class_entry *phalcon_cache_frontend_output_ce;
 zend_class_entry *phalcon_cache_backend_memcache_ce;
 zend_class_entry *phalcon_tag_select_ce;
@@ -223,6 +226,9 @@ zend_class_entry *phalcon_http_response_headersinterface_ce;
 zend_class_entry *phalcon_http_response_cookiesinterface_ce;
 zend_class_entry *phalcon_queue_beanstalk_ce;
 zend_class_entry *phalcon_queue_beanstalk_job_ce;
+zend_class_entry *phalcon_async_ce;
+zend_class_entry *phalcon_async_handle_ce;
+zend_class_entry *phalcon_async_exception_ce;
 zend_class_entry *phalcon_mvc_view_ce;
 zend_class_entry *phalcon_mvc_url_ce;
 zend_class_entry *phalcon_mvc_model_ce;
@@ -245,6 +251,7 @@ zend_class_entry *phalcon_mvc_collectioninterface_ce;
 zend_class_entry *phalcon_mvc_controllerinterface_ce;
 zend_class_entry *phalcon_mvc_collection_exception_ce;
 zend_class_entry *phalcon_mvc_collection_manager_ce;
+zend_class_entry *phalcon_mvc_collection_resultset_ce;
 zend_class_entry *phalcon_mvc_collection_managerinterface_ce;
 zend_class_entry *phalcon_mvc_dispatcherinterface_ce;
 zend_class_entry *phalcon_mvc_dispatcher_exception_ce;
@@ -266,6 +273,7 @@ zend_class_entry *phalcon_mvc_micro_collectioninterface_ce;
 zend_class_entry *phalcon_mvc_micro_middlewareinterface_ce;
 zend_class_entry *phalcon_mvc_model_validator_url_ce;
 zend_class_entry *phalcon_mvc_model_metadata_apc_ce;
+zend_class_entry *phalcon_mvc_model_metadata_shm_ce;
 zend_class_entry *phalcon_mvc_model_metadata_files_ce;
 zend_class_entry *phalcon_mvc_model_transaction_ce;
 zend_class_entry *phalcon_mvc_model_query_status_ce;
@@ -326,6 +334,28 @@ zend_class_entry *phalcon_exception_ce;
 
 ZEND_DECLARE_MODULE_GLOBALS(phalcon)
 
+phalcon_persistent_cache *phalcon_orm_ir_cache = NULL;
+phalcon_shm_header *phalcon_orm_metadata_shm = NULL;
+phalcon_persistent_cache *phalcon_mvc_view_manifest_cache = NULL;
+phalcon_persistent_cache *phalcon_acl_compiled_cache = NULL;
+phalcon_persistent_cache *phalcon_dispatcher_cache = NULL;
+phalcon_persistent_cache *phalcon_di_compiled_cache = NULL;
+
+PHP_INI_BEGIN()
+	/** Number of PHQL intermediate representations kept between requests, zero (the default) disables the cache */
+	PHP_INI_ENTRY("phalcon.orm.ir_cache_size", "0", PHP_INI_SYSTEM, NULL)
+	/** Bytes of the segment shared by the processes to store models meta-data, zero disables it */
+	PHP_INI_ENTRY("phalcon.orm.metadata_shm_size", "4194304", PHP_INI_SYSTEM, NULL)
+	/** Number of view manifests kept between requests, zero disables the cache */
+	PHP_INI_ENTRY("phalcon.view.manifest_cache_size", "16", PHP_INI_SYSTEM, NULL)
+	/** Number of compiled ACL lists kept between requests, zero disables the cache */
+	PHP_INI_ENTRY("phalcon.acl.compiled_cache_size", "16", PHP_INI_SYSTEM, NULL)
+	/** Number of handler class names resolved by the dispatchers kept between requests, zero (the default) disables the cache */
+	PHP_INI_ENTRY("phalcon.dispatcher.cache_size", "0", PHP_INI_SYSTEM, NULL)
+	/** Number of compiled service definitions kept between requests, zero disables the cache */
+	PHP_INI_ENTRY("phalcon.di.compiled_cache_size", "16", PHP_INI_SYSTEM, NULL)
+PHP_INI_END()
+
 PHP_MINIT_FUNCTION(phalcon){
 
 	if(!spl_ce_Countable){
@@ -352,12 +382,35 @@ PHP_MINIT_FUNCTION(phalcon){
 	/** Init globals */
 	ZEND_INIT_MODULE_GLOBALS(phalcon, php_phalcon_init_globals, NULL);
 
+	REGISTER_INI_ENTRIES();
+
+	/** Init process-wide caches */
+	if (INI_INT("phalcon.orm.ir_cache_size") > 0) {
+		phalcon_orm_ir_cache = phalcon_persistent_cache_init(INI_INT("phalcon.orm.ir_cache_size"));
+	}
+	if (INI_INT("phalcon.orm.metadata_shm_size") > 0) {
+		phalcon_orm_metadata_shm = phalcon_shm_init(INI_INT("phalcon.orm.metadata_shm_size"));
+	}
+	if (INI_INT("phalcon.view.manifest_cache_size") > 0) {
+		phalcon_mvc_view_manifest_cache = phalcon_persistent_cache_init(INI_INT("phalcon.view.manifest_cache_size"));
+	}
+	if (INI_INT("phalcon.acl.compiled_cache_size") > 0) {
+		phalcon_acl_compiled_cache = phalcon_persistent_cache_init(INI_INT("phalcon.acl.compiled_cache_size"));
+	}
+	if (INI_INT("phalcon.dispatcher.cache_size") > 0) {
+		phalcon_dispatcher_cache = phalcon_persistent_cache_init(INI_INT("phalcon.dispatcher.cache_size"));
+	}
+	if (INI_INT("phalcon.di.compiled_cache_size") > 0) {
+		phalcon_di_compiled_cache = phalcon_persistent_cache_init(INI_INT("phalcon.di.compiled_cache_size"));
+	}
+
 	PHALCON_INIT(Phalcon_DI_InjectionAwareInterface);
 	PHALCON_INIT(Phalcon_Validation_ValidatorInterface);
 	PHALCON_INIT(Phalcon_Mvc_Model_ValidatorInterface);
 	PHALCON_INIT(Phalcon_Events_EventsAwareInterface);
 	PHALCON_INIT(Phalcon_Cache_FrontendInterface);
 	PHALCON_INIT(Phalcon_Cache_BackendInterface);
+	PHALCON_INIT(Phalcon_Cache_BatchInterface);
 	PHALCON_INIT(Phalcon_Db_DialectInterface);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaDataInterface);
 	PHALCON_INIT(Phalcon_Db_AdapterInterface);
@@ -575,6 +628,9 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Http_Response_Exception);
 	PHALCON_INIT(Phalcon_Queue_Beanstalk);
 	PHALCON_INIT(Phalcon_Queue_Beanstalk_Job);
+	PHALCON_INIT(Phalcon_Async);
+	PHALCON_INIT(Phalcon_Async_Handle);
+	PHALCON_INIT(Phalcon_Async_Exception);
 	PHALCON_INIT(Phalcon_Mvc_Url);
 	PHALCON_INIT(Phalcon_Mvc_View);
 	PHALCON_INIT(Phalcon_Mvc_Micro);
@@ -585,6 +641,7 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Mvc_Controller);
 	PHALCON_INIT(Phalcon_Mvc_Collection_Manager);
 	PHALCON_INIT(Phalcon_Mvc_Collection_Exception);
+	PHALCON_INIT(Phalcon_Mvc_Collection_Resultset);
 	PHALCON_INIT(Phalcon_Mvc_Collection_ManagerInterface);
 	PHALCON_INIT(Phalcon_Mvc_ControllerInterface);
 	PHALCON_INIT(Phalcon_Mvc_Dispatcher);
@@ -603,6 +660,7 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Mvc_Model_Query_Lang);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Files);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Apc);
+	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Shm);
 	PHALCON_INIT(Phalcon_Mvc_Model_Query_Status);
 	PHALCON_INIT(Phalcon_Mvc_Model_Query_Builder);
 	PHALCON_INIT(Phalcon_Mvc_Model_Validator_Url);
@@ -659,6 +717,38 @@ PHP_MSHUTDOWN_FUNCTION(phalcon){
 		PHALCON_GLOBAL(function_cache) = NULL;
 	}
 
+	if (phalcon_orm_ir_cache != NULL) {
+		phalcon_persistent_cache_destroy(phalcon_orm_ir_cache);
+		phalcon_orm_ir_cache = NULL;
+	}
+
+	if (phalcon_orm_metadata_shm != NULL) {
+		phalcon_shm_destroy(phalcon_orm_metadata_shm);
+		phalcon_orm_metadata_shm = NULL;
+	}
+
+	if (phalcon_mvc_view_manifest_cache != NULL) {
+		phalcon_persistent_cache_destroy(phalcon_mvc_view_manifest_cache);
+		phalcon_mvc_view_manifest_cache = NULL;
+	}
+
+	if (phalcon_acl_compiled_cache != NULL) {
+		phalcon_persistent_cache_destroy(phalcon_acl_compiled_cache);
+		phalcon_acl_compiled_cache = NULL;
+	}
+
+	if (phalcon_dispatcher_cache != NULL) {
+		phalcon_persistent_cache_destroy(phalcon_dispatcher_cache);
+		phalcon_dispatcher_cache = NULL;
+	}
+
+	if (phalcon_di_compiled_cache != NULL) {
+		phalcon_persistent_cache_destroy(phalcon_di_compiled_cache);
+		phalcon_di_compiled_cache = NULL;
+	}
+
+	UNREGISTER_INI_ENTRIES();
+
 	return SUCCESS;
 }
 
@@ -687,6 +777,12 @@ PHP_RSHUTDOWN_FUNCTION(phalcon){
 		PHALCON_GLOBAL(orm.parser_cache) = NULL;
 	}
 
+	if (PHALCON_GLOBAL(logger_buffers) != NULL) {
+		zend_hash_destroy(PHALCON_GLOBAL(logger_buffers));
+		FREE_HASHTABLE(PHALCON_GLOBAL(logger_buffers));
+		PHALCON_GLOBAL(logger_buffers) = NULL;
+	}
+
 	return SUCCESS;
 }
 
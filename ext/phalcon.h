@@ -23,6 +23,7 @@
 #include "events/eventsawareinterface.h"
 #include "cache/frontendinterface.h"
 #include "cache/backendinterface.h"
+#include "cache/batchinterface.h"
 #include "db/dialectinterface.h"
 #include "mvc/model/metadatainterface.h"
 #include "db/adapterinterface.h"
@@ -240,6 +241,9 @@
 #include "http/response/exception.h"
 #include "queue/beanstalk.h"
 #include "queue/beanstalk/job.h"
+#include "async.h"
+#include "async/handle.h"
+#include "async/exception.h"
 #include "mvc/url.h"
 #include "mvc/view.h"
 #include "mvc/micro.h"
@@ -250,6 +254,7 @@
 #include "mvc/controller.h"
 #include "mvc/collection/manager.h"
 #include "mvc/collection/exception.h"
+#include "mvc/collection/resultset.h"
 #include "mvc/collection/managerinterface.h"
 #include "mvc/controllerinterface.h"
 #include "mvc/dispatcher.h"
@@ -268,6 +273,7 @@
 #include "mvc/model/query/lang.h"
 #include "mvc/model/metadata/files.h"
 #include "mvc/model/metadata/apc.h"
+#include "mvc/model/metadata/shm.h"
 #include "mvc/model/query/status.h"
 #include "mvc/model/query/builder.h"
 #include "mvc/model/validator/url.h"
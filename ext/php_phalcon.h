@@ -82,6 +82,13 @@ ZEND_BEGIN_MODULE_GLOBALS(phalcon)
 	/** DB */
 	phalcon_db_options db;
 
+	/** Logger */
+	zend_bool logger_flush_registered;
+	HashTable *logger_buffers;
+
+	/** Router */
+	unsigned long router_generation;
+
 ZEND_END_MODULE_GLOBALS(phalcon)
 
 #ifdef ZTS
@@ -46,6 +46,16 @@
  * Class to access the beanstalk queue service.
  * Partially implements the protocol version 1.2
  *
+ * Bodies are serialized with the codec passed in the "codec" option: 'php' (serialize, the default),
+ * 'json', 'igbinary', 'raw' (strings are sent untouched) or an array with an encoder and a decoder callback
+ *
+ *<code>
+ * $queue = new Phalcon\Queue\Beanstalk(array('host' => '127.0.0.1', 'codec' => 'json'));
+ *
+ * //Send many jobs in a single round trip
+ * $ids = $queue->putMany(array($job1, $job2, $job3), array('priority' => 250));
+ *</code>
+ *
  * @see http://www.igvita.com/2010/05/20/scalable-work-queues-with-beanstalk/
  */
 
@@ -59,6 +69,8 @@ PHALCON_INIT_CLASS(Phalcon_Queue_Beanstalk){
 
 	zend_declare_property_null(phalcon_queue_beanstalk_ce, SL("_connection"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_queue_beanstalk_ce, SL("_parameters"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_string(phalcon_queue_beanstalk_ce, SL("_codec"), "php", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_queue_beanstalk_ce, SL("_tube"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
@@ -70,7 +82,7 @@ PHALCON_INIT_CLASS(Phalcon_Queue_Beanstalk){
  */
 PHP_METHOD(Phalcon_Queue_Beanstalk, __construct){
 
-	zval *options = NULL, *parameters = NULL;
+	zval *options = NULL, *parameters = NULL, *codec;
 
 	PHALCON_MM_GROW();
 
@@ -96,6 +108,12 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, __construct){
 		phalcon_array_update_string_long(&parameters, SL("port"), 11300, PH_SEPARATE TSRMLS_CC);
 	}
 	
+	if (phalcon_array_isset_string(parameters, SS("codec"))) {
+		PHALCON_OBS_VAR(codec);
+		phalcon_array_fetch_string(&codec, parameters, SL("codec"), PH_NOISY_CC);
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "setcodec", codec);
+	}
+	
 	phalcon_update_property_this(this_ptr, SL("_parameters"), parameters TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
@@ -103,9 +121,11 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, __construct){
 
 PHP_METHOD(Phalcon_Queue_Beanstalk, connect){
 
-	zval *connection = NULL, *parameters, *host, *port, *error_num;
-	zval *error_str, *no_timeout, *microseconds;
-	zval *p0[] = { NULL, NULL, NULL, NULL };
+	zval *connection = NULL, *parameters, *host, *port, *address;
+	php_stream *stream;
+	struct timeval no_timeout;
+	char *error_message = NULL;
+	int error_code = 0;
 
 	PHALCON_MM_GROW();
 
@@ -124,36 +144,188 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, connect){
 	PHALCON_OBS_VAR(port);
 	phalcon_array_fetch_string(&port, parameters, SL("port"), PH_NOISY_CC);
 	
-	PHALCON_INIT_VAR(error_num);
-	
-	PHALCON_INIT_VAR(error_str);
+	PHALCON_INIT_VAR(address);
+	PHALCON_CONCAT_SVSV(address, "tcp://", host, ":", port);
 	
-	p0[0] = host;
-	p0[1] = port;
-	Z_SET_ISREF_P(error_num);
-	p0[2] = error_num;
-	Z_SET_ISREF_P(error_str);
-	p0[3] = error_str;
+	stream = php_stream_xport_create(Z_STRVAL_P(address), Z_STRLEN_P(address), 0, STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT, NULL, NULL, NULL, &error_message, &error_code);
+	if (error_message) {
+		efree(error_message);
+	}
 	
-	PHALCON_INIT_NVAR(connection);
-	PHALCON_CALL_FUNC_PARAMS(connection, "fsockopen", 4, p0);
-	Z_UNSET_ISREF_P(p0[2]);
-	Z_UNSET_ISREF_P(p0[3]);
-	if (Z_TYPE_P(connection) != IS_RESOURCE) {
+	if (!stream) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Can't connect to Beanstalk server");
 		return;
 	}
 	
-	PHALCON_INIT_VAR(no_timeout);
-	ZVAL_LONG(no_timeout, -1);
+	/** 
+	 * Reads don't time out, 'reserve' may wait for jobs indefinitely
+	 */
+	no_timeout.tv_sec = -1;
+	no_timeout.tv_usec = 0;
+	php_stream_set_option(stream, PHP_STREAM_OPTION_READ_TIMEOUT, 0, &no_timeout);
 	
-	PHALCON_INIT_VAR(microseconds);
-	PHALCON_CALL_FUNC_PARAMS_3_NORETURN("stream_set_timeout", connection, no_timeout, microseconds);
+	PHALCON_INIT_NVAR(connection);
+	php_stream_to_zval(stream, connection);
 	phalcon_update_property_this(this_ptr, SL("_connection"), connection TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_tube") TSRMLS_CC);
 	
 	RETURN_CCTOR(connection);
 }
 
+/**
+ * Sets the codec used to serialize the bodies of the jobs: 'php', 'json', 'igbinary', 'raw' or
+ * an array with an encoder and a decoder callback
+ *
+ *<code>
+ * $queue->setCodec(array('gzdeflate', 'gzinflate'));
+ *</code>
+ *
+ * @param string|array $codec
+ * @return Phalcon\Queue\Beanstalk
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, setCodec){
+
+	zval *codec;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &codec);
+	
+	if (Z_TYPE_P(codec) == IS_ARRAY) { 
+		if (!phalcon_array_isset_long(codec, 0) || !phalcon_array_isset_long(codec, 1)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Custom codecs must be an array with an encoder and a decoder");
+			return;
+		}
+	} else {
+		if (!PHALCON_IS_STRING(codec, "php") && !PHALCON_IS_STRING(codec, "json") && !PHALCON_IS_STRING(codec, "igbinary") && !PHALCON_IS_STRING(codec, "raw")) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Unknown codec, valid codecs are 'php', 'json', 'igbinary' and 'raw'");
+			return;
+		}
+		if (PHALCON_IS_STRING(codec, "igbinary")) {
+			if (!zend_hash_exists(&module_registry, SS("igbinary"))) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "The igbinary extension is not loaded");
+				return;
+			}
+		}
+	}
+	
+	phalcon_update_property_this(this_ptr, SL("_codec"), codec TSRMLS_CC);
+	
+	RETURN_THIS();
+}
+
+/**
+ * Returns the codec used to serialize the bodies of the jobs
+ *
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, getCodec){
+
+
+	RETURN_MEMBER(this_ptr, "_codec");
+}
+
+/**
+ * Serializes the body of a job with the current codec
+ *
+ * @param mixed $data
+ * @return string
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, _encode){
+
+	zval *data, *codec, *encoder, *arguments, *encoded = NULL;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &data);
+	
+	PHALCON_OBS_VAR(codec);
+	phalcon_read_property_this(&codec, this_ptr, SL("_codec"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(codec) == IS_ARRAY) { 
+		PHALCON_OBS_VAR(encoder);
+		phalcon_array_fetch_long(&encoder, codec, 0, PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(arguments);
+		array_init_size(arguments, 1);
+		phalcon_array_append(&arguments, data, PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(encoded);
+		PHALCON_CALL_USER_FUNC_ARRAY(encoded, encoder, arguments);
+	} else {
+		if (PHALCON_IS_STRING(codec, "raw")) {
+			PHALCON_CPY_WRT_CTOR(encoded, data);
+		} else {
+			PHALCON_INIT_VAR(encoded);
+			if (PHALCON_IS_STRING(codec, "json")) {
+				PHALCON_CALL_FUNC_PARAMS_1(encoded, "json_encode", data);
+			} else {
+				if (PHALCON_IS_STRING(codec, "igbinary")) {
+					PHALCON_CALL_FUNC_PARAMS_1(encoded, "igbinary_serialize", data);
+				} else {
+					PHALCON_CALL_FUNC_PARAMS_1(encoded, "serialize", data);
+				}
+			}
+		}
+	}
+	
+	if (Z_TYPE_P(encoded) != IS_STRING) {
+		convert_to_string(encoded);
+	}
+	
+	RETURN_CCTOR(encoded);
+}
+
+/**
+ * Unserializes the body of a job with the current codec
+ *
+ * @param string $body
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, _decode){
+
+	zval *body, *codec, *decoder, *arguments, *assoc, *decoded;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &body);
+	
+	PHALCON_OBS_VAR(codec);
+	phalcon_read_property_this(&codec, this_ptr, SL("_codec"), PH_NOISY_CC);
+	
+	if (Z_TYPE_P(codec) == IS_ARRAY) { 
+		PHALCON_OBS_VAR(decoder);
+		phalcon_array_fetch_long(&decoder, codec, 1, PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(arguments);
+		array_init_size(arguments, 1);
+		phalcon_array_append(&arguments, body, PH_SEPARATE TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(decoded);
+		PHALCON_CALL_USER_FUNC_ARRAY(decoded, decoder, arguments);
+		RETURN_CCTOR(decoded);
+	}
+	
+	if (PHALCON_IS_STRING(codec, "raw")) {
+		RETURN_CCTOR(body);
+	}
+	
+	PHALCON_INIT_VAR(decoded);
+	if (PHALCON_IS_STRING(codec, "json")) {
+		PHALCON_INIT_VAR(assoc);
+		ZVAL_BOOL(assoc, 1);
+		PHALCON_CALL_FUNC_PARAMS_2(decoded, "json_decode", body, assoc);
+	} else {
+		if (PHALCON_IS_STRING(codec, "igbinary")) {
+			PHALCON_CALL_FUNC_PARAMS_1(decoded, "igbinary_unserialize", body);
+		} else {
+			PHALCON_CALL_FUNC_PARAMS_1(decoded, "unserialize", body);
+		}
+	}
+	
+	RETURN_CCTOR(decoded);
+}
+
 /**
  * Inserts jobs into the queue
  *
@@ -206,7 +378,7 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, put){
 	 * Data is automatically serialized before be sent to the server
 	 */
 	PHALCON_INIT_VAR(serialized);
-	PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", data);
+	PHALCON_CALL_METHOD_PARAMS_1(serialized, this_ptr, "_encode", data);
 	
 	PHALCON_INIT_VAR(serialized_length);
 	phalcon_fast_strlen(serialized_length, serialized);
@@ -294,7 +466,7 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, reserve){
 		PHALCON_CALL_METHOD_PARAMS_1(serialized_body, this_ptr, "read", length);
 	
 		PHALCON_INIT_VAR(body);
-		PHALCON_CALL_FUNC_PARAMS_1(body, "unserialize", serialized_body);
+		PHALCON_CALL_METHOD_PARAMS_1(body, this_ptr, "_decode", serialized_body);
 	
 		/** 
 		 * Create a beanstalk job abstraction
@@ -337,6 +509,7 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, choose){
 	if (PHALCON_IS_STRING(status, "USING")) {
 		PHALCON_OBS_VAR(using_tube);
 		phalcon_array_fetch_long(&using_tube, response, 1, PH_NOISY_CC);
+		phalcon_update_property_this(this_ptr, SL("_tube"), using_tube TSRMLS_CC);
 		RETURN_CCTOR(using_tube);
 	}
 	
@@ -409,7 +582,7 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, peekReady){
 		PHALCON_CALL_METHOD_PARAMS_1(serialized_body, this_ptr, "read", length);
 	
 		PHALCON_INIT_VAR(body);
-		PHALCON_CALL_FUNC_PARAMS_1(body, "unserialize", serialized_body);
+		PHALCON_CALL_METHOD_PARAMS_1(body, this_ptr, "_decode", serialized_body);
 	
 		PHALCON_INIT_VAR(job);
 		object_init_ex(job, phalcon_queue_beanstalk_job_ce);
@@ -421,6 +594,318 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, peekReady){
 	RETURN_MM_FALSE;
 }
 
+/**
+ * Inserts many jobs into the queue. Commands are pipelined, every batch of jobs is sent in a single
+ * write before reading the replies. Returns the ids of the jobs with the same keys of the array
+ * passed, jobs that could not be inserted have false as id
+ *
+ *<code>
+ * $ids = $queue->putMany(array(
+ *	array('processVideo' => 4871),
+ *	array('processVideo' => 4872)
+ * ), array('priority' => 250, 'batch' => 500));
+ *</code>
+ *
+ * @param array $jobs
+ * @param array $options
+ * @return array
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, putMany){
+
+	zval *jobs, *options = NULL, *priority = NULL, *delay = NULL, *ttr = NULL;
+	zval *batch = NULL, *command_prefix, *job_ids, *pending = NULL, *buffer = NULL;
+	zval *key = NULL, *data = NULL, *serialized = NULL, *serialized_length = NULL;
+	zval *response = NULL, *status = NULL, *job_id = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+	long batch_size = 1000, number_pending = 0;
+	int has_job;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &jobs, &options);
+	
+	if (!options) {
+		PHALCON_INIT_VAR(options);
+	}
+	
+	if (Z_TYPE_P(jobs) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Jobs must be an array");
+		return;
+	}
+	
+	if (phalcon_array_isset_string(options, SS("priority"))) {
+		PHALCON_OBS_VAR(priority);
+		phalcon_array_fetch_string(&priority, options, SL("priority"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(priority);
+		ZVAL_STRING(priority, "100", 1);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("delay"))) {
+		PHALCON_OBS_VAR(delay);
+		phalcon_array_fetch_string(&delay, options, SL("delay"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(delay);
+		ZVAL_STRING(delay, "0", 1);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("ttr"))) {
+		PHALCON_OBS_VAR(ttr);
+		phalcon_array_fetch_string(&ttr, options, SL("ttr"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(ttr);
+		ZVAL_STRING(ttr, "86400", 1);
+	}
+	
+	/** 
+	 * Jobs are sent in batches so the replies never fill the socket buffers
+	 */
+	if (phalcon_array_isset_string(options, SS("batch"))) {
+		PHALCON_OBS_VAR(batch);
+		phalcon_array_fetch_string(&batch, options, SL("batch"), PH_NOISY_CC);
+		batch_size = phalcon_get_intval(batch);
+		if (batch_size < 1) {
+			batch_size = 1;
+		}
+	}
+	
+	PHALCON_INIT_VAR(command_prefix);
+	PHALCON_CONCAT_SVSVSVS(command_prefix, "put ", priority, " ", delay, " ", ttr, " ");
+	
+	PHALCON_INIT_VAR(job_ids);
+	array_init(job_ids);
+	
+	PHALCON_INIT_VAR(pending);
+	array_init(pending);
+	
+	PHALCON_INIT_VAR(buffer);
+	ZVAL_EMPTY_STRING(buffer);
+	
+	phalcon_is_iterable(jobs, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (1) {
+	
+		has_job = zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS;
+		if (has_job) {
+	
+			PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
+			PHALCON_GET_FOREACH_VALUE(data);
+	
+			PHALCON_INIT_NVAR(serialized);
+			PHALCON_CALL_METHOD_PARAMS_1(serialized, this_ptr, "_encode", data);
+	
+			PHALCON_INIT_NVAR(serialized_length);
+			phalcon_fast_strlen(serialized_length, serialized);
+	
+			/** 
+			 * Commands are separated by \r\n, write() appends the last one
+			 */
+			if (number_pending) {
+				phalcon_concat_self_str(&buffer, SL("\r\n") TSRMLS_CC);
+			}
+			PHALCON_SCONCAT_VVS(buffer, command_prefix, serialized_length, "\r\n");
+			phalcon_concat_self(&buffer, serialized TSRMLS_CC);
+	
+			phalcon_array_append(&pending, key, PH_SEPARATE TSRMLS_CC);
+			number_pending++;
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+		if (number_pending && (!has_job || number_pending >= batch_size)) {
+	
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "write", buffer);
+	
+			/** 
+			 * Replies arrive in the same order the commands were sent
+			 */
+			phalcon_is_iterable(pending, &ah1, &hp1, 0, 0 TSRMLS_CC);
+	
+			while (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) == SUCCESS) {
+	
+				PHALCON_GET_FOREACH_VALUE(key);
+	
+				PHALCON_INIT_NVAR(response);
+				PHALCON_CALL_METHOD(response, this_ptr, "readstatus");
+	
+				PHALCON_OBS_NVAR(status);
+				phalcon_array_fetch_long(&status, response, 0, PH_NOISY_CC);
+				if (PHALCON_IS_STRING(status, "INSERTED") || PHALCON_IS_STRING(status, "BURIED")) {
+					PHALCON_OBS_NVAR(job_id);
+					phalcon_array_fetch_long(&job_id, response, 1, PH_NOISY_CC);
+					phalcon_array_update_zval(&job_ids, key, &job_id, PH_COPY | PH_SEPARATE TSRMLS_CC);
+				} else {
+					phalcon_array_update_zval_bool(&job_ids, key, 0, PH_SEPARATE TSRMLS_CC);
+				}
+	
+				zend_hash_move_forward_ex(ah1, &hp1);
+			}
+	
+			PHALCON_INIT_NVAR(pending);
+			array_init(pending);
+	
+			PHALCON_INIT_NVAR(buffer);
+			ZVAL_EMPTY_STRING(buffer);
+			number_pending = 0;
+		}
+	
+		if (!has_job) {
+			break;
+		}
+	}
+	
+	RETURN_CTOR(job_ids);
+}
+
+/**
+ * Reserves up to $count jobs. The first reservation waits up to $timeout seconds (or forever if no
+ * timeout is passed), the rest are pipelined in the same write and only take jobs already ready
+ *
+ * @param int $count
+ * @param int $timeout
+ * @return Phalcon\Queue\Beanstalk\Job[]
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, reserveMany){
+
+	zval *count, *timeout = NULL, *command, *jobs, *response = NULL;
+	zval *status = NULL, *job_id = NULL, *length = NULL, *serialized_body = NULL;
+	zval *body = NULL, *job = NULL;
+	long number, i;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 1, &count, &timeout);
+	
+	if (!timeout) {
+		PHALCON_INIT_VAR(timeout);
+	}
+	
+	PHALCON_INIT_VAR(jobs);
+	array_init(jobs);
+	
+	number = phalcon_get_intval(count);
+	if (number < 1) {
+		RETURN_CTOR(jobs);
+	}
+	
+	PHALCON_INIT_VAR(command);
+	if (Z_TYPE_P(timeout) != IS_NULL) {
+		PHALCON_CONCAT_SV(command, "reserve-with-timeout ", timeout);
+	} else {
+		ZVAL_STRING(command, "reserve", 1);
+	}
+	
+	for (i = 1; i < number; i++) {
+		phalcon_concat_self_str(&command, SL("\r\nreserve-with-timeout 0") TSRMLS_CC);
+	}
+	
+	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "write", command);
+	
+	for (i = 0; i < number; i++) {
+	
+		PHALCON_INIT_NVAR(response);
+		PHALCON_CALL_METHOD(response, this_ptr, "readstatus");
+	
+		PHALCON_OBS_NVAR(status);
+		phalcon_array_fetch_long(&status, response, 0, PH_NOISY_CC);
+		if (PHALCON_IS_STRING(status, "RESERVED")) {
+	
+			PHALCON_OBS_NVAR(job_id);
+			phalcon_array_fetch_long(&job_id, response, 1, PH_NOISY_CC);
+	
+			PHALCON_OBS_NVAR(length);
+			phalcon_array_fetch_long(&length, response, 2, PH_NOISY_CC);
+	
+			PHALCON_INIT_NVAR(serialized_body);
+			PHALCON_CALL_METHOD_PARAMS_1(serialized_body, this_ptr, "read", length);
+	
+			PHALCON_INIT_NVAR(body);
+			PHALCON_CALL_METHOD_PARAMS_1(body, this_ptr, "_decode", serialized_body);
+	
+			PHALCON_INIT_NVAR(job);
+			object_init_ex(job, phalcon_queue_beanstalk_job_ce);
+			PHALCON_CALL_METHOD_PARAMS_3_NORETURN(job, "__construct", this_ptr, job_id, body);
+	
+			phalcon_array_append(&jobs, job, PH_SEPARATE TSRMLS_CC);
+		}
+	}
+	
+	RETURN_CTOR(jobs);
+}
+
+/**
+ * Removes many jobs from the server in a single round trip, jobs can be passed as
+ * Phalcon\Queue\Beanstalk\Job objects or ids. Returns the number of jobs deleted
+ *
+ * @param array $jobs
+ * @return int
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, deleteMany){
+
+	zval *jobs, *command, *job = NULL, *job_id = NULL, *response = NULL;
+	zval *status = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	long number = 0, deleted = 0, i;
+
+	PHALCON_MM_GROW();
+
+	phalcon_fetch_params(1, 1, 0, &jobs);
+	
+	if (Z_TYPE_P(jobs) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Jobs must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(command);
+	ZVAL_EMPTY_STRING(command);
+	
+	phalcon_is_iterable(jobs, &ah0, &hp0, 0, 0 TSRMLS_CC);
+	
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(job);
+	
+		if (Z_TYPE_P(job) == IS_OBJECT) {
+			PHALCON_INIT_NVAR(job_id);
+			PHALCON_CALL_METHOD(job_id, job, "getid");
+		} else {
+			PHALCON_CPY_WRT(job_id, job);
+		}
+	
+		if (number) {
+			phalcon_concat_self_str(&command, SL("\r\n") TSRMLS_CC);
+		}
+		PHALCON_SCONCAT_SV(command, "delete ", job_id);
+		number++;
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	if (number) {
+	
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(this_ptr, "write", command);
+	
+		for (i = 0; i < number; i++) {
+	
+			PHALCON_INIT_NVAR(response);
+			PHALCON_CALL_METHOD(response, this_ptr, "readstatus");
+	
+			PHALCON_OBS_NVAR(status);
+			phalcon_array_fetch_long(&status, response, 0, PH_NOISY_CC);
+			if (PHALCON_IS_STRING(status, "DELETED")) {
+				deleted++;
+			}
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(deleted);
+}
+
 PHP_METHOD(Phalcon_Queue_Beanstalk, readStatus){
 
 	zval *response, *space, *parts;
@@ -447,19 +932,14 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, readStatus){
  */
 PHP_METHOD(Phalcon_Queue_Beanstalk, read){
 
-	zval *length = NULL, *connection = NULL, *is_eof, *eof_chars;
-	zval *total_length = NULL, *data, *meta, *timeout, *mask;
-	zval *packet = NULL, *end_of_file;
+	zval *length = NULL, *connection = NULL;
+	php_stream *stream;
+	char *data;
+	size_t total_length, received = 0, bytes;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &length) == FAILURE) {
-		RETURN_MM_NULL();
-	}
-
-	if (!length) {
-		PHALCON_INIT_VAR(length);
-	}
+	phalcon_fetch_params(1, 0, 1, &length);
 	
 	PHALCON_OBS_VAR(connection);
 	phalcon_read_property_this(&connection, this_ptr, SL("_connection"), PH_NOISY_CC);
@@ -472,51 +952,50 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, read){
 		}
 	}
 	
-	if (zend_is_true(length)) {
+	php_stream_from_zval_no_verify(stream, &connection);
+	if (!stream) {
+		RETURN_MM_FALSE;
+	}
+	
+	if (length && zend_is_true(length)) {
 	
-		PHALCON_INIT_VAR(is_eof);
-		PHALCON_CALL_FUNC_PARAMS_1(is_eof, "feof", connection);
-		if (zend_is_true(is_eof)) {
+		if (php_stream_eof(stream)) {
 			RETURN_MM_FALSE;
 		}
 	
-		PHALCON_INIT_VAR(eof_chars);
-		ZVAL_LONG(eof_chars, 2);
-	
-		PHALCON_INIT_VAR(total_length);
-		phalcon_add_function(total_length, length, eof_chars TSRMLS_CC);
-	
-		PHALCON_INIT_VAR(data);
-		PHALCON_CALL_FUNC_PARAMS_2(data, "fread", connection, total_length);
-	
-		PHALCON_INIT_VAR(meta);
-		PHALCON_CALL_FUNC_PARAMS_1(meta, "stream_get_meta_data", connection);
+		/** 
+		 * Bodies are followed by \r\n, the socket is read until the whole packet is received
+		 */
+		total_length = phalcon_get_intval(length) + 2;
+		data = emalloc(total_length + 1);
+	
+		while (received < total_length) {
+			bytes = php_stream_read(stream, data + received, total_length - received);
+			if (!bytes) {
+				break;
+			}
+			received += bytes;
+		}
 	
-		PHALCON_OBS_VAR(timeout);
-		phalcon_array_fetch_string(&timeout, meta, SL("timed_out"), PH_NOISY_CC);
-		if (zend_is_true(timeout)) {
+		if (received < total_length) {
+			efree(data);
 			PHALCON_THROW_EXCEPTION_STR(phalcon_exception_ce, "Connection timed out");
 			return;
 		}
 	
-		PHALCON_INIT_VAR(mask);
-		ZVAL_STRING(mask, "\r\n", 1);
-	
-		PHALCON_INIT_VAR(packet);
-		PHALCON_CALL_FUNC_PARAMS_2(packet, "rtrim", data, mask);
-	} else {
-		PHALCON_INIT_NVAR(total_length);
-		ZVAL_LONG(total_length, 16384);
-	
-		PHALCON_INIT_VAR(end_of_file);
-		ZVAL_STRING(end_of_file, "\r\n", 1);
+		data[total_length - 2] = '\0';
 	
-		PHALCON_INIT_NVAR(packet);
-		PHALCON_CALL_FUNC_PARAMS_3(packet, "stream_get_line", connection, total_length, end_of_file);
+		PHALCON_MM_RESTORE();
+		RETURN_STRINGL(data, total_length - 2, 0);
 	}
 	
+	data = php_stream_get_record(stream, 16384, &bytes, "\r\n", 2 TSRMLS_CC);
+	if (!data) {
+		RETURN_MM_FALSE;
+	}
 	
-	RETURN_CCTOR(packet);
+	PHALCON_MM_RESTORE();
+	RETURN_STRINGL(data, bytes, 0);
 }
 
 /**
@@ -527,15 +1006,14 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, read){
  */
 PHP_METHOD(Phalcon_Queue_Beanstalk, write){
 
-	zval *data, *connection = NULL, *packet, *data_length;
-	zval *status;
+	zval *data, *connection = NULL, *packet;
+	php_stream *stream;
+	size_t written;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &data) == FAILURE) {
-		RETURN_MM_NULL();
-	}
-
+	phalcon_fetch_params(1, 1, 0, &data);
+	
 	PHALCON_OBS_VAR(connection);
 	phalcon_read_property_this(&connection, this_ptr, SL("_connection"), PH_NOISY_CC);
 	if (Z_TYPE_P(connection) != IS_RESOURCE) {
@@ -547,16 +1025,21 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, write){
 		}
 	}
 	
+	php_stream_from_zval_no_verify(stream, &connection);
+	if (!stream) {
+		RETURN_MM_FALSE;
+	}
+	
 	PHALCON_INIT_VAR(packet);
 	PHALCON_CONCAT_VS(packet, data, "\r\n");
 	
-	PHALCON_INIT_VAR(data_length);
-	phalcon_fast_strlen(data_length, packet);
-	
-	PHALCON_INIT_VAR(status);
-	PHALCON_CALL_FUNC_PARAMS_3(status, "fwrite", connection, packet, data_length);
+	written = php_stream_write(stream, Z_STRVAL_P(packet), Z_STRLEN_P(packet));
+	if (written != (size_t) Z_STRLEN_P(packet)) {
+		RETURN_MM_FALSE;
+	}
 	
-	RETURN_CCTOR(status);
+	PHALCON_MM_RESTORE();
+	RETURN_LONG(written);
 }
 
 /**
@@ -567,6 +1050,7 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, write){
 PHP_METHOD(Phalcon_Queue_Beanstalk, disconnect){
 
 	zval *connection;
+	php_stream *stream;
 
 	PHALCON_MM_GROW();
 
@@ -576,7 +1060,108 @@ PHP_METHOD(Phalcon_Queue_Beanstalk, disconnect){
 		RETURN_MM_FALSE;
 	}
 	
-	PHALCON_CALL_FUNC_PARAMS_1_NORETURN("fclose", connection);
+	/** 
+	 * Closing the stream also removes its resource, as fclose() does
+	 */
+	php_stream_from_zval_no_verify(stream, &connection);
+	if (stream) {
+		php_stream_close(stream);
+	}
+	
+	phalcon_update_property_null(this_ptr, SL("_connection") TSRMLS_CC);
 	RETURN_MM_TRUE;
 }
 
+/**
+ * Inserts a job into the queue without waiting for the server, the returned handle
+ * can be waited together with other operations using Phalcon\Async::wait. Its result
+ * is the id of the job or false if the job was not inserted
+ *
+ *<code>
+ *	$handle = $queue->putAsync(array('processVideo' => 4871));
+ *	//...
+ *	$id = $handle->getResult();
+ *</code>
+ *
+ * @param mixed $data
+ * @param array $options
+ * @return Phalcon\Async\Handle
+ */
+PHP_METHOD(Phalcon_Queue_Beanstalk, putAsync){
+
+	zval *data, *options = NULL, *priority = NULL, *delay = NULL, *ttr = NULL;
+	zval *parameters, *host, *port, *address, *tube, *serialized;
+	zval *serialized_length, *command, *request = NULL;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &data, &options) == FAILURE) {
+		RETURN_MM_NULL();
+	}
+
+	if (!options) {
+		PHALCON_INIT_VAR(options);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("priority"))) {
+		PHALCON_OBS_VAR(priority);
+		phalcon_array_fetch_string(&priority, options, SL("priority"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(priority);
+		ZVAL_STRING(priority, "100", 1);
+	}
+	if (phalcon_array_isset_string(options, SS("delay"))) {
+		PHALCON_OBS_VAR(delay);
+		phalcon_array_fetch_string(&delay, options, SL("delay"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(delay);
+		ZVAL_STRING(delay, "0", 1);
+	}
+	
+	if (phalcon_array_isset_string(options, SS("ttr"))) {
+		PHALCON_OBS_VAR(ttr);
+		phalcon_array_fetch_string(&ttr, options, SL("ttr"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_NVAR(ttr);
+		ZVAL_STRING(ttr, "86400", 1);
+	}
+	
+	PHALCON_OBS_VAR(parameters);
+	phalcon_read_property_this(&parameters, this_ptr, SL("_parameters"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(host);
+	phalcon_array_fetch_string(&host, parameters, SL("host"), PH_NOISY_CC);
+	
+	PHALCON_OBS_VAR(port);
+	phalcon_array_fetch_string(&port, parameters, SL("port"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(address);
+	PHALCON_CONCAT_SVSV(address, "tcp://", host, ":", port);
+	
+	PHALCON_INIT_VAR(serialized);
+	PHALCON_CALL_METHOD_PARAMS_1(serialized, this_ptr, "_encode", data);
+	
+	PHALCON_INIT_VAR(serialized_length);
+	phalcon_fast_strlen(serialized_length, serialized);
+	
+	PHALCON_INIT_VAR(command);
+	PHALCON_CONCAT_SVSV(command, "put ", priority, " ", delay);
+	PHALCON_SCONCAT_SVSV(command, " ", ttr, " ", serialized_length);
+	PHALCON_SCONCAT_SVS(command, "\r\n", serialized, "\r\n");
+	
+	/** 
+	 * The handle uses its own connection, so the tube chosen in this one is selected again
+	 */
+	PHALCON_OBS_VAR(tube);
+	phalcon_read_property_this(&tube, this_ptr, SL("_tube"), PH_NOISY_CC);
+	if (Z_TYPE_P(tube) != IS_NULL) {
+		PHALCON_INIT_VAR(request);
+		PHALCON_CONCAT_SVSV(request, "use ", tube, "\r\n", command);
+	} else {
+		PHALCON_CPY_WRT(request, command);
+	}
+	
+	phalcon_async_handle_create(return_value, address, request, PHALCON_ASYNC_BEANSTALK_PUT, NULL, NULL TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
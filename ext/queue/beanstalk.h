@@ -23,20 +23,32 @@ PHALCON_INIT_CLASS(Phalcon_Queue_Beanstalk);
 
 PHP_METHOD(Phalcon_Queue_Beanstalk, __construct);
 PHP_METHOD(Phalcon_Queue_Beanstalk, connect);
+PHP_METHOD(Phalcon_Queue_Beanstalk, setCodec);
+PHP_METHOD(Phalcon_Queue_Beanstalk, getCodec);
+PHP_METHOD(Phalcon_Queue_Beanstalk, _encode);
+PHP_METHOD(Phalcon_Queue_Beanstalk, _decode);
 PHP_METHOD(Phalcon_Queue_Beanstalk, put);
 PHP_METHOD(Phalcon_Queue_Beanstalk, reserve);
 PHP_METHOD(Phalcon_Queue_Beanstalk, choose);
 PHP_METHOD(Phalcon_Queue_Beanstalk, watch);
 PHP_METHOD(Phalcon_Queue_Beanstalk, peekReady);
+PHP_METHOD(Phalcon_Queue_Beanstalk, putMany);
+PHP_METHOD(Phalcon_Queue_Beanstalk, reserveMany);
+PHP_METHOD(Phalcon_Queue_Beanstalk, deleteMany);
 PHP_METHOD(Phalcon_Queue_Beanstalk, readStatus);
 PHP_METHOD(Phalcon_Queue_Beanstalk, read);
 PHP_METHOD(Phalcon_Queue_Beanstalk, write);
 PHP_METHOD(Phalcon_Queue_Beanstalk, disconnect);
+PHP_METHOD(Phalcon_Queue_Beanstalk, putAsync);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_setcodec, 0, 0, 1)
+	ZEND_ARG_INFO(0, codec)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_put, 0, 0, 1)
 	ZEND_ARG_INFO(0, data)
 	ZEND_ARG_INFO(0, options)
@@ -54,6 +66,20 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_watch, 0, 0, 1)
 	ZEND_ARG_INFO(0, tube)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_putmany, 0, 0, 1)
+	ZEND_ARG_INFO(0, jobs)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_reservemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, count)
+	ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_deletemany, 0, 0, 1)
+	ZEND_ARG_INFO(0, jobs)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_queue_beanstalk_read, 0, 0, 0)
 	ZEND_ARG_INFO(0, length)
 ZEND_END_ARG_INFO()
@@ -61,15 +87,23 @@ ZEND_END_ARG_INFO()
 PHALCON_INIT_FUNCS(phalcon_queue_beanstalk_method_entry){
 	PHP_ME(Phalcon_Queue_Beanstalk, __construct, arginfo_phalcon_queue_beanstalk___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Queue_Beanstalk, connect, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, setCodec, arginfo_phalcon_queue_beanstalk_setcodec, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, getCodec, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, _encode, NULL, ZEND_ACC_PROTECTED) 
+	PHP_ME(Phalcon_Queue_Beanstalk, _decode, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Queue_Beanstalk, put, arginfo_phalcon_queue_beanstalk_put, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, reserve, arginfo_phalcon_queue_beanstalk_reserve, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, choose, arginfo_phalcon_queue_beanstalk_choose, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, watch, arginfo_phalcon_queue_beanstalk_watch, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, peekReady, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, putMany, arginfo_phalcon_queue_beanstalk_putmany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, reserveMany, arginfo_phalcon_queue_beanstalk_reservemany, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, deleteMany, arginfo_phalcon_queue_beanstalk_deletemany, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, readStatus, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Queue_Beanstalk, read, arginfo_phalcon_queue_beanstalk_read, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Queue_Beanstalk, write, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Queue_Beanstalk, disconnect, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Queue_Beanstalk, putAsync, arginfo_phalcon_queue_beanstalk_put, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -0,0 +1,120 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class AclTest extends PHPUnit_Framework_TestCase
+{
+
+	protected function _getAcl()
+	{
+		$acl = new Phalcon\Acl\Adapter\Memory();
+		$acl->setDefaultAction(Phalcon\Acl::DENY);
+
+		$acl->addRole('Guests');
+		$acl->addRole('Members', 'Guests');
+		$acl->addRole('Administrators', 'Members');
+
+		$acl->addResource('index', array('index', 'about'));
+		$acl->addResource('products', array('index', 'edit', 'delete'));
+		$acl->addResource('invoices', array('index', 'profile'));
+
+		$acl->allow('Guests', 'index', '*');
+		$acl->allow('Guests', 'products', 'index');
+		$acl->allow('Members', 'invoices', array('index', 'profile'));
+		$acl->allow('Administrators', 'products', array('edit', 'delete'));
+		$acl->deny('Members', 'index', 'about');
+
+		return $acl;
+	}
+
+	public function testAclCompiled()
+	{
+
+		$checks = array();
+		foreach (array('Guests', 'Members', 'Administrators', 'Unknown') as $role) {
+			foreach (array('index', 'products', 'invoices', 'unknown', '*') as $resource) {
+				foreach (array('index', 'about', 'edit', 'delete', 'profile', 'unknown') as $access) {
+					$checks[] = array($role, $resource, $access);
+				}
+			}
+		}
+
+		$acl = $this->_getAcl();
+
+		$expected = array();
+		foreach ($checks as $check) {
+			$expected[] = $acl->isAllowed($check[0], $check[1], $check[2]);
+		}
+
+		$compiledPath = 'unit-tests/cache/acl.compiled';
+		@unlink($compiledPath);
+
+		$compiled = $acl->compile($compiledPath);
+		$this->assertTrue(is_array($compiled));
+		$this->assertEquals($acl->getCompiled(), $compiled);
+		$this->assertTrue(file_exists($compiledPath));
+
+		foreach ($checks as $n => $check) {
+			$this->assertEquals($acl->isAllowed($check[0], $check[1], $check[2]), $expected[$n], join('/', $check));
+		}
+
+		//A compiled list loaded in an empty adapter
+		$acl = new Phalcon\Acl\Adapter\Memory();
+		$acl->setDefaultAction(Phalcon\Acl::DENY);
+		$acl->setCompiled($compiledPath);
+
+		foreach ($checks as $n => $check) {
+			$this->assertEquals($acl->isAllowed($check[0], $check[1], $check[2]), $expected[$n], join('/', $check));
+		}
+
+		$this->assertEquals($acl->isAllowedMany('Members', array(
+			'products' => array('products', 'index'),
+			'edit' => array('products', 'edit'),
+			'invoices' => array('invoices', 'profile'),
+			'about' => array('index', 'about')
+		)), array(
+			'products' => true,
+			'edit' => false,
+			'invoices' => true,
+			'about' => false
+		));
+
+		//A table written by another process replaces the cached one
+		$acl = $this->_getAcl();
+		$acl->deny('Members', 'invoices', 'profile');
+		file_put_contents($compiledPath, serialize($acl->compile()));
+		touch($compiledPath, time() + 10);
+
+		$acl = new Phalcon\Acl\Adapter\Memory();
+		$acl->setDefaultAction(Phalcon\Acl::DENY);
+		$acl->setCompiled($compiledPath);
+		$this->assertEquals($acl->isAllowed('Members', 'invoices', 'profile'), Phalcon\Acl::DENY);
+		$this->assertEquals($acl->isAllowed('Members', 'invoices', 'index'), Phalcon\Acl::ALLOW);
+
+		//Changing the list drops the compiled table
+		$acl = $this->_getAcl();
+		$acl->compile();
+		$acl->allow('Guests', 'invoices', 'index');
+		$this->assertNull($acl->getCompiled());
+		$this->assertEquals($acl->isAllowed('Guests', 'invoices', 'index'), Phalcon\Acl::ALLOW);
+
+		@unlink($compiledPath);
+	}
+
+}
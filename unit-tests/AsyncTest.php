@@ -0,0 +1,188 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class AsyncTest extends PHPUnit_Framework_TestCase
+{
+
+	protected function _listen()
+	{
+		$server = stream_socket_server('tcp://127.0.0.1:0', $errno, $errstr);
+		if (!$server) {
+			$this->markTestSkipped('Cannot listen on 127.0.0.1: ' . $errstr);
+			return false;
+		}
+		return $server;
+	}
+
+	protected function _address($server)
+	{
+		return 'tcp://' . stream_socket_get_name($server, false);
+	}
+
+	public function testWait()
+	{
+		$server1 = $this->_listen();
+		$server2 = $this->_listen();
+
+		$handle1 = Phalcon\Async::send($this->_address($server1), "version\r\n");
+		$handle2 = Phalcon\Async::send($this->_address($server2), "stats\r\n");
+
+		$this->assertInstanceOf('Phalcon\Async\Handle', $handle1);
+		$this->assertFalse($handle1->isReady());
+
+		//The second server answers first
+		$connection2 = stream_socket_accept($server2);
+		fwrite($connection2, "STAT pid 1\r\nEND\r\n");
+
+		$this->assertEquals(Phalcon\Async::wait(array($handle1, $handle2), 0.1), 1);
+		$this->assertFalse($handle1->isReady());
+		$this->assertTrue($handle2->isReady());
+		$this->assertEquals($handle2->getResult(), 'STAT pid 1');
+		$this->assertEquals(fread($connection2, 1024), "stats\r\n");
+
+		$connection1 = stream_socket_accept($server1);
+		fwrite($connection1, "VERSION 1.4.15\r\n");
+
+		$this->assertEquals(Phalcon\Async::wait(array($handle1, $handle2)), 2);
+		$this->assertEquals($handle1->getResult(), 'VERSION 1.4.15');
+		$this->assertNull($handle1->getError());
+
+		fclose($connection1);
+		fclose($connection2);
+	}
+
+	public function testErrors()
+	{
+		$server = $this->_listen();
+		$address = $this->_address($server);
+		fclose($server);
+
+		$handle = Phalcon\Async::send($address, "version\r\n");
+		$this->assertTrue($handle->wait(1));
+		$this->assertNotNull($handle->getError());
+
+		try {
+			$handle->getResult();
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Async\Exception $e) {
+			$this->assertTrue(true);
+		}
+	}
+
+	public function testMemcacheGetAsync()
+	{
+		$server1 = $this->_listen();
+		$server2 = $this->_listen();
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 3600
+		));
+
+		list($host1, $port1) = explode(':', stream_socket_get_name($server1, false));
+		list($host2, $port2) = explode(':', stream_socket_get_name($server2, false));
+
+		$cache1 = new Phalcon\Cache\Backend\Memcache($frontCache, array('host' => $host1, 'port' => $port1));
+		$cache2 = new Phalcon\Cache\Backend\Memcache($frontCache, array('host' => $host2, 'port' => $port2));
+
+		$hit = $cache1->getAsync('test-data');
+		$miss = $cache2->getAsync('test-missing');
+
+		$data = serialize(array(1, 2, 3));
+
+		$connection1 = stream_socket_accept($server1);
+		fwrite($connection1, "VALUE test-data 0 " . strlen($data) . "\r\n" . $data . "\r\nEND\r\n");
+
+		$connection2 = stream_socket_accept($server2);
+		fwrite($connection2, "END\r\n");
+
+		$this->assertEquals(Phalcon\Async::wait(array($hit, $miss), 1), 2);
+		$this->assertEquals($hit->getResult(), array(1, 2, 3));
+		$this->assertNull($miss->getResult());
+		$this->assertEquals(fread($connection1, 1024), "get test-data\r\n");
+
+		fclose($connection1);
+		fclose($connection2);
+	}
+
+	public function testMemcacheGetAsyncKeys()
+	{
+		$server = $this->_listen();
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 3600
+		));
+
+		list($host, $port) = explode(':', stream_socket_get_name($server, false));
+
+		$cache = new Phalcon\Cache\Backend\Memcache($frontCache, array('host' => $host, 'port' => $port));
+
+		//Spaces and line breaks are replaced as the Memcache extension does
+		$handle = $cache->getAsync("test data\r\nflush_all");
+
+		$connection = stream_socket_accept($server);
+		fwrite($connection, "END\r\n");
+
+		$this->assertTrue($handle->wait(1));
+		$this->assertNull($handle->getResult());
+		$this->assertEquals(fread($connection, 1024), "get test_data__flush_all\r\n");
+
+		fclose($connection);
+
+		try {
+			$cache->getAsync(str_repeat('a', 251));
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Cache\Exception $e) {
+			$this->assertTrue(true);
+		}
+	}
+
+	public function testBeanstalkPutAsync()
+	{
+		$server = $this->_listen();
+
+		list($host, $port) = explode(':', stream_socket_get_name($server, false));
+
+		$queue = new Phalcon\Queue\Beanstalk(array('host' => $host, 'port' => $port));
+
+		$inserted = $queue->putAsync('job-data');
+
+		$connection = stream_socket_accept($server);
+		fwrite($connection, "INSERTED 12\r\n");
+
+		$this->assertTrue($inserted->wait(1));
+		$this->assertEquals($inserted->getResult(), '12');
+		$this->assertEquals(fread($connection, 1024), "put 100 0 86400 " . strlen(serialize('job-data')) . "\r\n" . serialize('job-data') . "\r\n");
+
+		fclose($connection);
+
+		$rejected = $queue->putAsync('job-data', array('priority' => 10));
+
+		$connection = stream_socket_accept($server);
+		fwrite($connection, "DRAINING\r\n");
+
+		$this->assertTrue($rejected->wait(1));
+		$this->assertFalse($rejected->getResult());
+
+		fclose($connection);
+	}
+
+}
@@ -18,6 +18,77 @@
   +------------------------------------------------------------------------+
 */
 
+class ArrayCacheBackend implements Phalcon\Cache\BackendInterface
+{
+	public $data = array();
+
+	protected $_lastKey;
+
+	public function start($keyName, $lifetime = null)
+	{
+		return null;
+	}
+
+	public function stop($stopBuffer = true)
+	{
+	}
+
+	public function getFrontend()
+	{
+		return null;
+	}
+
+	public function getOptions()
+	{
+		return array();
+	}
+
+	public function isFresh()
+	{
+		return true;
+	}
+
+	public function isStarted()
+	{
+		return false;
+	}
+
+	public function setLastKey($lastKey)
+	{
+		$this->_lastKey = $lastKey;
+	}
+
+	public function getLastKey()
+	{
+		return $this->_lastKey;
+	}
+
+	public function get($keyName, $lifetime = null)
+	{
+		return isset($this->data[$keyName]) ? $this->data[$keyName] : null;
+	}
+
+	public function save($keyName = null, $content = null, $lifetime = null, $stopBuffer = true)
+	{
+		$this->data[$keyName] = $content;
+	}
+
+	public function delete($keyName)
+	{
+		unset($this->data[$keyName]);
+	}
+
+	public function queryKeys($prefix = null)
+	{
+		return array_keys($this->data);
+	}
+
+	public function exists($keyName = null, $lifetime = null)
+	{
+		return isset($this->data[$keyName]);
+	}
+}
+
 class CacheTest extends PHPUnit_Framework_TestCase
 {
 
@@ -148,6 +219,235 @@ class CacheTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testStampedeFileCache()
+	{
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 1
+		));
+
+		$options = array(
+			'cacheDir' => 'unit-tests/cache/',
+			'beta' => 0,
+			'grace' => 10,
+			'lock' => 5
+		);
+
+		$cache = new Phalcon\Cache\Backend\File($frontCache, $options);
+		$other = new Phalcon\Cache\Backend\File($frontCache, $options);
+
+		$this->assertNull($cache->get('test-stampede'));
+
+		$cache->save('test-stampede', "first");
+		$this->assertEquals($cache->get('test-stampede'), "first");
+
+		sleep(2);
+
+		//The first worker takes the lock and regenerates the entry
+		$this->assertNull($cache->get('test-stampede'));
+		$this->assertTrue($cache->isRegenerating());
+		$this->assertTrue(file_exists('unit-tests/cache/test-stampede.lock'));
+
+		//The others keep receiving the stale entry meanwhile
+		$this->assertEquals($other->get('test-stampede'), "first");
+		$this->assertFalse($other->isRegenerating());
+
+		$cache->save('test-stampede', "second");
+		$this->assertFalse(file_exists('unit-tests/cache/test-stampede.lock'));
+		$this->assertEquals($other->get('test-stampede'), "second");
+
+		$this->assertEquals($cache->getStats(), array('hits' => 1, 'misses' => 2, 'stale' => 0));
+		$this->assertEquals($other->getStats(), array('hits' => 1, 'misses' => 0, 'stale' => 1));
+
+		$multiple = new Phalcon\Cache\Multiple(array($other));
+		$this->assertEquals($multiple->get('test-stampede'), "second");
+		$this->assertNull($multiple->get('test-unknown'));
+
+		$stats = $multiple->getStats();
+		$this->assertEquals($stats['hits'], 1);
+		$this->assertEquals($stats['misses'], 1);
+		$this->assertEquals($stats['stale'], 1);
+		$this->assertEquals(count($stats['backends']), 1);
+
+		$this->assertTrue($cache->delete('test-stampede'));
+
+	}
+
+	public function testStampedeEarlyFileCache()
+	{
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 60
+		));
+
+		$early = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'beta' => 1,
+			'lock' => 5
+		));
+
+		$never = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'beta' => 0,
+			'lock' => 5
+		));
+
+		//An entry about to expire that took very long to compute is recomputed early
+		file_put_contents('unit-tests/cache/test-early', serialize(array(
+			'created' => time() - 59,
+			'expires' => time() + 1,
+			'delta' => 1000000.0,
+			'content' => serialize('early')
+		)));
+
+		$this->assertEquals($never->get('test-early'), 'early');
+		$this->assertFalse($never->isRegenerating());
+
+		$this->assertNull($early->get('test-early'));
+		$this->assertTrue($early->isRegenerating());
+
+		//Lock files are not keys
+		$this->assertTrue(file_exists('unit-tests/cache/test-early.lock'));
+		$this->assertEquals($early->queryKeys('test-early'), array('test-early'));
+
+		//The lock is taken, other workers keep the current content
+		$this->assertEquals($early->get('test-early'), 'early');
+		$this->assertFalse($early->isRegenerating());
+
+		$early->save('test-early', 'recomputed');
+		$this->assertFalse(file_exists('unit-tests/cache/test-early.lock'));
+		$this->assertEquals($never->get('test-early'), 'recomputed');
+
+		//A lifetime passed to get() is counted from the time the entry was stored
+		$this->assertEquals($never->get('test-early', 60), 'recomputed');
+		sleep(2);
+		$this->assertNull($never->get('test-early', 1));
+
+		$this->assertTrue($never->delete('test-early'));
+
+	}
+
+	public function testStaleFileCache()
+	{
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 60
+		));
+
+		$cache = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'grace' => 30,
+			'lock' => 5
+		));
+
+		//Expired within the grace period, the stale content is served while it is regenerated
+		file_put_contents('unit-tests/cache/test-stale', serialize(array(
+			'created' => time() - 70,
+			'expires' => time() - 10,
+			'delta' => 0.1,
+			'content' => serialize('stale')
+		)));
+
+		//A lock left by a worker that died is replaced
+		touch('unit-tests/cache/test-stale.lock', time() - 60);
+
+		$this->assertNull($cache->get('test-stale'));
+		$this->assertTrue($cache->isRegenerating());
+
+		$other = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'grace' => 30,
+			'lock' => 5
+		));
+		$this->assertEquals($other->get('test-stale'), 'stale');
+		$this->assertEquals($other->getStats(), array('hits' => 0, 'misses' => 0, 'stale' => 1));
+
+		$cache->save('test-stale', 'fresh');
+		$this->assertEquals($other->get('test-stale'), 'fresh');
+		$this->assertEquals(glob('unit-tests/cache/test-stale.*'), array());
+
+		//Expired beyond the grace period, the entry is a miss for every worker
+		file_put_contents('unit-tests/cache/test-stale', serialize(array(
+			'created' => time() - 100,
+			'expires' => time() - 40,
+			'delta' => 0.1,
+			'content' => serialize('stale')
+		)));
+
+		$this->assertNull($other->get('test-stale'));
+		$this->assertNull($cache->get('test-stale'));
+
+		$this->assertTrue($cache->delete('test-stale'));
+
+	}
+
+	public function testManyFileCache()
+	{
+
+		$frontCache = new Phalcon\Cache\Frontend\Data(array(
+			'lifetime' => 60
+		));
+
+		$fast = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'prefix' => 'fast-'
+		));
+
+		$slow = new Phalcon\Cache\Backend\File($frontCache, array(
+			'cacheDir' => 'unit-tests/cache/',
+			'prefix' => 'slow-'
+		));
+
+		$this->assertInstanceOf('Phalcon\Cache\BatchInterface', $slow);
+
+		$this->assertTrue($slow->saveMany(array('a' => 1, 'b' => array(2), 'c' => 'three')));
+		$this->assertTrue(file_exists('unit-tests/cache/slow-b'));
+
+		$this->assertEquals($slow->getMany(array('a', 'x', 'c')), array('a' => 1, 'c' => 'three'));
+
+		//Keys found in the second backend are stored in the first one
+		$multiple = new Phalcon\Cache\Multiple(array($fast, $slow));
+		$this->assertEquals($multiple->getMany(array('c', 'a', 'b', 'x')), array('c' => 'three', 'a' => 1, 'b' => array(2)));
+		$this->assertEquals($fast->getMany(array('a', 'b', 'c')), array('a' => 1, 'b' => array(2), 'c' => 'three'));
+
+		$stats = $multiple->getStats();
+		$this->assertEquals($stats['hits'], 3);
+		$this->assertEquals($stats['misses'], 1);
+
+		$this->assertEquals($slow->deleteMany(array('a', 'b', 'x')), 2);
+		$this->assertEquals($slow->getMany(array('a', 'b', 'c')), array('c' => 'three'));
+
+		$multiple->deleteMany(array('a', 'b', 'c'));
+		$this->assertEquals($fast->getMany(array('a', 'b', 'c')), array());
+		$this->assertEquals($slow->getMany(array('a', 'b', 'c')), array());
+
+		//Falsy contents are stored as they are, not taken from the frontend buffer
+		$falsy = array('zero' => 0, 'empty' => '', 'none' => array(), 'no' => false);
+		$this->assertTrue($slow->saveMany($falsy));
+		$this->assertEquals($slow->getMany(array_keys($falsy)), $falsy);
+
+		$this->assertEquals($multiple->getMany(array_keys($falsy)), $falsy);
+		$this->assertEquals($fast->getMany(array_keys($falsy)), $falsy);
+
+		$multiple->deleteMany(array_keys($falsy));
+
+		//Backends without batch operations are used key by key
+		$array = new ArrayCacheBackend();
+		$multiple = new Phalcon\Cache\Multiple(array($array, $slow));
+
+		$multiple->saveMany(array('a' => 1, 'b' => 2));
+		$this->assertEquals($array->data, array('a' => 1, 'b' => 2));
+
+		$array->delete('b');
+		$this->assertEquals($multiple->getMany(array('a', 'b', 'x')), array('a' => 1, 'b' => 2));
+		$this->assertEquals($array->data, array('a' => 1, 'b' => 2));
+
+		$multiple->deleteMany(array('a', 'b'));
+		$this->assertEquals($array->data, array());
+		$this->assertEquals($slow->getMany(array('a', 'b')), array());
+
+	}
+
 	private function _prepareMemcached()
 	{
 
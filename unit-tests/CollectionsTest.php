@@ -177,6 +177,59 @@ class CollectionsTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals(count($songs), 1);
 		$this->assertEquals($songs[0]->name, 'Teardrop');
 
+		//Cursor resultsets
+		$songs = Songs::find(array(
+			'conditions' => array('artist' => 'Massive Attack'),
+			'fields' => array('name' => true),
+			'sort' => array('name' => 1),
+			'batchSize' => 1,
+			'cursor' => true
+		));
+		$this->assertInstanceOf('Phalcon\Mvc\Collection\Resultset', $songs);
+		$this->assertEquals(count($songs), 2);
+
+		$names = array();
+		foreach ($songs as $position => $song) {
+			$this->assertInstanceOf('Songs', $song);
+			$this->assertFalse(isset($song->artist));
+			$names[$position] = $song->name;
+		}
+		$this->assertEquals($names, array('Paradise Circus', 'Teardrop'));
+		$this->assertEquals($songs->getFirst()->name, 'Paradise Circus');
+
+		//Saving a projected document keeps the fields that were not fetched
+		$song = Songs::findFirst(array(
+			'conditions' => array('name' => 'Teardrop')
+		));
+		$song->year = 1998;
+		$this->assertTrue($song->save());
+
+		$song = Songs::findFirst(array(
+			'conditions' => array('name' => 'Teardrop'),
+			'fields' => array('name' => true)
+		));
+		$this->assertFalse(isset($song->artist));
+		$song->name = 'Teardrop (Remastered)';
+		$song->artist = 'Unknown';
+		$this->assertTrue($song->save());
+
+		$song = Songs::findFirst(array(
+			'conditions' => array('name' => 'Teardrop (Remastered)')
+		));
+		$this->assertInstanceOf('Songs', $song);
+		$this->assertEquals($song->artist, 'Unknown');
+		$this->assertEquals($song->year, 1998);
+		$song->artist = 'Massive Attack';
+		$song->name = 'Teardrop';
+		$this->assertTrue($song->save());
+
+		$songs = Songs::find(array(
+			'conditions' => array('artist' => 'Lana'),
+			'cursor' => true
+		));
+		$this->assertEquals(count($songs), 0);
+		$this->assertFalse($songs->getFirst());
+
 		//Find first
 		$song = Songs::findFirst(array(
 			array('artist' => 'Massive Attack'),
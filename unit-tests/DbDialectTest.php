@@ -345,4 +345,32 @@ class DbDialectTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testUpsertDialects()
+	{
+
+		$mysql = new \Phalcon\Db\Dialect\Mysql();
+
+		$this->assertEquals($mysql->escapeIdentifier('year'), '`year`');
+		$this->assertEquals($mysql->escapeIdentifier('ye`ar'), '`ye``ar`');
+
+		$sql = 'INSERT INTO `robots` (`name`, `year`) VALUES (?, ?), (?, ?)';
+		$this->assertEquals($mysql->upsert($sql, array('year')), $sql . ' ON DUPLICATE KEY UPDATE `year` = VALUES(`year`)');
+		$this->assertEquals($mysql->upsert($sql, array('name', 'year')), $sql . ' ON DUPLICATE KEY UPDATE `name` = VALUES(`name`), `year` = VALUES(`year`)');
+
+		$postgresql = new \Phalcon\Db\Dialect\Postgresql();
+
+		$sql = 'INSERT INTO "robots" ("name", "year") VALUES (?, ?), (?, ?)';
+		$this->assertEquals($postgresql->upsert($sql, array('year'), array('name')), $sql . ' ON CONFLICT ("name") DO UPDATE SET "year" = EXCLUDED."year"');
+		$this->assertEquals($postgresql->upsert($sql, array(), array('name')), $sql . ' ON CONFLICT ("name") DO NOTHING');
+		$this->assertEquals($postgresql->upsert($sql, array()), $sql . ' ON CONFLICT DO NOTHING');
+
+		try {
+			$postgresql->upsert($sql, array('year'));
+			$this->assertTrue(false);
+		} catch (Phalcon\Db\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+	}
+
 }
@@ -88,6 +88,57 @@ class DbProfilerTest extends PHPUnit_Framework_TestCase
 		$this->_executeTests($connection);
 	}
 
+	public function testDbNative()
+	{
+
+		$profiler = new Phalcon\Db\Profiler(array(
+			'native' => true,
+			'slowest' => 2
+		));
+
+		foreach (array(3, 100, 5) as $limit) {
+			$profiler->startProfile("SELECT * FROM personas LIMIT " . $limit);
+			usleep(1000);
+			$profiler->stopProfile($limit);
+		}
+
+		$profiler->startProfile("SELECT * FROM personas WHERE nombres = 'LOST' AND cupo IN (1, 2, 3)");
+		$profiler->stopProfile();
+
+		$this->assertEquals($profiler->getNumberTotalStatements(), 4);
+		$this->assertEquals(count($profiler->getProfiles()), 0);
+		$this->assertEquals(gettype($profiler->getTotalElapsedSeconds()), "double");
+
+		$statistics = $profiler->getStatistics();
+		$this->assertEquals(array_keys($statistics), array(
+			"SELECT * FROM personas LIMIT ?",
+			"SELECT * FROM personas WHERE nombres = ? AND cupo IN (?)"
+		));
+
+		$statistic = $statistics["SELECT * FROM personas LIMIT ?"];
+		$this->assertEquals($statistic['count'], 3);
+		$this->assertEquals($statistic['rows'], 108);
+		$this->assertTrue($statistic['min'] >= 0.001);
+		$this->assertTrue($statistic['min'] <= $statistic['p50']);
+		$this->assertTrue($statistic['p50'] <= $statistic['p95']);
+		$this->assertTrue($statistic['p95'] <= $statistic['p99']);
+		$this->assertTrue($statistic['p99'] <= $statistic['max']);
+
+		$slowest = $profiler->getSlowestProfiles();
+		$this->assertEquals(count($slowest), 2);
+		$this->assertTrue($slowest[0]['elapsed'] >= $slowest[1]['elapsed']);
+		$this->assertEquals($slowest[0]['fingerprint'], "SELECT * FROM personas LIMIT ?");
+
+		$export = json_decode($profiler->toJson(), true);
+		$this->assertEquals($export['statements'], 4);
+		$this->assertEquals(count($export['statistics']), 2);
+
+		$profiler->reset();
+
+		$this->assertEquals($profiler->getNumberTotalStatements(), 0);
+		$this->assertEquals($profiler->getStatistics(), array());
+	}
+
 	public function _executeTests($connection)
 	{
 
@@ -87,6 +87,71 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->_executeTests($connection);
 	}
 
+	public function testDbStatementsCache()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		//The cache is disabled unless it is requested
+		$connection = new Phalcon\Db\Adapter\Pdo\Sqlite($configSqlite);
+		$connection->fetchAll("SELECT * FROM personas WHERE estado = ? LIMIT 3", Phalcon\Db::FETCH_ASSOC, array('A'));
+		$stats = $connection->getStatementsCacheStats();
+		$this->assertEquals($stats['size'], 0);
+		$this->assertEquals($stats['count'], 0);
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Sqlite(array_merge($configSqlite, array('statementsCache' => 2)));
+
+		$sql = "SELECT * FROM personas WHERE estado = ? LIMIT 3";
+
+		$rows = $connection->fetchAll($sql, Phalcon\Db::FETCH_ASSOC, array('A'));
+		$this->assertEquals(count($rows), 3);
+
+		$rows = $connection->fetchAll($sql, Phalcon\Db::FETCH_NUM, array('I'));
+		$this->assertEquals(count($rows[0]), 11);
+
+		//The fetch mode of the reused statement is restored
+		$rows = $connection->fetchAll($sql, Phalcon\Db::FETCH_ASSOC, array('A'));
+		$this->assertTrue(isset($rows[0]['cedula']));
+
+		$stats = $connection->getStatementsCacheStats();
+		$this->assertEquals($stats['size'], 2);
+		$this->assertEquals($stats['count'], 1);
+		$this->assertEquals($stats['hits'], 2);
+		$this->assertEquals($stats['misses'], 1);
+
+		//A statement being fetched is not reused
+		$result = $connection->query($sql, array('A'));
+		$other = $connection->query($sql, array('I'));
+		$this->assertEquals($result->numRows(), 3);
+		$this->assertTrue(is_array($other->fetch()));
+
+		$connection->fetchAll("SELECT * FROM personas WHERE estado = ? LIMIT 1", Phalcon\Db::FETCH_ASSOC, array('A'));
+		$connection->fetchAll("SELECT * FROM personas WHERE estado = ? LIMIT 2", Phalcon\Db::FETCH_ASSOC, array('A'));
+
+		$stats = $connection->getStatementsCacheStats();
+		$this->assertEquals($stats['count'], 2);
+		$this->assertTrue($stats['evictions'] > 0);
+
+		//A partially fetched statement left in the cache doesn't lock the schema
+		$connection->execute("CREATE TABLE statements_cache_test (id INTEGER)");
+		$row = $connection->fetchOne("SELECT * FROM personas WHERE estado = ?", Phalcon\Db::FETCH_ASSOC, array('A'));
+		$this->assertTrue(isset($row['cedula']));
+		$this->assertTrue($connection->execute("DROP TABLE statements_cache_test"));
+
+		//Schema changes sent through query() discard the cached statements too
+		$connection->fetchAll($sql, Phalcon\Db::FETCH_ASSOC, array('A'));
+		$connection->query("CREATE TABLE statements_cache_test (id INTEGER)");
+		$stats = $connection->getStatementsCacheStats();
+		$this->assertEquals($stats['count'], 0);
+		$this->assertTrue($connection->execute("DROP TABLE statements_cache_test"));
+
+		//Reconnecting discards the cached statements
+		$connection->fetchAll($sql, Phalcon\Db::FETCH_ASSOC, array('A'));
+		$connection->connect();
+		$stats = $connection->getStatementsCacheStats();
+		$this->assertEquals($stats['count'], 0);
+	}
+
 	protected function _executeTests($connection)
 	{
 
@@ -188,6 +253,22 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->assertTrue($success);
 		$this->assertEquals($connection->affectedRows(), 53);
 
+		$success = $connection->insertMany('prueba', array(
+			array("LOL 1", "A"),
+			array("LOL 4", "E"),
+			array(new Phalcon\Db\RawValue('current_date'), "I")
+		), array('nombre', 'estado'));
+		$this->assertTrue($success);
+
+		$success = $connection->insertMany('prueba', array(
+			array("LOL 2", "A"),
+			array("LOL 3", "E")
+		), array('nombre', 'estado'), null, array('maxParameters' => 2));
+		$this->assertTrue($success);
+
+		$connection->delete("prueba");
+		$this->assertEquals($connection->affectedRows(), 5);
+
 		$row = $connection->fetchOne("SELECT * FROM personas");
 		$this->assertEquals(count($row), 22);
 
@@ -369,5 +369,80 @@ class DiTest extends PHPUnit_Framework_TestCase
 		$di = Phalcon\DI::getDefault();
 		$this->assertInstanceOf('Phalcon\DI', $di);
 	}
+	public function testCompiledDefinitions()
+	{
+
+		$di = new Phalcon\DI();
+		$di->set('response', 'Phalcon\Http\Response');
+		$di->setDefinitions('unit-tests/config/services.php');
+
+		//Compiled services are registered but not created yet
+		$this->assertTrue($di->has('request'));
+		$this->assertTrue($di->has('component'));
+		$this->assertEquals(array_keys($di->getStatistics()), array());
+
+		$this->assertInstanceOf('Phalcon\Http\Request', $di->get('request'));
+
+		$component = $di->get('component');
+		$this->assertInstanceOf('InjectableComponent', $component);
+		$this->assertInstanceOf('Phalcon\Http\Response', $component->getResponse());
+
+		//Shared services are built once
+		$this->assertSame($di->get('component'), $component);
+		$this->assertTrue($di->getService('component')->isShared());
+
+		$statistics = $di->getStatistics();
+		$this->assertEquals(array_keys($statistics), array('request', 'response', 'component'));
+		$this->assertEquals($statistics['component']['instances'], 1);
+		$this->assertTrue($statistics['component']['time'] >= 0);
+
+		//The compiled table is reused by other containers
+		$other = new Phalcon\DI();
+		$other->setDefinitions('unit-tests/config/services.php');
+		$this->assertEquals($other->getRaw('request'), 'Phalcon\Http\Request');
+		$this->assertEquals(count($other->getServices()), 2);
+
+		//Services registered by other means are not replaced
+		$other->set('request', 'Phalcon\Http\Response');
+		$other->remove('component');
+		$this->assertInstanceOf('Phalcon\Http\Response', $other->get('request'));
+		$this->assertFalse($other->has('component'));
+
+		//Successive definitions are added to the compiled ones
+		$other = new Phalcon\DI();
+		$other->setDefinitions('unit-tests/config/services.php');
+		$other->setDefinitions(array('request' => 'Phalcon\Http\Response', 'escaper' => 'Phalcon\Escaper'));
+		$this->assertEquals($other->getRaw('request'), 'Phalcon\Http\Response');
+		$this->assertTrue($other->has('component'));
+		$this->assertTrue($other->has('escaper'));
+
+		//A services file that changes is compiled again
+		$servicesPath = 'unit-tests/cache/services.php';
+		file_put_contents($servicesPath, "<?php return array('escaper' => 'Phalcon\\Escaper');");
+
+		$other = new Phalcon\DI();
+		$other->setDefinitions($servicesPath);
+		$this->assertTrue($other->has('escaper'));
+
+		file_put_contents($servicesPath, "<?php return array('filter' => 'Phalcon\\Filter');");
+		touch($servicesPath, time() + 10);
+
+		$other = new Phalcon\DI();
+		$other->setDefinitions($servicesPath);
+		$this->assertTrue($other->has('filter'));
+		$this->assertFalse($other->has('escaper'));
+
+		unlink($servicesPath);
+
+		try {
+			$di->setDefinitions(array('closure' => function(){
+				return new SimpleComponent();
+			}));
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\DI\Exception $e) {
+			$this->assertEquals($e->getMessage(), "The service 'closure' cannot be compiled, only class names and array definitions are allowed");
+		}
+	}
 
 }
\ No newline at end of file
@@ -167,4 +167,51 @@ class DispatcherMvcTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testDispatcherResolutionCache()
+	{
+
+		Phalcon\DI::reset();
+
+		$di = new Phalcon\DI();
+
+		$di->set('response', new \Phalcon\Http\Response());
+
+		$dispatcher = new Phalcon\Mvc\Dispatcher();
+		$dispatcher->setDI($di);
+
+		$di->set('dispatcher', $dispatcher);
+
+		for ($i = 0; $i < 2; $i++) {
+			$dispatcher->setControllerName('test2');
+			$dispatcher->setActionName('another');
+			$dispatcher->setParams(array());
+			$dispatcher->dispatch();
+			$this->assertEquals($dispatcher->getReturnedValue(), 100);
+		}
+
+		//The services container replaces the handler, its methods are checked again
+		$di = new Phalcon\DI();
+
+		$di->set('response', new \Phalcon\Http\Response());
+		$di->set('dispatcher', $dispatcher);
+		$di->set('Test2Controller', function() {
+			return new Test7Controller();
+		});
+
+		$dispatcher->setDI($di);
+
+		$dispatcher->setControllerName('test2');
+		$dispatcher->setActionName('another');
+		$dispatcher->setParams(array());
+
+		try {
+			$dispatcher->dispatch();
+			$this->assertTrue(FALSE, 'oh, Why?');
+		}
+		catch(Phalcon\Exception $e){
+			$this->assertEquals($e->getMessage(), "Action 'another' was not found on handler 'test2'");
+		}
+
+	}
+
 }
@@ -0,0 +1,53 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class EscaperTest extends PHPUnit_Framework_TestCase
+{
+
+	public function testEscaper()
+	{
+
+		$escaper = new Phalcon\Escaper();
+
+		$this->assertEquals($escaper->escapeCss("font-family: <Verdana>"), 'font\2d family\3a \20 \3c Verdana\3e ');
+		$this->assertEquals($escaper->escapeJs("alert('hello')"), 'alert(\x27hello\x27)');
+		$this->assertEquals($escaper->escapeHtmlAttr('"><h1>Hello</table'), '&#x22;&#x3e;&#x3c;h1&#x3e;Hello&#x3c;/table');
+
+		//Strings without characters to escape are returned as they are
+		$plain = str_repeat('abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789', 4);
+		$this->assertEquals($escaper->escapeCss($plain), $plain);
+		$this->assertEquals($escaper->escapeJs($plain . ' (x, y);'), $plain . ' (x, y);');
+		$this->assertEquals($escaper->escapeHtmlAttr($plain), $plain);
+
+		//A character to escape after a long alphanumeric run
+		$this->assertEquals($escaper->escapeJs($plain . '@'), $plain . '\x40');
+
+		//Multi-byte UTF-8 characters
+		$this->assertEquals($escaper->escapeCss("\xc3\xa9"), '\e9 ');
+		$this->assertEquals($escaper->escapeJs("\xe6\x97\xa5\xe6\x9c\xac"), '\x65e5\x672c');
+		$this->assertEquals($escaper->escapeHtmlAttr("\xf0\x9f\x98\x80"), '&#x1f600;');
+
+		//Character zero
+		$this->assertFalse($escaper->escapeCss("a\0b"));
+
+		$this->assertNull($escaper->escapeJs(''));
+	}
+
+}
@@ -170,4 +170,26 @@ class EventsTest extends PHPUnit_Framework_TestCase
 
 		$this->assertEquals($number, 1);
 	}
+
+	public function testEventsPriorities()
+	{
+
+		$eventsManager = new Phalcon\Events\Manager();
+		$eventsManager->enablePriorities(true);
+		$eventsManager->collectResponses(true);
+
+		$eventsManager->attach('some-type', function() { return 'low'; }, 50);
+		$eventsManager->attach('some-type', function() { return 'high'; }, 150);
+		$eventsManager->attach('some-type', function() { return 'default'; });
+		$eventsManager->attach('some-type', function() { return 'default-second'; });
+
+		$this->assertEquals($eventsManager->fire('some-type:beforeSome', $this), 'low');
+		$this->assertEquals($eventsManager->getResponses(), array('high', 'default', 'default-second', 'low'));
+
+		$this->assertNull($eventsManager->fire('other-type:beforeSome', $this));
+
+		$eventsManager->dettachAll('some-type');
+		$this->assertNull($eventsManager->fire('some-type:beforeSome', $this));
+
+	}
 }
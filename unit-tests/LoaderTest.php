@@ -215,4 +215,104 @@ class LoaderTest extends PHPUnit_Framework_TestCase
 
 	}
 
-}
\ No newline at end of file
+	public function testClassMap()
+	{
+
+		@unlink('unit-tests/cache/classmap.php');
+
+		$loader = new Phalcon\Loader();
+
+		$loader->registerNamespaces(array(
+			"Example\Engines" => "unit-tests/vendor/example/Engines/"
+		));
+
+		$loader->registerDirs(array(
+			"unit-tests/vendor/example/base"
+		));
+
+		$loader->setClassMapFile('unit-tests/cache/classmap.php');
+
+		$loader->register();
+
+		$leEngine = new Example\Engines\LeEngine();
+		$this->assertEquals(get_class($leEngine), 'Example\Engines\LeEngine');
+
+		$any = new Any();
+		$this->assertEquals(get_class($any), 'Any');
+
+		$this->assertFalse(class_exists('Example\Engines\LeMissingEngine'));
+
+		$this->assertTrue(file_exists('unit-tests/cache/classmap.php'));
+
+		$this->assertEquals($loader->getStats(), array(
+			'hits' => 2,
+			'misses' => 1,
+			'stats' => 1
+		));
+
+		$classMap = $loader->getClassMap();
+		$this->assertEquals($classMap['Example\Engines\LeEngine'], 'unit-tests/vendor/example/Engines/LeEngine.php');
+		$this->assertEquals($classMap['Any'], 'unit-tests/vendor/example/base/Any.php');
+		$this->assertFalse(isset($classMap['Example\Engines\LeOtherEngine']));
+
+		$loader->unregister();
+
+		/** The class map is read from the file checking the directories scanned */
+		$otherLoader = new Phalcon\Loader();
+
+		$otherLoader->setClassMapFile('unit-tests/cache/classmap.php', Phalcon\Loader::CLASSMAP_CHECK_MTIME);
+
+		$this->assertEquals($otherLoader->getClassMap(), $classMap);
+		$this->assertFalse($otherLoader->autoLoad('Example\Engines\LeMissingEngine'));
+
+		$this->assertEquals($otherLoader->getStats(), array(
+			'hits' => 0,
+			'misses' => 1,
+			'stats' => 3
+		));
+
+	}
+
+	public function testClassMapSymlinks()
+	{
+
+		if (!function_exists('symlink')) {
+			$this->markTestSkipped('symlink() is not available');
+			return;
+		}
+
+		$directory = 'unit-tests/cache/classmap-links/';
+		@unlink($directory . 'loop');
+		@unlink($directory . 'Linked.php');
+		@rmdir($directory);
+		@unlink('unit-tests/cache/classmap-links.php');
+
+		mkdir($directory);
+		file_put_contents($directory . 'Linked.php', '<?php class Linked {}');
+		if (!@symlink(realpath($directory), $directory . 'loop')) {
+			$this->markTestSkipped('Symbolic links cannot be created');
+			return;
+		}
+
+		$loader = new Phalcon\Loader();
+
+		$loader->registerDirs(array($directory));
+
+		$loader->setClassMapFile('unit-tests/cache/classmap-links.php');
+
+		/** The link back to the directory is not scanned again */
+		$classMap = $loader->buildClassMap();
+		$this->assertEquals($classMap['Linked'], $directory . 'Linked.php');
+
+		/** The file is renamed into place, no temporary file is left behind */
+		$data = require 'unit-tests/cache/classmap-links.php';
+		$this->assertEquals($data['classes'], $classMap);
+		$this->assertEquals(glob('unit-tests/cache/classmap-links.php.*'), array());
+
+		unlink($directory . 'loop');
+		unlink($directory . 'Linked.php');
+		rmdir($directory);
+
+	}
+
+}
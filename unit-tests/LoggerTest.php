@@ -0,0 +1,151 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class ResizedFileLogger extends Phalcon\Logger\Adapter\File
+{
+
+	public function resize($size)
+	{
+		$this->_bufferSize = $size;
+	}
+
+}
+
+class LoggerTest extends PHPUnit_Framework_TestCase
+{
+
+	public function testLoggerFormatterLine()
+	{
+
+		$formatter = new Phalcon\Logger\Formatter\Line('%type%|%message%|%date%|100%');
+		$formatter->setDateFormat('Y');
+
+		$time = mktime(0, 0, 0, 1, 1, 2013);
+		$this->assertEquals($formatter->format('hello', Phalcon\Logger::ERROR, $time), 'ERROR|hello|2013|100%' . PHP_EOL);
+		$this->assertEquals($formatter->format('again', Phalcon\Logger::INFO, $time), 'INFO|again|2013|100%' . PHP_EOL);
+
+		//Changing the date format discards the cached date
+		$formatter->setDateFormat('m');
+		$this->assertEquals($formatter->format('hello', Phalcon\Logger::ERROR, $time), 'ERROR|hello|01|100%' . PHP_EOL);
+	}
+
+	public function testLoggerBuffer()
+	{
+
+		$path = 'unit-tests/logs/buffer.log';
+		@unlink($path);
+
+		$logger = new Phalcon\Logger\Adapter\File($path, array(
+			'buffer' => 1024,
+			'flushLevel' => Phalcon\Logger::ERROR
+		));
+		$logger->setFormatter(new Phalcon\Logger\Formatter\Line('%message%'));
+
+		//Messages are kept in memory until the buffer is flushed
+		$logger->info('first');
+		$logger->debug('second');
+		clearstatcache();
+		$this->assertEquals(filesize($path), 0);
+
+		$this->assertTrue($logger->flush());
+		$this->assertEquals(file_get_contents($path), 'first' . PHP_EOL . 'second' . PHP_EOL);
+
+		//Severe messages flush the buffer at once
+		$logger->notice('third');
+		$logger->error('fourth');
+		$this->assertEquals(file_get_contents($path), 'first' . PHP_EOL . 'second' . PHP_EOL . 'third' . PHP_EOL . 'fourth' . PHP_EOL);
+
+		//A full buffer is written
+		$logger->info(str_repeat('a', 1000));
+		$logger->info(str_repeat('b', 1000));
+		$this->assertEquals(strlen(file_get_contents($path)), 22 + 1000 + 5 * strlen(PHP_EOL));
+
+		//Closing the logger writes the remaining messages
+		$logger->close();
+		$this->assertEquals(strlen(file_get_contents($path)), 22 + 2000 + 6 * strlen(PHP_EOL));
+
+		@unlink($path);
+	}
+
+	public function testLoggerBufferDestruct()
+	{
+
+		$path = 'unit-tests/logs/buffer.log';
+		@unlink($path);
+
+		$logger = new Phalcon\Logger\Adapter\File($path, array('buffer' => 1024));
+		$logger->setFormatter(new Phalcon\Logger\Formatter\Line('%message%'));
+		$logger->info('pending');
+		unset($logger);
+
+		$this->assertEquals(file_get_contents($path), 'pending' . PHP_EOL);
+
+		@unlink($path);
+	}
+
+	public function testLoggerBufferShutdown()
+	{
+
+		$path = 'unit-tests/logs/buffer.log';
+		@unlink($path);
+
+		$logger = new Phalcon\Logger\Adapter\File($path, array('buffer' => 1024));
+		$logger->setFormatter(new Phalcon\Logger\Formatter\Line('%message%'));
+		$logger->info('pending');
+
+		//Registered as shutdown function, it runs even after a fatal error
+		Phalcon\Logger\Adapter::flushBuffers();
+		$this->assertEquals(file_get_contents($path), 'pending' . PHP_EOL);
+
+		//Clones don't write again the messages pending in the original adapter
+		$logger->info('original');
+		$clone = clone $logger;
+		$clone->info('clone');
+		$clone->flush();
+		$logger->flush();
+		$this->assertEquals(file_get_contents($path), 'pending' . PHP_EOL . 'clone' . PHP_EOL . 'original' . PHP_EOL);
+
+		$logger->close();
+
+		@unlink($path);
+	}
+
+	public function testLoggerBufferResized()
+	{
+
+		$path = 'unit-tests/logs/buffer.log';
+		@unlink($path);
+
+		$logger = new ResizedFileLogger($path, array('buffer' => 16));
+		$logger->setFormatter(new Phalcon\Logger\Formatter\Line('%message%'));
+		$logger->info('first');
+
+		//A larger buffer size set by a subclass allocates a new buffer
+		$logger->resize(4096);
+		$logger->info(str_repeat('a', 2000));
+		$this->assertEquals(file_get_contents($path), 'first' . PHP_EOL);
+
+		$logger->close();
+		$this->assertEquals(strlen(file_get_contents($path)), 2005 + 2 * strlen(PHP_EOL));
+
+		@unlink($path);
+	}
+
+}
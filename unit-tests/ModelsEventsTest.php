@@ -116,6 +116,49 @@ class ModelsEventsTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testEventsSaveMany()
+	{
+
+		$trace = array();
+
+		$this->_prepareDI($trace);
+
+		$robot = new GossipRobots();
+
+		$robot->name = 'Test';
+		$robot->year = 2000;
+		$robot->type = 'Some Type';
+
+		$robot->trace = &$trace;
+
+		$this->assertFalse(GossipRobots::saveMany(array($robot)));
+
+		$this->assertEquals($trace, array(
+			'beforeValidation' => array(
+				'GossipRobots' => 2,
+			),
+			'beforeValidationOnCreate' => array(
+				'GossipRobots' => 1,
+			),
+			'validation' => array(
+				'GossipRobots' => 2,
+			),
+			'afterValidationOnCreate' => array(
+				'GossipRobots' => 1,
+			),
+			'afterValidation' => array(
+				'GossipRobots' => 2,
+			),
+			'beforeSave' => array(
+				'GossipRobots' => 2,
+			),
+			'beforeCreate' => array(
+				'GossipRobots' => 1,
+			)
+		));
+
+	}
+
 	public function testEventsUpdate()
 	{
 
@@ -197,6 +197,64 @@ class ModelsMetadataAdaptersTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testMetadataShm()
+	{
+
+		$stats = Phalcon\Mvc\Model\Metadata\Shm::getStats();
+		if (!$stats['size']) {
+			$this->markTestSkipped('the shared segment is not available');
+			return false;
+		}
+
+		$di = $this->_getDI();
+
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Shm(array(
+				'prefix' => 'my-local-app'
+			));
+		});
+
+		$metaData = $di->getShared('modelsMetadata');
+
+		$metaData->reset();
+
+		$this->assertTrue($metaData->isEmpty());
+
+		$initialStats = $metaData->getStats();
+
+		Robots::findFirst();
+
+		$stats = $metaData->getStats();
+		$this->assertEquals($stats['count'], $initialStats['count'] + 2);
+
+		//Another application sharing the segment
+		$foreignMetaData = new Phalcon\Mvc\Model\Metadata\Shm(array(
+			'prefix' => 'my-other-app'
+		));
+		$foreignMetaData->write('meta-robots-robots', $this->_data['meta-robots-robots']);
+
+		$otherMetaData = new Phalcon\Mvc\Model\Metadata\Shm(array(
+			'prefix' => 'my-local-app'
+		));
+		$this->assertEquals($otherMetaData->read('meta-robots-robots'), $this->_data['meta-robots-robots']);
+		$this->assertEquals($otherMetaData->read('map-robots'), $this->_data['map-robots']);
+
+		$this->assertFalse($metaData->isEmpty());
+
+		Robots::findFirst();
+
+		$otherMetaData->reset();
+
+		$newStats = $metaData->getStats();
+		$this->assertEquals($newStats['generation'], $stats['generation']);
+		$this->assertEquals($otherMetaData->read('meta-robots-robots'), null);
+		$this->assertEquals($otherMetaData->read('map-robots'), null);
+
+		//Resetting an application keeps the meta-data of the others
+		$this->assertEquals($foreignMetaData->read('meta-robots-robots'), $this->_data['meta-robots-robots']);
+
+	}
+
 	public function testMetadataFiles()
 	{
 
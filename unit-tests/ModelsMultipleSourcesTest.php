@@ -96,4 +96,72 @@ class ModelsMultipleSourcesTest extends PHPUnit_Framework_TestCase
 		$this->assertFalse($robot->save());
 	}
 
+	public function testReadConnectionPool()
+	{
+		require 'unit-tests/config.db.php';
+
+		$di = new Phalcon\DI();
+
+		foreach (array('db', 'dbReplicaOne', 'dbReplicaTwo') as $service) {
+			$di->set($service, function() use ($configSqlite) {
+				return new Phalcon\Db\Adapter\Pdo\Sqlite($configSqlite);
+			}, true);
+		}
+
+		$di->set('dbReplicaDown', function() {
+			throw new Exception('The replica is down');
+		}, true);
+
+		$manager = new Phalcon\Mvc\Model\Manager();
+		$manager->setDI($di);
+
+		$model = new stdClass();
+
+		//Replicas that cannot be resolved are skipped whatever their weight
+		$manager->setReadConnectionService($model, array('dbReplicaOne' => 1, 'dbReplicaDown' => 1000));
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('dbReplicaOne'));
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('dbReplicaOne'));
+		$this->assertEquals($manager->getReadConnectionService($model), array('dbReplicaOne' => 1, 'dbReplicaDown' => 1000));
+
+		//Replicas lagging behind are skipped
+		$manager->resetReadConnections();
+		$manager->setReadConnectionService($model, array('dbReplicaOne', 'dbReplicaTwo'));
+		$manager->setReadConnectionOptions(array(
+			'maxLag' => 5,
+			'healthCheck' => function($connection, $service) {
+				return $service == 'dbReplicaOne' ? 10 : 1;
+			}
+		));
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('dbReplicaTwo'));
+
+		//The primary is used if no replica is left
+		$manager->resetReadConnections();
+		$manager->setReadConnectionOptions(array(
+			'healthCheck' => function($connection, $service) {
+				return false;
+			}
+		));
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('db'));
+
+		//A single replica is checked as well, servers that are not replicas have no lag
+		$manager->resetReadConnections();
+		$manager->setReadConnectionService($model, 'dbReplicaOne');
+		$manager->setReadConnectionOptions(array('maxLag' => 5));
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('dbReplicaOne'));
+
+		//Reads stick to the primary after a write
+		$manager->getWriteConnection($model);
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('db'));
+
+		//Unless that is disabled, then they only stick to it during transactions
+		$manager->resetReadConnections();
+		$manager->setReadConnectionOptions(array('sticky' => false));
+		$connection = $manager->getWriteConnection($model);
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('dbReplicaOne'));
+
+		$connection->begin();
+		$this->assertSame($manager->getReadConnection($model), $di->getShared('db'));
+		$connection->rollback();
+	}
+
 }
\ No newline at end of file
@@ -7851,4 +7851,53 @@ class ModelsQueryParsingTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($query->parse(), $expected);
 	}
 
+	public function testIntermediateCache()
+	{
+
+		$di = $this->_getDI();
+
+		Query::clearIntermediateCache();
+
+		$stats = Query::getIntermediateCacheStats();
+		if (!$stats['size']) {
+			$this->markTestSkipped('phalcon.orm.ir_cache_size is disabled');
+			return;
+		}
+
+		$this->assertEquals($stats['count'], 0);
+
+		$query = new Query('SELECT * FROM Robots WHERE id > 100');
+		$query->setDI($di);
+		$expected = $query->parse();
+
+		$stats = Query::getIntermediateCacheStats();
+		$this->assertEquals($stats['count'], 1);
+
+		$query = new Query('SELECT * FROM Robots WHERE id > 100');
+		$query->setDI($di);
+		$this->assertEquals($query->parse(), $expected);
+		$this->assertEquals($query->getType(), Query::TYPE_SELECT);
+
+		$newStats = Query::getIntermediateCacheStats();
+		$this->assertEquals($newStats['hits'], $stats['hits'] + 1);
+
+		//Another meta-data storage doesn't reuse the entry
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Files(array('metaDataDir' => 'unit-tests/cache/'));
+		});
+
+		$query = new Query('SELECT * FROM Robots WHERE id > 100');
+		$query->setDI($di);
+		$this->assertEquals($query->parse(), $expected);
+
+		$stats = Query::getIntermediateCacheStats();
+		$this->assertEquals($stats['count'], 2);
+		$this->assertEquals($stats['hits'], $newStats['hits']);
+
+		$di->getShared('modelsMetadata')->reset();
+
+		$stats = Query::getIntermediateCacheStats();
+		$this->assertEquals($stats['count'], 0);
+	}
+
 }
\ No newline at end of file
@@ -171,6 +171,65 @@ class ModelsRelationsTest extends PHPUnit_Framework_TestCase
 		$part = $robotPart->getParts();
 		$this->assertEquals(get_class($part), 'Parts');
 
+		/** Eager loading */
+		$robots = Robots::find(array("order" => "id", "with" => "robotsParts.parts"));
+		$this->assertEquals(get_class($robots), 'Phalcon\Mvc\Model\Resultset\Simple');
+
+		$robot = $robots->getFirst();
+		$robotsParts = $robot->robotsParts;
+		$this->assertEquals(get_class($robotsParts), 'Phalcon\Mvc\Model\Resultset\Simple');
+		$this->assertEquals(count($robotsParts), 3);
+		foreach ($robotsParts as $robotPart) {
+			$this->assertEquals($robotPart->robots_id, $robot->id);
+			$this->assertEquals(get_class($robotPart->parts), 'Parts');
+			$this->assertEquals($robotPart->parts->id, $robotPart->parts_id);
+		}
+
+		$robots = Robots::find("id > 1")->load(array("robotsParts"));
+		foreach ($robots as $robot) {
+			$this->assertEquals(count($robot->getRobotsParts()), $robot->countRobotsParts());
+		}
+
+		/** Saving a related record discards the records loaded in advance */
+		$robots = Robots::find(array("order" => "id", "with" => "robotsParts.parts"));
+		$robotPart = $robots->getFirst()->robotsParts->getFirst();
+
+		$part = Parts::findFirst($robotPart->parts_id);
+		$name = $part->name;
+		$part->name = 'Preloaded';
+		$this->assertTrue($part->save());
+
+		$this->assertEquals($robotPart->getParts()->name, 'Preloaded');
+
+		$part->name = $name;
+		$this->assertTrue($part->save());
+
+		/** Large sets of records are preloaded in several queries */
+		$records = array();
+		for ($i = 1; $i <= 1200; $i++) {
+			$robot = new Robots();
+			$robot->id = $i;
+			$records[] = $robot;
+		}
+
+		$manager->preloadRelations('Robots', $records, 'robotsParts');
+		$this->assertEquals(count($records[0]->robotsParts), $records[0]->countRobotsParts());
+		$this->assertEquals(count($records[1199]->robotsParts), 0);
+
+		/** Relations through an intermediate model cannot be preloaded */
+		$manager->addHasMany(new Robots(), 'id', 'Parts', 'id', array(
+			'alias' => 'throughParts',
+			'through' => 'RobotsParts'
+		));
+
+		try {
+			$manager->preloadRelations('Robots', Robots::find(), 'throughParts');
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertEquals($e->getMessage(), 'The relation "throughParts" of the model "Robots" uses an intermediate model and cannot be preloaded');
+		}
+
 		/** Relations in namespaced models */
 		$robot = Some\Robots::findFirst();
 		$this->assertNotEquals($robot, false);
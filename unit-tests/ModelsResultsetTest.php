@@ -113,6 +113,64 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 		$this->_applyTests($robots);
 	}
 
+	public function testResultsetStreamingMysql()
+	{
+		$this->_prepareTestMysql();
+		$this->_applyTestsStreaming();
+	}
+
+	public function testResultsetStreamingSqlite()
+	{
+		$this->_prepareTestSqlite();
+		$this->_applyTestsStreaming();
+	}
+
+	public function _applyTestsStreaming()
+	{
+		$robots = Robots::find(array(
+			'order' => 'id',
+			'stream' => true
+		));
+
+		$this->assertEquals($robots->getType(), Phalcon\Mvc\Model\Resultset::TYPE_RESULT_STREAM);
+
+		$number = 0;
+		$previous = null;
+		foreach ($robots as $robot) {
+			$number++;
+			$this->assertEquals($robot->id, $number);
+			if ($previous !== null) {
+				$this->assertSame($robot, $previous);
+			}
+			$previous = $robot;
+		}
+		$this->assertEquals($number, 3);
+
+		try {
+			$robots->rewind();
+			$this->assertFalse(true);
+		}
+		catch(Exception $e){
+			$this->assertEquals($e->getMessage(), 'Streaming resultsets are forward-only and cannot be rewound');
+		}
+
+		try {
+			count($robots);
+			$this->assertFalse(true);
+		}
+		catch(Exception $e){
+			$this->assertEquals($e->getMessage(), 'The number of rows in a streaming resultset is unknown, use a COUNT query instead');
+		}
+
+		$robots = Robots::find(array('stream' => true, 'hydration' => Phalcon\Mvc\Model\Resultset::HYDRATE_ARRAYS));
+		$number = 0;
+		foreach ($robots as $robot) {
+			$this->assertTrue(is_array($robot));
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+	}
+
 	public function testResultsetNormalPostgresql()
 	{
 		$this->_prepareTestPostgresql();
@@ -323,6 +323,66 @@ class ModelsTest extends PHPUnit_Framework_TestCase
 		$this->assertTrue($persona->delete());
 		$this->assertEquals($before - 1, People::count());
 
+		//Bulk create, one statement per record
+		$persona = new Personas($di);
+		$persona->cedula = 'CELL' . mt_rand(0, 999999);
+		$persona->tipo_documento_id = 1;
+		$persona->nombres = 'LOST BULK';
+		$persona->telefono = '1';
+		$persona->cupo = 21000;
+		$persona->estado = 'A';
+
+		$before = People::count();
+		$this->assertTrue(Personas::saveMany(array(
+			$persona,
+			array(
+				'cedula' => 'CELL' . mt_rand(0, 999999),
+				'tipo_documento_id' => 1,
+				'nombres' => 'LOST BULK',
+				'telefono' => '1',
+				'cupo' => 21000,
+				'estado' => 'A'
+			)
+		), array('maxPacketSize' => 1)));
+		$this->assertEquals($before + 2, People::count());
+
+		//A failed bulk create rolls back the rows already inserted
+		$cedula = 'CELL' . mt_rand(0, 999999);
+		$row = array(
+			'cedula' => $cedula,
+			'tipo_documento_id' => 1,
+			'nombres' => 'LOST BULK',
+			'telefono' => '1',
+			'cupo' => 21000,
+			'estado' => 'A'
+		);
+
+		$before = People::count();
+		try {
+			Personas::saveMany(array($row, $row), array('maxPacketSize' => 1));
+			$this->assertTrue(false);
+		}
+		catch (PDOException $e) {
+			$this->assertTrue(true);
+		}
+		$this->assertFalse($persona->getWriteConnection()->isUnderTransaction());
+		$this->assertEquals($before, People::count());
+
+		//A failed bulk create leaves the transaction of the caller open
+		$connection = $persona->getWriteConnection();
+		$connection->begin();
+		try {
+			Personas::saveMany(array($row, $row), array('maxPacketSize' => 1));
+			$this->assertTrue(false);
+		}
+		catch (PDOException $e) {
+			$this->assertTrue(true);
+		}
+		$this->assertTrue($connection->isUnderTransaction());
+		$connection->rollback();
+		$this->assertFalse($connection->isUnderTransaction());
+		$this->assertEquals($before, People::count());
+
 		//Assign
 		$persona = new Personas();
 
@@ -0,0 +1,165 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2013 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class QueueBeanstalkTest extends PHPUnit_Framework_TestCase
+{
+
+	/**
+	 * Listens on a free local port, the test plays the role of beanstalkd writing the replies
+	 * before the client reads them
+	 */
+	protected function _listen()
+	{
+		$server = stream_socket_server('tcp://127.0.0.1:0', $errno, $errstr);
+		if (!$server) {
+			$this->markTestSkipped('Cannot listen on 127.0.0.1: ' . $errstr);
+			return false;
+		}
+		return $server;
+	}
+
+	protected function _getQueue($server, $codec)
+	{
+		$name = stream_socket_get_name($server, false);
+
+		$queue = new Phalcon\Queue\Beanstalk(array(
+			'host' => '127.0.0.1',
+			'port' => substr($name, strrpos($name, ':') + 1),
+			'codec' => $codec
+		));
+
+		$queue->connect();
+
+		return $queue;
+	}
+
+	protected function _received($connection)
+	{
+		stream_set_blocking($connection, 0);
+		$data = '';
+		while (strlen($chunk = fread($connection, 65536))) {
+			$data .= $chunk;
+		}
+		stream_set_blocking($connection, 1);
+		return $data;
+	}
+
+	public function testBatches()
+	{
+
+		$server = $this->_listen();
+		$queue = $this->_getQueue($server, 'json');
+		$connection = stream_socket_accept($server);
+
+		$jobs = array();
+		$replies = '';
+		for ($i = 0; $i < 25; $i++) {
+			$jobs['job-' . $i] = array('number' => $i);
+			$replies .= ($i == 3 ? 'BURIED ' : 'INSERTED ') . ($i + 1) . "\r\n";
+		}
+		$replies = str_replace("INSERTED 6\r\n", "JOB_TOO_BIG\r\n", $replies);
+		fwrite($connection, $replies);
+
+		$ids = $queue->putMany($jobs, array('batch' => 10));
+		$this->assertEquals(array_keys($ids), array_keys($jobs));
+		$this->assertEquals($ids['job-0'], 1);
+		$this->assertEquals($ids['job-3'], 4);
+		$this->assertFalse($ids['job-5']);
+		$this->assertEquals($ids['job-24'], 25);
+
+		$sent = $this->_received($connection);
+		$this->assertEquals(substr_count($sent, 'put 100 0 86400 '), 25);
+		$this->assertEquals(substr($sent, 0, 34), "put 100 0 86400 12\r\n{\"number\":0}\r\n");
+
+		//The reservations after the first one are pipelined in the same write
+		fwrite($connection, "RESERVED 7 12\r\n{\"number\":7}\r\nRESERVED 8 12\r\n{\"number\":8}\r\nTIMED_OUT\r\n");
+
+		$reserved = $queue->reserveMany(3, 1);
+		$this->assertEquals($this->_received($connection), "reserve-with-timeout 1\r\nreserve-with-timeout 0\r\nreserve-with-timeout 0\r\n");
+		$this->assertEquals(count($reserved), 2);
+		$this->assertEquals(get_class($reserved[0]), 'Phalcon\Queue\Beanstalk\Job');
+		$this->assertEquals($reserved[0]->getId(), 7);
+		$this->assertEquals($reserved[0]->getBody(), array('number' => 7));
+		$this->assertEquals($reserved[1]->getBody(), array('number' => 8));
+
+		fwrite($connection, "DELETED\r\nDELETED\r\nNOT_FOUND\r\n");
+
+		$this->assertEquals($queue->deleteMany(array($reserved[0], $reserved[1], 9)), 2);
+		$this->assertEquals($this->_received($connection), "delete 7\r\ndelete 8\r\ndelete 9\r\n");
+
+		$this->assertEquals($queue->reserveMany(0), array());
+
+		//The server sees the connection closed
+		$this->assertTrue($queue->disconnect());
+		$this->assertFalse($queue->disconnect());
+		$this->assertEquals(fread($connection, 1024), '');
+		$this->assertTrue(feof($connection));
+
+		fclose($connection);
+		fclose($server);
+	}
+
+	public function testCodecs()
+	{
+
+		$server = $this->_listen();
+		$queue = $this->_getQueue($server, 'raw');
+		$connection = stream_socket_accept($server);
+
+		fwrite($connection, "INSERTED 5\r\n");
+
+		$id = $queue->put("some\r\nraw body\r\n");
+		$this->assertEquals($id, 5);
+		$this->assertEquals($this->_received($connection), "put 100 0 86400 16\r\nsome\r\nraw body\r\n\r\n");
+
+		fwrite($connection, "RESERVED 5 16\r\nsome\r\nraw body\r\n\r\nDELETED\r\n");
+
+		$job = $queue->reserve(1);
+		$this->assertEquals($job->getBody(), "some\r\nraw body\r\n");
+		$this->assertTrue($job->delete());
+		$this->assertEquals($this->_received($connection), "reserve-with-timeout 1\r\ndelete 5\r\n");
+
+		$queue->setCodec(array('strrev', 'strrev'));
+		$this->assertEquals($queue->getCodec(), array('strrev', 'strrev'));
+
+		fwrite($connection, "INSERTED 6\r\nINSERTED 7\r\nRESERVED 6 3\r\ncba\r\nRESERVED 7 3\r\nfed\r\nDELETED\r\nDELETED\r\n");
+
+		$queue->putMany(array('abc', 'def'));
+		$this->assertEquals($this->_received($connection), "put 100 0 86400 3\r\ncba\r\nput 100 0 86400 3\r\nfed\r\n");
+
+		$jobs = $queue->reserveMany(2, 1);
+		$this->assertEquals($jobs[0]->getBody(), 'abc');
+		$this->assertEquals($jobs[1]->getBody(), 'def');
+		$this->assertEquals($queue->deleteMany($jobs), 2);
+
+		try {
+			$queue->setCodec('unknown');
+			$this->assertTrue(false);
+		} catch (Phalcon\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		$queue->disconnect();
+
+		fclose($connection);
+		fclose($server);
+	}
+
+}
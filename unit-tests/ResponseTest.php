@@ -191,4 +191,210 @@ class ResponseTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testStreamContent()
+	{
+
+		$response = new Phalcon\Http\Response();
+		$response->setStreamContent(array('a', 'b', 'c'), false);
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), 'abc');
+
+		$response = new Phalcon\Http\Response();
+		$response->setStreamContent(function($response) {
+			echo 'a';
+			return new ArrayIterator(array('b', 'c'));
+		});
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), 'abc');
+
+	}
+
+	public function testSendFileRange()
+	{
+
+		$path = tempnam(sys_get_temp_dir(), 'phalcon');
+		file_put_contents($path, '0123456789');
+
+		$response = new Phalcon\Http\Response();
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '0123456789');
+		$this->assertEquals($response->getHeaders()->get('Content-Length'), 10);
+
+		$_SERVER['HTTP_RANGE'] = 'bytes=2-5';
+
+		$response = new Phalcon\Http\Response();
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '2345');
+		$this->assertEquals($response->getHeaders()->get('Status'), '206 Partial Content');
+		$this->assertEquals($response->getHeaders()->get('Content-Range'), 'bytes 2-5/10');
+
+		$_SERVER['HTTP_RANGE'] = 'bytes=20-';
+
+		$response = new Phalcon\Http\Response();
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '');
+		$this->assertEquals($response->getHeaders()->get('Status'), '416 Requested Range Not Satisfiable');
+		$this->assertEquals($response->getHeaders()->get('Content-Range'), 'bytes */10');
+
+		$_SERVER['HTTP_RANGE'] = 'bytes=2-5';
+		$_SERVER['REQUEST_METHOD'] = 'POST';
+
+		$response = new Phalcon\Http\Response();
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '0123456789');
+		$this->assertEquals($response->getHeaders()->get('Status'), false);
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$_SERVER['HTTP_IF_RANGE'] = '"other"';
+
+		$response = new Phalcon\Http\Response();
+		$response->setEtag('"numbers"');
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '0123456789');
+		$this->assertEquals($response->getHeaders()->get('Content-Length'), 10);
+
+		$_SERVER['HTTP_IF_RANGE'] = '"numbers"';
+
+		$response = new Phalcon\Http\Response();
+		$response->setEtag('"numbers"');
+		$response->setFileToSend($path, 'numbers.txt');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '2345');
+		$this->assertEquals($response->getHeaders()->get('Status'), '206 Partial Content');
+
+		unset($_SERVER['HTTP_RANGE'], $_SERVER['HTTP_IF_RANGE'], $_SERVER['REQUEST_METHOD']);
+		unlink($path);
+
+	}
+
+	public function testCheckNotModified()
+	{
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$_SERVER['HTTP_IF_NONE_MATCH'] = 'W/"v1", "v2"';
+
+		$response = new Phalcon\Http\Response();
+		$response->setContent('Hello');
+		$this->assertTrue($response->checkNotModified('v2'));
+		$this->assertTrue($response->isNotModified());
+		$this->assertEquals($response->getContent(), '');
+		$this->assertEquals($response->getHeaders()->get('Etag'), '"v2"');
+		$this->assertEquals($response->getHeaders()->get('Status'), '304 Not modified');
+
+		$response = new Phalcon\Http\Response();
+		$this->assertFalse($response->checkNotModified('v3'));
+		$this->assertFalse($response->isNotModified());
+
+		unset($_SERVER['HTTP_IF_NONE_MATCH']);
+		$_SERVER['HTTP_IF_MODIFIED_SINCE'] = 'Sat, 01 Jun 2013 10:00:00 GMT';
+
+		$response = new Phalcon\Http\Response();
+		$this->assertTrue($response->checkNotModified(null, 1370080800));
+		$this->assertEquals($response->getHeaders()->get('Last-Modified'), 'Sat, 01 Jun 2013 10:00:00 GMT');
+
+		$response = new Phalcon\Http\Response();
+		$this->assertFalse($response->checkNotModified(null, 1370080801));
+
+		$_SERVER['REQUEST_METHOD'] = 'POST';
+
+		$response = new Phalcon\Http\Response();
+		$this->assertFalse($response->checkNotModified(null, 1370080800));
+
+		unset($_SERVER['HTTP_IF_MODIFIED_SINCE']);
+		unset($_SERVER['REQUEST_METHOD']);
+
+	}
+
+	public function testLastModifiedDates()
+	{
+
+		$response = new Phalcon\Http\Response();
+
+		$response->setLastModified(1370080800);
+		$this->assertEquals($response->getHeaders()->get('Last-Modified'), 'Sat, 01 Jun 2013 10:00:00 GMT');
+
+		$response->setLastModified('2013-06-01 10:00:00 UTC');
+		$this->assertEquals($response->getHeaders()->get('Last-Modified'), 'Sat, 01 Jun 2013 10:00:00 GMT');
+
+		$response->setLastModified(new DateTime('2013-06-01 10:00:00', new DateTimeZone('UTC')));
+		$this->assertEquals($response->getHeaders()->get('Last-Modified'), 'Sat, 01 Jun 2013 10:00:00 GMT');
+
+		try {
+			$response->setLastModified('not a date');
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Http\Response\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		try {
+			$response->setLastModified(new stdClass());
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Http\Response\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$_SERVER['HTTP_IF_MODIFIED_SINCE'] = 'Sat, 01 Jun 2013 10:00:00 GMT';
+
+		$response = new Phalcon\Http\Response();
+		$this->assertTrue($response->checkNotModified(null, '2013-06-01 10:00:00 UTC'));
+
+		$response = new Phalcon\Http\Response();
+		$this->assertFalse($response->checkNotModified(null, '2013-06-01 10:00:01 UTC'));
+
+		unset($_SERVER['HTTP_IF_MODIFIED_SINCE']);
+		unset($_SERVER['REQUEST_METHOD']);
+
+	}
+
+	public function testAutoEtag()
+	{
+
+		$response = new Phalcon\Http\Response();
+		$response->setAutoEtag(true);
+		$response->setContent('Hello');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), 'Hello');
+		$this->assertEquals($response->getHeaders()->get('Etag'), 'W/"' . md5('Hello') . '"');
+
+		$_SERVER['HTTP_IF_NONE_MATCH'] = 'W/"' . md5('Hello') . '"';
+
+		$response = new Phalcon\Http\Response();
+		$response->setAutoEtag(true);
+		$response->setContent('Hello');
+
+		ob_start();
+		$response->send();
+		$this->assertEquals(ob_get_clean(), '');
+		$this->assertTrue($response->isNotModified());
+
+		unset($_SERVER['HTTP_IF_NONE_MATCH']);
+
+	}
+
 }
\ No newline at end of file
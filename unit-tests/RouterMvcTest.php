@@ -137,65 +137,70 @@ class RouterMvcTest extends PHPUnit_Framework_TestCase
 			),
 		);
 
-		$router = new Phalcon\Mvc\Router();
+		foreach (array(false, true) as $compiled) {
 
-		$router->add('/', array(
-			'controller' => 'index',
-			'action' => 'index'
-		));
+			$router = new Phalcon\Mvc\Router();
 
-		$router->add('/system/:controller/a/:action/:params', array(
-			'controller' => 1,
-			'action' => 2,
-			'params' => 3,
-		));
+			$router->setCompiledMatching($compiled);
 
-		$router->add('/([a-z]{2})/:controller', array(
-			'controller' => 2,
-			'action' => 'index',
-			'language' => 1
-		));
+			$router->add('/', array(
+				'controller' => 'index',
+				'action' => 'index'
+			));
 
-		$router->add('/admin/:controller/:action/:int', array(
-			'controller' => 1,
-			'action' => 2,
-			'id' => 3
-		));
+			$router->add('/system/:controller/a/:action/:params', array(
+				'controller' => 1,
+				'action' => 2,
+				'params' => 3,
+			));
 
-		$router->add('/posts/([0-9]{4})/([0-9]{2})/([0-9]{2})/:params', array(
-			'controller' => 'posts',
-			'action' => 'show',
-			'year' => 1,
-			'month' => 2,
-			'day' => 3,
-			'params' => 4,
-		));
+			$router->add('/([a-z]{2})/:controller', array(
+				'controller' => 2,
+				'action' => 'index',
+				'language' => 1
+			));
 
-		$router->add('/manual/([a-z]{2})/([a-z\.]+)\.html', array(
-			'controller' => 'manual',
-			'action' => 'show',
-			'language' => 1,
-			'file' => 2
-		));
+			$router->add('/admin/:controller/:action/:int', array(
+				'controller' => 1,
+				'action' => 2,
+				'id' => 3
+			));
 
-		$router->add('/named-manual/{language:([a-z]{2})}/{file:[a-z\.]+}\.html', array(
-			'controller' => 'manual',
-			'action' => 'show',
-		));
+			$router->add('/posts/([0-9]{4})/([0-9]{2})/([0-9]{2})/:params', array(
+				'controller' => 'posts',
+				'action' => 'show',
+				'year' => 1,
+				'month' => 2,
+				'day' => 3,
+				'params' => 4,
+			));
 
-		$router->add('/very/static/route', array(
-			'controller' => 'static',
-			'action' => 'route'
-		));
+			$router->add('/manual/([a-z]{2})/([a-z\.]+)\.html', array(
+				'controller' => 'manual',
+				'action' => 'show',
+				'language' => 1,
+				'file' => 2
+			));
 
-		$router->add("/feed/{lang:[a-z]+}/blog/{blog:[a-z\-]+}\.{type:[a-z\-]+}", "Feed::get");
+			$router->add('/named-manual/{language:([a-z]{2})}/{file:[a-z\.]+}\.html', array(
+				'controller' => 'manual',
+				'action' => 'show',
+			));
 
-		$router->add("/posts/{year:[0-9]+}/s/{title:[a-z\-]+}", "Posts::show");
+			$router->add('/very/static/route', array(
+				'controller' => 'static',
+				'action' => 'route'
+			));
 
-		$router->add("/posts/delete/{id}", "Posts::delete");
+			$router->add("/feed/{lang:[a-z]+}/blog/{blog:[a-z\-]+}\.{type:[a-z\-]+}", "Feed::get");
 
-		foreach ($tests as $n => $test) {
-			$this->_runTest($router, $test);
+			$router->add("/posts/{year:[0-9]+}/s/{title:[a-z\-]+}", "Posts::show");
+
+			$router->add("/posts/delete/{id}", "Posts::delete");
+
+			foreach ($tests as $n => $test) {
+				$this->_runTest($router, $test);
+			}
 		}
 
 	}
@@ -637,6 +642,59 @@ class RouterMvcTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($trace, 2);
 	}
 
+	public function testCompiledMatching()
+	{
+		Phalcon\Mvc\Router\Route::reset();
+
+		$router = new Phalcon\Mvc\Router(false);
+
+		$router->setCompiledMatching(true);
+
+		$this->assertTrue($router->isCompiledMatching());
+
+		$router->add('/products/{id:[0-9]+}', 'Products::show');
+
+		$router->add('/products/([a-z]+)', array(
+			'controller' => 'products',
+			'action' => 1
+		));
+
+		$router->add('/products/(.*)', 'Products::fallback')->beforeMatch(function() {
+			return false;
+		});
+
+		$about = $router->add('/about', 'Pages::about');
+
+		$router->handle('/products/10');
+		$this->assertTrue($router->wasMatched());
+		$this->assertEquals($router->getActionName(), 'show');
+		$this->assertEquals($router->getParams(), array('id' => '10'));
+
+		$router->handle('/products/list');
+		$this->assertEquals($router->getActionName(), 'list');
+
+		$router->handle('/about');
+		$this->assertEquals($router->getControllerName(), 'pages');
+
+		$router->handle('/unknown');
+		$this->assertFalse($router->wasMatched());
+
+		//Routes added after the first match are indexed again
+		$router->add('/products/(.*)', 'Products::latest');
+
+		$router->handle('/products/10');
+		$this->assertEquals($router->getActionName(), 'latest');
+
+		//Routes changed after the first match are indexed again
+		$about->reConfigure('/about-us', 'Pages::about');
+
+		$router->handle('/about');
+		$this->assertFalse($router->wasMatched());
+
+		$router->handle('/about-us');
+		$this->assertEquals($router->getControllerName(), 'pages');
+	}
+
 	public function testHostnameRouter()
 	{
 		Phalcon\Mvc\Router\Route::reset();
@@ -1216,6 +1216,46 @@ Clearly, the song is: <?php echo $this->getContent(); ?>.
 
 	}
 
+	public function testVoltCompilerInlinePartials()
+	{
+
+		@unlink('unit-tests/views/inline/index.volt.php');
+		@unlink('unit-tests/views/inline/index.volt.php.deps');
+
+		file_put_contents('unit-tests/views/inline/partials/item.volt', '<li>{{ name }}</li>');
+
+		$view = new Phalcon\Mvc\View();
+		$view->setViewsDir('unit-tests/views/');
+		$view->setPartialsDir('inline/partials/');
+
+		$volt = new \Phalcon\Mvc\View\Engine\Volt\Compiler($view);
+		$volt->setOptions(array(
+			'inlinePartials' => true
+		));
+
+		//Partials with a literal path are replaced by their code
+		$volt->compile('unit-tests/views/inline/index.volt');
+
+		$compilation = file_get_contents('unit-tests/views/inline/index.volt.php');
+		$this->assertEquals($compilation, '<ul><li><?php echo $name; ?></li></ul>');
+		$this->assertEquals($volt->getDependencies(), array(
+			'unit-tests/views/inline/partials/item.volt' => 'unit-tests/views/inline/partials/item.volt'
+		));
+		$this->assertTrue(file_exists('unit-tests/views/inline/index.volt.php.deps'));
+
+		//Changing the partial recompiles the template that includes it
+		file_put_contents('unit-tests/views/inline/partials/item.volt', '<li class="item">{{ name }}</li>');
+		touch('unit-tests/views/inline/partials/item.volt', time() + 10);
+
+		$volt->compile('unit-tests/views/inline/index.volt');
+
+		$compilation = file_get_contents('unit-tests/views/inline/index.volt.php');
+		$this->assertEquals($compilation, '<ul><li class="item"><?php echo $name; ?></li></ul>');
+
+		file_put_contents('unit-tests/views/inline/partials/item.volt', '<li>{{ name }}</li>');
+
+	}
+
 	public function testVoltCompilerFileOptions()
 	{
 
@@ -1305,6 +1345,85 @@ Clearly, the song is: <?php echo $this->getContent(); ?>.
 
 	}
 
+	public function testVoltManifest()
+	{
+
+		@unlink('unit-tests/cache/views.manifest');
+
+		$di = new Phalcon\DI();
+
+		$view = new Phalcon\Mvc\View();
+		$view->setDI($di);
+		$view->setViewsDir('unit-tests/views/manifest/');
+
+		$view->registerEngines(array(
+			'.volt' => function($view, $di) {
+				$volt = new Phalcon\Mvc\View\Engine\Volt($view, $di);
+				$volt->setOptions(array(
+					'compiledPath' => 'unit-tests/cache/',
+					'compiledSeparator' => '_'
+				));
+				return $volt;
+			},
+			'.phtml' => 'Phalcon\Mvc\View\Engine\Php'
+		));
+
+		$manifest = $view->precompile('unit-tests/cache/views.manifest');
+		$this->assertTrue(file_exists('unit-tests/cache/views.manifest'));
+
+		ksort($manifest['views']);
+		$this->assertEquals($manifest['views'], array(
+			'base' => '.volt',
+			'index/index' => '.volt',
+			'index/plain' => '.phtml',
+			'layouts/main' => '.volt'
+		));
+		$this->assertEquals(count($manifest['compiled']), 3);
+
+		$compiledPath = $view->getCompiledPath('unit-tests/views/manifest/index/index.volt');
+		$this->assertTrue(file_exists($compiledPath));
+		$this->assertEquals($view->getCompiledPath('unit-tests/views/manifest/index/plain.phtml'), null);
+
+		//A new view in production mode, the manifest is already in memory
+		$view = new Phalcon\Mvc\View();
+		$view->setDI($di);
+		$view->setViewsDir('unit-tests/views/manifest/');
+		$view->registerEngines(array(
+			'.volt' => 'Phalcon\Mvc\View\Engine\Volt',
+			'.phtml' => 'Phalcon\Mvc\View\Engine\Php'
+		));
+		$view->setManifest('unit-tests/cache/views.manifest');
+		$this->assertEquals($view->getManifest(), $manifest);
+
+		$view->setParamToView('name', 'Manifest');
+		$view->setLayout('main');
+
+		$view->start();
+		$view->render('index', 'index');
+		$view->finish();
+		$this->assertEquals($view->getContent(), '<main>[Hello Manifest]</main>');
+
+		$view->start();
+		$view->setRenderLevel(Phalcon\Mvc\View::LEVEL_ACTION_VIEW);
+		$view->render('index', 'plain');
+		$view->finish();
+		$this->assertEquals($view->getContent(), 'Plain Manifest');
+
+		//Templates added after the manifest was built are not seen
+		file_put_contents('unit-tests/views/manifest/index/added.volt', 'Added');
+
+		try {
+			$view->partial('index/added');
+			$this->assertTrue(false);
+		}
+		catch (Phalcon\Mvc\View\Exception $e) {
+			$this->assertEquals($e->getMessage(), "View 'unit-tests/views/manifest/index/added' was not found in the views directory");
+		}
+
+		@unlink('unit-tests/views/manifest/index/added.volt');
+
+	}
+
 	public function testVoltEngineBuiltInFunctions()
 	{
 
@@ -0,0 +1,12 @@
+<?php
+
+return array(
+	'request' => 'Phalcon\Http\Request',
+	'component' => array(
+		'className' => 'InjectableComponent',
+		'arguments' => array(
+			array('type' => 'service', 'name' => 'response')
+		),
+		'shared' => true
+	)
+);